@@ -61,16 +61,29 @@ namespace api
 		SetResponse(http::StatusCode::InternalServerError, error->what());
 	}
 
+	ApiResponse::ApiResponse(const std::shared_ptr<const ov::Data> &serialized_body, const ov::String &etag, const ov::String &content_type)
+		: _serialized_body(serialized_body),
+		  _etag(etag),
+		  _content_type(content_type)
+	{
+	}
+
 	ApiResponse::ApiResponse(const ApiResponse &response)
 	{
 		_status_code = response._status_code;
 		_json = response._json;
+		_serialized_body = response._serialized_body;
+		_etag = response._etag;
+		_content_type = response._content_type;
 	}
 
 	ApiResponse::ApiResponse(ApiResponse &&response)
 	{
 		_status_code = std::move(response._status_code);
 		_json = std::move(response._json);
+		_serialized_body = std::move(response._serialized_body);
+		_etag = std::move(response._etag);
+		_content_type = std::move(response._content_type);
 	}
 
 	void ApiResponse::SetResponse(http::StatusCode status_code)
@@ -93,12 +106,53 @@ namespace api
 		_json["response"] = json;
 	}
 
+	bool ApiResponse::IsETagMatched(const ov::String &if_none_match, const ov::String &etag)
+	{
+		// https://www.rfc-editor.org/rfc/rfc9110#section-13.1.2
+		// If-None-Match = "*" / #entity-tag
+		// A recipient MUST use the weak comparison function when comparing entity tags for If-None-Match
+		for (auto &tag : if_none_match.Split(","))
+		{
+			tag = tag.Trim();
+
+			if (tag.HasPrefix("W/"))
+			{
+				tag = tag.Substring(2);
+			}
+
+			if ((tag == "*") || (tag == etag))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	bool ApiResponse::SendToClient(const std::shared_ptr<http::svr::HttpExchange> &client)
 	{
 		const auto &response = client->GetResponse();
 
+		if (_etag.IsEmpty() == false)
+		{
+			response->SetHeader("ETag", _etag);
+
+			auto if_none_match = client->GetRequest()->GetHeader("If-None-Match");
+
+			if ((if_none_match.IsEmpty() == false) && IsETagMatched(if_none_match, _etag))
+			{
+				response->SetStatusCode(http::StatusCode::NotModified);
+				return true;
+			}
+		}
+
 		response->SetStatusCode(_status_code);
-		response->SetHeader("Content-Type", "application/json;charset=UTF-8");
+		response->SetHeader("Content-Type", _content_type);
+
+		if (_serialized_body != nullptr)
+		{
+			return response->AppendData(_serialized_body);
+		}
 
 		return (_json.isNull() == false) ? response->AppendString(ov::Json::Stringify(_json)) : true;
 	}
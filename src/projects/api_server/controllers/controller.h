@@ -61,6 +61,11 @@ namespace api
 		// }
 		ApiResponse(const std::exception *error);
 
+		// Sends the response body that is already serialized (e.g. cached statistics) as is.
+		// If etag matches the If-None-Match header of the request, 304 Not Modified is sent without the body
+		ApiResponse(const std::shared_ptr<const ov::Data> &serialized_body, const ov::String &etag,
+					const ov::String &content_type = "application/json;charset=UTF-8");
+
 		// Copy ctor
 		ApiResponse(const ApiResponse &response);
 		// Move ctor
@@ -79,8 +84,15 @@ namespace api
 		void SetResponse(http::StatusCode status_code, const char *message);
 		void SetResponse(http::StatusCode status_code, const char *message, const Json::Value &json);
 
+		static bool IsETagMatched(const ov::String &if_none_match, const ov::String &etag);
+
 		http::StatusCode _status_code = http::StatusCode::OK;
 		Json::Value _json = Json::Value::null;
+
+		// If it is not nullptr, it is sent instead of _json
+		std::shared_ptr<const ov::Data> _serialized_body;
+		ov::String _etag;
+		ov::String _content_type = "application/json;charset=UTF-8";
 	};
 
 	class ControllerInterface
@@ -8,6 +8,8 @@
 //==============================================================================
 #include "current_controller.h"
 
+#include "../prometheus_exporter.h"
+#include "../stats_cache.h"
 #include "vhosts/vhosts_controller.h"
 #include "internals/internals_controller.h"
 
@@ -20,6 +22,8 @@ namespace api
 			void CurrentController::PrepareHandlers()
 			{
 				RegisterGet(R"()", &CurrentController::OnGetServerMetrics);
+				RegisterGet(R"(\/streams)", &CurrentController::OnGetAllStreamMetrics);
+				RegisterGet(R"(\/metrics)", &CurrentController::OnGetPrometheusMetrics);
 
 				CreateSubController<VHostsController>(R"(\/vhosts)");
 				CreateSubController<InternalsController>(R"(\/internals)");
@@ -27,9 +31,40 @@ namespace api
 
 			ApiResponse CurrentController::OnGetServerMetrics(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
+				auto entry = StatsCache::GetInstance()->GetServerStats();
+
+				if (entry != nullptr)
+				{
+					return {entry->body, entry->etag};
+				}
+
 				auto serverMetric = MonitorInstance->GetServerMetrics();
 				return ::serdes::JsonFromMetrics(serverMetric);
 			}
+
+			ApiResponse CurrentController::OnGetAllStreamMetrics(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				auto entry = StatsCache::GetInstance()->GetAllStreamStats();
+
+				if (entry == nullptr)
+				{
+					throw http::HttpError(http::StatusCode::ServiceUnavailable, "The statistics are not ready yet");
+				}
+
+				return {entry->body, entry->etag};
+			}
+
+			ApiResponse CurrentController::OnGetPrometheusMetrics(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				auto entry = PrometheusExporter::GetInstance()->GetMetrics();
+
+				if (entry == nullptr)
+				{
+					throw http::HttpError(http::StatusCode::ServiceUnavailable, "The statistics are not ready yet");
+				}
+
+				return {entry->body, entry->etag, PROMETHEUS_CONTENT_TYPE};
+			}
 		}  // namespace stats
 	}	   // namespace v1
 }  // namespace api
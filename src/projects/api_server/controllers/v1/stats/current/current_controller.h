@@ -22,6 +22,9 @@ namespace api
 				void PrepareHandlers() override;
 
 				ApiResponse OnGetServerMetrics(const std::shared_ptr<http::svr::HttpExchange> &client);
+				ApiResponse OnGetAllStreamMetrics(const std::shared_ptr<http::svr::HttpExchange> &client);
+				// Metrics in the Prometheus text exposition format
+				ApiResponse OnGetPrometheusMetrics(const std::shared_ptr<http::svr::HttpExchange> &client);
 			};
 		}  // namespace stats
 	}	   // namespace v1
@@ -8,6 +8,7 @@
 //==============================================================================
 #include "apps_controller.h"
 
+#include "../../../stats_cache.h"
 #include "streams/streams_controller.h"
 
 namespace api
@@ -23,10 +24,26 @@ namespace api
 				CreateSubController<StreamsController>(R"(\/(?<app_name>[^\/:]*)\/streams)");
 			};
 
-			ApiResponse AppsController::OnGetApp(const std::shared_ptr<http::svr::HttpExchange> &client,
-												 const std::shared_ptr<mon::HostMetrics> &vhost,
-												 const std::shared_ptr<mon::ApplicationMetrics> &app)
+			ApiResponse AppsController::OnGetApp(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
+				auto &match_result = client->GetRequest()->GetMatchResult();
+
+				auto entry = StatsCache::GetInstance()->GetApplicationStats(
+					match_result.GetNamedGroup("vhost_name").GetValue(),
+					match_result.GetNamedGroup("app_name").GetValue());
+
+				if (entry != nullptr)
+				{
+					return {entry->body, entry->etag};
+				}
+
+				// The application may not be in the snapshot yet
+				std::shared_ptr<mon::HostMetrics> vhost;
+				GetVirtualHostMetrics(match_result, &vhost);
+
+				std::shared_ptr<mon::ApplicationMetrics> app;
+				GetApplicationMetrics(match_result, vhost, &app);
+
 				return ::serdes::JsonFromMetrics(app);
 			}
 		}  // namespace stats
@@ -22,9 +22,7 @@ namespace api
 				void PrepareHandlers() override;
 
 			protected:
-				ApiResponse OnGetApp(const std::shared_ptr<http::svr::HttpExchange> &client,
-									 const std::shared_ptr<mon::HostMetrics> &vhost,
-									 const std::shared_ptr<mon::ApplicationMetrics> &app);
+				ApiResponse OnGetApp(const std::shared_ptr<http::svr::HttpExchange> &client);
 			};
 		}  // namespace stats
 	}	   // namespace v1
@@ -8,6 +8,8 @@
 //==============================================================================
 #include "streams_controller.h"
 
+#include "../../../../stats_cache.h"
+
 namespace api
 {
 	namespace v1
@@ -19,13 +21,31 @@ namespace api
 				RegisterGet(R"(\/(?<stream_name>[^\/]*))", &StreamsController::OnGetStream);
 			};
 
-			ApiResponse StreamsController::OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client,
-													   const std::shared_ptr<mon::HostMetrics> &vhost,
-													   const std::shared_ptr<mon::ApplicationMetrics> &app,
-													   const std::shared_ptr<mon::StreamMetrics> &stream,
-													   const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			ApiResponse StreamsController::OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
-				return ::serdes::JsonFromMetrics(stream);
+				auto &match_result = client->GetRequest()->GetMatchResult();
+
+				auto entry = StatsCache::GetInstance()->GetStreamStats(
+					match_result.GetNamedGroup("vhost_name").GetValue(),
+					match_result.GetNamedGroup("app_name").GetValue(),
+					match_result.GetNamedGroup("stream_name").GetValue());
+
+				if (entry != nullptr)
+				{
+					return {entry->body, entry->etag};
+				}
+
+				// The stream may not be in the snapshot yet
+				std::shared_ptr<mon::HostMetrics> vhost;
+				GetVirtualHostMetrics(match_result, &vhost);
+
+				std::shared_ptr<mon::ApplicationMetrics> app;
+				GetApplicationMetrics(match_result, vhost, &app);
+
+				std::shared_ptr<mon::StreamMetrics> stream;
+				GetStreamMetrics(match_result, vhost, app, &stream, nullptr);
+
+				return ::serdes::JsonFromStreamStats(stream);
 			}
 		}  // namespace stats
 	}	   // namespace v1
@@ -22,11 +22,7 @@ namespace api
 				void PrepareHandlers() override;
 
 			protected:
-				ApiResponse OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client,
-										const std::shared_ptr<mon::HostMetrics> &vhost,
-										const std::shared_ptr<mon::ApplicationMetrics> &app,
-										const std::shared_ptr<mon::StreamMetrics> &stream,
-										const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+				ApiResponse OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client);
 			};
 		}  // namespace stats
 	}	   // namespace v1
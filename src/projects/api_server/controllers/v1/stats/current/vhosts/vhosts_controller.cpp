@@ -8,6 +8,7 @@
 //==============================================================================
 #include "vhosts_controller.h"
 
+#include "../../stats_cache.h"
 #include "apps/apps_controller.h"
 
 namespace api
@@ -23,9 +24,21 @@ namespace api
 				CreateSubController<AppsController>(R"(\/(?<vhost_name>[^\/]*)\/apps)");
 			};
 
-			ApiResponse VHostsController::OnGetVhost(const std::shared_ptr<http::svr::HttpExchange> &client,
-													 const std::shared_ptr<mon::HostMetrics> &vhost)
+			ApiResponse VHostsController::OnGetVhost(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
+				auto &match_result = client->GetRequest()->GetMatchResult();
+
+				auto entry = StatsCache::GetInstance()->GetVirtualHostStats(match_result.GetNamedGroup("vhost_name").GetValue());
+
+				if (entry != nullptr)
+				{
+					return {entry->body, entry->etag};
+				}
+
+				// The virtual host may not be in the snapshot yet
+				std::shared_ptr<mon::HostMetrics> vhost;
+				GetVirtualHostMetrics(match_result, &vhost);
+
 				return ::serdes::JsonFromMetrics(vhost);
 			}
 		}  // namespace stats
@@ -0,0 +1,476 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "prometheus_exporter.h"
+
+#include <charconv>
+#include <string_view>
+
+#define PROMETHEUS_METRIC_PREFIX "ome_"
+
+namespace api
+{
+	namespace v1
+	{
+		namespace stats
+		{
+			using Values = mon::MetricsSnapshot::Values;
+
+			struct ValueFamily
+			{
+				const char *name;
+				const char *type;
+				const char *help;
+				uint64_t (*getter)(const Values &values);
+			};
+
+			// ome_<scope>_<name>
+			static const ValueFamily VALUE_FAMILIES[] = {
+				{"bytes_in_total", "counter", "Total bytes received",
+				 [](const Values &values) -> uint64_t { return values.total_bytes_in; }},
+				{"bytes_out_total", "counter", "Total bytes sent",
+				 [](const Values &values) -> uint64_t { return values.total_bytes_out; }},
+				{"throughput_in_bits_per_second", "gauge", "Incoming throughput measured over the last second",
+				 [](const Values &values) -> uint64_t { return values.avg_throughput_in; }},
+				{"throughput_out_bits_per_second", "gauge", "Outgoing throughput measured over the last second",
+				 [](const Values &values) -> uint64_t { return values.avg_throughput_out; }},
+				{"max_throughput_in_bits_per_second", "gauge", "Maximum incoming throughput",
+				 [](const Values &values) -> uint64_t { return values.max_throughput_in; }},
+				{"max_throughput_out_bits_per_second", "gauge", "Maximum outgoing throughput",
+				 [](const Values &values) -> uint64_t { return values.max_throughput_out; }},
+				{"connections", "gauge", "Number of the sessions of all publishers",
+				 [](const Values &values) -> uint64_t { return values.total_connections; }},
+				{"max_connections", "gauge", "Maximum number of the sessions of all publishers",
+				 [](const Values &values) -> uint64_t { return values.max_total_connections; }},
+			};
+
+			static constexpr int8_t PUBLISHER_TYPE_COUNT = static_cast<int8_t>(PublisherType::NumberOfPublishers);
+
+			static void AppendUInt64(ov::String *output, uint64_t value)
+			{
+				char buffer[24];
+				auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+				output->Append(buffer, result.ptr - buffer);
+			}
+
+			static void AppendInt64(ov::String *output, int64_t value)
+			{
+				char buffer[24];
+				auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+				output->Append(buffer, result.ptr - buffer);
+			}
+
+			static void AppendString(ov::String *output, const ov::String &value)
+			{
+				output->Append(value.CStr(), value.GetLength());
+			}
+
+			// Appends the value with the escape sequences of the label value (\\, \", \n)
+			static void AppendLabelValue(ov::String *output, const ov::String &value)
+			{
+				auto buffer = value.CStr();
+				auto length = value.GetLength();
+				size_t run_start = 0;
+
+				for (size_t index = 0; index < length; index++)
+				{
+					auto ch = buffer[index];
+
+					if ((ch != '\\') && (ch != '"') && (ch != '\n'))
+					{
+						continue;
+					}
+
+					output->Append(buffer + run_start, index - run_start);
+					run_start = index + 1;
+
+					output->Append((ch == '\n') ? "\\n" : (ch == '"') ? "\\\"" : "\\\\");
+				}
+
+				output->Append(buffer + run_start, length - run_start);
+			}
+
+			static void AppendLabel(ov::String *output, const char *name, const ov::String &value)
+			{
+				if (output->IsEmpty() == false)
+				{
+					output->Append(',');
+				}
+
+				output->Append(name);
+				output->Append("=\"");
+				AppendLabelValue(output, value);
+				output->Append('"');
+			}
+
+			// # HELP <name> <help>
+			// # TYPE <name> <type>
+			static void AppendHeader(ov::String *output, const ov::String &name, const char *type, const char *help)
+			{
+				output->Append("# HELP ");
+				AppendString(output, name);
+				output->Append(' ');
+				output->Append(help);
+				output->Append("\n# TYPE ");
+				AppendString(output, name);
+				output->Append(' ');
+				output->Append(type);
+				output->Append('\n');
+			}
+
+			// <name>{<labels>,<extra_labels>} (The labels are omitted if both are empty)
+			static void AppendName(ov::String *output, const ov::String &name, const ov::String &labels, const ov::String &extra_labels)
+			{
+				AppendString(output, name);
+
+				if (labels.IsEmpty() && extra_labels.IsEmpty())
+				{
+					return;
+				}
+
+				output->Append('{');
+				AppendString(output, labels);
+
+				if ((labels.IsEmpty() == false) && (extra_labels.IsEmpty() == false))
+				{
+					output->Append(',');
+				}
+
+				AppendString(output, extra_labels);
+				output->Append('}');
+			}
+
+			static void AppendSample(ov::String *output, const ov::String &name, const ov::String &labels, uint64_t value)
+			{
+				AppendName(output, name, labels, {});
+				output->Append(' ');
+				AppendUInt64(output, value);
+				output->Append('\n');
+			}
+
+			static ov::String MakeName(const char *scope, const char *name)
+			{
+				return ov::String::FormatString(PROMETHEUS_METRIC_PREFIX "%s_%s", scope, name);
+			}
+
+			std::shared_ptr<const PrometheusExporter::Entry> PrometheusExporter::GetMetrics()
+			{
+				auto snapshot = MonitorInstance->GetMetricsSnapshot();
+
+				if (snapshot == nullptr)
+				{
+					return nullptr;
+				}
+
+				// Scrapes during the rendering wait for it, so the text is rendered only once per snapshot
+				std::lock_guard lock_guard(_mutex);
+
+				if (_snapshot == snapshot)
+				{
+					return _entry;
+				}
+
+				ov::String text;
+
+				// The size of the text rarely changes much between the snapshots
+				if (_entry != nullptr)
+				{
+					text.SetCapacity(_entry->body->GetLength() + (_entry->body->GetLength() / 8));
+				}
+
+				Render(*snapshot, &text);
+
+				auto entry = std::make_shared<Entry>();
+				auto hash = std::hash<std::string_view>()(std::string_view(text.CStr(), text.GetLength()));
+
+				entry->etag = ov::String::FormatString("\"%zx-%zu\"", hash, text.GetLength());
+				entry->body = text.ToData(false);
+
+				_snapshot = snapshot;
+				_entry = entry;
+
+				return entry;
+			}
+
+			const ov::String &PrometheusExporter::GetLabels(std::unordered_map<uint64_t, Labels> &labels_map, uint64_t version, uint64_t id, const LabelList &label_list, const char *id_label)
+			{
+				auto &labels = labels_map[id];
+
+				labels.version = version;
+
+				if (labels.values.size() == label_list.size())
+				{
+					auto value = labels.values.begin();
+					bool is_changed = false;
+
+					for (const auto &label : label_list)
+					{
+						if (*value != *(label.second))
+						{
+							is_changed = true;
+							break;
+						}
+
+						++value;
+					}
+
+					if (is_changed == false)
+					{
+						return labels.labels;
+					}
+				}
+
+				labels.values.clear();
+				labels.labels.Clear();
+
+				if (id_label != nullptr)
+				{
+					AppendLabel(&labels.labels, id_label, ov::String::FormatString("%" PRIu64, id));
+				}
+
+				for (const auto &label : label_list)
+				{
+					labels.values.push_back(*(label.second));
+					AppendLabel(&labels.labels, label.first, *(label.second));
+				}
+
+				return labels.labels;
+			}
+
+			void PrometheusExporter::RemoveUnusedLabels(std::unordered_map<uint64_t, Labels> &labels_map, uint64_t version)
+			{
+				for (auto item = labels_map.begin(); item != labels_map.end();)
+				{
+					if (item->second.version != version)
+					{
+						item = labels_map.erase(item);
+					}
+					else
+					{
+						++item;
+					}
+				}
+			}
+
+			void PrometheusExporter::Render(const mon::MetricsSnapshot &snapshot, ov::String *output)
+			{
+				const auto version = snapshot.version;
+				const ov::String empty_labels;
+
+				std::vector<Target> server_targets{{&empty_labels, &snapshot.server}};
+				std::vector<Target> host_targets;
+				std::vector<Target> app_targets;
+				std::vector<Target> stream_targets;
+				std::vector<std::pair<const ov::String *, size_t>> app_stream_counts;
+
+				host_targets.reserve(snapshot.hosts.size());
+
+				for (const auto &host : snapshot.hosts)
+				{
+					host_targets.push_back({&GetLabels(_host_labels, version, host.id, {{"vhost", &host.name}}), &host.values});
+
+					for (const auto &application : host.applications)
+					{
+						auto &app_labels = GetLabels(_app_labels, version, application.id, {{"vhost", &host.name}, {"app", &application.name}});
+
+						app_targets.push_back({&app_labels, &application.values});
+						app_stream_counts.emplace_back(&app_labels, application.input_stream_index.size());
+
+						for (const auto &stream : application.streams)
+						{
+							// The values of the output streams are also accumulated to the input stream.
+							// If there are input streams with the same name, only the first one is rendered to avoid duplicate series
+							if (stream.is_input && (application.FindInputStream(stream.name) == &stream))
+							{
+								stream_targets.push_back({&GetLabels(_stream_labels, version, (static_cast<uint64_t>(application.id) << 32) | stream.id, {{"vhost", &host.name}, {"app", &application.name}, {"stream", &stream.name}}),
+														  &stream.values});
+							}
+						}
+					}
+				}
+
+				RenderValues("server", server_targets, output);
+				RenderValues("vhost", host_targets, output);
+				RenderValues("app", app_targets, output);
+				RenderValues("stream", stream_targets, output);
+
+				{
+					auto name = MakeName("app", "streams");
+					AppendHeader(output, name, "gauge", "Number of the input streams");
+
+					for (const auto &[labels, count] : app_stream_counts)
+					{
+						AppendSample(output, name, *labels, count);
+					}
+				}
+
+				// Queues
+				{
+					std::vector<const ov::String *> queue_labels;
+					queue_labels.reserve(snapshot.queues.size());
+
+					for (const auto &queue : snapshot.queues)
+					{
+						queue_labels.push_back(&GetLabels(_queue_labels, version, queue.id, {{"urn", &queue.urn}, {"type", &queue.type_name}}, "id"));
+					}
+
+					struct QueueFamily
+					{
+						const char *name;
+						const char *type;
+						const char *help;
+						int64_t (*getter)(const mon::MetricsSnapshot::Queue &queue);
+					};
+
+					static const QueueFamily QUEUE_FAMILIES[] = {
+						{"size", "gauge", "Number of the messages in the queue",
+						 [](const mon::MetricsSnapshot::Queue &queue) -> int64_t { return queue.size; }},
+						{"peak", "gauge", "Maximum number of the messages in the queue",
+						 [](const mon::MetricsSnapshot::Queue &queue) -> int64_t { return queue.peak; }},
+						{"threshold", "gauge", "Number of the messages that the queue is considered to be congested",
+						 [](const mon::MetricsSnapshot::Queue &queue) -> int64_t { return queue.threshold; }},
+						{"waiting_time_microseconds", "gauge", "Average time that the messages wait in the queue",
+						 [](const mon::MetricsSnapshot::Queue &queue) -> int64_t { return queue.waiting_time; }},
+						{"input_messages_per_second", "gauge", "Number of the messages pushed in the last second",
+						 [](const mon::MetricsSnapshot::Queue &queue) -> int64_t { return queue.input_per_second; }},
+						{"output_messages_per_second", "gauge", "Number of the messages popped in the last second",
+						 [](const mon::MetricsSnapshot::Queue &queue) -> int64_t { return queue.output_per_second; }},
+						{"dropped_messages_total", "counter", "Total messages dropped from the queue",
+						 [](const mon::MetricsSnapshot::Queue &queue) -> int64_t { return queue.drop_count; }},
+					};
+
+					for (const auto &family : QUEUE_FAMILIES)
+					{
+						auto name = MakeName("queue", family.name);
+						AppendHeader(output, name, family.type, family.help);
+
+						for (size_t index = 0; index < snapshot.queues.size(); index++)
+						{
+							AppendName(output, name, *(queue_labels[index]), {});
+							output->Append(' ');
+							AppendInt64(output, family.getter(snapshot.queues[index]));
+							output->Append('\n');
+						}
+					}
+				}
+
+				// Socket pools (There are only a few pools, so the labels are not cached)
+				{
+					std::vector<ov::String> pool_labels;
+					pool_labels.reserve(snapshot.socket_pools.size());
+
+					for (const auto &socket_pool : snapshot.socket_pools)
+					{
+						auto &labels = pool_labels.emplace_back();
+
+						AppendLabel(&labels, "name", socket_pool.name);
+						AppendLabel(&labels, "type", socket_pool.type_name);
+					}
+
+					auto workers_name = MakeName("socket_pool", "workers");
+					AppendHeader(output, workers_name, "gauge", "Number of the workers of the socket pool");
+
+					for (size_t index = 0; index < snapshot.socket_pools.size(); index++)
+					{
+						AppendSample(output, workers_name, pool_labels[index], snapshot.socket_pools[index].worker_count);
+					}
+
+					auto sockets_name = MakeName("socket_pool", "sockets");
+					AppendHeader(output, sockets_name, "gauge", "Number of the sockets assigned to the workers of the socket pool");
+
+					for (size_t index = 0; index < snapshot.socket_pools.size(); index++)
+					{
+						AppendSample(output, sockets_name, pool_labels[index], snapshot.socket_pools[index].socket_count);
+					}
+
+					auto allocated_name = MakeName("socket_pool", "allocated_sockets_total");
+					AppendHeader(output, allocated_name, "counter", "Total sockets allocated from the socket pool");
+
+					for (size_t index = 0; index < snapshot.socket_pools.size(); index++)
+					{
+						AppendSample(output, allocated_name, pool_labels[index], snapshot.socket_pools[index].total_allocated_count);
+					}
+				}
+
+				RemoveUnusedLabels(_host_labels, version);
+				RemoveUnusedLabels(_app_labels, version);
+				RemoveUnusedLabels(_stream_labels, version);
+				RemoveUnusedLabels(_queue_labels, version);
+			}
+
+			void PrometheusExporter::RenderValues(const char *scope, const std::vector<Target> &targets, ov::String *output)
+			{
+				for (const auto &family : VALUE_FAMILIES)
+				{
+					auto name = MakeName(scope, family.name);
+					AppendHeader(output, name, family.type, family.help);
+
+					for (const auto &target : targets)
+					{
+						AppendSample(output, name, *(target.labels), family.getter(*(target.values)));
+					}
+				}
+
+				// The labels of the publishers are rendered only once
+				static const auto publisher_labels = []() {
+					std::vector<ov::String> labels;
+
+					for (int8_t type = 0; type < PUBLISHER_TYPE_COUNT; type++)
+					{
+						auto &label = labels.emplace_back();
+						AppendLabel(&label, "publisher", ::StringFromPublisherType(static_cast<PublisherType>(type)));
+					}
+
+					return labels;
+				}();
+
+				// Publishers that have never been used are skipped. bytes_out never decreases,
+				// so a series doesn't disappear once it appears.
+				auto is_publisher_used = [](const Values &values, int8_t type) -> bool {
+					return (values.bytes_out[type] > 0) || (values.connections[type] > 0);
+				};
+
+				auto bytes_out_name = MakeName(scope, "publisher_bytes_out_total");
+				AppendHeader(output, bytes_out_name, "counter", "Total bytes sent by the publisher");
+
+				for (const auto &target : targets)
+				{
+					for (int8_t type = 0; type < PUBLISHER_TYPE_COUNT; type++)
+					{
+						if (is_publisher_used(*(target.values), type))
+						{
+							AppendName(output, bytes_out_name, *(target.labels), publisher_labels[type]);
+							output->Append(' ');
+							AppendUInt64(output, target.values->bytes_out[type]);
+							output->Append('\n');
+						}
+					}
+				}
+
+				auto connections_name = MakeName(scope, "publisher_connections");
+				AppendHeader(output, connections_name, "gauge", "Number of the sessions of the publisher");
+
+				for (const auto &target : targets)
+				{
+					for (int8_t type = 0; type < PUBLISHER_TYPE_COUNT; type++)
+					{
+						if (is_publisher_used(*(target.values), type))
+						{
+							AppendName(output, connections_name, *(target.labels), publisher_labels[type]);
+							output->Append(' ');
+							AppendUInt64(output, target.values->connections[type]);
+							output->Append('\n');
+						}
+					}
+				}
+			}
+		}  // namespace stats
+	}	   // namespace v1
+}  // namespace api
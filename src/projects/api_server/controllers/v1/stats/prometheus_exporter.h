@@ -0,0 +1,93 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <monitoring/monitoring.h>
+
+// https://prometheus.io/docs/instrumenting/exposition_formats/#text-based-format
+#define PROMETHEUS_CONTENT_TYPE "text/plain; version=0.0.4; charset=utf-8"
+
+namespace api
+{
+	namespace v1
+	{
+		namespace stats
+		{
+			// Renders the metrics in the Prometheus text exposition format.
+			//
+			// The text is rendered from mon::MetricsSnapshot at most once per snapshot, and the label strings
+			// ({vhost="...",app="...",stream="..."}) are kept across the snapshots,
+			// so the scrapes only copy the cached text while the streams don't change.
+			class PrometheusExporter
+			{
+			public:
+				struct Entry
+				{
+					std::shared_ptr<const ov::Data> body;
+					ov::String etag;
+				};
+
+				static PrometheusExporter *GetInstance()
+				{
+					static PrometheusExporter exporter;
+					return &exporter;
+				}
+
+				// Returns nullptr if the first snapshot is not taken yet
+				std::shared_ptr<const Entry> GetMetrics();
+
+			private:
+				// <label name, label value>
+				using LabelList = std::initializer_list<std::pair<const char *, const ov::String *>>;
+
+				struct Labels
+				{
+					// The label values that the labels are rendered from
+					std::vector<ov::String> values;
+
+					// Escaped labels without the braces (e.g. vhost="default",app="app")
+					ov::String labels;
+
+					// The version of the snapshot that used the labels last
+					uint64_t version = 0;
+				};
+
+				// A target to render the metrics of mon::MetricsSnapshot::Values
+				struct Target
+				{
+					const ov::String *labels;
+					const mon::MetricsSnapshot::Values *values;
+				};
+
+				void Render(const mon::MetricsSnapshot &snapshot, ov::String *output);
+				static void RenderValues(const char *scope, const std::vector<Target> &targets, ov::String *output);
+
+				// Returns the cached labels of the item, and renders the labels again if the label values are changed.
+				// If id_label is not nullptr, the id is also rendered as a label (for the items that can have the same values)
+				static const ov::String &GetLabels(std::unordered_map<uint64_t, Labels> &labels_map, uint64_t version, uint64_t id, const LabelList &label_list,
+												   const char *id_label = nullptr);
+				// Removes the labels that are not used by the snapshot
+				static void RemoveUnusedLabels(std::unordered_map<uint64_t, Labels> &labels_map, uint64_t version);
+
+				std::mutex _mutex;
+
+				// The snapshot that _entry is rendered from
+				std::shared_ptr<const mon::MetricsSnapshot> _snapshot;
+				std::shared_ptr<const Entry> _entry;
+
+				// key: id of the host/application/queue, (application id << 32 | stream id) of the stream
+				// (stream ids are random, so they can be the same between the applications)
+				std::unordered_map<uint64_t, Labels> _host_labels;
+				std::unordered_map<uint64_t, Labels> _app_labels;
+				std::unordered_map<uint64_t, Labels> _stream_labels;
+				std::unordered_map<uint64_t, Labels> _queue_labels;
+			};
+		}  // namespace stats
+	}	   // namespace v1
+}  // namespace api
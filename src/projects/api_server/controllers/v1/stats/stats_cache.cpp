@@ -0,0 +1,176 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "stats_cache.h"
+
+#include <modules/http/http.h>
+
+#include <string_view>
+
+namespace api
+{
+	namespace v1
+	{
+		namespace stats
+		{
+			std::shared_ptr<const StatsCache::Entry> StatsCache::GetServerStats()
+			{
+				return GetEntry("server", [](const mon::MetricsSnapshot &snapshot, serdes::JsonWriter &writer) -> bool {
+					serdes::WriteMetrics(writer, snapshot.server);
+					return true;
+				});
+			}
+
+			std::shared_ptr<const StatsCache::Entry> StatsCache::GetVirtualHostStats(const ov::String &vhost_name)
+			{
+				return GetEntry(
+					ov::String::FormatString("vhost\n%s", vhost_name.CStr()),
+					[&](const mon::MetricsSnapshot &snapshot, serdes::JsonWriter &writer) -> bool {
+						auto host = snapshot.FindHost(vhost_name);
+
+						if (host == nullptr)
+						{
+							return false;
+						}
+
+						serdes::WriteMetrics(writer, host->values);
+						return true;
+					});
+			}
+
+			std::shared_ptr<const StatsCache::Entry> StatsCache::GetApplicationStats(const ov::String &vhost_name, const ov::String &app_name)
+			{
+				return GetEntry(
+					ov::String::FormatString("app\n%s\n%s", vhost_name.CStr(), app_name.CStr()),
+					[&](const mon::MetricsSnapshot &snapshot, serdes::JsonWriter &writer) -> bool {
+						auto host = snapshot.FindHost(vhost_name);
+						auto application = (host != nullptr) ? host->FindApplication(app_name) : nullptr;
+
+						if (application == nullptr)
+						{
+							return false;
+						}
+
+						serdes::WriteMetrics(writer, application->values);
+						return true;
+					});
+			}
+
+			std::shared_ptr<const StatsCache::Entry> StatsCache::GetStreamStats(const ov::String &vhost_name, const ov::String &app_name, const ov::String &stream_name)
+			{
+				return GetEntry(
+					ov::String::FormatString("stream\n%s\n%s\n%s", vhost_name.CStr(), app_name.CStr(), stream_name.CStr()),
+					[&](const mon::MetricsSnapshot &snapshot, serdes::JsonWriter &writer) -> bool {
+						auto host = snapshot.FindHost(vhost_name);
+						auto application = (host != nullptr) ? host->FindApplication(app_name) : nullptr;
+						auto stream = (application != nullptr) ? application->FindInputStream(stream_name) : nullptr;
+
+						if (stream == nullptr)
+						{
+							return false;
+						}
+
+						serdes::WriteStreamMetrics(writer, *stream);
+						return true;
+					});
+			}
+
+			std::shared_ptr<const StatsCache::Entry> StatsCache::GetAllStreamStats()
+			{
+				return GetEntry("streams", [](const mon::MetricsSnapshot &snapshot, serdes::JsonWriter &writer) -> bool {
+					writer.BeginArray();
+
+					for (const auto &host : snapshot.hosts)
+					{
+						for (const auto &application : host.applications)
+						{
+							for (const auto &stream : application.streams)
+							{
+								if (stream.is_input == false)
+								{
+									continue;
+								}
+
+								writer.BeginObject();
+
+								writer.Key("app");
+								writer.String(application.name);
+								writer.Key("stats");
+								serdes::WriteStreamMetrics(writer, stream);
+								writer.Key("stream");
+								writer.String(stream.name);
+								writer.Key("vhost");
+								writer.String(host.name);
+
+								writer.EndObject();
+							}
+						}
+					}
+
+					writer.EndArray();
+					return true;
+				});
+			}
+
+			std::shared_ptr<const StatsCache::Entry> StatsCache::GetEntry(const ov::String &key, const ResponseWriter &response_writer)
+			{
+				auto snapshot = MonitorInstance->GetMetricsSnapshot();
+
+				if (snapshot == nullptr)
+				{
+					return nullptr;
+				}
+
+				// Requests for the same entry wait for the first one to serialize it, so it is serialized only once per snapshot
+				std::lock_guard lock_guard(_mutex);
+
+				if (_snapshot != snapshot)
+				{
+					_snapshot = snapshot;
+					_entries.clear();
+				}
+
+				auto item = _entries.find(key);
+
+				if (item != _entries.end())
+				{
+					return item->second;
+				}
+
+				ov::String json;
+				serdes::JsonWriter writer(&json);
+
+				// Same as the body of ApiResponse(json)
+				writer.BeginObject();
+				writer.Key("message");
+				writer.String(StringFromStatusCode(http::StatusCode::OK));
+				writer.Key("response");
+
+				if (response_writer(*snapshot, writer) == false)
+				{
+					_entries.emplace(key, nullptr);
+					return nullptr;
+				}
+
+				writer.Key("statusCode");
+				writer.Int64(static_cast<int>(http::StatusCode::OK));
+				writer.EndObject();
+
+				auto entry = std::make_shared<Entry>();
+				auto hash = std::hash<std::string_view>()(std::string_view(json.CStr(), json.GetLength()));
+
+				entry->etag = ov::String::FormatString("\"%zx-%zu\"", hash, json.GetLength());
+				entry->body = json.ToData(false);
+
+				_entries.emplace(key, entry);
+
+				return entry;
+			}
+		}  // namespace stats
+	}	   // namespace v1
+}  // namespace api
@@ -0,0 +1,66 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <modules/json_serdes/converters.h>
+#include <monitoring/monitoring.h>
+
+namespace api
+{
+	namespace v1
+	{
+		namespace stats
+		{
+			// Caches the serialized responses of the statistics APIs for each snapshot of the metrics.
+			//
+			// A response is serialized from mon::MetricsSnapshot on the first request after a new snapshot is taken,
+			// and the following requests are served from the cache until the next snapshot,
+			// so polling the statistics of many streams doesn't touch the live metrics.
+			class StatsCache
+			{
+			public:
+				struct Entry
+				{
+					// The whole response body ({"message": ..., "response": ..., "statusCode": ...})
+					std::shared_ptr<const ov::Data> body;
+					// Calculated from the body, so it doesn't change while the metrics don't change
+					ov::String etag;
+				};
+
+				static StatsCache *GetInstance()
+				{
+					static StatsCache stats_cache;
+					return &stats_cache;
+				}
+
+				// These return nullptr if the target is not in the latest snapshot
+				// (e.g. the stream is created after the snapshot is taken)
+				std::shared_ptr<const Entry> GetServerStats();
+				std::shared_ptr<const Entry> GetVirtualHostStats(const ov::String &vhost_name);
+				std::shared_ptr<const Entry> GetApplicationStats(const ov::String &vhost_name, const ov::String &app_name);
+				std::shared_ptr<const Entry> GetStreamStats(const ov::String &vhost_name, const ov::String &app_name, const ov::String &stream_name);
+				// Statistics of all the input streams of the server
+				std::shared_ptr<const Entry> GetAllStreamStats();
+
+			private:
+				// Writes the "response" of the body, returns false if the target is not found
+				using ResponseWriter = std::function<bool(const mon::MetricsSnapshot &snapshot, serdes::JsonWriter &writer)>;
+
+				std::shared_ptr<const Entry> GetEntry(const ov::String &key, const ResponseWriter &response_writer);
+
+				std::mutex _mutex;
+
+				// The snapshot that the entries are made from
+				std::shared_ptr<const mon::MetricsSnapshot> _snapshot;
+				// key : entry (nullptr if the target is not found)
+				std::unordered_map<ov::String, std::shared_ptr<const Entry>> _entries;
+			};
+		}  // namespace stats
+	}	   // namespace v1
+}  // namespace api
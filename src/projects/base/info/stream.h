@@ -114,6 +114,12 @@ namespace info
 			return _from_origin_map_store;
 		}
 
+		// Depth of this server in the relay tree of OriginMapStore (origin is 0)
+		uint32_t GetOriginMapDepth() const
+		{
+			return _origin_map_depth;
+		}
+
 	protected:
 		info::stream_id_t _id = 0;
 		uint32_t _msid = 0;
@@ -132,6 +138,7 @@ namespace info
 		std::map<ov::String, std::shared_ptr<Playlist>> _playlists;
 
 		bool _from_origin_map_store = false;
+		uint32_t _origin_map_depth = 0;
 
 	private:
 		std::chrono::system_clock::time_point _created_time;
@@ -0,0 +1,70 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Keukhan Kwon
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/info/media_track.h>
+#include <base/info/stream.h>
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <functional>
+#include <map>
+#include <shared_mutex>
+
+// Output tracks that are encoded only when a consumer needs them (e.g. thumbnails).
+//
+// The transcoder registers a handler for each on-demand output track, and the publisher
+// calls Request() when it needs a new encoded frame of the track.
+class OnDemandEncoding : public ov::Singleton<OnDemandEncoding>
+{
+public:
+	using RequestHandler = std::function<void()>;
+
+	void Register(info::stream_id_t stream_id, MediaTrackId track_id, RequestHandler handler)
+	{
+		std::lock_guard<std::shared_mutex> lock(_handler_map_mutex);
+
+		_handler_map[{stream_id, track_id}] = std::move(handler);
+	}
+
+	void Unregister(info::stream_id_t stream_id, MediaTrackId track_id)
+	{
+		std::lock_guard<std::shared_mutex> lock(_handler_map_mutex);
+
+		_handler_map.erase({stream_id, track_id});
+	}
+
+	// Returns false if the track is not on-demand (it is encoded continuously)
+	bool Request(info::stream_id_t stream_id, MediaTrackId track_id)
+	{
+		RequestHandler handler;
+
+		{
+			std::shared_lock<std::shared_mutex> lock(_handler_map_mutex);
+
+			auto handler_it = _handler_map.find({stream_id, track_id});
+			if (handler_it == _handler_map.end())
+			{
+				return false;
+			}
+
+			handler = handler_it->second;
+		}
+
+		if (handler != nullptr)
+		{
+			handler();
+		}
+
+		return true;
+	}
+
+private:
+	std::shared_mutex _handler_map_mutex;
+	std::map<std::pair<info::stream_id_t, MediaTrackId>, RequestHandler> _handler_map;
+};
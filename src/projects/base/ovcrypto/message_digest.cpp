@@ -109,6 +109,19 @@ namespace ov
 		return Destroy() && Create(algorithm);
 	}
 
+	bool MessageDigest::CopyFrom(const MessageDigest &other)
+	{
+		OV_ASSERT2(_context != nullptr);
+		OV_ASSERT2(other._context != nullptr);
+
+		if ((_context == nullptr) || (other._context == nullptr) || (_algorithm != other._algorithm))
+		{
+			return false;
+		}
+
+		return (EVP_MD_CTX_copy_ex((EVP_MD_CTX *)_context, (const EVP_MD_CTX *)other._context) == 1);
+	}
+
 	unsigned int MessageDigest::Size(CryptoAlgorithm algorithm) noexcept
 	{
 		switch(algorithm)
@@ -335,4 +348,125 @@ namespace ov
 	{
 		return ComputeDigest(algorithm, input->GetData(), input->GetLength());
 	}
+
+	HmacContext::~HmacContext()
+	{
+		Destroy();
+	}
+
+	bool HmacContext::Create(CryptoAlgorithm algorithm, const void *key, size_t key_length)
+	{
+		if (_created)
+		{
+			Destroy();
+		}
+
+		// Same as ComputeHmac(), only SHA-256 or less can be processed
+		constexpr unsigned int block_length = 64;
+		uint8_t new_key[block_length] = {0};
+
+		if (key_length > block_length)
+		{
+			if (MessageDigest::ComputeDigest(algorithm, key, key_length, new_key, OV_COUNTOF(new_key)) == false)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			::memcpy(new_key, key, key_length);
+		}
+
+		uint8_t input_pad[block_length] = {0};
+		uint8_t output_pad[block_length] = {0};
+
+		for (unsigned int index = 0; index < block_length; index++)
+		{
+			input_pad[index] = 0x36 ^ new_key[index];
+			output_pad[index] = 0x5C ^ new_key[index];
+		}
+
+		MessageDigest *digests[] = {&_inner_base, &_outer_base, &_inner, &_outer};
+
+		for (size_t index = 0; index < OV_COUNTOF(digests); index++)
+		{
+			if (digests[index]->Create(algorithm) == false)
+			{
+				// Destroy the contexts created so far
+				for (size_t created_index = 0; created_index < index; created_index++)
+				{
+					digests[created_index]->Destroy();
+				}
+
+				return false;
+			}
+		}
+
+		_created = true;
+		_algorithm = algorithm;
+
+		if ((_inner_base.Update(input_pad, OV_COUNTOF(input_pad)) && _outer_base.Update(output_pad, OV_COUNTOF(output_pad))) == false)
+		{
+			Destroy();
+			return false;
+		}
+
+		return true;
+	}
+
+	void HmacContext::Destroy()
+	{
+		if (_created == false)
+		{
+			return;
+		}
+
+		_inner_base.Destroy();
+		_outer_base.Destroy();
+		_inner.Destroy();
+		_outer.Destroy();
+
+		_created = false;
+		_algorithm = CryptoAlgorithm::Unknown;
+	}
+
+	bool HmacContext::Compute(const void *input, size_t input_length, void *output, size_t output_length)
+	{
+		if (_created == false)
+		{
+			return false;
+		}
+
+		// SHA-512 is the largest digest
+		uint8_t inner[SHA512_DIGEST_LENGTH];
+		const unsigned int digest_size = MessageDigest::Size(_algorithm);
+
+		bool result = true;
+
+		// inner hash: H(K XOR ipad, text)
+		result = result && _inner.CopyFrom(_inner_base);
+		result = result && _inner.Update(input, input_length);
+		result = result && _inner.Finish(inner, digest_size);
+
+		// outer hash: H(K XOR opad, inner)
+		result = result && _outer.CopyFrom(_outer_base);
+		result = result && _outer.Update(inner, digest_size);
+		result = result && _outer.Finish(output, output_length);
+
+		return result;
+	}
+
+	std::shared_ptr<ov::Data> HmacContext::Compute(const std::shared_ptr<const ov::Data> &input)
+	{
+		auto data = std::make_shared<ov::Data>();
+
+		data->SetLength(MessageDigest::Size(_algorithm));
+
+		if (Compute(input->GetData(), input->GetLength(), data->GetWritableData(), data->GetLength()))
+		{
+			return data;
+		}
+
+		return nullptr;
+	}
 }
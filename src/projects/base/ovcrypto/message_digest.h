@@ -33,6 +33,8 @@ namespace ov
 		bool Create(CryptoAlgorithm algorithm);
 		bool Destroy();
 		bool Reset();
+		// Copy the digest state of other (including the data that has been updated so far)
+		bool CopyFrom(const MessageDigest &other);
 
 		static unsigned int Size(CryptoAlgorithm algorithm) noexcept;
 		unsigned int Size() const noexcept;
@@ -56,4 +58,35 @@ namespace ov
 		// 실제로는 EVP_MD_CTX * 타입. openssl을 외부로 부터 감추기 위해 void *로 선언함
 		void *_context;
 	};
+
+	// Keeps the digest states of the inner/outer padded key, so that HMAC can be computed
+	// repeatedly with the same key without re-hashing the key and paddings.
+	// This class is not thread-safe. Use an instance per thread.
+	class HmacContext
+	{
+	public:
+		HmacContext() = default;
+		~HmacContext();
+
+		bool Create(CryptoAlgorithm algorithm, const void *key, size_t key_length);
+		void Destroy();
+
+		bool IsCreated() const
+		{
+			return _created;
+		}
+
+		bool Compute(const void *input, size_t input_length, void *output, size_t output_length);
+		std::shared_ptr<ov::Data> Compute(const std::shared_ptr<const ov::Data> &input);
+
+	protected:
+		bool _created = false;
+		CryptoAlgorithm _algorithm = CryptoAlgorithm::Unknown;
+
+		MessageDigest _inner_base;
+		MessageDigest _outer_base;
+
+		MessageDigest _inner;
+		MessageDigest _outer;
+	};
 }
@@ -2,6 +2,8 @@
 
 // This code is referenced from https://rosettacode.org/wiki/CRC-32#C
 
+#include <array>
+
 #include "base/common_types.h"
 
 namespace ov
@@ -11,47 +13,64 @@ namespace ov
 	public:
 		static uint32_t Crc32(uint32_t crc, const uint8_t *buf, size_t len)
 		{
-			static uint32_t table[256];
-			static int have_table = 0;
-			uint32_t rem;
-			uint8_t octet;
-			int i, j;
-			const uint8_t *p, *q;
-		
-			/* This check is not thread safe; there is no mutex. */
-			if (have_table == 0) 
-			{
-				/* Calculate CRC table. */
-				for (i = 0; i < 256; i++) 
+			// The table is built once by the first caller (thread-safe static initialization)
+			static const auto table = []() {
+				std::array<uint32_t, 256> table{};
+
+				for (uint32_t i = 0; i < 256; i++)
 				{
-					rem = i;  /* remainder from polynomial division */
-					for (j = 0; j < 8; j++) 
+					uint32_t rem = i; /* remainder from polynomial division */
+
+					for (int j = 0; j < 8; j++)
 					{
-						if (rem & 1) 
-						{
-							rem >>= 1;
-							rem ^= 0x04C11DB7;
-						} 
-						else
-						{
-							rem >>= 1;
-						}
+						rem = (rem & 1) ? ((rem >> 1) ^ 0x04C11DB7) : (rem >> 1);
 					}
 
 					table[i] = rem;
 				}
-				have_table = 1;
-			}
-		
+
+				return table;
+			}();
+
 			crc = ~crc;
-			q = buf + len;
-			for (p = buf; p < q; p++) 
+
+			for (const uint8_t *p = buf, *q = buf + len; p < q; p++)
 			{
-				octet = *p;  /* Cast to unsigned octet. */
-				crc = (crc >> 8) ^ table[(crc & 0xff) ^ octet];
+				crc = (crc >> 8) ^ table[(crc & 0xff) ^ *p];
 			}
 
 			return ~crc;
 		}
+
+		// CRC-32/MPEG-2 of the PSI sections (ISO/IEC 13818-1, Annex A)
+		static uint32_t Crc32Mpeg2(const uint8_t *buf, size_t len)
+		{
+			static const auto table = []() {
+				std::array<uint32_t, 256> table{};
+
+				for (uint32_t i = 0; i < 256; i++)
+				{
+					uint32_t rem = i << 24;
+
+					for (int j = 0; j < 8; j++)
+					{
+						rem = (rem & 0x80000000) ? ((rem << 1) ^ 0x04C11DB7) : (rem << 1);
+					}
+
+					table[i] = rem;
+				}
+
+				return table;
+			}();
+
+			uint32_t crc = 0xFFFFFFFF;
+
+			for (size_t i = 0; i < len; i++)
+			{
+				crc = (crc << 8) ^ table[((crc >> 24) ^ buf[i]) & 0xFF];
+			}
+
+			return crc;
+		}
 	};
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 //==============================================================================
 #include "log_internal.h"
 
+#include <algorithm>
+#include <string_view>
 #include <thread>
 
 #include "platform.h"
@@ -52,6 +54,75 @@
 
 namespace ov
 {
+	constexpr const char *color_prefix[] = {
+		OV_LOG_COLOR_FG_CYAN,
+		OV_LOG_COLOR_FG_WHITE,
+		OV_LOG_COLOR_FG_YELLOW,
+		OV_LOG_COLOR_FG_BR_RED,
+		OV_LOG_COLOR_FG_BR_WHITE OV_LOG_COLOR_BG_RED};
+
+	constexpr const char *color_suffix[] = {
+		OV_LOG_COLOR_RESET "\n",
+		OV_LOG_COLOR_RESET "\n",
+		OV_LOG_COLOR_RESET "\n",
+		OV_LOG_COLOR_RESET "\n",
+		OV_LOG_COLOR_RESET "\n"};
+
+	LogInternal::LogRing::~LogRing()
+	{
+		LogRecord *record;
+
+		while ((record = Pop()) != nullptr)
+		{
+			delete record;
+		}
+	}
+
+	bool LogInternal::LogRing::Push(LogRecord *record)
+	{
+		auto head = _head.load(std::memory_order_relaxed);
+		auto next = (head + 1) % Capacity;
+
+		if (next == _tail.load(std::memory_order_acquire))
+		{
+			// Full
+			return false;
+		}
+
+		_buffer[head] = record;
+		_head.store(next, std::memory_order_release);
+
+		return true;
+	}
+
+	LogInternal::LogRecord *LogInternal::LogRing::Pop()
+	{
+		auto tail = _tail.load(std::memory_order_relaxed);
+
+		if (tail == _head.load(std::memory_order_acquire))
+		{
+			// Empty
+			return nullptr;
+		}
+
+		auto record = _buffer[tail];
+		_tail.store((tail + 1) % Capacity, std::memory_order_release);
+
+		return record;
+	}
+
+	void LogInternal::LogRing::Close()
+	{
+		_closed.store(true, std::memory_order_release);
+	}
+
+	bool LogInternal::LogRing::IsDrained() const
+	{
+		// Records pushed before Close() are visible once _closed is observed
+		return _closed.load(std::memory_order_acquire) &&
+			   (_tail.load(std::memory_order_relaxed) == _head.load(std::memory_order_acquire));
+	}
+
 	LogInternal::LogInternal(std::string log_file_name) noexcept
 		: _level(OVLogLevelDebug),
 		  _log_file(log_file_name)
@@ -60,7 +131,23 @@ namespace ov
 
 	LogInternal::~LogInternal()
 	{
+		if (_writer_running.exchange(false))
+		{
+			_writer_condition.notify_all();
+
+			if (_writer_thread.joinable())
+			{
+				_writer_thread.join();
+			}
+		}
+
+		// Write the remaining logs
+		Flush();
+
 		_released = true;
+
+		// The tags of _tag_level_slots are not freed here: other threads may still be reading them in IsEnabled()
+		// (the static instance is released at the exit of the process)
 	}
 
 	void LogInternal::SetLogLevel(OVLogLevel level)
@@ -79,17 +166,13 @@ namespace ov
 
 		_enable_map.clear();
 		_enable_list.clear();
+
+		_generation++;
 	}
 
-	bool LogInternal::IsEnabled(const char *tag, OVLogLevel level)
+	uint8_t LogInternal::ResolveLevelMask(const char *tag)
 	{
-		if (_released)
-		{
-			return false;
-		}
-
-		std::lock_guard<std::mutex> lock(_mutex);
-
+		// Must be called while _mutex is locked
 		auto item = _enable_map.find(tag);
 
 		if (item == _enable_map.cend())
@@ -113,7 +196,8 @@ namespace ov
 				_enable_map[tag] = (EnableItem){
 					.regex = nullptr,
 					.level = OVLogLevelInformation,
-					.is_enabled = true};
+					.is_enabled = true,
+					.regex_string = ""};
 			}
 
 			item = _enable_map.find(tag);
@@ -122,18 +206,89 @@ namespace ov
 			{
 				// Item must be added
 				OV_ASSERT2(false);
-				return false;
+				return 0;
+			}
+		}
+
+		uint8_t mask = 0;
+
+		for (int level = OVLogLevelDebug; level <= OVLogLevelCritical; level++)
+		{
+			// Levels below level behave as opposed to being activated
+			bool is_enabled = (level >= item->second.level) ? item->second.is_enabled : (item->second.is_enabled == false);
+
+			if (is_enabled)
+			{
+				mask |= (1 << level);
 			}
 		}
 
-		if (level >= item->second.level)
+		return mask;
+	}
+
+	bool LogInternal::IsEnabledSlow(const char *tag, OVLogLevel level)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		return (ResolveLevelMask(tag) & (1 << level)) != 0;
+	}
+
+	bool LogInternal::IsEnabled(const char *tag, OVLogLevel level)
+	{
+		if (_released)
+		{
+			return false;
+		}
+
+		// Find the slot of the tag without locking
+		auto generation = _generation.load(std::memory_order_acquire);
+		auto index = std::hash<std::string_view>()(tag) % TagLevelSlotCount;
+
+		for (size_t probe = 0; probe < TagLevelMaxProbeCount; probe++)
 		{
-			// Returns whether the log level for the tag is activated
-			return item->second.is_enabled;
+			auto &slot = _tag_level_slots[(index + probe) % TagLevelSlotCount];
+			auto slot_tag = slot.tag.load(std::memory_order_acquire);
+
+			if (slot_tag == nullptr)
+			{
+				// Claim an empty slot for the tag
+				auto new_tag = ::strdup(tag);
+
+				if (slot.tag.compare_exchange_strong(slot_tag, new_tag, std::memory_order_acq_rel) == false)
+				{
+					// Another thread claimed the slot first
+					::free(new_tag);
+				}
+				else
+				{
+					slot_tag = new_tag;
+				}
+			}
+
+			if (::strcmp(slot_tag, tag) != 0)
+			{
+				continue;
+			}
+
+			auto state = slot.state.load(std::memory_order_acquire);
+
+			if ((state >> 8) != generation)
+			{
+				// Not resolved yet, or the enable rules are changed
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				// Generation cannot be changed while _mutex is locked
+				generation = _generation.load(std::memory_order_acquire);
+				state = (generation << 8) | ResolveLevelMask(tag);
+
+				slot.state.store(state, std::memory_order_release);
+			}
+
+			return (state & (1 << level)) != 0;
 		}
 
-		// Levels below level behave as opposed to being activated
-		return (item->second.is_enabled == false);
+		// Too many tags - use the map protected by _mutex
+		return IsEnabledSlow(tag, level);
 	}
 
 	bool LogInternal::SetEnable(const char *tag_regex, OVLogLevel level, bool is_enabled)
@@ -146,6 +301,7 @@ namespace ov
 		std::lock_guard<std::mutex> lock(_mutex);
 
 		_enable_map.clear();
+		_generation++;
 
 		try
 		{
@@ -178,6 +334,185 @@ namespace ov
 		}
 	}
 
+	LogInternal::LogRing *LogInternal::GetThreadLogRing()
+	{
+		// Each thread has its own ring per LogInternal instance, so no lock is needed to push a record
+		struct LogRingOwner
+		{
+			~LogRingOwner()
+			{
+				// The writer removes the rings after popping the remaining records
+				for (auto &item : ring_map)
+				{
+					item.second->Close();
+				}
+			}
+
+			std::unordered_map<LogInternal *, std::shared_ptr<LogRing>> ring_map;
+		};
+		thread_local LogRingOwner owner;
+		auto &ring_map = owner.ring_map;
+
+		auto item = ring_map.find(this);
+
+		if (item != ring_map.end())
+		{
+			return item->second.get();
+		}
+
+		auto ring = std::make_shared<LogRing>();
+
+		{
+			std::lock_guard<std::mutex> lock(_ring_list_mutex);
+			_ring_list.push_back(ring);
+		}
+
+		ring_map.emplace(this, ring);
+
+		return ring.get();
+	}
+
+	void LogInternal::StartWriterThread()
+	{
+		_writer_running = true;
+		_writer_thread = std::thread(&LogInternal::WriterThread, this);
+		::pthread_setname_np(_writer_thread.native_handle(), "LogWriter");
+	}
+
+	void LogInternal::WriterThread()
+	{
+		while (_writer_running)
+		{
+			size_t count;
+
+			{
+				std::lock_guard<std::mutex> lock(_drain_mutex);
+				count = DrainRecords();
+			}
+
+			if (count == 0)
+			{
+				// Wait for new logs (loggers wake up this thread only if it is idle)
+				std::unique_lock<std::mutex> lock(_writer_mutex);
+				_writer_idle = true;
+				_writer_condition.wait_for(lock, std::chrono::milliseconds(50));
+				_writer_idle = false;
+			}
+		}
+	}
+
+	size_t LogInternal::DrainRecords()
+	{
+		std::vector<std::shared_ptr<LogRing>> ring_list;
+
+		{
+			std::lock_guard<std::mutex> lock(_ring_list_mutex);
+			ring_list = _ring_list;
+		}
+
+		std::vector<LogRecord *> records;
+
+		for (auto &ring : ring_list)
+		{
+			LogRecord *record;
+
+			while ((record = ring->Pop()) != nullptr)
+			{
+				records.push_back(record);
+			}
+		}
+
+		{
+			// Remove rings of threads that have been terminated.
+			// A ring is removed only if it was closed and is still empty, so the records pushed right before the thread exited are not lost
+			// (they are popped in the next drain)
+			std::lock_guard<std::mutex> lock(_ring_list_mutex);
+
+			_ring_list.erase(std::remove_if(_ring_list.begin(), _ring_list.end(), [](const std::shared_ptr<LogRing> &ring) -> bool {
+								 return ring->IsDrained();
+							 }),
+							 _ring_list.end());
+		}
+
+		if (records.empty() == false)
+		{
+			std::sort(records.begin(), records.end(), [](const LogRecord *a, const LogRecord *b) -> bool {
+				return a->sequence < b->sequence;
+			});
+
+			WriteRecords(records);
+
+			for (auto record : records)
+			{
+				delete record;
+			}
+		}
+
+		return records.size();
+	}
+
+	void LogInternal::WriteRecords(const std::vector<LogRecord *> &records)
+	{
+		std::vector<struct iovec> console_iov;
+		std::vector<struct iovec> file_iov;
+		int console_fd = -1;
+
+		console_iov.reserve(records.size() * 3);
+		file_iov.reserve(records.size() * 2);
+
+		std::lock_guard<std::mutex> lock(_write_mutex);
+
+		for (auto record : records)
+		{
+			if (record->show_format)
+			{
+				int fd = (record->level < OVLogLevelWarning) ? STDOUT_FILENO : STDERR_FILENO;
+
+				if ((fd != console_fd) && (console_iov.empty() == false))
+				{
+					// Keep the order of stdout/stderr logs
+					LogWrite::WriteFully(console_fd, console_iov.data(), console_iov.size());
+					console_iov.clear();
+				}
+
+				console_fd = fd;
+
+				console_iov.push_back({const_cast<char *>(color_prefix[record->level]), ::strlen(color_prefix[record->level])});
+				console_iov.push_back({const_cast<char *>(record->log.CStr()), record->log.GetLength()});
+				console_iov.push_back({const_cast<char *>(color_suffix[record->level]), ::strlen(color_suffix[record->level])});
+			}
+
+			file_iov.push_back({const_cast<char *>(record->log.CStr()), record->log.GetLength()});
+			file_iov.push_back({const_cast<char *>("\n"), 1});
+		}
+
+		if (console_iov.empty() == false)
+		{
+			LogWrite::WriteFully(console_fd, console_iov.data(), console_iov.size());
+		}
+
+		_log_file.Write(file_iov.data(), file_iov.size(), records.back()->time);
+	}
+
+	void LogInternal::WriteSync(bool show_format, OVLogLevel level, const ov::String &log, std::time_t time)
+	{
+		LogRecord record{
+			.sequence = 0,
+			.level = level,
+			.show_format = show_format,
+			.time = time,
+			.log = log};
+
+		WriteRecords({&record});
+	}
+
+	void LogInternal::Flush()
+	{
+		std::lock_guard<std::mutex> lock(_drain_mutex);
+
+		DrainRecords();
+	}
+
 	void LogInternal::Log(bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list)
 	{
 		if (_released)
@@ -185,7 +520,7 @@ namespace ov
 			return;
 		}
 
-		if (level < _level)
+		if (level < _level.load(std::memory_order_relaxed))
 		{
 			// Disabled log level
 			return;
@@ -209,28 +544,21 @@ namespace ov
 			"E",
 			"C"};
 
-		constexpr const char *color_prefix[] = {
-			OV_LOG_COLOR_FG_CYAN,
-			OV_LOG_COLOR_FG_WHITE,
-			OV_LOG_COLOR_FG_YELLOW,
-			OV_LOG_COLOR_FG_BR_RED,
-			OV_LOG_COLOR_FG_BR_WHITE OV_LOG_COLOR_BG_RED};
-
-		constexpr const char *color_suffix[] = {
-			OV_LOG_COLOR_RESET,
-			OV_LOG_COLOR_RESET,
-			OV_LOG_COLOR_RESET,
-			OV_LOG_COLOR_RESET,
-			OV_LOG_COLOR_RESET};
-
 		// Obtain current time in milliseconds
 		auto current = std::chrono::system_clock::now();
 		auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current.time_since_epoch()).count() % 1000;
 
-		// Obtain current hours/minutes/seconds
-		std::time_t time = std::time(nullptr);
-		std::tm local_time{};
-		::localtime_r(&time, &local_time);
+		// Obtain current hours/minutes/seconds (localtime_r() is called only when the second is changed)
+		thread_local std::time_t last_time = 0;
+		thread_local std::tm local_time{};
+
+		std::time_t time = std::chrono::system_clock::to_time_t(current);
+
+		if (time != last_time)
+		{
+			::localtime_r(&time, &local_time);
+			last_time = time;
+		}
 
 		ov::String log;
 
@@ -265,6 +593,8 @@ namespace ov
 				func = func.Substring(position + 1);
 			}
 		}
+#else	// OV_LOG_SHOW_FUNCTION_NAME
+		(void)method;
 #endif	// OV_LOG_SHOW_FUNCTION_NAME
 
 		if (show_format)
@@ -332,21 +662,43 @@ namespace ov
 
 		// Append messages
 		log.AppendVFormat(format, arg_list);
-		if (show_format)
+
+		if (level >= OVLogLevelCritical)
 		{
-			if (level < OVLogLevelWarning)
-			{
-				fprintf(stdout, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stdout);
-			}
-			else
+			// Critical logs are written immediately since the process may be terminated soon (e.g. in the signal handler)
+			if (_drain_mutex.try_lock())
 			{
-				fprintf(stderr, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stderr);
+				DrainRecords();
+				_drain_mutex.unlock();
 			}
+
+			WriteSync(show_format, level, log, time);
+			return;
+		}
+
+		std::call_once(_writer_once, [this]() {
+			StartWriterThread();
+		});
+
+		auto record = new LogRecord{
+			.sequence = _sequence++,
+			.level = level,
+			.show_format = show_format,
+			.time = time,
+			.log = std::move(log)};
+
+		if (GetThreadLogRing()->Push(record) == false)
+		{
+			// The writer cannot keep up with the logs - write it in this thread instead of dropping it
+			WriteSync(record->show_format, record->level, record->log, record->time);
+			delete record;
+			return;
 		}
 
-		_log_file.Write(log.CStr());
+		if (_writer_idle.load(std::memory_order_relaxed) && _writer_idle.exchange(false))
+		{
+			_writer_condition.notify_one();
+		}
 	}
 
 	void LogInternal::SetLogPath(const char *log_path)
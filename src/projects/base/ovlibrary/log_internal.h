@@ -12,11 +12,15 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <ctime>
 #include <mutex>
 #include <regex>
+#include <thread>
 #include <unordered_map>
 
 #include "./assert.h"
@@ -67,15 +71,94 @@ namespace ov
 
 		void SetLogPath(const char *log_path);
 
+		// Writes all pending logs
+		void Flush();
+
 	protected:
+		struct LogRecord
+		{
+			// Used to write the logs of multiple threads in order
+			uint64_t sequence;
+			OVLogLevel level;
+			bool show_format;
+			std::time_t time;
+			ov::String log;
+		};
+
+		// Single producer (logging thread), single consumer (writer thread) lock-free ring
+		class LogRing
+		{
+		public:
+			static constexpr size_t Capacity = 4096;
+
+			~LogRing();
+
+			bool Push(LogRecord *record);
+			LogRecord *Pop();
+
+			// Called by the producer when its thread exits, no record is pushed after this
+			void Close();
+			// Whether the ring can be removed (the producer is gone and all records are popped)
+			bool IsDrained() const;
+
+		private:
+			std::array<LogRecord *, Capacity> _buffer;
+			std::atomic<size_t> _head{0};
+			std::atomic<size_t> _tail{0};
+			std::atomic<bool> _closed{false};
+		};
+
+		// Resolved enabled levels of a tag
+		struct TagLevelSlot
+		{
+			// A copy of the tag owned by LogInternal
+			std::atomic<const char *> tag{nullptr};
+			// (generation << 8) | (bitmask of enabled levels)
+			std::atomic<uint64_t> state{0};
+		};
+		static constexpr size_t TagLevelSlotCount = 1024;
+		static constexpr size_t TagLevelMaxProbeCount = 32;
+
+		uint8_t ResolveLevelMask(const char *tag);
+		bool IsEnabledSlow(const char *tag, OVLogLevel level);
+
+		LogRing *GetThreadLogRing();
+		void StartWriterThread();
+		void WriterThread();
+		// Returns the number of records written. Must be called while _drain_mutex is locked
+		size_t DrainRecords();
+		void WriteRecords(const std::vector<LogRecord *> &records);
+		void WriteSync(bool show_format, OVLogLevel level, const ov::String &log, std::time_t time);
+
 		// This variable is used to avoid the problem of referencing incorrect heap if the log is written after LogInternal instance is released.
 		// This situation occurs when the LogInternal instance declared static is disabled just before the OME is terminated and then logs are written by another module.
 		bool _released = false;
 
-		OVLogLevel _level;
+		std::atomic<OVLogLevel> _level;
 
 		std::mutex _mutex;
 
+		// Incremented whenever the enable rules are changed to invalidate _tag_level_slots
+		std::atomic<uint64_t> _generation{1};
+		std::array<TagLevelSlot, TagLevelSlotCount> _tag_level_slots;
+
+		// Asynchronous writer
+		std::once_flag _writer_once;
+		std::thread _writer_thread;
+		std::atomic<bool> _writer_running{false};
+		std::atomic<bool> _writer_idle{false};
+		std::mutex _writer_mutex;
+		std::condition_variable _writer_condition;
+
+		std::atomic<uint64_t> _sequence{0};
+		// Rings of each logging thread, the thread_local owner closes its rings when the thread exits
+		std::mutex _ring_list_mutex;
+		std::vector<std::shared_ptr<LogRing>> _ring_list;
+		// Only one thread can consume the rings at a time
+		std::mutex _drain_mutex;
+		// Serializes writing to the console/file
+		std::mutex _write_mutex;
+
 		LogWrite _log_file;
 
 		struct EnableItem
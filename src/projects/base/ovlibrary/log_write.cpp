@@ -7,11 +7,19 @@
 //
 //==============================================================================
 
-#include <iostream>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <iomanip>
+#include <iostream>
 #include <memory>
 #include <sstream>
-#include <sys/stat.h>
+#include <vector>
 
 #include "log_write.h"
 
@@ -36,12 +44,24 @@ namespace ov
 		_include_date_in_filename = include_date_in_filename;
     }
 
+    LogWrite::~LogWrite()
+    {
+        std::lock_guard<std::mutex> lock_guard(_log_stream_mutex);
+
+        if (_log_fd >= 0)
+        {
+            ::close(_log_fd);
+            _log_fd = -1;
+        }
+    }
+
     void LogWrite::SetLogPath(const char* log_path)
     {
         _log_path = log_path;
         _log_file = log_path + std::string("/") + _log_file_name;
     }
 
+    // Must be called while _log_stream_mutex is locked
     void LogWrite::OpenNewFile(std::time_t time)
     {
         if (_start_service)
@@ -57,9 +77,11 @@ namespace ov
             return;
         }
 
-        std::lock_guard<std::mutex> lock_guard(_log_stream_mutex);
-        _log_stream.close();
-        _log_stream.clear();
+        if (_log_fd >= 0)
+        {
+            ::close(_log_fd);
+            _log_fd = -1;
+        }
 
 		if(_include_date_in_filename == true)
 		{
@@ -67,11 +89,11 @@ namespace ov
         	::localtime_r(&time, &local_time);
 			std::ostringstream logfile;
             logfile << _log_file << "." << std::put_time(&local_time, "%Y%m%d");
-			_log_stream.open(logfile.str().c_str(), std::ofstream::out | std::ofstream::app);
+			_log_fd = ::open(logfile.str().c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
 		}
 		else
 		{
-        	_log_stream.open(_log_file, std::ofstream::out | std::ofstream::app);
+        	_log_fd = ::open(_log_file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
 		}
     }
 
@@ -80,7 +102,8 @@ namespace ov
         _start_service = start_service;
     }
 
-    void LogWrite::Write(const char *log, std::time_t time)
+    // Must be called while _log_stream_mutex is locked
+    void LogWrite::PrepareFile(std::time_t time)
     {
     	if(time == 0)
 		{
@@ -89,7 +112,7 @@ namespace ov
         std::tm local_time {};
         ::localtime_r(&time, &local_time);
 
-		if (!_log_stream.is_open() || _log_stream.fail())
+		if (_log_fd < 0)
         {
             OpenNewFile(time);
         }
@@ -113,9 +136,74 @@ namespace ov
             }
             _last_day = local_time.tm_mday;
         }
+    }
+
+    void LogWrite::Write(const char *log, std::time_t time)
+    {
+        struct iovec iov[2];
+
+        iov[0].iov_base = const_cast<char *>(log);
+        iov[0].iov_len = ::strlen(log);
+        iov[1].iov_base = const_cast<char *>("\n");
+        iov[1].iov_len = 1;
 
+        Write(iov, 2, time);
+    }
+
+    void LogWrite::Write(const struct iovec *iov, int iov_count, std::time_t time)
+    {
         std::lock_guard<std::mutex> lock_guard(_log_stream_mutex);
-        _log_stream << log << std::endl;
-        _log_stream.flush();
+
+        PrepareFile(time);
+
+        if (_log_fd >= 0)
+        {
+            if (WriteFully(_log_fd, iov, iov_count) == false)
+            {
+                // Reopen the file at the next write
+                ::close(_log_fd);
+                _log_fd = -1;
+            }
+        }
+    }
+
+    bool LogWrite::WriteFully(int fd, const struct iovec *iov, int iov_count)
+    {
+        // Copy the vector since partially written entries are adjusted
+        std::vector<struct iovec> remained(iov, iov + iov_count);
+        size_t index = 0;
+
+        while (index < remained.size())
+        {
+            int count = static_cast<int>(std::min(remained.size() - index, static_cast<size_t>(IOV_MAX)));
+            ssize_t written = ::writev(fd, remained.data() + index, count);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            // Skip the entries that have been written
+            size_t written_bytes = static_cast<size_t>(written);
+
+            while ((index < remained.size()) && (written_bytes >= remained[index].iov_len))
+            {
+                written_bytes -= remained[index].iov_len;
+                index++;
+            }
+
+            if (written_bytes > 0)
+            {
+                remained[index].iov_base = static_cast<uint8_t *>(remained[index].iov_base) + written_bytes;
+                remained[index].iov_len -= written_bytes;
+            }
+        }
+
+        return true;
     }
-}
\ No newline at end of file
+}
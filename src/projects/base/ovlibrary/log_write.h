@@ -8,8 +8,11 @@
 //==============================================================================
 #pragma once
 
-#include <fstream>
+#include <sys/uio.h>
+
+#include <ctime>
 #include <mutex>
+#include <string>
 
 #define OV_LOG_DIR              "logs"
 #define OV_LOG_DIR_SVC          "/var/log/ovenmediaengine"
@@ -20,17 +23,23 @@ namespace ov
     {
     public:
         LogWrite(std::string log_file_name, bool include_date_in_filename = false);
-        virtual ~LogWrite() = default;
+        virtual ~LogWrite();
         void Write(const char* log, std::time_t time = 0);
+        // Writes multiple log lines at once using writev() (Each line must contain a trailing '\n')
+        void Write(const struct iovec *iov, int iov_count, std::time_t time = 0);
         void SetLogPath(const char* log_path);
 
         static void SetAsService(bool start_service);
 
+        // writev() that handles partial writes and IOV_MAX
+        static bool WriteFully(int fd, const struct iovec *iov, int iov_count);
+
     private:
         void OpenNewFile(std::time_t time = 0);
+        void PrepareFile(std::time_t time);
 
         std::mutex _log_stream_mutex;
-        std::ofstream _log_stream;
+        int _log_fd = -1;
         int _last_day;
         std::string _log_path;
         std::string _log_file_name;
@@ -39,4 +48,3 @@ namespace ov
         static bool _start_service;
     };
 }
-
@@ -0,0 +1,113 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace ov
+{
+	// Thread-safe LRU cache with a bounded number of items
+	template <typename Tkey, typename Tvalue, typename Thash = std::hash<Tkey>>
+	class LruCache
+	{
+	public:
+		explicit LruCache(size_t capacity)
+			: _capacity(capacity)
+		{
+		}
+
+		// Returns false if there is no item with the key
+		bool Get(const Tkey &key, Tvalue *value)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			auto item = _map.find(key);
+			if (item == _map.end())
+			{
+				return false;
+			}
+
+			// Move to the front (most recently used)
+			_list.splice(_list.begin(), _list, item->second);
+			*value = item->second->second;
+
+			return true;
+		}
+
+		void Set(const Tkey &key, const Tvalue &value)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			auto item = _map.find(key);
+			if (item != _map.end())
+			{
+				item->second->second = value;
+				_list.splice(_list.begin(), _list, item->second);
+				return;
+			}
+
+			if ((_capacity > 0) && (_map.size() >= _capacity))
+			{
+				// Evict the least recently used item
+				_map.erase(_list.back().first);
+				_list.pop_back();
+			}
+
+			_list.emplace_front(key, value);
+			_map[key] = _list.begin();
+		}
+
+		bool Remove(const Tkey &key)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			auto item = _map.find(key);
+			if (item == _map.end())
+			{
+				return false;
+			}
+
+			_list.erase(item->second);
+			_map.erase(item);
+
+			return true;
+		}
+
+		void Clear()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			_map.clear();
+			_list.clear();
+		}
+
+		size_t GetSize() const
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			return _map.size();
+		}
+
+		size_t GetCapacity() const
+		{
+			return _capacity;
+		}
+
+	private:
+		using ItemList = std::list<std::pair<Tkey, Tvalue>>;
+
+		const size_t _capacity;
+
+		mutable std::mutex _mutex;
+		ItemList _list;
+		std::unordered_map<Tkey, typename ItemList::iterator, Thash> _map;
+	};
+}  // namespace ov
@@ -19,6 +19,7 @@
 
 // UDP socket
 #include "datagram_socket.h"
+#include "socket_send_batch.h"
 
 // Socket pool
 #include "socket_pool/socket_pool.h"
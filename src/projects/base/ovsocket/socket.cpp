@@ -12,6 +12,7 @@
 #include <errno.h>
 #include <sys/fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -34,6 +35,7 @@
 
 // Debugging purpose
 #include "socket_profiler.h"
+#include "socket_send_batch.h"
 #include "stats_counter.h"
 
 namespace ov
@@ -908,6 +910,88 @@ namespace ov
 		return DispatchResult::PartialDispatched;
 	}
 
+	Socket::DispatchResult Socket::DispatchSendCommandsInternal(DispatchCommand &command)
+	{
+		struct iovec iov[OV_SOCKET_MAX_COALESCED_SEND_COUNT];
+		size_t iov_count = 0;
+
+		iov[iov_count++] = {const_cast<void *>(command.data->GetData()), command.data->GetLength()};
+
+		for (const auto &next_command : _dispatch_queue)
+		{
+			if ((next_command.type != DispatchCommand::Type::Send) || (iov_count >= OV_SOCKET_MAX_COALESCED_SEND_COUNT))
+			{
+				break;
+			}
+
+			iov[iov_count++] = {const_cast<void *>(next_command.data->GetData()), next_command.data->GetLength()};
+		}
+
+		if (_force_stop)
+		{
+			return DispatchResult::PartialDispatched;
+		}
+
+		struct msghdr message{};
+		message.msg_iov = iov;
+		message.msg_iovlen = iov_count;
+
+		logap("Trying to send data of %zu commands...", iov_count);
+
+		auto sent_bytes = ::sendmsg(GetNativeHandle(), &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+		if (sent_bytes < 0L)
+		{
+			sent_bytes = HandleSendError(sent_bytes, 0);
+
+			if (sent_bytes < 0L)
+			{
+				return DispatchResult::Error;
+			}
+		}
+		else
+		{
+			STATS_COUNTER_INCREASE_PPS();
+			UpdateLastSentTime();
+		}
+
+		// Remove the commands that have been sent from the queue
+		size_t remaining_bytes = sent_bytes;
+
+		for (size_t index = 0; index < iov_count; index++)
+		{
+			if (index > 0)
+			{
+				// command is fully sent, so it is replaced with the next command
+				command.data = _dispatch_queue.front().data;
+				command.enqueued_time = _dispatch_queue.front().enqueued_time;
+				_dispatch_queue.pop_front();
+			}
+
+			auto length = iov[index].iov_len;
+
+			if (remaining_bytes < length)
+			{
+				if (remaining_bytes > 0)
+				{
+					// Since some data has been sent, the time needs to be updated.
+					command.UpdateTime();
+					command.data = command.data->Subdata(remaining_bytes);
+
+					logad("Part of the data has been sent: %zu bytes, left: %zu bytes (%s)", remaining_bytes, command.data->GetLength(), command.ToString().CStr());
+				}
+
+				return DispatchResult::PartialDispatched;
+			}
+
+			remaining_bytes -= length;
+		}
+
+		logap("%zd bytes sent", sent_bytes);
+
+		return DispatchResult::Dispatched;
+	}
+
 	Socket::DispatchResult Socket::DispatchEventsInternal()
 	{
 		SOCKET_PROFILER_INIT();
@@ -956,7 +1040,13 @@ namespace ov
 						break;
 					}
 
-					result = DispatchEventInternal(front);
+					// Frames queued while the socket was backlogged (e.g. WebSocket messages) are coalesced into one system call
+					bool can_coalesce = (front.type == DispatchCommand::Type::Send) &&
+										(GetType() == SocketType::Tcp) &&
+										(_dispatch_queue.empty() == false) &&
+										(_dispatch_queue.front().type == DispatchCommand::Type::Send);
+
+					result = can_coalesce ? DispatchSendCommandsInternal(front) : DispatchEventInternal(front);
 
 					if (result == DispatchResult::Dispatched)
 					{
@@ -985,6 +1075,16 @@ namespace ov
 					break;
 				}
 			}
+
+			if (result == DispatchResult::PartialDispatched)
+			{
+				_has_pending_command = true;
+			}
+			else if (_has_pending_command && _dispatch_queue.empty())
+			{
+				_has_pending_command = false;
+				_drained = true;
+			}
 		}
 
 		return result;
@@ -1023,6 +1123,7 @@ namespace ov
 		switch (DispatchEvents())
 		{
 			case DispatchResult::Dispatched:
+				CallDrainedCallbackIfNeeded();
 				return PostProcessMethod::Nothing;
 
 			case DispatchResult::PartialDispatched:
@@ -1387,6 +1488,101 @@ namespace ov
 		return true;
 	}
 
+	// Returns the number of datagrams sent from the offset
+	template <typename Tpktinfo>
+	size_t SendMultipleFromToInternal(
+		const int socket_handle,
+		const int msg_level, const int msg_type,
+		const std::vector<SocketDatagram> &datagrams, const size_t offset)
+	{
+		constexpr size_t MAX_MESSAGE_COUNT = 64;
+
+		mmsghdr messages[MAX_MESSAGE_COUNT]{};
+		iovec iovs[MAX_MESSAGE_COUNT]{};
+		char controls[MAX_MESSAGE_COUNT][CMSG_SPACE(sizeof(Tpktinfo))]{};
+
+		const auto count = std::min(MAX_MESSAGE_COUNT, datagrams.size() - offset);
+
+		for (size_t index = 0; index < count; index++)
+		{
+			auto &datagram = datagrams[offset + index];
+
+			// This is intentional conversion
+			iovs[index].iov_base = const_cast<void *>(datagram.data->GetData());
+			iovs[index].iov_len = datagram.data->GetLength();
+
+			Tpktinfo pktinfo{};
+			SetAddr(&pktinfo, datagram.address_pair.GetLocalAddress());
+
+			auto cmsg = reinterpret_cast<cmsghdr *>(controls[index]);
+			cmsg->cmsg_level = msg_level;
+			cmsg->cmsg_type = msg_type;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(pktinfo));
+			::memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+
+			auto &msg = messages[index].msg_hdr;
+			const auto &remote_address = datagram.address_pair.GetRemoteAddress();
+			// This is intentional conversion
+			msg.msg_name = const_cast<sockaddr *>(remote_address.ToSockAddr());
+			msg.msg_namelen = remote_address.GetSockAddrInLength();
+			msg.msg_iov = &iovs[index];
+			msg.msg_iovlen = 1;
+			msg.msg_control = controls[index];
+			msg.msg_controllen = sizeof(controls[index]);
+		}
+
+		const auto sent = ::sendmmsg(socket_handle, messages, count, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+		return (sent > 0) ? static_cast<size_t>(sent) : 0;
+	}
+
+	size_t Socket::SendMultipleFromToInternal(const std::vector<SocketDatagram> &datagrams)
+	{
+		size_t sent_count = 0;
+
+		while ((sent_count < datagrams.size()) && (_force_stop == false))
+		{
+			size_t sent = 0;
+
+			switch (_family)
+			{
+				case SocketFamily::Unknown:
+					OV_ASSERT2(false);
+					return sent_count;
+
+				case SocketFamily::Inet:
+					sent = ov::SendMultipleFromToInternal<in_pktinfo>(GetNativeHandle(), IPPROTO_IP, IP_PKTINFO, datagrams, sent_count);
+					break;
+
+				case SocketFamily::Inet6:
+					sent = ov::SendMultipleFromToInternal<in6_pktinfo>(GetNativeHandle(), IPPROTO_IPV6, IPV6_PKTINFO, datagrams, sent_count);
+					break;
+			}
+
+			if (sent == 0)
+			{
+				// EAGAIN or an error, which is handled when the rest are dispatched
+				break;
+			}
+
+			for (size_t index = 0; index < sent; index++)
+			{
+				STATS_COUNTER_INCREASE_PPS();
+			}
+
+			sent_count += sent;
+		}
+
+		if (sent_count > 0)
+		{
+			UpdateLastSentTime();
+		}
+
+		logap("%zu/%zu datagrams sent", sent_count, datagrams.size());
+
+		return sent_count;
+	}
+
 	ssize_t Socket::SendFromToInternal(const SocketAddressPair &address_pair, const std::shared_ptr<const Data> &data)
 	{
 		if (GetType() != SocketType::Udp)
@@ -1470,6 +1666,18 @@ namespace ov
 			case BlockingMode::NonBlocking:
 				if (IsSendable())
 				{
+					if (GetType() == SocketType::Udp)
+					{
+						auto send_batch = SocketSendBatch::GetCurrent();
+
+						if (send_batch != nullptr)
+						{
+							// Sent with the other datagrams of the batch when it ends
+							send_batch->Add(GetSharedPtr(), address_pair, data->Clone());
+							return true;
+						}
+					}
+
 					return AppendCommand(
 						(GetType() == SocketType::Udp)
 							? DispatchCommand(address_pair, data->Clone())
@@ -1486,6 +1694,52 @@ namespace ov
 		return SendFromTo(address_pair, (data == nullptr) ? nullptr : std::make_shared<Data>(data, length));
 	}
 
+	bool Socket::SendFromTo(const std::vector<SocketDatagram> &datagrams)
+	{
+		if (IsSendable() == false)
+		{
+			return false;
+		}
+
+		if ((GetType() != SocketType::Udp) || (_blocking_mode != BlockingMode::NonBlocking))
+		{
+			bool result = true;
+
+			for (auto &datagram : datagrams)
+			{
+				result = SendFromTo(datagram.address_pair, datagram.data) && result;
+			}
+
+			return result;
+		}
+
+		std::lock_guard lock_guard(_dispatch_queue_lock);
+
+		size_t sent_count = 0;
+
+		// The datagrams must not overtake the commands waiting in the queue
+		if (_dispatch_queue.empty())
+		{
+			sent_count = SendMultipleFromToInternal(datagrams);
+		}
+
+		if (sent_count == datagrams.size())
+		{
+			return true;
+		}
+
+		// The rest are sent (or the error is handled) when the socket becomes writable
+		for (size_t index = sent_count; index < datagrams.size(); index++)
+		{
+			auto &datagram = datagrams[index];
+			_dispatch_queue.emplace_back(datagram.address_pair, datagram.data->Clone());
+		}
+
+		_worker->EnqueueToDispatchLater(GetSharedPtr());
+
+		return true;
+	}
+
 	std::shared_ptr<const SocketError> Socket::Recv(std::shared_ptr<Data> &data, const bool non_block)
 	{
 		OV_ASSERT2(data != nullptr);
@@ -2146,6 +2400,33 @@ namespace ov
 		}
 	}
 
+	void Socket::SetDrainedCallback(std::function<void()> drained_callback)
+	{
+		std::lock_guard lock_guard(_drained_callback_lock);
+
+		_drained_callback = std::move(drained_callback);
+	}
+
+	void Socket::CallDrainedCallbackIfNeeded()
+	{
+		if (_drained.exchange(false) == false)
+		{
+			return;
+		}
+
+		std::function<void()> drained_callback;
+
+		{
+			std::lock_guard lock_guard(_drained_callback_lock);
+			drained_callback = _drained_callback;
+		}
+
+		if (drained_callback != nullptr)
+		{
+			drained_callback();
+		}
+	}
+
 	String Socket::ToString(const char *class_name) const
 	{
 		ov::String caller(class_name);
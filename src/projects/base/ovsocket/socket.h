@@ -26,11 +26,15 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 // Failure to send data for the specified time period will be considered an error.
 // For example, it can occur when EAGAIN continues to occur for a period of time, or when the peer's TCP window is full and no longer receives data.
 #define OV_SOCKET_EXPIRE_TIMEOUT (10 * 1000)
 
+// The maximum number of queued Send commands that are written with a single sendmsg() (TCP only)
+#define OV_SOCKET_MAX_COALESCED_SEND_COUNT 64
+
 namespace ov
 {
 	// Forward declaration
@@ -51,6 +55,12 @@ namespace ov
 		virtual void OnClosed() = 0;
 	};
 
+	struct SocketDatagram
+	{
+		SocketAddressPair address_pair;
+		std::shared_ptr<const Data> data;
+	};
+
 	class Socket : public EnableSharedFromThis<Socket>, public SocketPoolEventInterface
 	{
 	protected:
@@ -169,6 +179,10 @@ namespace ov
 			return _callback;
 		}
 
+		// The callback is called when the commands that could not be sent immediately (EAGAIN) have all been sent.
+		// It is called from the socket pool worker without holding any lock, so more data can be sent in the callback.
+		void SetDrainedCallback(std::function<void()> drained_callback);
+
 		// only available for SRT socket
 		String GetStreamId() const;
 
@@ -180,6 +194,9 @@ namespace ov
 
 		bool SendFromTo(const SocketAddressPair &address_pair, const std::shared_ptr<const Data> &data);
 		bool SendFromTo(const SocketAddressPair &address_pair, const void *data, size_t length);
+		// Sends the datagrams with as few system calls as possible (sendmmsg).
+		// The datagrams that could not be sent immediately are queued like SendFromTo().
+		bool SendFromTo(const std::vector<SocketDatagram> &datagrams);
 
 		// When Recv is called in non-blocking mode,
 		//
@@ -430,6 +447,9 @@ namespace ov
 		//--------------------------------------------------------------------
 
 		DispatchResult DispatchEventInternal(DispatchCommand &command);
+		// Writes the data of command and the following Send commands in _dispatch_queue with a single sendmsg().
+		// If the data is partially sent, command is replaced with the command that has the remaining data.
+		DispatchResult DispatchSendCommandsInternal(DispatchCommand &command);
 
 		bool IsSendable() const;
 		ssize_t HandleSendError(const ssize_t result, const size_t total_sent);
@@ -442,6 +462,8 @@ namespace ov
 		ssize_t SendInternal(const std::shared_ptr<const Data> &data);
 		ssize_t SendToInternal(const SocketAddress &address, const std::shared_ptr<const Data> &data);
 		ssize_t SendFromToInternal(const SocketAddressPair &address_pair, const std::shared_ptr<const Data> &data);
+		// Returns the number of datagrams sent
+		size_t SendMultipleFromToInternal(const std::vector<SocketDatagram> &datagrams);
 
 		std::shared_ptr<SocketError> RecvInternal(void *data, size_t length, size_t *received_length);
 
@@ -457,6 +479,7 @@ namespace ov
 		// Since the resource is usually cleaned inside the OnClosed() callback,
 		// callback is performed outside the lock_guard to prevent acquiring the lock.
 		void CallCloseCallbackIfNeeded();
+		void CallDrainedCallbackIfNeeded();
 
 	protected:
 		std::shared_ptr<const SocketError> DoConnectionCallback(const std::shared_ptr<const SocketError> &error);
@@ -530,6 +553,12 @@ namespace ov
 
 		// A temporary variable used to send callback without mutex lock
 		std::shared_ptr<SocketAsyncInterface> _post_callback;
+
+		// Set when a command is partially dispatched, and cleared when the dispatch queue becomes empty (protected by _dispatch_queue_lock)
+		bool _has_pending_command = false;
+		std::atomic<bool> _drained{false};
+		std::mutex _drained_callback_lock;
+		std::function<void()> _drained_callback;
 		SocketState _close_reason = SocketState::Closed;
 
 		volatile bool _force_stop = false;
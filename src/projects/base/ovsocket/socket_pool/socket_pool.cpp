@@ -99,6 +99,20 @@ namespace ov
 			}
 		}
 
+		if (_initialized)
+		{
+			std::lock_guard lock_guard(_pool_list_mutex);
+
+			// Remove the pools that are released without Uninitialize()
+			_pool_list.erase(
+				std::remove_if(_pool_list.begin(), _pool_list.end(), [](const std::weak_ptr<SocketPool> &pool) {
+					return pool.expired();
+				}),
+				_pool_list.end());
+
+			_pool_list.emplace_back(GetSharedPtr());
+		}
+
 		return _initialized;
 	}
 
@@ -118,11 +132,68 @@ namespace ov
 	{
 		logad("Trying to uninitialize socket pool...");
 
+		{
+			std::lock_guard lock_guard(_pool_list_mutex);
+
+			_pool_list.erase(
+				std::remove_if(_pool_list.begin(), _pool_list.end(), [this](const std::weak_ptr<SocketPool> &pool) {
+					auto instance = pool.lock();
+					return (instance == nullptr) || (instance.get() == this);
+				}),
+				_pool_list.end());
+		}
+
 		std::lock_guard lock_guard(_worker_list_mutex);
 
 		return UninitializeInternal();
 	}
 
+	SocketPool::Stats SocketPool::GetStats() const
+	{
+		Stats stats;
+
+		stats.name = _name;
+		stats.type = _type;
+		stats.total_allocated_count = _total_allocated_count;
+
+		std::lock_guard lock_guard(_worker_list_mutex);
+
+		stats.worker_count = static_cast<int>(_worker_list.size());
+
+		for (auto &worker : _worker_list)
+		{
+			stats.socket_count += worker->_socket_count;
+		}
+
+		return stats;
+	}
+
+	std::vector<SocketPool::Stats> SocketPool::GetStatsList()
+	{
+		std::vector<std::weak_ptr<SocketPool>> pool_list;
+
+		{
+			std::lock_guard lock_guard(_pool_list_mutex);
+			pool_list = _pool_list;
+		}
+
+		std::vector<Stats> stats_list;
+		stats_list.reserve(pool_list.size());
+
+		// The stats are collected after the lock is released, so the pools can be initialized/uninitialized meanwhile
+		for (auto &pool : pool_list)
+		{
+			auto instance = pool.lock();
+
+			if (instance != nullptr)
+			{
+				stats_list.push_back(instance->GetStats());
+			}
+		}
+
+		return stats_list;
+	}
+
 	String SocketPool::ToString() const
 	{
 		String description;
@@ -20,6 +20,18 @@ namespace ov
 		OV_SOCKET_DECLARE_PRIVATE_TOKEN();
 
 	public:
+		struct Stats
+		{
+			ov::String name;
+			SocketType type = SocketType::Unknown;
+
+			int worker_count = 0;
+			// The number of sockets currently assigned to the workers
+			int socket_count = 0;
+			// The number of sockets allocated since the pool is initialized
+			uint64_t total_allocated_count = 0;
+		};
+
 		// SocketPool can only be created using SocketPool::Create()
 		SocketPool(PrivateToken token, const char *name, SocketType type);
 		~SocketPool() override;
@@ -103,6 +115,10 @@ namespace ov
 					// Rollback
 					worker->DecreaseSocketCount();
 				}
+				else
+				{
+					_total_allocated_count++;
+				}
 
 				return socket;
 			}
@@ -117,6 +133,10 @@ namespace ov
 
 		bool Uninitialize();
 
+		Stats GetStats() const;
+		// Returns the stats of all the socket pools that are initialized
+		static std::vector<Stats> GetStatsList();
+
 		String ToString() const;
 
 	protected:
@@ -149,5 +169,11 @@ namespace ov
 
 		mutable std::mutex _worker_list_mutex;
 		std::vector<std::shared_ptr<SocketPoolWorker>> _worker_list;
+
+		std::atomic<uint64_t> _total_allocated_count{0};
+
+		// Socket pools that are initialized (to collect the stats)
+		inline static std::mutex _pool_list_mutex;
+		inline static std::vector<std::weak_ptr<SocketPool>> _pool_list;
 	};
 }  // namespace ov
@@ -464,6 +464,7 @@ namespace ov
 					switch (socket->DispatchEvents())
 					{
 						case Socket::DispatchResult::Dispatched:
+							socket->CallDrainedCallbackIfNeeded();
 							break;
 
 						case Socket::DispatchResult::PartialDispatched:
@@ -0,0 +1,98 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "socket_send_batch.h"
+
+#include <algorithm>
+
+#include "socket_private.h"
+
+namespace ov
+{
+	thread_local SocketSendBatch *SocketSendBatch::_current = nullptr;
+
+	SocketSendBatch::~SocketSendBatch()
+	{
+		if (_begun)
+		{
+			End();
+		}
+	}
+
+	void SocketSendBatch::Begin()
+	{
+		if (_begun)
+		{
+			OV_ASSERT2(_begun == false);
+			return;
+		}
+
+		_previous = _current;
+		_current = this;
+		_begun = true;
+	}
+
+	void SocketSendBatch::End()
+	{
+		if (_begun == false)
+		{
+			OV_ASSERT2(_begun);
+			return;
+		}
+
+		// The datagrams must be sent by the sockets, not collected again
+		_current = _previous;
+		_previous = nullptr;
+		_begun = false;
+
+		Flush();
+	}
+
+	void SocketSendBatch::Add(const std::shared_ptr<Socket> &socket, const SocketAddressPair &address_pair, std::shared_ptr<const Data> data)
+	{
+		_items.push_back({socket, {address_pair, std::move(data)}});
+	}
+
+	void SocketSendBatch::Flush()
+	{
+		if (_items.empty())
+		{
+			return;
+		}
+
+		// Groups the datagrams by socket, keeping the order of the datagrams of each socket
+		std::stable_sort(_items.begin(), _items.end(), [](const Item &item1, const Item &item2) {
+			return item1.socket.get() < item2.socket.get();
+		});
+
+		auto begin = _items.begin();
+
+		while (begin != _items.end())
+		{
+			auto &socket = begin->socket;
+			auto end = begin;
+
+			_datagrams.clear();
+
+			for (; (end != _items.end()) && (end->socket == socket); ++end)
+			{
+				_datagrams.push_back(std::move(end->datagram));
+			}
+
+			if (socket->SendFromTo(_datagrams) == false)
+			{
+				logtd("Could not send %zu datagrams: %s", _datagrams.size(), socket->ToString().CStr());
+			}
+
+			begin = end;
+		}
+
+		_items.clear();
+		_datagrams.clear();
+	}
+}  // namespace ov
@@ -0,0 +1,59 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "socket.h"
+
+namespace ov
+{
+	// Collects the UDP datagrams sent by the current thread between Begin() and End(),
+	// and sends the datagrams of each socket at once with Socket::SendFromTo(datagrams).
+	//
+	// When a packet is delivered to thousands of sessions, most of them share a few sockets,
+	// so one sendmmsg() replaces a sendto() per session.
+	class SocketSendBatch
+	{
+	public:
+		~SocketSendBatch();
+
+		// Returns the batch of the current thread, or nullptr if there is none
+		static SocketSendBatch *GetCurrent()
+		{
+			return _current;
+		}
+
+		// Makes this batch the batch of the current thread
+		void Begin();
+		// Sends the collected datagrams and restores the previous batch of the current thread
+		void End();
+
+		void Add(const std::shared_ptr<Socket> &socket, const SocketAddressPair &address_pair, std::shared_ptr<const Data> data);
+
+	private:
+		struct Item
+		{
+			std::shared_ptr<Socket> socket;
+			SocketDatagram datagram;
+		};
+
+		void Flush();
+
+		static thread_local SocketSendBatch *_current;
+
+		SocketSendBatch *_previous = nullptr;
+		bool _begun = false;
+
+		// The capacities are reused by the next batch
+		std::vector<Item> _items;
+		std::vector<SocketDatagram> _datagrams;
+	};
+}  // namespace ov
@@ -119,6 +119,16 @@ namespace pvd
 				return false;
 			}
 		}
+		else
+		{
+			// Register this server as a relay node if RelayTree is enabled, so that other edges can pull from this server
+			auto result = ocst::Orchestrator::GetInstance()->RegisterRelayToOriginMapStore(GetName(), stream->GetName(), stream->GetOriginMapDepth());
+			if (result == CommonErrorCode::ERROR)
+			{
+				// The stream can be played even if it is not registered as a relay node
+				logtw("Failed to register stream to origin map store as a relay node : %s/%s", GetName().CStr(), stream->GetName().CStr());
+			}
+		}
 
 		// If there is no data track, add data track
 		if (stream->GetFirstTrackByType(cmn::MediaType::Data) == nullptr)
@@ -216,6 +226,10 @@ namespace pvd
 				return false;
 			}
 		}
+		else
+		{
+			ocst::Orchestrator::GetInstance()->UnregisterRelayFromOriginMapStore(GetName(), stream->GetName());
+		}
 
 		return true;
 	}
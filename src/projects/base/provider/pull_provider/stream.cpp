@@ -38,6 +38,7 @@ namespace pvd
 		SetRepresentationType((_properties->IsRelay()==true)?StreamRepresentationType::Relay:StreamRepresentationType::Source);
 
 		_from_origin_map_store = _properties->IsFromOriginMapStore();
+		_origin_map_depth = _from_origin_map_store ? (_properties->GetOriginMapSourceDepth() + 1) : 0;
 	}
 
 	bool PullStream::Start()
@@ -67,6 +67,17 @@ namespace pvd
 			_from_origin_map_store = from_origin_map_store;
 		}
 
+		// Depth in the relay tree of the node this stream is pulled from (origin is 0)
+		uint32_t GetOriginMapSourceDepth()
+		{
+			return _origin_map_source_depth;
+		}
+
+		void SetOriginMapSourceDepth(uint32_t depth)
+		{
+			_origin_map_source_depth = depth;
+		}
+
 		int32_t GetFailbackTimeout()
 		{
 			return _failback_timeout;
@@ -128,6 +139,7 @@ namespace pvd
 		bool _failback = false;
 		bool _relay = false;
 		bool _from_origin_map_store = false;
+		uint32_t _origin_map_source_depth = 0;
 
 		// -1 means that the values in configuration file will be used. (Conf/Origins/Properties)
 		int32_t _failback_timeout = -1;
@@ -189,7 +189,8 @@ namespace pub
 		{
 			// Pull stream with the origin map store
 			logti("Try to pull stream from origin map store: [%s/%s]", vapp_name.CStr(), stream_name.CStr());
-			auto origin_url = orchestrator->GetOriginUrlFromOriginMapStore(vhost_app_name, stream_name);
+			uint32_t depth = 0;
+			auto origin_url = orchestrator->GetOriginUrlFromOriginMapStore(vhost_app_name, stream_name, &depth);
 			if (origin_url == nullptr)
 			{
 				return nullptr;
@@ -197,6 +198,7 @@ namespace pub
 
 			auto properties = std::make_shared<pvd::PullStreamProperties>();
 			properties->EnableFromOriginMapStore(true);
+			properties->SetOriginMapSourceDepth(depth);
 			if (origin_url->Scheme().UpperCaseString() == "OVT")
 			{
 				properties->EnableRelay(true);
@@ -314,6 +316,17 @@ namespace pub
 		return _access_controller->VerifyByWebhooks(request_info);
 	}
 
+	void Publisher::VerifyByAdmissionWebhooksAsync(const std::shared_ptr<const AccessController::RequestInfo> &request_info, const AccessController::WebhooksHandler &handler)
+	{
+		if(_access_controller == nullptr)
+		{
+			handler(AccessController::VerificationResult::Error, nullptr);
+			return;
+		}
+
+		_access_controller->VerifyByWebhooksAsync(request_info, handler);
+	}
+
 	std::tuple<AccessController::VerificationResult, std::shared_ptr<const SignedToken>>  Publisher::VerifyBySignedToken(const std::shared_ptr<const ov::Url> &request_url, const std::shared_ptr<ov::SocketAddress> &client_address)
 	{
 		if(_access_controller == nullptr)
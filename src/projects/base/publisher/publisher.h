@@ -145,6 +145,8 @@ namespace pub
 		// AdmissionWebhooks is an official feature
 		std::tuple<AccessController::VerificationResult, std::shared_ptr<const AdmissionWebhooks>> SendCloseAdmissionWebhooks(const std::shared_ptr<const AccessController::RequestInfo> &request_info);
 		std::tuple<AccessController::VerificationResult, std::shared_ptr<const AdmissionWebhooks>> VerifyByAdmissionWebhooks(const std::shared_ptr<const AccessController::RequestInfo> &request_info);
+		// The handler can be called in another thread after the control server responds
+		void VerifyByAdmissionWebhooksAsync(const std::shared_ptr<const AccessController::RequestInfo> &request_info, const AccessController::WebhooksHandler &handler);
 		// SingedToken is used only special purposes
 		std::tuple<AccessController::VerificationResult, std::shared_ptr<const SignedToken>> VerifyBySignedToken(const std::shared_ptr<const ov::Url> &request_url, const std::shared_ptr<ov::SocketAddress> &client_address);
 
@@ -179,6 +179,7 @@ namespace pub
 			auto packet = PopStreamPacket();
 			if (packet.has_value())
 			{		
+				_send_batch.Begin();
 				session_lock.lock();
 				for (auto const &x : _sessions)
 				{
@@ -186,6 +187,8 @@ namespace pub
 					session->SendOutgoingData(packet.value());
 				}
 				session_lock.unlock();
+				// The datagrams of all sessions are sent at once
+				_send_batch.End();
 			}
 		}
 	}
@@ -436,12 +439,20 @@ namespace pub
 		}
 		else
 		{
-			std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
-			for (auto const &x : _sessions)
+			// BroadcastPacket() may be called by several threads, so each thread has its own batch
+			static thread_local ov::SocketSendBatch send_batch;
+
+			send_batch.Begin();
 			{
-				auto session = std::static_pointer_cast<Session>(x.second);
-				session->SendOutgoingData(packet);
+				std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
+				for (auto const &x : _sessions)
+				{
+					auto session = std::static_pointer_cast<Session>(x.second);
+					session->SendOutgoingData(packet);
+				}
 			}
+			// The datagrams of all sessions are sent at once
+			send_batch.End();
 		}
 	
 		return true;
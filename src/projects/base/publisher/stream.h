@@ -5,6 +5,7 @@
 #include "base/info/stream.h"
 #include "base/info/push.h"
 #include "base/mediarouter/media_buffer.h"
+#include "base/ovsocket/socket_send_batch.h"
 #include "modules/managed_queue/managed_queue.h"
 #include "session.h"
 
@@ -57,6 +58,9 @@ namespace pub
 		std::shared_ptr<SessionMessage> PopSessionMessage();
 		ov::Queue<std::shared_ptr<SessionMessage>> _session_message_queue;
 
+		// Collects the datagrams of all sessions for a packet
+		ov::SocketSendBatch _send_batch;
+
 		std::atomic<bool> _stop_thread_flag;
 		std::thread _worker_thread;
 
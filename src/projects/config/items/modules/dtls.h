@@ -0,0 +1,57 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		struct DTLS : public ModuleTemplate
+		{
+		protected:
+			int _handshake_worker_count = 2;
+			int _max_handshakes_per_second = 0;
+			int _max_pending_handshakes = 1000;
+
+		public:
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetHandshakeWorkerCount, _handshake_worker_count)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxHandshakesPerSecond, _max_handshakes_per_second)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxPendingHandshakes, _max_pending_handshakes)
+
+		protected:
+			void MakeList() override
+			{
+				ModuleTemplate::MakeList();
+
+				/**
+					DTLS handshakes of WebRTC sessions are processed by dedicated threads,
+					so that a burst of handshakes does not delay the media of other sessions.
+					If disabled, handshakes are processed by the thread that received the packet.
+
+					server.xml:
+						<Modules>
+							<DTLS>
+								<Enable>true</Enable>
+								<HandshakeWorkerCount>2</HandshakeWorkerCount>
+								<!-- New handshakes started per second. 0 means unlimited. -->
+								<MaxHandshakesPerSecond>0</MaxHandshakesPerSecond>
+								<!-- New handshakes waiting to be started. The others are dropped and retransmitted by the peer. -->
+								<MaxPendingHandshakes>1000</MaxPendingHandshakes>
+							</DTLS>
+						</Modules>
+				*/
+				Register<Optional>("HandshakeWorkerCount", &_handshake_worker_count);
+				Register<Optional>("MaxHandshakesPerSecond", &_max_handshakes_per_second);
+				Register<Optional>("MaxPendingHandshakes", &_max_pending_handshakes);
+			}
+		};
+	}  // namespace modules
+}  // namespace cfg
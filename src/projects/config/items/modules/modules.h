@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include "dtls.h"
 #include "http2.h"
 #include "ll_hls.h"
 #include "p2p.h"
@@ -21,12 +22,14 @@ namespace cfg
 		{
 		protected:
 			HTTP2 _http2;
+			DTLS _dtls;
 			LLHls _ll_hls;
 			P2P _p2p;
 			Recovery _recovery;
 
 		public:
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetHttp2, _http2)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetDtls, _dtls)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetLLHls, _ll_hls)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetP2P, _p2p)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetRecovery, _recovery)
@@ -35,6 +38,7 @@ namespace cfg
 			void MakeList() override
 			{
 				Register<Optional>("HTTP2", &_http2);
+				Register<Optional>("DTLS", &_dtls);
 				Register<Optional>("LLHLS", &_ll_hls);
 				Register<Optional>({"P2P", "p2p"}, &_p2p);
 				Register<Optional>("Recovery", &_recovery);
@@ -8,6 +8,8 @@
 //==============================================================================
 #pragma once
 
+#include <base/ovcrypto/message_digest.h>
+
 #include "base/common_types.h"
 #include "enables.h"
 
@@ -22,6 +24,8 @@ namespace cfg
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetPolicyQueryKeyName, _policy_query_key_name)
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetSignatureQueryKeyName, _signature_query_key_name)
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetSecretKey, _secret_key)
+				// SHA-256 of the secret key in hex, which identifies the key without the plaintext
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetSecretKeyId, _secret_key_id)
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetEnabledProviders, _enables.GetProviders().GetValue())
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetEnabledPublishers, _enables.GetPublishers().GetValue())
 
@@ -42,13 +46,21 @@ namespace cfg
 				{
 					Register("PolicyQueryKeyName", &_policy_query_key_name);
 					Register("SignatureQueryKeyName", &_signature_query_key_name);
-					Register("SecretKey", &_secret_key);
+					Register("SecretKey", &_secret_key, nullptr, [=]() -> std::shared_ptr<ConfigError> {
+						auto secret_key_digest = ov::MessageDigest::ComputeDigest(ov::CryptoAlgorithm::Sha256, _secret_key.CStr(), _secret_key.GetLength());
+
+						// If the digest cannot be computed, the verified policies are not cached
+						_secret_key_id = (secret_key_digest != nullptr) ? secret_key_digest->ToHexString() : "";
+
+						return nullptr;
+					});
 					Register("Enables", &_enables);
 				}
 
 				ov::String _policy_query_key_name;
 				ov::String _signature_query_key_name;
 				ov::String _secret_key;
+				ov::String _secret_key_id;
 
 				Enables _enables;
 			};
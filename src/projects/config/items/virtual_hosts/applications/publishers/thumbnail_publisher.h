@@ -21,18 +21,25 @@ namespace cfg
 			{
 				struct ThumbnailPublisher : public Publisher, public cmn::CrossDomainSupport
 				{
+				protected:
+					// How long (in milliseconds) an on-demand thumbnail can be served without being encoded again
+					int _cache_ttl = 1000;
+
 				public:
 					PublisherType GetType() const override
 					{
 						return PublisherType::Thumbnail;
 					}
 
+					CFG_DECLARE_CONST_REF_GETTER_OF(GetCacheTTL, _cache_ttl)
+
 				protected:
 					void MakeList() override
 					{
 						Publisher::MakeList();
 
 						Register<Optional>("CrossDomains", &_cross_domains);
+						Register<Optional>("CacheTTL", &_cache_ttl);
 					}
 				};
 			}  // namespace pub
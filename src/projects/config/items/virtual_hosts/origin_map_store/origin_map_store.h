@@ -9,6 +9,7 @@
 #pragma once
 
 #include "redis_server.h"
+#include "relay_tree.h"
 
 namespace cfg
 {
@@ -20,16 +21,19 @@ namespace cfg
 			{
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetRedisServer, _redis_server)
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetOriginHostName, _origin_host_name)
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetRelayTree, _relay_tree)
 
 			protected:
 				void MakeList() override
 				{
 					Register("RedisServer", &_redis_server);
 					Register<Optional>("OriginHostName", &_origin_host_name);
+					Register<Optional>("RelayTree", &_relay_tree);
 				}
 				
 				RedisServer _redis_server;
 				ov::String _origin_host_name;
+				RelayTree _relay_tree;
 			};
 		}  // namespace orgn
 	}	   // namespace vhost
@@ -0,0 +1,38 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+namespace cfg
+{
+	namespace vhost
+	{
+		namespace orgn
+		{
+			// If RelayTree is set, edges that pulled a stream from OriginMapStore re-publish it via OVT
+			// and register themselves as relay nodes, so that other edges can pull from them instead of the origin.
+			struct RelayTree : public Item
+			{
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxDepth, _max_depth)
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxFanOut, _max_fan_out)
+
+			protected:
+				void MakeList() override
+				{
+					Register<Optional>("MaxDepth", &_max_depth);
+					Register<Optional>("MaxFanOut", &_max_fan_out);
+				}
+
+				// Depth of the origin is 0, edges that pull from the origin are 1, and so on
+				int _max_depth = 3;
+				// Maximum number of OVT sessions per node before new edges are attached to other nodes
+				int _max_fan_out = 10;
+			};
+		}  // namespace orgn
+	}	   // namespace vhost
+}  // namespace cfg
@@ -16,7 +16,7 @@
 #include <config/config_manager.h>
 #include <mediarouter/mediarouter.h>
 #include <modules/address/address_utilities.h>
-#include <modules/sdp/sdp_regex_pattern.h>
+#include <modules/dtls_srtp/dtls_handshake_pool.h>
 #include <monitoring/monitoring.h>
 #include <orchestrator/orchestrator.h>
 #include <providers/providers.h>
@@ -99,13 +99,6 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	// Precompile SDP patterns for better performance.
-	if (SDPRegexPattern::GetInstance()->Compile() == false)
-	{
-		OV_ASSERT(false, "SDPRegexPattern compile failed");
-		return false;
-	}
-
 	logti("This host supports %s", ov::ipv6::Checker::GetInstance()->ToString().CStr());
 
 	bool succeeded = true;
@@ -115,6 +108,13 @@ int main(int argc, char *argv[])
 	INIT_EXTERNAL_MODULE("OpenSSL", InitializeOpenSsl);
 	INIT_EXTERNAL_MODULE("SRTP", InitializeSrtp);
 
+	// DTLS handshakes are processed by dedicated threads not to delay media delivery
+	auto &dtls_config = server_config->GetModules().GetDtls();
+	if (dtls_config.IsEnabled())
+	{
+		DtlsHandshakePool::GetInstance()->Start(dtls_config.GetHandshakeWorkerCount(), dtls_config.GetMaxHandshakesPerSecond(), dtls_config.GetMaxPendingHandshakes());
+	}
+
 	//--------------------------------------------------------------------
 	// Create the modules
 	//--------------------------------------------------------------------
@@ -203,6 +203,8 @@ int main(int argc, char *argv[])
 
 	RELEASE_MODULE(media_router, "MediaRouter");
 
+	DtlsHandshakePool::GetInstance()->Stop();
+
 	TERMINATE_EXTERNAL_MODULE("SRTP", TerminateSrtp);
 	TERMINATE_EXTERNAL_MODULE("OpenSSL", TerminateOpenSsl);
 	TERMINATE_EXTERNAL_MODULE("SRT", TerminateSrt);
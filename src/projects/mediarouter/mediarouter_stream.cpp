@@ -1003,7 +1003,9 @@ std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
 
 	if ( (GetInoutType() == MediaRouterStreamType::OUTBOUND) && 
 		// The packet duration recalculation applies only to video and audio types.
-		 (media_packet->GetMediaType() == MediaType::Video || media_packet->GetMediaType() == MediaType::Audio) )
+		 (media_packet->GetMediaType() == MediaType::Video || media_packet->GetMediaType() == MediaType::Audio) &&
+		// Still images are not stashed, on-demand images must be delivered as soon as they are encoded.
+		 (media_packet->GetBitstreamFormat() != cmn::BitstreamFormat::JPEG && media_packet->GetBitstreamFormat() != cmn::BitstreamFormat::PNG) )
 	{
 		auto it = _media_packet_stash.find(media_packet->GetTrackId());
 		if (it == _media_packet_stash.end())
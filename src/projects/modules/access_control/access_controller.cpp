@@ -219,6 +219,7 @@ std::tuple<AccessController::VerificationResult, std::shared_ptr<const Admission
 		auto control_server_url = ov::Url::Parse(control_server_url_address);
 		auto secret_key = webhooks_config.GetSecretKey();
 		auto timeout_msec = webhooks_config.GetTimeoutMsec();
+		auto cache_ttl_msec = std::max(webhooks_config.GetCacheTTLMsec(), 0);
 
 		if(control_server_url == nullptr)
 		{
@@ -232,14 +233,14 @@ std::tuple<AccessController::VerificationResult, std::shared_ptr<const Admission
 			auto webhooks_request_info = std::make_shared<AdmissionWebhooks::RequestInfo>(request_url);
 			auto client_info = std::make_shared<AdmissionWebhooks::ClientInfo>(client_address, request_info->GetUserAgent());
 
-			admission_webhooks = AdmissionWebhooks::Query(_provider_type, control_server_url, timeout_msec, secret_key, webhooks_request_info, client_info);
+			admission_webhooks = AdmissionWebhooks::Query(_provider_type, control_server_url, timeout_msec, secret_key, webhooks_request_info, client_info, AdmissionWebhooks::Status::Code::OPENING, cache_ttl_msec);
 		}
 		else if(_publisher_type != PublisherType::Unknown)
 		{
 			auto webhooks_request_info = std::make_shared<AdmissionWebhooks::RequestInfo>(request_url);
 			auto client_info = std::make_shared<AdmissionWebhooks::ClientInfo>(client_address, request_info->GetUserAgent());
 
-			admission_webhooks = AdmissionWebhooks::Query(_publisher_type, control_server_url, timeout_msec, secret_key, webhooks_request_info, client_info);
+			admission_webhooks = AdmissionWebhooks::Query(_publisher_type, control_server_url, timeout_msec, secret_key, webhooks_request_info, client_info, AdmissionWebhooks::Status::Code::OPENING, cache_ttl_msec);
 		}
 		else
 		{
@@ -254,8 +255,9 @@ std::tuple<AccessController::VerificationResult, std::shared_ptr<const Admission
 			return {AccessController::VerificationResult::Error, nullptr};
 		}
 
-		logti("AdmissionWebhooks queried %s whether client %s could access %s. (Result : %s Elapsed : %u ms)",
-			control_server_url_address.CStr(), client_address->ToString(false).CStr(), request_url->ToUrlString().CStr(), admission_webhooks->GetErrCode()==AdmissionWebhooks::ErrCode::ALLOWED?"Allow":"Reject", admission_webhooks->GetElapsedTime());
+		logti("AdmissionWebhooks queried %s whether client %s could access %s. (Result : %s Elapsed : %u ms%s)",
+			control_server_url_address.CStr(), client_address->ToString(false).CStr(), request_url->ToUrlString().CStr(), admission_webhooks->GetErrCode()==AdmissionWebhooks::ErrCode::ALLOWED?"Allow":"Reject", admission_webhooks->GetElapsedTime(),
+			admission_webhooks->IsCached() ? " Cached" : "");
 
 		if(admission_webhooks->GetErrCode() != AdmissionWebhooks::ErrCode::ALLOWED)
 		{
@@ -270,6 +272,93 @@ std::tuple<AccessController::VerificationResult, std::shared_ptr<const Admission
 	return {AccessController::VerificationResult::Error, nullptr};
 }
 
+void AccessController::VerifyByWebhooksAsync(const std::shared_ptr<const AccessController::RequestInfo> &request_info, const WebhooksHandler &handler)
+{
+	auto orchestrator = ocst::Orchestrator::GetInstance();
+	auto request_url = request_info->GetRequestUrl();
+	auto client_address = request_info->GetClientAddress();
+
+	auto vhost_name = orchestrator->GetVhostNameFromDomain(request_url->Host());
+
+	if (vhost_name.IsEmpty())
+	{
+		logte("Could not resolve the domain: %s", request_url->Host().CStr());
+		handler(AccessController::VerificationResult::Error, nullptr);
+		return;
+	}
+
+	auto item = ocst::Orchestrator::GetInstance()->GetHostInfo(vhost_name);
+	if (item.has_value() == false)
+	{
+		// Probably this doesn't happen
+		logte("Could not find VirtualHost (%s)", vhost_name.CStr());
+		handler(AccessController::VerificationResult::Error, nullptr);
+		return;
+	}
+
+	auto vhost_item = item.value();
+
+	auto &webhooks_config = vhost_item.GetAdmissionWebhooks();
+	if (!webhooks_config.IsParsed())
+	{
+		// The vhost doesn't use the AdmissionWebhooks feature.
+		handler(AccessController::VerificationResult::Off, nullptr);
+		return;
+	}
+
+	if (((_provider_type != ProviderType::Unknown) && (webhooks_config.IsEnabledProvider(_provider_type) == false)) ||
+		((_publisher_type != PublisherType::Unknown) && (webhooks_config.IsEnabledPublisher(_publisher_type) == false)))
+	{
+		// This provider/publisher turned off the AdmissionWebhooks function
+		handler(AccessController::VerificationResult::Off, nullptr);
+		return;
+	}
+
+	auto control_server_url_address = webhooks_config.GetControlServerUrl();
+	auto control_server_url = ov::Url::Parse(control_server_url_address);
+	auto secret_key = webhooks_config.GetSecretKey();
+	auto timeout_msec = webhooks_config.GetTimeoutMsec();
+	auto cache_ttl_msec = std::max(webhooks_config.GetCacheTTLMsec(), 0);
+
+	if (control_server_url == nullptr)
+	{
+		logte("Could not parse control server url: %s", control_server_url_address.CStr());
+		handler(AccessController::VerificationResult::Error, nullptr);
+		return;
+	}
+
+	auto webhooks_request_info = std::make_shared<AdmissionWebhooks::RequestInfo>(request_url);
+	auto client_info = std::make_shared<AdmissionWebhooks::ClientInfo>(client_address, request_info->GetUserAgent());
+
+	auto completion_handler = [control_server_url_address, client_address, request_url, handler](const std::shared_ptr<AdmissionWebhooks> &admission_webhooks) {
+		logti("AdmissionWebhooks queried %s whether client %s could access %s. (Result : %s Elapsed : %u ms%s)",
+			  control_server_url_address.CStr(), client_address->ToString(false).CStr(), request_url->ToUrlString().CStr(), admission_webhooks->GetErrCode() == AdmissionWebhooks::ErrCode::ALLOWED ? "Allow" : "Reject", admission_webhooks->GetElapsedTime(),
+			  admission_webhooks->IsCached() ? " Cached" : "");
+
+		if (admission_webhooks->GetErrCode() != AdmissionWebhooks::ErrCode::ALLOWED)
+		{
+			handler(AccessController::VerificationResult::Fail, admission_webhooks);
+			return;
+		}
+
+		handler(AccessController::VerificationResult::Pass, admission_webhooks);
+	};
+
+	if (_provider_type != ProviderType::Unknown)
+	{
+		AdmissionWebhooks::QueryAsync(_provider_type, control_server_url, timeout_msec, secret_key, webhooks_request_info, client_info, AdmissionWebhooks::Status::Code::OPENING, cache_ttl_msec, completion_handler);
+	}
+	else if (_publisher_type != PublisherType::Unknown)
+	{
+		AdmissionWebhooks::QueryAsync(_publisher_type, control_server_url, timeout_msec, secret_key, webhooks_request_info, client_info, AdmissionWebhooks::Status::Code::OPENING, cache_ttl_msec, completion_handler);
+	}
+	else
+	{
+		logte("Provider type or publisher type must be set");
+		handler(AccessController::VerificationResult::Error, nullptr);
+	}
+}
+
 std::tuple<AccessController::VerificationResult, std::shared_ptr<const SignedPolicy>> AccessController::VerifyBySignedPolicy(const std::shared_ptr<const ov::Url> &request_url, const std::shared_ptr<ov::SocketAddress> &client_address)
 {
 	auto orchestrator = ocst::Orchestrator::GetInstance();
@@ -318,8 +407,9 @@ std::tuple<AccessController::VerificationResult, std::shared_ptr<const SignedPol
 		auto policy_query_key_name = signed_policy_config.GetPolicyQueryKeyName();
 		auto signature_query_key_name = signed_policy_config.GetSignatureQueryKeyName();
 		auto secret_key = signed_policy_config.GetSecretKey();
+		auto secret_key_id = signed_policy_config.GetSecretKeyId();
 
-		auto signed_policy = SignedPolicy::Load(client_address->GetIpAddress(), request_url->ToUrlString(), policy_query_key_name, signature_query_key_name, secret_key);
+		auto signed_policy = SignedPolicy::Load(client_address->GetIpAddress(), request_url->ToUrlString(), policy_query_key_name, signature_query_key_name, secret_key, secret_key_id);
 		if(signed_policy == nullptr)
 		{
 			// Probably this doesn't happen
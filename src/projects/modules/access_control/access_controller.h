@@ -46,6 +46,8 @@ public:
 		const ov::String _user_agent;
 	};
 
+	using WebhooksHandler = std::function<void(VerificationResult result, const std::shared_ptr<const AdmissionWebhooks> &admission_webhooks)>;
+
 	AccessController(ProviderType provider_type, const cfg::Server &server_config);
 	AccessController(PublisherType publisher_type, const cfg::Server &server_config);
 
@@ -56,6 +58,9 @@ public:
 	std::tuple<VerificationResult, std::shared_ptr<const AdmissionWebhooks>> SendCloseWebhooks(const std::shared_ptr<const AccessController::RequestInfo> &request_info);
 
 	std::tuple<VerificationResult, std::shared_ptr<const AdmissionWebhooks>> VerifyByWebhooks(const std::shared_ptr<const AccessController::RequestInfo> &request_info);
+	// Same as VerifyByWebhooks(), but the calling thread is not blocked while the control server is queried.
+	// The handler can be called before VerifyByWebhooksAsync() returns (e.g. the verdict is cached)
+	void VerifyByWebhooksAsync(const std::shared_ptr<const AccessController::RequestInfo> &request_info, const WebhooksHandler &handler);
 	
 private:
 	const ProviderType _provider_type;
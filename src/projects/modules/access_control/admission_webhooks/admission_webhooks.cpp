@@ -2,12 +2,17 @@
 
 #include <modules/http/client/http_client.h>
 
+#include "admission_webhooks_cache.h"
+
+#define OV_LOG_TAG "AdmissionWebhooks"
+
 std::shared_ptr<AdmissionWebhooks> AdmissionWebhooks::Query(ProviderType provider,
 															const std::shared_ptr<ov::Url> &control_server_url, uint32_t timeout_msec,
 															const ov::String secret_key,
 															const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
 															const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
-															const Status::Code status)
+															const Status::Code status,
+															uint64_t cache_ttl_msec)
 {
 	auto hooks = std::make_shared<AdmissionWebhooks>();
 
@@ -18,6 +23,7 @@ std::shared_ptr<AdmissionWebhooks> AdmissionWebhooks::Query(ProviderType provide
 	hooks->_request_info = request_info;
 	hooks->_client_info = client_info;
 	hooks->_status = status;
+	hooks->_cache_ttl_msec = cache_ttl_msec;
 
 	hooks->Run();
 
@@ -29,7 +35,8 @@ std::shared_ptr<AdmissionWebhooks> AdmissionWebhooks::Query(PublisherType publis
 															const ov::String secret_key,
 															const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
 															const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
-															const Status::Code status)
+															const Status::Code status,
+															uint64_t cache_ttl_msec)
 {
 	auto hooks = std::make_shared<AdmissionWebhooks>();
 
@@ -40,12 +47,59 @@ std::shared_ptr<AdmissionWebhooks> AdmissionWebhooks::Query(PublisherType publis
 	hooks->_request_info = request_info;
 	hooks->_client_info = client_info;
 	hooks->_status = status;
+	hooks->_cache_ttl_msec = cache_ttl_msec;
 
 	hooks->Run();
 
 	return hooks;
 }
 
+void AdmissionWebhooks::QueryAsync(ProviderType provider,
+								   const std::shared_ptr<ov::Url> &control_server_url, uint32_t timeout_msec,
+								   const ov::String secret_key,
+								   const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
+								   const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
+								   const Status::Code status,
+								   uint64_t cache_ttl_msec,
+								   const CompletionHandler &handler)
+{
+	auto hooks = std::make_shared<AdmissionWebhooks>();
+
+	hooks->_provider_type = provider;
+	hooks->_control_server_url = control_server_url;
+	hooks->_timeout_msec = timeout_msec;
+	hooks->_secret_key = secret_key;
+	hooks->_request_info = request_info;
+	hooks->_client_info = client_info;
+	hooks->_status = status;
+	hooks->_cache_ttl_msec = cache_ttl_msec;
+
+	hooks->RunAsync(handler);
+}
+
+void AdmissionWebhooks::QueryAsync(PublisherType publisher,
+								   const std::shared_ptr<ov::Url> &control_server_url, uint32_t timeout_msec,
+								   const ov::String secret_key,
+								   const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
+								   const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
+								   const Status::Code status,
+								   uint64_t cache_ttl_msec,
+								   const CompletionHandler &handler)
+{
+	auto hooks = std::make_shared<AdmissionWebhooks>();
+
+	hooks->_publisher_type = publisher;
+	hooks->_control_server_url = control_server_url;
+	hooks->_timeout_msec = timeout_msec;
+	hooks->_secret_key = secret_key;
+	hooks->_request_info = request_info;
+	hooks->_client_info = client_info;
+	hooks->_status = status;
+	hooks->_cache_ttl_msec = cache_ttl_msec;
+
+	hooks->RunAsync(handler);
+}
+
 AdmissionWebhooks::ClientInfo::ClientInfo(const std::shared_ptr<ov::SocketAddress> &client_address)
 	: _client_address(client_address), _user_agent("")
 {
@@ -125,6 +179,11 @@ uint64_t AdmissionWebhooks::GetElapsedTime() const
 	return _elapsed_ms;
 }
 
+bool AdmissionWebhooks::IsCached() const
+{
+	return _cached;
+}
+
 void AdmissionWebhooks::SetError(ErrCode code, ov::String reason)
 {
 	_err_code = code;
@@ -273,9 +332,49 @@ void AdmissionWebhooks::ParseResponse(const std::shared_ptr<ov::Data> &data)
 		}
 	}
 
+	// How long this verdict can be reused for the same client and url (in milliseconds)
+	Json::Value &jv_cache_ttl = object.GetJsonValue()["cache_ttl"];
+	if(jv_cache_ttl.isNull() == false)
+	{
+		if(jv_cache_ttl.isUInt64())
+		{
+			_cache_ttl_msec = jv_cache_ttl.asUInt64();
+		}
+	}
+
 	SetError(_allowed ? ErrCode::ALLOWED : ErrCode::DENIED, _err_reason);
 }
 
+ov::String AdmissionWebhooks::GetCacheKey() const
+{
+	// The port of the client is excluded because a reconnecting client uses a new port
+	return ov::String::FormatString("%s|%s|%s|%s|%s|%s",
+									_control_server_url->ToUrlString(true).CStr(),
+									StringFromProviderType(_provider_type).CStr(),
+									StringFromPublisherType(_publisher_type).CStr(),
+									_request_info->GetUrl()->ToUrlString(true).CStr(),
+									(_client_info != nullptr) ? _client_info->GetAddress().CStr() : "",
+									(_client_info != nullptr) ? _client_info->GetUserAgent().CStr() : "");
+}
+
+void AdmissionWebhooks::CopyVerdict(const AdmissionWebhooks &verdict)
+{
+	_allowed = verdict._allowed;
+	_err_code = verdict._err_code;
+	_err_reason = verdict._err_reason;
+	_new_url = verdict._new_url;
+	_responded_msec = verdict._responded_msec;
+	_cached = true;
+
+	// The lifetime is counted from the time the control server responded
+	_lifetime = verdict._lifetime;
+	if (_lifetime != 0)
+	{
+		auto passed_msec = ov::Clock::NowMSec() - _responded_msec;
+		_lifetime = (_lifetime > passed_msec) ? (_lifetime - passed_msec) : 1;
+	}
+}
+
 void AdmissionWebhooks::Run()
 {
 	auto body = GetMessageBody();
@@ -285,53 +384,254 @@ void AdmissionWebhooks::Run()
 		return;
 	}
 
+	if (_status == Status::Code::CLOSING)
+	{
+		// Closing notifications are neither cached nor coalesced
+		Request(body);
+		return;
+	}
+
+	ov::StopWatch watch;
+	watch.Start();
+
+	auto cache = AdmissionWebhooksCache::GetInstance();
+	auto key = GetCacheKey();
+
+	auto verdict = cache->FindVerdict(key);
+	if (verdict != nullptr)
+	{
+		CopyVerdict(*verdict);
+		_elapsed_ms = watch.Elapsed();
+		return;
+	}
+
+	// Blocking queries are not coalesced, because waiting for the query in flight blocks the calling thread.
+	// QueryAsync() joins the query in flight instead.
+	Request(body);
+
+	cache->StoreVerdict(key, std::make_shared<AdmissionWebhooks>(*this), _cache_ttl_msec);
+}
+
+void AdmissionWebhooks::RunAsync(const CompletionHandler &handler)
+{
+	auto self = GetSharedPtr();
+
+	auto body = GetMessageBody();
+	if(body.IsEmpty())
+	{
+		// Error
+		handler(self);
+		return;
+	}
+
+	if (_status == Status::Code::CLOSING)
+	{
+		// Closing notifications are neither cached nor coalesced
+		RequestAsync(body, true, [self, handler]() {
+			handler(self);
+		});
+		return;
+	}
+
+	auto started_msec = ov::Clock::NowMSec();
+
+	auto cache = AdmissionWebhooksCache::GetInstance();
+	auto key = GetCacheKey();
+
+	auto verdict = cache->FindVerdict(key);
+	if (verdict != nullptr)
+	{
+		CopyVerdict(*verdict);
+		_elapsed_ms = ov::Clock::NowMSec() - started_msec;
+		handler(self);
+		return;
+	}
+
+	std::shared_ptr<AdmissionWebhooksCache::InFlightQuery> in_flight_query;
+	if (cache->BeginQuery(key, &in_flight_query) == false)
+	{
+		// The same query is in flight, continue with its verdict
+		in_flight_query->AddContinuation([self, started_msec, handler](const std::shared_ptr<const AdmissionWebhooks> &result) {
+			self->CopyVerdict(*result);
+			self->_elapsed_ms = ov::Clock::NowMSec() - started_msec;
+			handler(self);
+		});
+		return;
+	}
+
+	RequestAsync(body, true, [self, key, handler]() {
+		AdmissionWebhooksCache::GetInstance()->EndQuery(key, std::make_shared<AdmissionWebhooks>(*self), self->_cache_ttl_msec);
+		handler(self);
+	});
+}
+
+ov::String AdmissionWebhooks::GetConnectionKey(ov::BlockingMode blocking_mode) const
+{
+	// Blocking and non-blocking clients are pooled separately, because the mode of a connected socket cannot be changed
+	return ov::String::FormatString("%s://%s:%d (%s)",
+									_control_server_url->Scheme().LowerCaseString().CStr(), _control_server_url->Host().CStr(), _control_server_url->Port(),
+									(blocking_mode == ov::BlockingMode::Blocking) ? "blocking" : "non-blocking");
+}
+
+bool AdmissionWebhooks::SetupClient(const std::shared_ptr<http::clnt::HttpClient> &client, const ov::String &body, ov::BlockingMode blocking_mode)
+{
 	// Set X-OME-Signature
 	auto md_sha1 = ov::MessageDigest::ComputeHmac(ov::CryptoAlgorithm::Sha1, _secret_key.ToData(false), body.ToData(false));
 	if(md_sha1 == nullptr)
 	{
 		// Error
 		SetError(ErrCode::INTERNAL_ERROR, ov::String::FormatString("Signature creation failed.(Method : HMAC(SHA1), Key : %s, Body length : %d", _secret_key.CStr(), body.GetLength()));
-		return;
+		return false;
 	}
 
-	auto signature_sha1_base64 = ov::Base64::Encode(md_sha1, true);
-
-	auto client = std::make_shared<http::clnt::HttpClient>();
 	client->SetMethod(http::Method::Post);
-	client->SetBlockingMode(ov::BlockingMode::Blocking);
+	client->SetBlockingMode(blocking_mode);
 	client->SetConnectionTimeout(_timeout_msec);
-	client->SetRequestHeader("X-OME-Signature", signature_sha1_base64);
-	client->SetRequestHeader("Content-Type", "application/json");
-	client->SetRequestHeader("Accept", "application/json");
+	client->SetRecvTimeout(_timeout_msec);
+
+	auto &headers = client->GetRequestHeaders();
+	headers["X-OME-Signature"] = ov::Base64::Encode(md_sha1, true);
+	headers["Content-Type"] = "application/json";
+	headers["Accept"] = "application/json";
 	client->SetRequestBody(body);
 
+	return true;
+}
+
+void AdmissionWebhooks::Request(const ov::String &body)
+{
+	auto cache = AdmissionWebhooksCache::GetInstance();
+	auto connection_key = GetConnectionKey(ov::BlockingMode::Blocking);
+
 	ov::StopWatch watch;
 	watch.Start();
 
-	client->Request(_control_server_url->ToUrlString(true), [=](http::StatusCode status_code, const std::shared_ptr<ov::Data> &data, const std::shared_ptr<const ov::Error> &error) 
+	http::StatusCode status_code = http::StatusCode::Unknown;
+	std::shared_ptr<ov::Data> data;
+	std::shared_ptr<const ov::Error> error;
+	std::shared_ptr<http::clnt::HttpClient> client;
+
+	// If the idle connection was closed by the control server, try again with a new connection
+	for (int retry = 0; retry < 2; retry++)
 	{
-		_elapsed_ms = watch.Elapsed();
+		bool reused = false;
+		client = cache->AcquireHttpClient(connection_key, &reused);
 
-		// A response was received from the server.
-		if(error == nullptr) 
-		{	
-			if(status_code == http::StatusCode::OK) 
-			{
-				// Parsing response
-				ParseResponse(data);
-				return;
-			} 
-			else 
+		if (SetupClient(client, body, ov::BlockingMode::Blocking) == false)
+		{
+			return;
+		}
+
+		// Blocking mode, so the handler is called before Request() returns
+		client->Request(_control_server_url->ToUrlString(true), [&](http::StatusCode response_status_code, const std::shared_ptr<ov::Data> &response_data, const std::shared_ptr<const ov::Error> &response_error) {
+			status_code = response_status_code;
+			data = response_data;
+			error = response_error;
+		});
+
+		if ((reused == false) || ((error == nullptr) && (status_code != http::StatusCode::Unknown)))
+		{
+			break;
+		}
+
+		logtd("The idle connection to the control server (%s) is closed, retry with a new connection", connection_key.CStr());
+	}
+
+	cache->ReleaseHttpClient(connection_key, client);
+
+	_elapsed_ms = watch.Elapsed();
+
+	HandleResponse(status_code, data, error);
+}
+
+void AdmissionWebhooks::RequestAsync(const ov::String &body, bool retry, const std::function<void()> &handler)
+{
+	auto self = GetSharedPtr();
+	auto cache = AdmissionWebhooksCache::GetInstance();
+	auto connection_key = GetConnectionKey(ov::BlockingMode::NonBlocking);
+
+	bool reused = false;
+	auto client = cache->AcquireHttpClient(connection_key, &reused);
+
+	if (SetupClient(client, body, ov::BlockingMode::NonBlocking) == false)
+	{
+		cache->ReleaseHttpClient(connection_key, client);
+		cache->PostCallback(handler);
+		return;
+	}
+
+	auto started_msec = ov::Clock::NowMSec();
+	// Either the response handler or the timeout handler completes the request
+	auto completed = std::make_shared<std::atomic<bool>>(false);
+
+	// The non-blocking HttpClient doesn't have a receive timeout (connection timeout + receive timeout)
+	cache->PostCallback(
+		[self, client, completed, started_msec, handler]() {
+			if (completed->exchange(true))
 			{
-				SetError(ErrCode::INVALID_STATUS_CODE, ov::String::FormatString("Control server responded with %d status code.", static_cast<uint16_t>(status_code)));
 				return;
 			}
+
+			client->Cancel();
+
+			self->_elapsed_ms = ov::Clock::NowMSec() - started_msec;
+			self->HandleResponse(http::StatusCode::Unknown, nullptr,
+								 ov::Error::CreateError("HTTP", "Timed out after %" PRIu64 " milliseconds", self->_timeout_msec * 2));
+			handler();
+		},
+		_timeout_msec * 2);
+
+	client->Request(_control_server_url->ToUrlString(true), [self, body, retry, handler, cache, connection_key, client, reused, completed, started_msec](http::StatusCode status_code, const std::shared_ptr<ov::Data> &data, const std::shared_ptr<const ov::Error> &error) {
+		if (completed->exchange(true))
+		{
+			return;
 		}
-		else
+
+		// The client is released before the response is handled, so that the next query can reuse the connection
+		cache->ReleaseHttpClient(connection_key, client);
+
+		if (reused && retry && ((error != nullptr) || (status_code == http::StatusCode::Unknown)))
 		{
-			// A connection error or an error that does not conform to the HTTP spec has occurred.
-			SetError(ErrCode::INTERNAL_ERROR, ov::String::FormatString("The HTTP client's request failed. (error code(%d) error message(%s)", error->GetCode(), error->GetMessage().CStr()));
+			// The idle connection was closed by the control server, try again with a new connection
+			logtd("The idle connection to the control server (%s) is closed, retry with a new connection", connection_key.CStr());
+
+			cache->PostCallback([self, body, handler]() {
+				self->RequestAsync(body, false, handler);
+			});
 			return;
 		}
+
+		cache->PostCallback([self, status_code, data, error, started_msec, handler]() {
+			self->_elapsed_ms = ov::Clock::NowMSec() - started_msec;
+			self->HandleResponse(status_code, data, error);
+			handler();
+		});
 	});
 }
+
+void AdmissionWebhooks::HandleResponse(http::StatusCode status_code, const std::shared_ptr<ov::Data> &data, const std::shared_ptr<const ov::Error> &error)
+{
+	_responded_msec = ov::Clock::NowMSec();
+
+	// A response was received from the server.
+	if(error == nullptr) 
+	{	
+		if(status_code == http::StatusCode::OK) 
+		{
+			// Parsing response
+			ParseResponse(data);
+			return;
+		} 
+		else 
+		{
+			SetError(ErrCode::INVALID_STATUS_CODE, ov::String::FormatString("Control server responded with %d status code.", static_cast<uint16_t>(status_code)));
+			return;
+		}
+	}
+	else
+	{
+		// A connection error or an error that does not conform to the HTTP spec has occurred.
+		SetError(ErrCode::INTERNAL_ERROR, ov::String::FormatString("The HTTP client's request failed. (error code(%d) error message(%s)", error->GetCode(), error->GetMessage().CStr()));
+		return;
+	}
+}
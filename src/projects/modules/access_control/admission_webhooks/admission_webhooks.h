@@ -3,10 +3,21 @@
 #include <base/common_types.h>
 #include <base/ovlibrary/ovlibrary.h>
 #include <base/ovsocket/socket_address.h>
+#include <modules/http/http_datastructure.h>
 
-class AdmissionWebhooks
+namespace http
+{
+	namespace clnt
+	{
+		class HttpClient;
+	}
+}
+
+class AdmissionWebhooks : public ov::EnableSharedFromThis<AdmissionWebhooks>
 {
 public:
+	using CompletionHandler = std::function<void(const std::shared_ptr<AdmissionWebhooks> &hooks)>;
+
 	enum class ErrCode : uint8_t
 	{
 		// From control server
@@ -70,34 +81,78 @@ public:
 		const std::shared_ptr<const ov::Url> _new_url;
 	};
 
+	// cache_ttl_msec : How long the verdict of the control server is cached (0 : not cached)
+	//                  It is overridden by "cache_ttl" in the response
 	static std::shared_ptr<AdmissionWebhooks> Query(ProviderType provider,
 													const std::shared_ptr<ov::Url> &control_server_url, uint32_t timeout_msec,
 													const ov::String secret_key,
 													const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
 													const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
-													const Status::Code status = Status::Code::OPENING);
+													const Status::Code status = Status::Code::OPENING,
+													uint64_t cache_ttl_msec = 0);
 
+	// cache_ttl_msec : How long the verdict of the control server is cached (0 : not cached)
+	//                  It is overridden by "cache_ttl" in the response
 	static std::shared_ptr<AdmissionWebhooks> Query(PublisherType publisher,
 													const std::shared_ptr<ov::Url> &control_server_url, uint32_t timeout_msec,
 													const ov::String secret_key,
 													const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
 													const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
-													const Status::Code status = Status::Code::OPENING);
+													const Status::Code status = Status::Code::OPENING,
+													uint64_t cache_ttl_msec = 0);
+
+	// Same as Query(), but the socket worker threads are not blocked while the query is in flight.
+	// The handler is called in the calling thread if the verdict is cached,
+	// otherwise it is called in the callback thread of AdmissionWebhooksCache
+	static void QueryAsync(ProviderType provider,
+						   const std::shared_ptr<ov::Url> &control_server_url, uint32_t timeout_msec,
+						   const ov::String secret_key,
+						   const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
+						   const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
+						   const Status::Code status,
+						   uint64_t cache_ttl_msec,
+						   const CompletionHandler &handler);
+
+	static void QueryAsync(PublisherType publisher,
+						   const std::shared_ptr<ov::Url> &control_server_url, uint32_t timeout_msec,
+						   const ov::String secret_key,
+						   const std::shared_ptr<const AdmissionWebhooks::RequestInfo> &request_info,
+						   const std::shared_ptr<const AdmissionWebhooks::ClientInfo> &client_info,
+						   const Status::Code status,
+						   uint64_t cache_ttl_msec,
+						   const CompletionHandler &handler);
 
 	ErrCode GetErrCode() const;
 	ov::String GetErrReason() const;
 	std::shared_ptr<ov::Url> GetNewURL() const;
 	uint64_t GetLifetime() const;
 	uint64_t GetElapsedTime() const;
+	// Whether the verdict is served from the cache or from the query in flight of other clients
+	bool IsCached() const;
 	
 private:
 	void Run();
+	void RunAsync(const CompletionHandler &handler);
+	// Sends the query to the control server
+	void Request(const ov::String &body);
+	// Sends the query with a non-blocking HttpClient, and the handler is called in the callback thread of AdmissionWebhooksCache
+	// (retry : whether to retry with a new connection if the idle connection was closed by the control server)
+	void RequestAsync(const ov::String &body, bool retry, const std::function<void()> &handler);
+	// The key of the connection pool of AdmissionWebhooksCache
+	ov::String GetConnectionKey(ov::BlockingMode blocking_mode) const;
+	// Returns false if the signature cannot be made
+	bool SetupClient(const std::shared_ptr<http::clnt::HttpClient> &client, const ov::String &body, ov::BlockingMode blocking_mode);
+	void HandleResponse(http::StatusCode status_code, const std::shared_ptr<ov::Data> &data, const std::shared_ptr<const ov::Error> &error);
+	// Identical queries share the verdict
+	ov::String GetCacheKey() const;
+	void CopyVerdict(const AdmissionWebhooks &verdict);
 	ov::String GetMessageBody();
 	void SetError(ErrCode code, ov::String reason);
 
 	void ParseResponse(const std::shared_ptr<ov::Data> &data);
 
 	uint64_t _elapsed_ms = 0;
+	bool _cached = false;
 
 	// Client
 	std::shared_ptr<const ClientInfo> _client_info;
@@ -117,4 +172,7 @@ private:
 	ov::String _err_reason;
 	std::shared_ptr<ov::Url> _new_url = nullptr;
 	uint64_t _lifetime = 0;
+	uint64_t _cache_ttl_msec = 0;
+	// When the response is received (ov::Clock::NowMSec())
+	uint64_t _responded_msec = 0;
 };
@@ -0,0 +1,248 @@
+#include "admission_webhooks_cache.h"
+
+#define OV_LOG_TAG "AdmissionWebhooks"
+
+// The maximum number of verdicts to keep
+#define ADMISSION_WEBHOOKS_MAX_VERDICT_COUNT (100 * 1000)
+// The maximum number of idle connections per control server
+#define ADMISSION_WEBHOOKS_MAX_IDLE_CLIENT_COUNT 32
+// The number of threads that handle the responses of the control server
+#define ADMISSION_WEBHOOKS_CALLBACK_THREAD_COUNT 4
+
+void AdmissionWebhooksCache::InFlightQuery::AddContinuation(const Continuation &continuation)
+{
+	std::shared_ptr<const AdmissionWebhooks> result;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_completed == false)
+		{
+			_continuations.push_back(continuation);
+			return;
+		}
+
+		result = _result;
+	}
+
+	continuation(result);
+}
+
+void AdmissionWebhooksCache::InFlightQuery::Complete(const std::shared_ptr<const AdmissionWebhooks> &result)
+{
+	std::vector<Continuation> continuations;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_completed = true;
+		_result = result;
+
+		continuations.swap(_continuations);
+	}
+
+	for (auto &continuation : continuations)
+	{
+		continuation(result);
+	}
+}
+
+AdmissionWebhooksCache::AdmissionWebhooksCache()
+{
+	for (int index = 0; index < ADMISSION_WEBHOOKS_CALLBACK_THREAD_COUNT; index++)
+	{
+		auto queue = std::make_shared<ov::DelayQueue>("AWCallback");
+		queue->Start();
+
+		_callback_queues.push_back(queue);
+	}
+
+	_timer_queue = std::make_shared<ov::DelayQueue>("AWTimer");
+	_timer_queue->Start();
+}
+
+AdmissionWebhooksCache::~AdmissionWebhooksCache()
+{
+	_timer_queue->Stop();
+
+	for (auto &queue : _callback_queues)
+	{
+		queue->Stop();
+	}
+}
+
+std::shared_ptr<const AdmissionWebhooks> AdmissionWebhooksCache::FindVerdict(const ov::String &key)
+{
+	std::lock_guard<std::mutex> lock(_verdict_map_mutex);
+
+	auto item = _verdict_map.find(key);
+	if (item == _verdict_map.end())
+	{
+		return nullptr;
+	}
+
+	if (item->second.expire_msec <= ov::Clock::NowMSec())
+	{
+		_verdict_map.erase(item);
+		return nullptr;
+	}
+
+	return item->second.result;
+}
+
+bool AdmissionWebhooksCache::BeginQuery(const ov::String &key, std::shared_ptr<InFlightQuery> *in_flight_query)
+{
+	std::lock_guard<std::mutex> lock(_in_flight_map_mutex);
+
+	auto item = _in_flight_map.find(key);
+	if (item != _in_flight_map.end())
+	{
+		*in_flight_query = item->second;
+		return false;
+	}
+
+	*in_flight_query = std::make_shared<InFlightQuery>();
+	_in_flight_map[key] = *in_flight_query;
+
+	return true;
+}
+
+void AdmissionWebhooksCache::EndQuery(const ov::String &key, const std::shared_ptr<const AdmissionWebhooks> &result, uint64_t cache_ttl_msec)
+{
+	StoreVerdict(key, result, cache_ttl_msec);
+
+	std::shared_ptr<InFlightQuery> in_flight_query;
+	{
+		std::lock_guard<std::mutex> lock(_in_flight_map_mutex);
+
+		auto item = _in_flight_map.find(key);
+		if (item != _in_flight_map.end())
+		{
+			in_flight_query = item->second;
+			_in_flight_map.erase(item);
+		}
+	}
+
+	if (in_flight_query != nullptr)
+	{
+		in_flight_query->Complete(result);
+	}
+}
+
+void AdmissionWebhooksCache::StoreVerdict(const ov::String &key, const std::shared_ptr<const AdmissionWebhooks> &result, uint64_t cache_ttl_msec)
+{
+	if ((result != nullptr) && (cache_ttl_msec > 0))
+	{
+		auto err_code = result->GetErrCode();
+
+		// Only the verdicts of the control server are cached
+		if ((err_code == AdmissionWebhooks::ErrCode::ALLOWED) || (err_code == AdmissionWebhooks::ErrCode::DENIED))
+		{
+			auto now_msec = ov::Clock::NowMSec();
+			auto expire_msec = now_msec + cache_ttl_msec;
+
+			// An allowed verdict must not outlive the lifetime of the session
+			if ((err_code == AdmissionWebhooks::ErrCode::ALLOWED) && (result->GetLifetime() != 0))
+			{
+				expire_msec = std::min(expire_msec, now_msec + result->GetLifetime());
+			}
+
+			std::lock_guard<std::mutex> lock(_verdict_map_mutex);
+
+			if (_verdict_map.size() >= ADMISSION_WEBHOOKS_MAX_VERDICT_COUNT)
+			{
+				RemoveExpiredVerdicts(now_msec);
+			}
+
+			if (_verdict_map.size() < ADMISSION_WEBHOOKS_MAX_VERDICT_COUNT)
+			{
+				_verdict_map[key] = {result, expire_msec};
+			}
+		}
+	}
+}
+
+void AdmissionWebhooksCache::PostCallback(const std::function<void()> &callback, int after_msec)
+{
+	if (after_msec > 0)
+	{
+		_timer_queue->Push(
+			[this, callback](void *parameter) -> ov::DelayQueueAction {
+				PostCallback(callback);
+				return ov::DelayQueueAction::Stop;
+			},
+			after_msec);
+
+		return;
+	}
+
+	auto &queue = _callback_queues[_callback_index++ % _callback_queues.size()];
+
+	queue->Push(
+		[callback](void *parameter) -> ov::DelayQueueAction {
+			callback();
+			return ov::DelayQueueAction::Stop;
+		},
+		0);
+}
+
+void AdmissionWebhooksCache::RemoveExpiredVerdicts(uint64_t now_msec)
+{
+	for (auto item = _verdict_map.begin(); item != _verdict_map.end();)
+	{
+		if (item->second.expire_msec <= now_msec)
+		{
+			item = _verdict_map.erase(item);
+		}
+		else
+		{
+			++item;
+		}
+	}
+}
+
+std::shared_ptr<http::clnt::HttpClient> AdmissionWebhooksCache::AcquireHttpClient(const ov::String &key, bool *reused)
+{
+	{
+		std::lock_guard<std::mutex> lock(_idle_client_map_mutex);
+
+		auto item = _idle_client_map.find(key);
+		if (item != _idle_client_map.end())
+		{
+			auto &client_list = item->second;
+
+			while (client_list.empty() == false)
+			{
+				auto client = client_list.back();
+				client_list.pop_back();
+
+				if (client->IsReusable())
+				{
+					*reused = true;
+					return client;
+				}
+			}
+		}
+	}
+
+	auto client = std::make_shared<http::clnt::HttpClient>();
+	client->SetKeepAlive(true);
+
+	*reused = false;
+	return client;
+}
+
+void AdmissionWebhooksCache::ReleaseHttpClient(const ov::String &key, const std::shared_ptr<http::clnt::HttpClient> &client)
+{
+	if (client->IsReusable() == false)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(_idle_client_map_mutex);
+
+	auto &client_list = _idle_client_map[key];
+	if (client_list.size() < ADMISSION_WEBHOOKS_MAX_IDLE_CLIENT_COUNT)
+	{
+		client_list.push_back(client);
+	}
+}
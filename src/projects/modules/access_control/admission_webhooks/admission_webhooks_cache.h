@@ -0,0 +1,79 @@
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/http/client/http_client.h>
+
+#include "admission_webhooks.h"
+
+// Shared state of AdmissionWebhooks queries
+// - Verdict cache : Allow/deny verdicts are cached for CacheTTL (or "cache_ttl" of the response)
+// - Request coalescing : Asynchronous queries with the same key continue with the verdict of the query in flight instead of sending a new one
+// - Keep-alive connection pool : HttpClients connected to the control server are reused
+class AdmissionWebhooksCache : public ov::Singleton<AdmissionWebhooksCache>
+{
+public:
+	class InFlightQuery
+	{
+	public:
+		using Continuation = std::function<void(const std::shared_ptr<const AdmissionWebhooks> &result)>;
+
+		// The continuation is called by Complete(), or immediately if the query is already completed
+		void AddContinuation(const Continuation &continuation);
+		// Calls the continuations in the calling thread
+		void Complete(const std::shared_ptr<const AdmissionWebhooks> &result);
+
+	private:
+		std::mutex _mutex;
+		bool _completed = false;
+		std::shared_ptr<const AdmissionWebhooks> _result;
+		std::vector<Continuation> _continuations;
+	};
+
+	AdmissionWebhooksCache();
+	~AdmissionWebhooksCache() override;
+
+	std::shared_ptr<const AdmissionWebhooks> FindVerdict(const ov::String &key);
+
+	// Returns true if the caller has to send the query and call EndQuery(),
+	// otherwise the caller can add a continuation to in_flight_query
+	bool BeginQuery(const ov::String &key, std::shared_ptr<InFlightQuery> *in_flight_query);
+	// Stores the verdict and completes the query in flight
+	void EndQuery(const ov::String &key, const std::shared_ptr<const AdmissionWebhooks> &result, uint64_t cache_ttl_msec);
+	// cache_ttl_msec == 0 means that the result is not cached
+	void StoreVerdict(const ov::String &key, const std::shared_ptr<const AdmissionWebhooks> &result, uint64_t cache_ttl_msec);
+
+	// Runs the callback in one of the callback threads after after_msec,
+	// so the responses of the control server are not handled in the socket worker threads.
+	// The timer thread only hands the callback over to the callback threads when after_msec elapses,
+	// so the callbacks that take a while don't delay the timeouts of the other queries.
+	void PostCallback(const std::function<void()> &callback, int after_msec = 0);
+
+	// key : scheme://host:port of the control server and the blocking mode of the client
+	std::shared_ptr<http::clnt::HttpClient> AcquireHttpClient(const ov::String &key, bool *reused);
+	void ReleaseHttpClient(const ov::String &key, const std::shared_ptr<http::clnt::HttpClient> &client);
+
+private:
+	struct Verdict
+	{
+		std::shared_ptr<const AdmissionWebhooks> result;
+		uint64_t expire_msec = 0;
+	};
+
+	void RemoveExpiredVerdicts(uint64_t now_msec);
+
+	std::unordered_map<ov::String, Verdict> _verdict_map;
+	std::mutex _verdict_map_mutex;
+
+	std::unordered_map<ov::String, std::shared_ptr<InFlightQuery>> _in_flight_map;
+	std::mutex _in_flight_map_mutex;
+
+	std::unordered_map<ov::String, std::vector<std::shared_ptr<http::clnt::HttpClient>>> _idle_client_map;
+	std::mutex _idle_client_map_mutex;
+
+	// The callbacks can take a while (e.g. pulling a stream from the origin),
+	// so they are spread over a few threads
+	std::vector<std::shared_ptr<ov::DelayQueue>> _callback_queues;
+	std::atomic<uint32_t> _callback_index{0};
+	// Runs nothing but the timers of the delayed callbacks
+	std::shared_ptr<ov::DelayQueue> _timer_queue;
+};
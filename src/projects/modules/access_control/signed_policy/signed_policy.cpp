@@ -5,16 +5,22 @@
 
 #include "signed_policy.h"
 
+// Maximum number of verified (policy, signature) pairs to keep.
+// Repeated requests with the same URL (e.g. LLHLS playlist/part requests) skip
+// HMAC computation, base64 decoding and JSON parsing using this cache
+#define SIGNED_POLICY_CACHE_SIZE 10000
+// Maximum number of precomputed HMAC contexts per thread (one per secret key)
+#define SIGNED_POLICY_MAX_HMAC_CONTEXTS_PER_THREAD 16
 
 // requested_url ==> scheme://domain:port/app/stream[/file]?[query1=value&query2=value&]policy=value&signature=value
-std::shared_ptr<const SignedPolicy> SignedPolicy::Load(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key)
+std::shared_ptr<const SignedPolicy> SignedPolicy::Load(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key, const ov::String &secret_key_id)
 {
 	auto signed_policy = std::make_shared<SignedPolicy>();
-	signed_policy->Process(client_address, requested_url, policy_query_key, signature_query_key, secret_key);
+	signed_policy->Process(client_address, requested_url, policy_query_key, signature_query_key, secret_key, secret_key_id);
 	return signed_policy;
 }
 
-bool SignedPolicy::Process(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key)
+bool SignedPolicy::Process(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key, const ov::String &secret_key_id)
 {
 	auto url = ov::Url::Parse(requested_url);
 	
@@ -43,25 +49,50 @@ bool SignedPolicy::Process(const ov::String &client_address, const ov::String &r
 	url->RemoveQueryKey(signature_query_key);
 	auto base_url = url->ToUrlString(true);
 
-	// Make signature
-	ov::String signature_base64;
-	if(MakeSignature(base_url, secret_key, signature_base64) == false)
-	{
-		SetError(ErrCode::NO_SIGNATURE_VALUE_IN_URL, ov::String::FormatString("Could not generate signature from url(%s).", requested_url.CStr()));
-		return false;
-	}
+	auto cache_key = MakeCacheKey(secret_key_id, base_url, signature_query_value);
+	auto verified_policy = FindVerifiedPolicy(cache_key);
 
-	if(signature_base64 != signature_query_value)
+	if (verified_policy != nullptr)
 	{
-		SetError(ErrCode::INVALID_SIGNATURE, ov::String::FormatString("Signature value is invalid(expected : %s | input : %s).", signature_base64.CStr(), signature_query_value.CStr()));
-		return false;
+		// Signature has already been verified
+		ApplyVerifiedPolicy(*verified_policy);
 	}
+	else
+	{
+		// Make signature
+		ov::String signature_base64;
+		if(MakeSignature(base_url, secret_key, signature_base64) == false)
+		{
+			SetError(ErrCode::NO_SIGNATURE_VALUE_IN_URL, ov::String::FormatString("Could not generate signature from url(%s).", requested_url.CStr()));
+			return false;
+		}
 
-	// Extract policy
-	auto policy_base64 = url->GetQueryValue(policy_query_key);
-	auto policy = ov::Base64::Decode(policy_base64, true);
+		if(signature_base64 != signature_query_value)
+		{
+			SetError(ErrCode::INVALID_SIGNATURE, ov::String::FormatString("Signature value is invalid(expected : %s | input : %s).", signature_base64.CStr(), signature_query_value.CStr()));
+			return false;
+		}
+
+		// Extract policy
+		auto policy_base64 = url->GetQueryValue(policy_query_key);
+		auto policy = ov::Base64::Decode(policy_base64, true);
 
-	if(ProcessPolicyJson(policy->ToString()) == false)
+		if(policy == nullptr)
+		{
+			SetError(ErrCode::INVALID_POLICY, "The policy is in wrong format.");
+			return false;
+		}
+
+		if(ProcessPolicyJson(policy->ToString()) == false)
+		{
+			return false;
+		}
+
+		StoreVerifiedPolicy(cache_key);
+	}
+
+	// Time based policy must be checked on every request, even if the signature is cached
+	if(ValidatePolicy() == false)
 	{
 		return false;
 	}
@@ -80,7 +111,33 @@ bool SignedPolicy::Process(const ov::String &client_address, const ov::String &r
 
 bool SignedPolicy::MakeSignature(const ov::String &base_url, const ov::String &secret_key, ov::String &signature_base64)
 {
-	auto md = ov::MessageDigest::ComputeHmac(ov::CryptoAlgorithm::Sha1, secret_key.ToData(false), base_url.ToData(false));
+	// Inner/outer padded key states are precomputed per secret key and reused in this thread
+	thread_local std::unordered_map<ov::String, std::shared_ptr<ov::HmacContext>> hmac_context_map;
+
+	std::shared_ptr<ov::HmacContext> hmac_context;
+
+	auto item = hmac_context_map.find(secret_key);
+	if (item != hmac_context_map.end())
+	{
+		hmac_context = item->second;
+	}
+	else
+	{
+		hmac_context = std::make_shared<ov::HmacContext>();
+		if (hmac_context->Create(ov::CryptoAlgorithm::Sha1, secret_key.CStr(), secret_key.GetLength()) == false)
+		{
+			return false;
+		}
+
+		if (hmac_context_map.size() >= SIGNED_POLICY_MAX_HMAC_CONTEXTS_PER_THREAD)
+		{
+			hmac_context_map.clear();
+		}
+
+		hmac_context_map.emplace(secret_key, hmac_context);
+	}
+
+	auto md = hmac_context->Compute(base_url.ToData(false));
 	if(md == nullptr)
 	{
 		return false;
@@ -91,6 +148,85 @@ bool SignedPolicy::MakeSignature(const ov::String &base_url, const ov::String &s
 	return true;
 }
 
+ov::LruCache<ov::String, std::shared_ptr<const SignedPolicy::VerifiedPolicy>> &SignedPolicy::GetVerifiedPolicyCache()
+{
+	static ov::LruCache<ov::String, std::shared_ptr<const VerifiedPolicy>> cache(SIGNED_POLICY_CACHE_SIZE);
+	return cache;
+}
+
+ov::String SignedPolicy::MakeCacheKey(const ov::String &secret_key_id, const ov::String &base_url, const ov::String &signature)
+{
+	if (secret_key_id.IsEmpty())
+	{
+		// Not cached
+		return "";
+	}
+
+	// base_url contains the policy, so the key identifies the (policy, signature) pair signed with the secret key of secret_key_id
+	ov::String key;
+
+	key.SetCapacity(secret_key_id.GetLength() + base_url.GetLength() + signature.GetLength() + 2);
+	key.Append(secret_key_id);
+	key.Append('\n');
+	key.Append(base_url);
+	key.Append('\n');
+	key.Append(signature);
+
+	return key;
+}
+
+std::shared_ptr<const SignedPolicy::VerifiedPolicy> SignedPolicy::FindVerifiedPolicy(const ov::String &cache_key)
+{
+	if (cache_key.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	auto &cache = GetVerifiedPolicyCache();
+
+	std::shared_ptr<const VerifiedPolicy> verified_policy;
+	if (cache.Get(cache_key, &verified_policy) == false)
+	{
+		return nullptr;
+	}
+
+	if (verified_policy->url_expire_epoch_msec < ov::Clock::NowMSec())
+	{
+		// The URL can no longer be used
+		cache.Remove(cache_key);
+		return nullptr;
+	}
+
+	return verified_policy;
+}
+
+void SignedPolicy::StoreVerifiedPolicy(const ov::String &cache_key) const
+{
+	if (cache_key.IsEmpty() || (_url_expire_epoch_msec < ov::Clock::NowMSec()))
+	{
+		return;
+	}
+
+	auto verified_policy = std::make_shared<VerifiedPolicy>();
+
+	verified_policy->url_expire_epoch_msec = _url_expire_epoch_msec;
+	verified_policy->url_activate_epoch_msec = _url_activate_epoch_msec;
+	verified_policy->stream_expire_epoch_msec = _stream_expire_epoch_msec;
+	verified_policy->allow_ip_cidr = _allow_ip_cidr;
+	verified_policy->cidr = _cidr;
+
+	GetVerifiedPolicyCache().Set(cache_key, verified_policy);
+}
+
+void SignedPolicy::ApplyVerifiedPolicy(const VerifiedPolicy &verified_policy)
+{
+	_url_expire_epoch_msec = verified_policy.url_expire_epoch_msec;
+	_url_activate_epoch_msec = verified_policy.url_activate_epoch_msec;
+	_stream_expire_epoch_msec = verified_policy.stream_expire_epoch_msec;
+	_allow_ip_cidr = verified_policy.allow_ip_cidr;
+	_cidr = verified_policy.cidr;
+}
+
 /*	Policy format
 {
 	"url_activate":1399721576,									
@@ -118,40 +254,18 @@ bool SignedPolicy::ProcessPolicyJson(const ov::String &policy_json)
 		SetError(ErrCode::INVALID_POLICY, ov::String::FormatString("url_expire must be epoch milliseconds as uint64_t and is a required value.", policy_json.CStr()));
 		return false;
 	}
-	else
-	{
-		_url_expire_epoch_msec = jv_url_expire.asUInt64();
+	_url_expire_epoch_msec = jv_url_expire.asUInt64();
 
-		// Policy expired
-		if(_url_expire_epoch_msec < ov::Clock::NowMSec())
-		{
-			SetError(ErrCode::INVALID_POLICY, ov::String::FormatString("URL has expired.(now:%llu policy_expire:%llu) ", ov::Clock::NowMSec(), _url_expire_epoch_msec));
-			return false;
-		}
-	}
-	
 	if(!jv_url_activate.isNull() && jv_url_activate.isUInt64())
 	{
 		_url_activate_epoch_msec = jv_url_activate.asUInt64();
-
-		// Policy is not activated yet
-		if(_url_activate_epoch_msec > ov::Clock::NowMSec())
-		{
-			SetError(ErrCode::INVALID_POLICY, ov::String::FormatString("The URL has not yet been activated.(now:%llu policy_activate:%llu) ", ov::Clock::NowMSec(), _url_activate_epoch_msec));
-			return false;
-		}
 	}
 
 	if(!jv_stream_expire.isNull() && jv_stream_expire.isUInt64())
 	{
 		_stream_expire_epoch_msec = jv_stream_expire.asUInt64();
-		if(_stream_expire_epoch_msec < ov::Clock::NowMSec())
-		{
-			SetError(ErrCode::INVALID_POLICY, ov::String::FormatString("Stream has expired.(now:%llu policy_expire:%llu) ", ov::Clock::NowMSec(), _url_expire_epoch_msec));
-			return false;
-		}
 	}
-	
+
 	if(!jv_allow_ip.isNull() && jv_allow_ip.isString())
 	{
 		_allow_ip_cidr = jv_allow_ip.asString().c_str();
@@ -166,6 +280,33 @@ bool SignedPolicy::ProcessPolicyJson(const ov::String &policy_json)
 	return true;
 }
 
+bool SignedPolicy::ValidatePolicy()
+{
+	auto now = ov::Clock::NowMSec();
+
+	// Policy expired
+	if(_url_expire_epoch_msec < now)
+	{
+		SetError(ErrCode::INVALID_POLICY, ov::String::FormatString("URL has expired.(now:%llu policy_expire:%llu) ", now, _url_expire_epoch_msec));
+		return false;
+	}
+
+	// Policy is not activated yet
+	if((_url_activate_epoch_msec != 0) && (_url_activate_epoch_msec > now))
+	{
+		SetError(ErrCode::INVALID_POLICY, ov::String::FormatString("The URL has not yet been activated.(now:%llu policy_activate:%llu) ", now, _url_activate_epoch_msec));
+		return false;
+	}
+
+	if((_stream_expire_epoch_msec != 0) && (_stream_expire_epoch_msec < now))
+	{
+		SetError(ErrCode::INVALID_POLICY, ov::String::FormatString("Stream has expired.(now:%llu policy_expire:%llu) ", now, _stream_expire_epoch_msec));
+		return false;
+	}
+
+	return true;
+}
+
 const ov::String& SignedPolicy::GetRequestedUrl() const
 {
 	return _requested_url;
@@ -3,6 +3,8 @@
 #include <base/ovsocket/socket_address.h>
 #include <base/ovlibrary/ovlibrary.h>
 #include <base/ovlibrary/cidr.h>
+#include <base/ovlibrary/lru_cache.h>
+
 class SignedPolicy
 {
 public:
@@ -22,7 +24,9 @@ public:
 	};
 
 	// requested_url ==> scheme://domain:port/app/stream[/file]?[query1=value&query2=value&]policy=value&signature=value
-	static std::shared_ptr<const SignedPolicy> Load(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key);
+	// secret_key_id identifies secret_key in the verified policy cache (See cfg::vhost::sig::SignedPolicy::GetSecretKeyId()),
+	// the policy is not cached if it is empty
+	static std::shared_ptr<const SignedPolicy> Load(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key, const ov::String &secret_key_id);
 
 	ErrCode GetErrCode() const
 	{
@@ -56,10 +60,29 @@ private:
 		_error_message = message;
 	}
 
-    bool Process(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key);
+	// Policy that has passed signature verification (time/IP checks are not included)
+	struct VerifiedPolicy
+	{
+		uint64_t url_expire_epoch_msec = 0;
+		uint64_t url_activate_epoch_msec = 0;
+		uint64_t stream_expire_epoch_msec = 0;
+
+		ov::String allow_ip_cidr;
+		std::shared_ptr<ov::CIDR> cidr = nullptr;
+	};
+
+    bool Process(const ov::String &client_address, const ov::String &requested_url, const ov::String &policy_query_key, const ov::String &signature_query_key, const ov::String &secret_key, const ov::String &secret_key_id);
 	bool ProcessPolicyJson(const ov::String &policy_json);
+	bool ValidatePolicy();
+	void ApplyVerifiedPolicy(const VerifiedPolicy &verified_policy);
 	bool MakeSignature(const ov::String &base_url, const ov::String &secret_key, ov::String &signature_base64);
 
+	static ov::LruCache<ov::String, std::shared_ptr<const VerifiedPolicy>> &GetVerifiedPolicyCache();
+	// Returns an empty key if the policy cannot be cached
+	static ov::String MakeCacheKey(const ov::String &secret_key_id, const ov::String &base_url, const ov::String &signature);
+	static std::shared_ptr<const VerifiedPolicy> FindVerifiedPolicy(const ov::String &cache_key);
+	void StoreVerifiedPolicy(const ov::String &cache_key) const;
+
 private:
 	ErrCode	_error_code = ErrCode::INIT;
 	ov::String _error_message;
@@ -0,0 +1,406 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "fmp4_dvr_store.h"
+
+#include <base/ovlibrary/directory.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "fmp4_private.h"
+
+// Warns if the writer cannot keep up with the segments
+#define FMP4_DVR_WRITER_QUEUE_WARNING_SIZE 100
+#define FMP4_DVR_WRITER_WARNING_INTERVAL_MS 5000
+// Segments are dropped from DVR if this many tasks are waiting
+#define FMP4_DVR_WRITER_QUEUE_MAX_SIZE 500
+
+namespace bmff
+{
+	FMP4DvrWriter::~FMP4DvrWriter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+
+		_condition.notify_all();
+
+		if (_thread.joinable())
+		{
+			_thread.join();
+		}
+	}
+
+	bool FMP4DvrWriter::Post(Task task, bool droppable)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (_running == false)
+			{
+				if (_stop)
+				{
+					return false;
+				}
+
+				_running = true;
+				_thread = std::thread(&FMP4DvrWriter::WorkerThread, this);
+				pthread_setname_np(_thread.native_handle(), "DvrWriter");
+			}
+
+			if (droppable && (_tasks.size() >= FMP4_DVR_WRITER_QUEUE_MAX_SIZE))
+			{
+				auto now_ms = ov::Clock::NowMSec();
+				_dropped_count++;
+
+				if ((now_ms - _last_drop_warning_time_ms) > FMP4_DVR_WRITER_WARNING_INTERVAL_MS)
+				{
+					logtw("DVR writer queue is full: %zu segments have been dropped from DVR. The DVR storage may be too slow.", _dropped_count);
+					_last_drop_warning_time_ms = now_ms;
+					_dropped_count = 0;
+				}
+
+				return false;
+			}
+
+			_tasks.push_back(std::move(task));
+
+			if (_tasks.size() > FMP4_DVR_WRITER_QUEUE_WARNING_SIZE)
+			{
+				auto now_ms = ov::Clock::NowMSec();
+
+				if ((now_ms - _last_warning_time_ms) > FMP4_DVR_WRITER_WARNING_INTERVAL_MS)
+				{
+					logtw("DVR writer is delayed: %zu tasks are waiting. The DVR storage may be too slow.", _tasks.size());
+					_last_warning_time_ms = now_ms;
+				}
+			}
+		}
+
+		_condition.notify_one();
+
+		return true;
+	}
+
+	void FMP4DvrWriter::WorkerThread()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		while (true)
+		{
+			_condition.wait(lock, [this]() { return _stop || (_tasks.empty() == false); });
+
+			// The queued tasks are processed before exiting, so the segments/directories of the closed stores are deleted
+			if (_stop && _tasks.empty())
+			{
+				break;
+			}
+
+			auto task = std::move(_tasks.front());
+			_tasks.pop_front();
+
+			lock.unlock();
+			task();
+			// Release the references of the task before taking the lock again
+			task = nullptr;
+			lock.lock();
+		}
+	}
+
+	FMP4DvrStore::LogFile::~LogFile()
+	{
+		if (fd != -1)
+		{
+			::close(fd);
+		}
+	}
+
+	FMP4DvrStore::FMP4DvrStore(const ov::String &directory)
+		: _directory(directory)
+	{
+	}
+
+	FMP4DvrStore::~FMP4DvrStore()
+	{
+		logtd("DVR store has been terminated: %s", _directory.CStr());
+	}
+
+	void FMP4DvrStore::Append(uint32_t segment_number, const std::shared_ptr<ov::Data> &data)
+	{
+		if (_closed)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_index_mutex);
+			_pending_segments[segment_number] = data;
+		}
+
+		auto posted = FMP4DvrWriter::GetInstance()->Post(
+			[self = GetSharedPtr(), segment_number, data]() {
+				self->Write(segment_number, data);
+			},
+			true);
+
+		if (posted == false)
+		{
+			// The segment is not available from DVR
+			std::lock_guard<std::mutex> lock(_index_mutex);
+			_pending_segments.erase(segment_number);
+		}
+	}
+
+	void FMP4DvrStore::Remove(uint32_t segment_number)
+	{
+		std::lock_guard<std::mutex> lock(_index_mutex);
+
+		// The writer skips the segment
+		if (_pending_segments.erase(segment_number) > 0)
+		{
+			return;
+		}
+
+		auto item = _segments.find(segment_number);
+		if (item == _segments.end())
+		{
+			return;
+		}
+
+		auto log_file = item->second.log_file;
+		_segments.erase(item);
+		_hot_segments.Remove(segment_number);
+
+		log_file->stored_segment_count--;
+		DeleteLogFileIfNeeded(log_file);
+	}
+
+	std::shared_ptr<ov::Data> FMP4DvrStore::Read(uint32_t segment_number)
+	{
+		SegmentLocation location;
+
+		{
+			std::lock_guard<std::mutex> lock(_index_mutex);
+
+			auto pending_item = _pending_segments.find(segment_number);
+			if (pending_item != _pending_segments.end())
+			{
+				return pending_item->second;
+			}
+
+			auto item = _segments.find(segment_number);
+			if (item == _segments.end())
+			{
+				return nullptr;
+			}
+
+			location = item->second;
+		}
+
+		std::shared_ptr<ov::Data> data;
+		if (_hot_segments.Get(segment_number, &data))
+		{
+			return data;
+		}
+
+		// The log file stays open while it is referenced, even if it is deleted in the meantime
+		data = std::make_shared<ov::Data>(location.length);
+		data->SetLength(location.length);
+
+		auto buffer = data->GetWritableDataAs<uint8_t>();
+		size_t read_bytes = 0;
+
+		while (read_bytes < location.length)
+		{
+			auto result = ::pread(location.log_file->fd, buffer + read_bytes, location.length - read_bytes, location.offset + read_bytes);
+
+			if (result < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				logte("Could not read DVR segment %u from %s: %s", segment_number, location.log_file->path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+				return nullptr;
+			}
+
+			if (result == 0)
+			{
+				logte("Could not read DVR segment %u from %s: unexpected end of file", segment_number, location.log_file->path.CStr());
+				return nullptr;
+			}
+
+			read_bytes += result;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_index_mutex);
+
+			// Do not cache the segment if it was removed while it was read
+			auto item = _segments.find(segment_number);
+			if ((item != _segments.end()) && (item->second.log_file == location.log_file))
+			{
+				_hot_segments.Set(segment_number, data);
+			}
+		}
+
+		return data;
+	}
+
+	void FMP4DvrStore::Close()
+	{
+		if (_closed.exchange(true))
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_index_mutex);
+
+			_pending_segments.clear();
+			_segments.clear();
+		}
+
+		_hot_segments.Clear();
+
+		FMP4DvrWriter::GetInstance()->Post([self = GetSharedPtr()]() {
+			self->_current_log_file = nullptr;
+
+			logti("Try to delete directory for LLHLS DVR: %s", self->_directory.CStr());
+			ov::DeleteDirectories(self->_directory);
+			logti("Successfully deleted directory for LLHLS DVR: %s", self->_directory.CStr());
+		});
+	}
+
+	void FMP4DvrStore::Write(uint32_t segment_number, const std::shared_ptr<ov::Data> &data)
+	{
+		if (_closed)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_index_mutex);
+
+			if (_pending_segments.find(segment_number) == _pending_segments.end())
+			{
+				// Expired before it is written
+				return;
+			}
+		}
+
+		if ((_current_log_file == nullptr) && (OpenLogFile() == false))
+		{
+			std::lock_guard<std::mutex> lock(_index_mutex);
+			_pending_segments.erase(segment_number);
+			return;
+		}
+
+		auto log_file = _current_log_file;
+		const off_t offset = log_file->size;
+		auto buffer = data->GetDataAs<uint8_t>();
+		const size_t length = data->GetLength();
+		size_t written_bytes = 0;
+
+		while (written_bytes < length)
+		{
+			auto result = ::pwrite(log_file->fd, buffer + written_bytes, length - written_bytes, offset + written_bytes);
+
+			if (result < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				logte("Could not write DVR segment %u to %s: %s", segment_number, log_file->path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+
+				std::lock_guard<std::mutex> lock(_index_mutex);
+				_pending_segments.erase(segment_number);
+				return;
+			}
+
+			written_bytes += result;
+		}
+
+		log_file->size += length;
+		log_file->segment_count++;
+
+		{
+			std::lock_guard<std::mutex> lock(_index_mutex);
+
+			// The segment may have expired while it was written
+			if (_pending_segments.erase(segment_number) > 0)
+			{
+				_segments[segment_number] = {log_file, offset, length};
+				log_file->stored_segment_count++;
+			}
+		}
+
+		if ((log_file->segment_count >= FMP4_DVR_LOG_FILE_MAX_SEGMENT_COUNT) || (log_file->size >= FMP4_DVR_LOG_FILE_MAX_SIZE))
+		{
+			SealLogFile();
+		}
+	}
+
+	bool FMP4DvrStore::OpenLogFile()
+	{
+		if (ov::IsDirExist(_directory) == false)
+		{
+			logti("Try to create directory for LLHLS DVR: %s", _directory.CStr());
+			if (ov::CreateDirectories(_directory) == false)
+			{
+				logte("Could not create directory for DVR: %s", _directory.CStr());
+				return false;
+			}
+		}
+
+		auto log_file = std::make_shared<LogFile>();
+		log_file->path = ov::String::FormatString("%s/%u.log", _directory.CStr(), _next_log_file_number);
+		log_file->fd = ::open(log_file->path.CStr(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+		if (log_file->fd == -1)
+		{
+			logte("Could not open DVR log file: %s (%s)", log_file->path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		_next_log_file_number++;
+		_current_log_file = log_file;
+
+		return true;
+	}
+
+	void FMP4DvrStore::SealLogFile()
+	{
+		std::lock_guard<std::mutex> lock(_index_mutex);
+
+		_current_log_file->is_sealed = true;
+		DeleteLogFileIfNeeded(_current_log_file);
+
+		_current_log_file = nullptr;
+	}
+
+	void FMP4DvrStore::DeleteLogFileIfNeeded(const std::shared_ptr<LogFile> &log_file)
+	{
+		// The log file that is being written is deleted after it is sealed
+		if ((log_file->is_sealed == false) || (log_file->stored_segment_count > 0))
+		{
+			return;
+		}
+
+		FMP4DvrWriter::GetInstance()->Post([path = log_file->path]() {
+			if (::unlink(path.CStr()) != 0)
+			{
+				logte("Could not delete DVR log file: %s", path.CStr());
+			}
+		});
+	}
+}  // namespace bmff
@@ -0,0 +1,124 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/lru_cache.h>
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+// A log file is closed when it has this many segments or bytes
+#define FMP4_DVR_LOG_FILE_MAX_SEGMENT_COUNT 10
+#define FMP4_DVR_LOG_FILE_MAX_SIZE (64 * 1024 * 1024)
+// Number of segments read from the log files to keep in memory for each track
+#define FMP4_DVR_HOT_SEGMENT_CACHE_COUNT 4
+
+namespace bmff
+{
+	// Performs the file operations of all DVR stores on a background thread,
+	// so a slow disk does not delay packaging.
+	// The tasks are processed in order, so the operations of a store never overtake each other.
+	// The tasks that are queued when the writer is destroyed are processed before the thread exits.
+	// The droppable tasks (segment writes) are rejected while the queue is full,
+	// so the memory is not exhausted if the disk cannot keep up.
+	class FMP4DvrWriter : public ov::Singleton<FMP4DvrWriter>
+	{
+	public:
+		using Task = std::function<void()>;
+
+		~FMP4DvrWriter() override;
+
+		// Returns false if the task is droppable and the queue is full
+		bool Post(Task task, bool droppable = false);
+
+	private:
+		void WorkerThread();
+
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::deque<Task> _tasks;
+
+		bool _running = false;
+		bool _stop = false;
+		std::thread _thread;
+
+		int64_t _last_warning_time_ms = 0;
+		int64_t _last_drop_warning_time_ms = 0;
+		size_t _dropped_count = 0;
+	};
+
+	// Stores the DVR segments of a track.
+	//
+	// Segments are appended to log files with an in-memory index instead of a file per segment,
+	// and the oldest log file is deleted as a whole when all of its segments have expired.
+	// Writes and deletions are done by FMP4DvrWriter. Segments are read from memory until they are written.
+	class FMP4DvrStore : public ov::EnableSharedFromThis<FMP4DvrStore>
+	{
+	public:
+		explicit FMP4DvrStore(const ov::String &directory);
+		~FMP4DvrStore() override;
+
+		// The data must not be modified after it is appended
+		void Append(uint32_t segment_number, const std::shared_ptr<ov::Data> &data);
+		void Remove(uint32_t segment_number);
+		std::shared_ptr<ov::Data> Read(uint32_t segment_number);
+
+		// Discards the segments and deletes the directory
+		void Close();
+
+	private:
+		struct LogFile
+		{
+			~LogFile();
+
+			ov::String path;
+			int fd = -1;
+
+			// Accessed by the writer only
+			size_t size = 0;
+			size_t segment_count = 0;
+
+			// Protected by _index_mutex
+			size_t stored_segment_count = 0;
+			bool is_sealed = false;
+		};
+
+		struct SegmentLocation
+		{
+			std::shared_ptr<LogFile> log_file;
+			off_t offset = 0;
+			size_t length = 0;
+		};
+
+		// Called by the writer
+		void Write(uint32_t segment_number, const std::shared_ptr<ov::Data> &data);
+		bool OpenLogFile();
+		void SealLogFile();
+
+		// Must be called with _index_mutex locked
+		void DeleteLogFileIfNeeded(const std::shared_ptr<LogFile> &log_file);
+
+		ov::String _directory;
+		std::atomic<bool> _closed = false;
+
+		// Accessed by the writer only
+		std::shared_ptr<LogFile> _current_log_file;
+		uint32_t _next_log_file_number = 0;
+
+		std::mutex _index_mutex;
+		// Segments waiting for the writer
+		std::map<uint32_t, std::shared_ptr<ov::Data>> _pending_segments;
+		std::map<uint32_t, SegmentLocation> _segments;
+
+		ov::LruCache<uint32_t, std::shared_ptr<ov::Data>> _hot_segments{FMP4_DVR_HOT_SEGMENT_CACHE_COUNT};
+	};
+}  // namespace bmff
@@ -8,7 +8,6 @@
 //==============================================================================
 
 #include <base/info/media_track.h>
-#include <base/ovlibrary/directory.h>
 
 #include "fmp4_storage.h"
 #include "fmp4_private.h"
@@ -31,18 +30,19 @@ namespace bmff
 			// last segment number = current epoch time / segment duration
 			_initial_segment_number = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() / _target_segment_duration_ms;
 		}
+
+		if (_config.dvr_enabled == true)
+		{
+			_dvr_store = std::make_shared<FMP4DvrStore>(GetDVRDirectory());
+		}
 	}
 
 	FMP4Storage::~FMP4Storage()
 	{
-		if (_config.dvr_enabled == true)
+		if (_dvr_store != nullptr)
 		{
 			// Delete all dvr directory and files
-			auto dvr_path = GetDVRDirectory();
-
-			logti("Try to delete directory for LLHLS DVR: %s", dvr_path.CStr());
-			ov::DeleteDirectories(dvr_path);
-			logti("Successfully deleted directory for LLHLS DVR: %s", dvr_path.CStr());
+			_dvr_store->Close();
 		}
 
 		logtd("FMP4 Storage has been terminated successfully");
@@ -173,39 +173,15 @@ namespace bmff
 		return ov::String::FormatString("%s/%s/%d", _config.dvr_storage_path.CStr(), _stream_tag.CStr(), _track->GetId());
 	}
 
-	ov::String FMP4Storage::GetSegmentFilePath(uint32_t segment_number) const
-	{
-		return ov::String::FormatString("%s/%d.m4s", GetDVRDirectory().CStr(), segment_number);
-	}
-
 	bool FMP4Storage::SaveMediaSegmentToFile(const std::shared_ptr<FMP4Segment> &segment)
 	{
-		if (_config.dvr_enabled == false)
+		if (_dvr_store == nullptr)
 		{
 			return false;
 		}
 
-		// Save to file
-		auto file_path = GetSegmentFilePath(segment->GetNumber());
-		auto dir = GetDVRDirectory();
-
-		// Create directory
-		if (ov::IsDirExist(dir) == false)
-		{
-			logti("Try to create directory for LLHLS DVR: %s", dir.CStr());
-			if (ov::CreateDirectories(dir) == false)
-			{
-				logte("Could not create directory for DVR: %s", dir.CStr());
-				return false;
-			}
-		}
-
-		// Save to file
-		if (ov::DumpToFile(file_path, segment->GetData()) == nullptr)
-		{
-			logte("Could not save segment to file: %s", file_path.CStr());
-			return false;
-		}
+		// The segment is written in the background
+		_dvr_store->Append(segment->GetNumber(), segment->GetData());
 
 		_dvr_info.AppendSegment(segment->GetNumber(), segment->GetDuration(), segment->GetData()->GetLength());
 
@@ -218,11 +194,7 @@ namespace bmff
 				break;
 			}
 
-			auto file_path = GetSegmentFilePath(segment_to_delete.segment_number);
-			if (std::remove(file_path) != 0)
-			{
-				logte("Could not delete DVR segment file: %s", file_path.CStr());
-			}
+			_dvr_store->Remove(segment_to_delete.segment_number);
 
 			if (_observer != nullptr)
 			{
@@ -235,7 +207,7 @@ namespace bmff
 
 	std::shared_ptr<FMP4Segment> FMP4Storage::LoadMediaSegmentFromFile(uint32_t segment_number) const
 	{
-		if (_config.dvr_enabled == false)
+		if (_dvr_store == nullptr)
 		{
 			return nullptr;
 		}
@@ -247,12 +219,10 @@ namespace bmff
 			return nullptr;
 		}
 
-		auto file_path = GetSegmentFilePath(segment_number);
-
-		auto data = ov::LoadFromFile(file_path);
+		auto data = _dvr_store->Read(segment_number);
 		if (data == nullptr)
 		{
-			logte("Could not load segment from file: %s", file_path.CStr());
+			logte("Could not load segment from DVR storage: %u", segment_number);
 			return nullptr;
 		}
 
@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include "fmp4_dvr_store.h"
 #include "fmp4_structure.h"
 
 namespace bmff
@@ -156,8 +157,9 @@ namespace bmff
 
 		DvrInfo _dvr_info;
 
+		std::shared_ptr<FMP4DvrStore> _dvr_store;
+
 		ov::String GetDVRDirectory() const;
-		ov::String GetSegmentFilePath(uint32_t segment_number) const;
 		bool SaveMediaSegmentToFile(const std::shared_ptr<FMP4Segment> &segment);
 		std::shared_ptr<FMP4Segment> LoadMediaSegmentFromFile(uint32_t segment_number) const;
 
@@ -0,0 +1,220 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "dtls_handshake_pool.h"
+
+#define OV_LOG_TAG "DTLS"
+
+#define DTLS_HANDSHAKE_STATISTICS_LOG_INTERVAL_MS 10000
+
+DtlsHandshakePool::~DtlsHandshakePool()
+{
+	Stop();
+}
+
+bool DtlsHandshakePool::Start(int worker_count, int max_handshakes_per_second, size_t max_pending_handshakes)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_running)
+	{
+		return true;
+	}
+
+	worker_count = std::max(worker_count, 1);
+
+	_max_pending_handshakes = max_pending_handshakes;
+	_max_handshakes_per_second = std::max(max_handshakes_per_second, 0);
+	_tokens = _max_handshakes_per_second;
+	_last_refill_time_ms = static_cast<int64_t>(ov::Clock::NowMSec());
+	_last_log_time_ms = _last_refill_time_ms;
+
+	_running = true;
+
+	for (int index = 0; index < worker_count; index++)
+	{
+		_workers.emplace_back(&DtlsHandshakePool::WorkerThread, this);
+		pthread_setname_np(_workers.back().native_handle(), "DtlsHandshake");
+	}
+
+	logti("DTLS handshake pool is started (workers: %d, max handshakes per second: %d, max pending handshakes: %zu)",
+		  worker_count, _max_handshakes_per_second, _max_pending_handshakes);
+
+	return true;
+}
+
+bool DtlsHandshakePool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_running == false)
+		{
+			return true;
+		}
+
+		_running = false;
+	}
+
+	_condition.notify_all();
+
+	for (auto &worker : _workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_workers.clear();
+	_new_handshake_queue.clear();
+	_admitted_queue.clear();
+
+	return true;
+}
+
+bool DtlsHandshakePool::PostNewHandshake(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_running == false)
+		{
+			return false;
+		}
+
+		if ((_max_pending_handshakes > 0) && (_new_handshake_queue.size() >= _max_pending_handshakes))
+		{
+			// The peer retransmits the flight later
+			_statistics.rejected_count++;
+			return false;
+		}
+
+		_new_handshake_queue.push_back({std::move(task), static_cast<int64_t>(ov::Clock::NowMSec())});
+	}
+
+	_condition.notify_one();
+
+	return true;
+}
+
+bool DtlsHandshakePool::Post(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_running == false)
+		{
+			return false;
+		}
+
+		_admitted_queue.push_back({std::move(task), static_cast<int64_t>(ov::Clock::NowMSec())});
+	}
+
+	_condition.notify_one();
+
+	return true;
+}
+
+int64_t DtlsHandshakePool::TryAdmit(int64_t now_ms)
+{
+	if (_max_handshakes_per_second <= 0)
+	{
+		return 0;
+	}
+
+	// Allows a burst of up to one second
+	_tokens = std::min<double>(_max_handshakes_per_second, _tokens + (now_ms - _last_refill_time_ms) * _max_handshakes_per_second / 1000.0);
+	_last_refill_time_ms = now_ms;
+
+	if (_tokens >= 1.0)
+	{
+		_tokens -= 1.0;
+		return 0;
+	}
+
+	return std::max<int64_t>(1, static_cast<int64_t>((1.0 - _tokens) * 1000.0 / _max_handshakes_per_second));
+}
+
+void DtlsHandshakePool::LogStatisticsIfNeeded(int64_t now_ms)
+{
+	if ((now_ms - _last_log_time_ms) < DTLS_HANDSHAKE_STATISTICS_LOG_INTERVAL_MS)
+	{
+		return;
+	}
+
+	const auto processed_count = _statistics.processed_count - _last_logged_statistics.processed_count;
+	const auto rejected_count = _statistics.rejected_count - _last_logged_statistics.rejected_count;
+
+	if ((processed_count > 0) || (rejected_count > 0))
+	{
+		const auto queue_time_ms = _statistics.total_queue_time_ms - _last_logged_statistics.total_queue_time_ms;
+
+		logti("DTLS handshake flights - processed: %" PRIu64 ", rejected: %" PRIu64 ", avg queue time: %.1f ms, max queue time: %" PRId64 " ms, pending: %zu",
+			  processed_count, rejected_count,
+			  (processed_count > 0) ? (static_cast<double>(queue_time_ms) / processed_count) : 0.0,
+			  _max_queue_time_ms_in_interval,
+			  _new_handshake_queue.size());
+	}
+
+	_last_logged_statistics = _statistics;
+	_max_queue_time_ms_in_interval = 0;
+	_last_log_time_ms = now_ms;
+}
+
+void DtlsHandshakePool::WorkerThread()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (_running)
+	{
+		const int64_t now_ms = static_cast<int64_t>(ov::Clock::NowMSec());
+
+		LogStatisticsIfNeeded(now_ms);
+
+		Item item;
+
+		if (_admitted_queue.empty() == false)
+		{
+			item = std::move(_admitted_queue.front());
+			_admitted_queue.pop_front();
+		}
+		else if (_new_handshake_queue.empty() == false)
+		{
+			auto wait_ms = TryAdmit(now_ms);
+
+			if (wait_ms > 0)
+			{
+				_condition.wait_for(lock, std::chrono::milliseconds(wait_ms));
+				continue;
+			}
+
+			item = std::move(_new_handshake_queue.front());
+			_new_handshake_queue.pop_front();
+		}
+		else
+		{
+			_condition.wait_for(lock, std::chrono::milliseconds(DTLS_HANDSHAKE_STATISTICS_LOG_INTERVAL_MS));
+			continue;
+		}
+
+		const int64_t queue_time_ms = now_ms - item.posted_time_ms;
+		_statistics.processed_count++;
+		_statistics.total_queue_time_ms += queue_time_ms;
+		_statistics.max_queue_time_ms = std::max(_statistics.max_queue_time_ms, queue_time_ms);
+		_max_queue_time_ms_in_interval = std::max(_max_queue_time_ms_in_interval, queue_time_ms);
+
+		lock.unlock();
+		item.task();
+		// Release the references of the task before taking the lock again
+		item.task = nullptr;
+		lock.lock();
+	}
+}
@@ -0,0 +1,91 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+// Processes DTLS handshakes on dedicated threads.
+//
+// Signing and key exchange are expensive, and a reconnect burst of thousands of sessions
+// would stall the media of every session if they were processed by the threads that deliver media.
+// New handshakes are admitted at a limited rate, and the flights of admitted handshakes are processed first
+// so that a handshake that has started finishes as soon as possible.
+class DtlsHandshakePool : public ov::Singleton<DtlsHandshakePool>
+{
+public:
+	using Task = std::function<void()>;
+
+	~DtlsHandshakePool() override;
+
+	// max_handshakes_per_second: 0 means unlimited
+	bool Start(int worker_count, int max_handshakes_per_second, size_t max_pending_handshakes);
+	bool Stop();
+
+	bool IsRunning() const
+	{
+		return _running;
+	}
+
+	// Posts the first flight of a handshake. Returns false if too many handshakes are waiting for admission.
+	bool PostNewHandshake(Task task);
+	// Posts the subsequent flights of an admitted handshake
+	bool Post(Task task);
+
+private:
+	struct Statistics
+	{
+		uint64_t processed_count = 0;
+		// New handshakes dropped because too many handshakes were waiting
+		uint64_t rejected_count = 0;
+
+		// Time from the post to the start of processing
+		int64_t total_queue_time_ms = 0;
+		int64_t max_queue_time_ms = 0;
+	};
+
+	struct Item
+	{
+		Task task;
+		int64_t posted_time_ms = 0;
+	};
+
+	void WorkerThread();
+	// Returns 0 if a new handshake can be admitted now, or the time to wait in milliseconds.
+	// Must be called with _mutex locked.
+	int64_t TryAdmit(int64_t now_ms);
+	// Must be called with _mutex locked
+	void LogStatisticsIfNeeded(int64_t now_ms);
+
+	std::atomic<bool> _running = false;
+	std::vector<std::thread> _workers;
+
+	std::mutex _mutex;
+	std::condition_variable _condition;
+
+	std::deque<Item> _new_handshake_queue;
+	std::deque<Item> _admitted_queue;
+
+	size_t _max_pending_handshakes = 0;
+
+	// Token bucket for admission
+	int _max_handshakes_per_second = 0;
+	double _tokens = 0.0;
+	int64_t _last_refill_time_ms = 0;
+
+	Statistics _statistics;
+	Statistics _last_logged_statistics;
+	// Max queue time since the last log
+	int64_t _max_queue_time_ms_in_interval = 0;
+	int64_t _last_log_time_ms = 0;
+};
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <utility>
 
+#include "dtls_handshake_pool.h"
+
 #define OV_LOG_TAG "DTLS"
 
 DtlsTransport::DtlsTransport()
@@ -249,35 +251,16 @@ bool DtlsTransport::OnDataReceivedFromNextNode(NodeType from_node, const std::sh
 		case SSL_CONNECTED: {
 			if (IsDtlsPacket(data))
 			{
-				std::lock_guard<std::mutex> lock(_tls_lock);
 				logtd("Receive DTLS packet");
-				// Packet을 Queue에 쌓는다.
-				SaveDtlsPacket(data);
 
-				if (_state == SSL_CONNECTING)
+				// Handshakes are expensive, so they are processed by the handshake threads not to delay media
+				if ((_state == SSL_CONNECTING) && DtlsHandshakePool::GetInstance()->IsRunning())
 				{
-					ContinueSSL();
+					return PostHandshakePacket(data);
 				}
-				else
-				{
-					char buffer[MAX_DTLS_PACKET_LEN];
-
-					// SSL -> Read() -> TakeDtlsPacket() -> Decrypt -> buffer
-					[[maybe_unused]] int ssl_error = _tls.Read(buffer, sizeof(buffer), nullptr);
-
-					int pending = _tls.Pending();
-					if (pending >= 0)
-					{
-						logtd("Short DTLS read. Flushing %d bytes", pending);
-						_tls.FlushInput();
-					}
 
-					// TODO: Currently, SCTP is not supported, so there is no need to encrypt,
-					// and it will be developed if it supports data channels in the future.
-					logtd("Unknown dtls packet received (%d)", ssl_error);
-				}
-
-				return true;
+				std::lock_guard<std::mutex> lock(_tls_lock);
+				return ProcessDtlsPacket(data);
 			}
 			// SRTP or SRTCP will be input here. However, since OME does not receive media,
 			// SRTP cannot be input, only SRTCP can be input.
@@ -297,6 +280,119 @@ bool DtlsTransport::OnDataReceivedFromNextNode(NodeType from_node, const std::sh
 	return false;
 }
 
+bool DtlsTransport::ProcessDtlsPacket(const std::shared_ptr<const ov::Data> &data)
+{
+	// Packet을 Queue에 쌓는다.
+	SaveDtlsPacket(data);
+
+	if (_state == SSL_CONNECTING)
+	{
+		ContinueSSL();
+	}
+	else
+	{
+		char buffer[MAX_DTLS_PACKET_LEN];
+
+		// SSL -> Read() -> TakeDtlsPacket() -> Decrypt -> buffer
+		[[maybe_unused]] int ssl_error = _tls.Read(buffer, sizeof(buffer), nullptr);
+
+		int pending = _tls.Pending();
+		if (pending >= 0)
+		{
+			logtd("Short DTLS read. Flushing %d bytes", pending);
+			_tls.FlushInput();
+		}
+
+		// TODO: Currently, SCTP is not supported, so there is no need to encrypt,
+		// and it will be developed if it supports data channels in the future.
+		logtd("Unknown dtls packet received (%d)", ssl_error);
+	}
+
+	return true;
+}
+
+bool DtlsTransport::PostHandshakePacket(const std::shared_ptr<const ov::Data> &data)
+{
+	bool admitted;
+
+	{
+		std::lock_guard<std::mutex> lock(_handshake_lock);
+
+		if (_handshake_packets.size() >= MAX_PENDING_HANDSHAKE_PACKETS)
+		{
+			logtd("Too many handshake packets are pending, the packet is dropped");
+			return false;
+		}
+
+		_handshake_packets.push_back(data);
+
+		if (_handshake_scheduled)
+		{
+			// The packet is processed by the task already posted
+			return true;
+		}
+
+		_handshake_scheduled = true;
+		admitted = _handshake_admitted;
+	}
+
+	auto pool = DtlsHandshakePool::GetInstance();
+	auto self = GetSharedPtrAs<DtlsTransport>();
+	auto task = [self]() {
+		self->ProcessHandshakePackets();
+	};
+
+	if (admitted ? pool->Post(std::move(task)) : pool->PostNewHandshake(std::move(task)))
+	{
+		return true;
+	}
+
+	// The peer retransmits the flight
+	logtd("Could not post the handshake, the flight is dropped");
+
+	std::lock_guard<std::mutex> lock(_handshake_lock);
+	_handshake_packets.clear();
+	_handshake_scheduled = false;
+
+	return false;
+}
+
+void DtlsTransport::ProcessHandshakePackets()
+{
+	while (true)
+	{
+		std::shared_ptr<const ov::Data> data;
+
+		{
+			std::lock_guard<std::mutex> lock(_handshake_lock);
+
+			_handshake_admitted = true;
+
+			if (_handshake_packets.empty())
+			{
+				_handshake_scheduled = false;
+				return;
+			}
+
+			data = _handshake_packets.front();
+			_handshake_packets.pop_front();
+		}
+
+		std::lock_guard<std::mutex> lock(_tls_lock);
+
+		// Stopped while waiting in the pool
+		if (GetNodeState() != ov::Node::NodeState::Started)
+		{
+			continue;
+		}
+
+		if ((_state == SSL_CONNECTING) || (_state == SSL_CONNECTED))
+		{
+			ProcessDtlsPacket(data);
+		}
+	}
+}
+
 ssize_t DtlsTransport::Read(ov::Tls *tls, void *buffer, size_t length)
 {
 	std::shared_ptr<const ov::Data> data = TakeDtlsPacket();
@@ -10,6 +10,8 @@
 #define DTLS_RECORD_HEADER_LEN                  13
 #define MAX_DTLS_PACKET_LEN                     2048
 #define MIN_RTP_PACKET_LEN                      12
+// Handshake packets of a session waiting for DtlsHandshakePool
+#define MAX_PENDING_HANDSHAKE_PACKETS           32
 
 class DtlsTransport : public ov::Node
 {
@@ -56,6 +58,12 @@ protected:
 
 private:
 	bool ContinueSSL();
+	// Must be called with _tls_lock locked
+	bool ProcessDtlsPacket(const std::shared_ptr<const ov::Data> &data);
+	// Hands the handshake packet over to DtlsHandshakePool
+	bool PostHandshakePacket(const std::shared_ptr<const ov::Data> &data);
+	// Called by a thread of DtlsHandshakePool
+	void ProcessHandshakePackets();
 	bool IsDtlsPacket(const std::shared_ptr<const ov::Data> data);
 	bool IsRtpPacket(const std::shared_ptr<const ov::Data> data);
 	bool SaveDtlsPacket(const std::shared_ptr<const ov::Data> data);
@@ -73,7 +81,8 @@ private:
 		SSL_CLOSED
 	};
 
-	SSLState _state;
+	// Changed by the handshake thread while the media threads check it
+	std::atomic<SSLState> _state;
 	bool _peer_certificate_verified;
 	std::shared_ptr<info::Session> _session_info;
 	std::shared_ptr<IcePort> _ice_port;
@@ -92,5 +101,12 @@ private:
 
 	std::mutex _tls_lock;
 
+	std::mutex _handshake_lock;
+	std::deque<std::shared_ptr<const ov::Data>> _handshake_packets;
+	// Whether ProcessHandshakePackets() is posted to DtlsHandshakePool
+	bool _handshake_scheduled = false;
+	// Whether the first flight has been admitted by DtlsHandshakePool
+	bool _handshake_admitted = false;
+
 	ov::Tls _tls;
 };
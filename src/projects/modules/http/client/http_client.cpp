@@ -67,6 +67,23 @@ namespace http
 			return _recv_timeout_msec;
 		}
 
+		void HttpClient::SetKeepAlive(bool keep_alive)
+		{
+			_keep_alive = keep_alive;
+		}
+
+		bool HttpClient::IsKeepAlive() const
+		{
+			return _keep_alive;
+		}
+
+		bool HttpClient::IsReusable() const
+		{
+			auto socket = _socket;
+
+			return _keep_alive && (socket != nullptr) && (socket->GetState() == ov::SocketState::Connected);
+		}
+
 		void HttpClient::SetMethod(http::Method method)
 		{
 			_method = method;
@@ -248,6 +265,21 @@ namespace http
 				parsed_url->SetPort(port);
 			}
 
+			if (CanReuseConnection(parsed_url))
+			{
+				// Reuse the connection of the previous request
+				_url = url;
+				_parsed_url = parsed_url;
+
+				return nullptr;
+			}
+
+			if (_socket != nullptr)
+			{
+				// The connection cannot be reused (closed by peer or connected to another host)
+				CleanupVariables();
+			}
+
 			auto host_port_string = ov::String::FormatString("%s:%d", parsed_url->Host().CStr(), port);
 			auto socket_address = ov::SocketAddress::CreateAndGetFirst(host_port_string);
 
@@ -372,10 +404,27 @@ namespace http
 
 			ov::SocketAddress address;
 
-			_response_handler = response_handler;
+			auto previous_socket = IsReusable() ? _socket : nullptr;
 
 			auto error = PrepareForRequest(url, &address);
 
+			// PrepareForRequest() can clean up the variables of the previous connection
+			_response_handler = response_handler;
+
+			if ((error == nullptr) && (previous_socket != nullptr) && (_socket == previous_socket))
+			{
+				logtd("Request an URL: %s (reuse connection: %s)...", url.CStr(), _socket->ToString().CStr());
+
+				SendRequestIfNeeded();
+
+				if (_socket->GetBlockingMode() == ov::BlockingMode::Blocking)
+				{
+					RecvResponse();
+				}
+
+				return;
+			}
+
 			if (error == nullptr)
 			{
 				OV_ASSERT2(_url.IsEmpty() == false);
@@ -408,6 +457,13 @@ namespace http
 			HandleError(error);
 		}
 
+		void HttpClient::Cancel()
+		{
+			std::lock_guard lock_guard(_request_mutex);
+
+			CleanupVariables();
+		}
+
 		ov::String HttpClient::GetResponseHeader(const ov::String &key)
 		{
 			return _parser.GetHeader(key);
@@ -504,13 +560,27 @@ namespace http
 			}
 
 			auto response_handler = _response_handler;
+			auto status_code = _parser.GetStatusCode();
+			auto response_body = _response_body;
 
-			if (response_handler != nullptr)
+			// The connection can be reused only if the end of the response was determined without closing the connection
+			auto reusable = _keep_alive && (error == nullptr) && (need_to_callback == false) &&
+							(_parser.GetHeader("CONNECTION").LowerCaseString() != "close");
+
+			// Clean up before calling the handler, so that the handler sees whether the connection can be reused
+			if (reusable)
 			{
-				response_handler(_parser.GetStatusCode(), _response_body, error);
+				ResetForNextRequest();
+			}
+			else
+			{
+				CleanupVariables();
 			}
 
-			CleanupVariables();
+			if (response_handler != nullptr)
+			{
+				response_handler(status_code, response_body, error);
+			}
 		}
 
 		std::shared_ptr<const ov::Error> HttpClient::ProcessChunk(const std::shared_ptr<const ov::Data> &data, size_t *processed_bytes)
@@ -760,6 +830,7 @@ namespace http
 			// Clean up variables
 			_url.Clear();
 			_parsed_url = nullptr;
+			_parsed_url_for_reuse = nullptr;
 			_response_handler = nullptr;
 
 			OV_SAFE_RESET(
@@ -771,6 +842,39 @@ namespace http
 			OV_SAFE_RESET(_socket, nullptr, _socket->Close(), _socket);
 		}
 
+		void HttpClient::ResetForNextRequest()
+		{
+			_url.Clear();
+			_parsed_url_for_reuse = _parsed_url;
+			_parsed_url = nullptr;
+			_response_handler = nullptr;
+			_requested = false;
+
+			_parser = prot::h1::HttpResponseParser();
+
+			_is_chunked_transfer = false;
+			_chunk_parse_status = ChunkParseStatus::None;
+			_chunk_length = 0L;
+			_chunk_header.Clear();
+
+			_is_header_found = false;
+			_response_string.Clear();
+			_response_header.clear();
+			_response_body = nullptr;
+		}
+
+		bool HttpClient::CanReuseConnection(const std::shared_ptr<const ov::Url> &parsed_url) const
+		{
+			if ((IsReusable() == false) || (_parsed_url_for_reuse == nullptr))
+			{
+				return false;
+			}
+
+			return (_parsed_url_for_reuse->Scheme().UpperCaseString() == parsed_url->Scheme().UpperCaseString()) &&
+				   (_parsed_url_for_reuse->Host() == parsed_url->Host()) &&
+				   (_parsed_url_for_reuse->Port() == parsed_url->Port());
+		}
+
 		void HttpClient::HandleError(std::shared_ptr<const ov::Error> error)
 		{
 			auto response_handler = _response_handler;
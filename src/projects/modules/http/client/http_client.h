@@ -47,6 +47,13 @@ namespace http
 
 			void SetTimeout(int timeout_msec);
 
+			// If keep-alive is enabled, the connection is not closed after the response is received,
+			// and the next Request() to the same scheme/host/port reuses it
+			void SetKeepAlive(bool keep_alive);
+			bool IsKeepAlive() const;
+			// Whether there is a connection that can be reused by the next Request()
+			bool IsReusable() const;
+
 			void SetMethod(http::Method method);
 			http::Method GetMethod() const;
 
@@ -64,6 +71,8 @@ namespace http
 			}
 
 			void Request(const ov::String &url, ResponseHandler response_handler);
+			// Closes the connection, and the response handler of the current request is not called
+			void Cancel();
 
 			// Response headers (Headers received from HTTP server)
 			ov::String GetResponseHeader(const ov::String &key);
@@ -118,6 +127,9 @@ namespace http
 
 			void PostProcess();
 			void CleanupVariables();
+			// Keeps the connection, and resets the variables for the next request
+			void ResetForNextRequest();
+			bool CanReuseConnection(const std::shared_ptr<const ov::Url> &parsed_url) const;
 
 			void HandleError(std::shared_ptr<const ov::Error> error);
 
@@ -130,6 +142,7 @@ namespace http
 			// Default: 60 seconds
 			int _recv_timeout_msec = 60 * 1000;
 			http::Method _method = http::Method::Get;
+			bool _keep_alive = false;
 
 			// Related to chunked transfer
 			bool _is_chunked_transfer = false;
@@ -147,6 +160,8 @@ namespace http
 
 			ov::String _url;
 			std::shared_ptr<ov::Url> _parsed_url;
+			// URL of the previous request, used to determine whether the connection can be reused
+			std::shared_ptr<const ov::Url> _parsed_url_for_reuse;
 			ResponseHandler _response_handler = nullptr;
 
 			std::shared_ptr<ov::Socket> _socket;
@@ -42,7 +42,13 @@ namespace http
 
 			ov::String GetKey() const
 			{
-				return (_name + _value);
+				// Neither name nor value can contain LF, so the key is unique for the pair
+				ov::String key;
+				key.SetCapacity(_name.GetLength() + _value.GetLength() + 1);
+				key.Append(_name.CStr(), _name.GetLength());
+				key.Append('\n');
+				key.Append(_value.CStr(), _value.GetLength());
+				return key;
 			}
 
 			size_t GetSize() const
@@ -7,6 +7,9 @@
 //
 //==============================================================================
 #include "encoder.h"
+
+#include <unordered_set>
+
 #include "huffman_codec.h"
 #include "hpack_private.h"
 
@@ -25,6 +28,21 @@ namespace http
 			return true;
 		}
 
+		bool Encoder::IsVolatileHeaderField(const ov::String &name)
+		{
+			static const std::unordered_set<ov::String, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> volatile_names{
+				"content-length",
+				"content-range",
+				"date",
+				"last-modified",
+				"etag",
+				"age",
+				"expires",
+				"set-cookie"};
+
+			return volatile_names.find(name) != volatile_names.end();
+		}
+
 		std::shared_ptr<ov::Data> Encoder::Encode(const HeaderField &header_fields, EncodingType type)
 		{
 			std::shared_ptr<ov::Data> encoded_data = std::make_shared<ov::Data>(header_fields.GetSize());
@@ -46,6 +64,12 @@ namespace http
 			// First check if the header field is in the table
 			auto [name_indexed, value_indexed, index] = _table_connector.LookupIndex(header_fields);
 
+			if ((type == EncodingType::LiteralWithIndexing) && IsVolatileHeaderField(header_fields.GetName()))
+			{
+				// It would only evict the reusable entries from the dynamic table
+				type = EncodingType::LiteralWithoutIndexing;
+			}
+
 			if (name_indexed == true && value_indexed == true)
 			{
 				result = EncodeIndexedHeaderField(stream, header_fields, index);
@@ -184,7 +208,7 @@ namespace http
 		bool Encoder::WriteInteger(ov::ByteStream &stream, uint8_t mask, uint8_t value_bits, uint64_t value)
 		{
 			uint8_t first_octet = mask;
-			uint8_t max_prefix_value = std::pow(2, value_bits) - 1;
+			uint8_t max_prefix_value = (1 << value_bits) - 1;
 			
 			if (value < max_prefix_value)
 			{
@@ -224,29 +248,27 @@ namespace http
 
 		bool Encoder::WriteString(ov::ByteStream &stream, const ov::String &value, bool huffman_encoding)
 		{
-			std::shared_ptr<ov::Data> data = nullptr;
+			auto huffman_codec = HuffmanCodec::GetInstance();
 
-			if (huffman_encoding == true)
+			// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
+			// Huffman encoding is optional, so the raw octets are used if the encoded string is not shorter
+			if ((huffman_encoding == true) && (huffman_codec->GetEncodedLength(value) < value.GetLength()))
 			{
-				data = HuffmanCodec::GetInstance()->Encode(value);
+				auto data = huffman_codec->Encode(value);
 				if (data == nullptr)
 				{
 					logte("Failed to encode string");
 					return false;
 				}
-			}
-			else
-			{
-				data = value.ToData(false);
-			}
 
-			// Write the length - 0x80 mask means string is Huffman Encoded
-			WriteInteger(stream, 0x80, 7, data->GetLength());
-			
-			// Write encoded string
-			stream.Write(data);
+				// Write the length - 0x80 mask means string is Huffman Encoded
+				WriteInteger(stream, 0x80, 7, data->GetLength());
+				// Write encoded string
+				return stream.Write(data);
+			}
 
-			return true;
+			WriteInteger(stream, 0x00, 7, value.GetLength());
+			return stream.Write(value.CStr(), value.GetLength());
 		}
 
 	} // namespace hpack
@@ -29,9 +29,14 @@ namespace http
 
 			bool UpdateDynamicTableSize(size_t size);
 
+			// If type is LiteralWithIndexing, the header fields whose values change on every response (e.g. content-length, date)
+			// are encoded without indexing, so that the dynamic table keeps the reusable fields (e.g. content-type, cache-control, CORS headers)
+			// and they are sent as a single index from the next response.
 			std::shared_ptr<ov::Data> Encode(const HeaderField &header_fields, EncodingType type);
 
 		private:
+			static bool IsVolatileHeaderField(const ov::String &name);
+
 			bool EncodeIndexedHeaderField(ov::ByteStream &stream, const HeaderField &header_fields, uint32_t index);
 			bool EncodeLiteralHeaderFieldWithIndexing(ov::ByteStream &stream, const HeaderField &header_fields, uint32_t name_index);
 			bool EncodeLiteralHeaderFieldWithoutIndexing(ov::ByteStream &stream, const HeaderField &header_fields, uint32_t name_index);
@@ -41,6 +46,7 @@ namespace http
 			
 			bool WriteLiteralHeaderField(ov::ByteStream &stream, const HeaderField &header_fields, uint32_t name_index, uint8_t mask, uint8_t index_bits, bool huffman_encoding = true);
 			bool WriteInteger(ov::ByteStream &stream, uint8_t mask, uint8_t value_bits, uint64_t value);
+			// If huffman_encoding is true, the string is Huffman encoded only if it gets shorter
 			bool WriteString(ov::ByteStream &stream, const ov::String &value, bool huffman_encoding);
 
 			// Unsigned Little Endian Base 128
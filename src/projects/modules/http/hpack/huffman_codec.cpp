@@ -7,7 +7,6 @@
 //
 //==============================================================================
 
-#include <base/ovlibrary/bit_reader.h>
 #include "huffman_codec.h"
 
 namespace http
@@ -16,6 +15,8 @@ namespace http
 	{
 		HuffmanCodec::HuffmanCodec()
 		{
+			_tree.emplace_back();
+
 			// https://www.rfc-editor.org/rfc/rfc7541.html#appendix-B
 			Build(0x1ff8, 13, 0);
 			Build(0x7fffd8, 23, 1);
@@ -274,142 +275,227 @@ namespace http
 			Build(0x7fffff0, 27, 254);
 			Build(0x3ffffee, 26, 255);
 			Build(0x3fffffff, 30, 256); //EOS
+
+			BuildDecodeTable();
+		}
+
+		size_t HuffmanCodec::GetEncodedLength(const ov::String &str) const
+		{
+			auto data = reinterpret_cast<const uint8_t *>(str.CStr());
+			auto length = str.GetLength();
+			size_t bit_length = 0;
+
+			for (size_t i = 0; i < length; i++)
+			{
+				bit_length += _codes[data[i]].length;
+			}
+
+			return (bit_length + 7) / 8;
 		}
 
-		std::shared_ptr<ov::Data> HuffmanCodec::Encode(const ov::String &str)
+		std::shared_ptr<ov::Data> HuffmanCodec::Encode(const ov::String &str) const
 		{
-			uint8_t out_data[str.GetLength() * 2];
+			auto encoded_length = GetEncodedLength(str);
+			auto encoded_data = std::make_shared<ov::Data>(encoded_length);
+			encoded_data->SetLength(encoded_length);
+
+			auto data = reinterpret_cast<const uint8_t *>(str.CStr());
+			auto length = str.GetLength();
+			auto out_data = encoded_data->GetWritableDataAs<uint8_t>();
 			size_t out_data_size = 0;
 
+			// Codes are up to 30 bits, so the bit buffer never has more than 37 valid bits
 			uint64_t bit_buffer = 0;
 			size_t bit_buffer_length = 0;
-			size_t length = str.GetLength();
+
 			for (size_t i = 0; i < length; i++)
 			{
-				uint8_t c = str[i];
-				auto [code, code_bit_length] = _map[c];
-				
+				const auto &code = _codes[data[i]];
+
 				// Append the code to the bit buffer
-				bit_buffer <<= code_bit_length;
-				bit_buffer |= code;
-				bit_buffer_length += code_bit_length;
+				bit_buffer = (bit_buffer << code.length) | code.code;
+				bit_buffer_length += code.length;
 
 				// If the bit buffer is over 8 bits, flush it to the output buffer
 				while (bit_buffer_length >= 8)
 				{
-					uint8_t byte = static_cast<uint8_t>(bit_buffer >> (bit_buffer_length - 8));
 					bit_buffer_length -= 8;
-					out_data[out_data_size] = byte;
-					out_data_size ++;
+					out_data[out_data_size++] = static_cast<uint8_t>(bit_buffer >> bit_buffer_length);
 				}
 			}
-			
+
 			// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
 			// As the Huffman-encoded data doesn't always end at an octet boundary,
 			// some padding is inserted after it, up to the next octet boundary.  To
 			// prevent this padding from being misinterpreted as part of the string
 			// literal, the most significant bits of the code corresponding to the
 			// EOS (end-of-string) symbol are used.
-
-			// Append EOS
 			if (bit_buffer_length > 0)
 			{
-				auto byte = bit_buffer << (8 - bit_buffer_length);
-				// Append EOS(0xFF) to the end of the bit buffer
-				// bit_buffer is always less than 8 bits
-				byte |= 0xFF >> bit_buffer_length;
-
-				out_data[out_data_size] = byte;
-				out_data_size ++;
+				// Append the MSBs of EOS(all 1s) to the remaining bits
+				out_data[out_data_size++] = static_cast<uint8_t>(bit_buffer << (8 - bit_buffer_length)) | (0xFF >> bit_buffer_length);
 			}
-			
-			return std::make_shared<ov::Data>(&out_data[0], out_data_size);
+
+			OV_ASSERT2(out_data_size == encoded_length);
+
+			return encoded_data;
 		}
 
-		bool HuffmanCodec::Decode(const std::shared_ptr<const ov::Data> &data, ov::String &str)
+		bool HuffmanCodec::Decode(const std::shared_ptr<const ov::Data> &data, ov::String &str) const
 		{
-			auto reader = std::make_shared<BitReader>(data->GetDataAs<uint8_t>(), data->GetLength());
-			auto node = _tree;
+			auto encoded_data = data->GetDataAs<uint8_t>();
+			auto encoded_length = data->GetLength();
 
-			while (reader->BytesRemained() > 0)
+			// The shortest code is 5 bits, so the symbols are written in place and the string is shrunk to fit later
+			auto offset = str.GetLength();
+			if (str.SetLength(offset + (encoded_length * 8 / 5)) == false)
 			{
-				auto b = reader->ReadBit();
-				if (b == 1)
-				{
-					node = node->GetRight();
-					if (node == nullptr)
-					{
-						return false;
-					}
-				}
-				else
+				return false;
+			}
+
+			auto out_data = str.GetBuffer() + offset;
+			size_t out_data_size = 0;
+
+			uint8_t state = 0;
+			// An empty string is valid
+			bool accepted = true;
+
+			for (size_t i = 0; i < encoded_length; i++)
+			{
+				const uint8_t byte = encoded_data[i];
+
+				for (const auto nibble : {byte >> 4, byte & 0x0F})
 				{
-					node = node->GetLeft();
-					if (node == nullptr)
+					const auto &entry = _decode_table[state][nibble];
+
+					if (entry.flags & DecodeFlag::Failed)
 					{
+						str.SetLength(offset);
 						return false;
 					}
-				}
 
-				if (node->IsLeaf())
-				{
-					if (node->GetValue() == 256)
+					if (entry.flags & DecodeFlag::Symbol)
 					{
-						// EOS
-						return false;
+						out_data[out_data_size++] = static_cast<char>(entry.symbol);
 					}
 
-					str.Append(static_cast<uint8_t>(node->GetValue()));
-					node = _tree;
-
-					// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
-					// As the Huffman-encoded data doesn't always end at an octet boundary,
-					// some padding is inserted after it, up to the next octet boundary.  To
-					// prevent this padding from being misinterpreted as part of the string
-					// literal, the most significant bits of the code corresponding to the
-					// EOS (end-of-string) symbol are used.
-
-					// So, the symbol (1111111) corresponding to EOS may be included in the 
-					// last 7 bits or less. In this case, no processing is done because it will 
-					// terminate without reaching the leaf naturally.
+					state = entry.next_state;
+					accepted = (entry.flags & DecodeFlag::Accepted);
 				}
 			}
 
-			return true;
+			str.SetLength(offset + out_data_size);
+
+			// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
+			// A padding strictly longer than 7 bits MUST be treated as a decoding error.
+			// A padding not corresponding to the most significant bits of the code for the EOS symbol MUST be treated as a decoding error.
+			return accepted;
 		}
 
-		void HuffmanCodec::BuildTree(uint32_t code, uint8_t length, uint16_t symbol)
+		void HuffmanCodec::Build(uint32_t code, uint8_t length, uint16_t symbol)
 		{
-			//TODO(Getroot): If needed, apply faster algorithm
-			auto node = _tree;
+			_codes[symbol] = {code, length};
+
+			uint16_t node_index = 0;
 
-			for (uint16_t i = 0; i < length; i++)
+			for (uint8_t i = 0; i < length; i++)
 			{
 				auto bit = (code >> (length - i - 1)) & 0x1;
+				auto child_index = _tree[node_index].children[bit];
 
-				if (bit == 0)
-				{
-					node = node->GetLeft(true);
-				}
-				else
+				if (child_index == 0)
 				{
-					node = node->GetRight(true);
+					child_index = _tree.size();
+					_tree[node_index].children[bit] = child_index;
+
+					// _tree[node_index] may be invalidated here
+					_tree.emplace_back();
 				}
+
+				node_index = child_index;
 			}
 
-			node->SetValue(symbol);
+			_tree[node_index].symbol = symbol;
 		}
 
-		void HuffmanCodec::BuildMap(uint32_t code, uint8_t length, uint16_t symbol)
+		void HuffmanCodec::BuildDecodeTable()
 		{
-			_map[symbol] = std::make_pair(code, length);
-		}
+			// Assign a state to each internal node, and find the nodes that can be a padding
+			std::vector<int16_t> state_of_node(_tree.size(), -1);
+			std::vector<uint16_t> node_of_state;
+			// The path from the root is all 1s and up to 7 bits
+			std::vector<bool> acceptable(_tree.size(), false);
 
-		// Build Tree and Map
-		void HuffmanCodec::Build(uint32_t code, uint8_t length, uint16_t symbol)
-		{
-			BuildMap(code, length, symbol);
-			BuildTree(code, length, symbol);
+			acceptable[0] = true;
+
+			for (size_t node_index = 0; node_index < _tree.size(); node_index++)
+			{
+				if (_tree[node_index].symbol < 0)
+				{
+					state_of_node[node_index] = node_of_state.size();
+					node_of_state.push_back(node_index);
+				}
+			}
+
+			OV_ASSERT2(node_of_state.size() == 256);
+
+			for (uint16_t depth = 1, node_index = 0; depth <= 7; depth++)
+			{
+				node_index = _tree[node_index].children[1];
+				acceptable[node_index] = true;
+			}
+
+			for (size_t state = 0; state < node_of_state.size(); state++)
+			{
+				for (uint8_t nibble = 0; nibble < 16; nibble++)
+				{
+					auto &entry = _decode_table[state][nibble];
+					uint16_t node_index = node_of_state[state];
+
+					for (int bit_index = 3; bit_index >= 0; bit_index--)
+					{
+						node_index = _tree[node_index].children[(nibble >> bit_index) & 0x1];
+
+						if (node_index == 0)
+						{
+							entry.flags = DecodeFlag::Failed;
+							break;
+						}
+
+						auto symbol = _tree[node_index].symbol;
+
+						if (symbol >= 0)
+						{
+							if (symbol == 256)
+							{
+								// EOS must not be decoded
+								entry.flags = DecodeFlag::Failed;
+								break;
+							}
+
+							OV_ASSERT2((entry.flags & DecodeFlag::Symbol) == 0);
+
+							entry.flags |= DecodeFlag::Symbol;
+							entry.symbol = symbol;
+							node_index = 0;
+						}
+					}
+
+					if ((entry.flags & DecodeFlag::Failed) == 0)
+					{
+						entry.next_state = state_of_node[node_index];
+
+						if (acceptable[node_index])
+						{
+							entry.flags |= DecodeFlag::Accepted;
+						}
+					}
+				}
+			}
+
+			// No longer needed
+			_tree.clear();
+			_tree.shrink_to_fit();
 		}
 	} // namespace hpack
 } // namespace http
\ No newline at end of file
@@ -19,66 +19,58 @@ namespace http
 		{
 		public:
 			HuffmanCodec();
-			std::shared_ptr<ov::Data> Encode(const ov::String &str);
-			bool Decode(const std::shared_ptr<const ov::Data> &data, ov::String &str);
-			
-		private:
-			// Build Tree and Map
-			void Build(uint32_t code, uint8_t length, uint16_t symbol);
-			// Build Map for encoding from symbol to code
-			void BuildMap(uint32_t code, uint8_t length, uint16_t symbol);
-			// Build Tree for decoding from code to symbol
-			void BuildTree(uint32_t code, uint8_t length, uint16_t symbol);
-
-			class Node
-			{
-			public:
-				Node* GetLeft(bool create = false)
-				{
-					if (_left == nullptr && create == true)
-					{
-						_left = new Node();
-					}
 
-					return _left;
-				}
+			// Returns the length of the Huffman encoded string in octets
+			size_t GetEncodedLength(const ov::String &str) const;
+			std::shared_ptr<ov::Data> Encode(const ov::String &str) const;
+			bool Decode(const std::shared_ptr<const ov::Data> &data, ov::String &str) const;
 
-				Node* GetRight(bool create = false)
-				{
-					if (_right == nullptr && create == true)
-					{
-						_right = new Node();
-					}
+		private:
+			struct Code
+			{
+				uint32_t code = 0;
+				uint8_t length = 0;
+			};
 
-					return _right;
-				}
+			struct Node
+			{
+				// Index of the child node for bit 0 and bit 1 (0 means no child, because the root cannot be a child)
+				uint16_t children[2] = {0, 0};
+				// -1 for the internal nodes
+				int16_t symbol = -1;
+			};
 
-				void SetValue(uint16_t value)
-				{
-					_value = value;
-					_is_leaf = true;
-				}
-				
-				uint16_t GetValue()
-				{
-					return _value;
-				}
+			enum DecodeFlag : uint8_t
+			{
+				// A symbol is decoded in this nibble
+				Symbol = 0x01,
+				// The bits after the last symbol are a valid padding (a prefix of EOS up to 7 bits)
+				Accepted = 0x02,
+				// Invalid code or EOS
+				Failed = 0x04,
+			};
 
-				bool IsLeaf()
-				{
-					return _is_leaf;
-				}
-				
-			private:
-				Node* _left = nullptr;
-				Node* _right = nullptr;
-				uint16_t _value = 0;
-				bool _is_leaf = false;
+			// The decoder is a state machine that consumes 4 bits at a time.
+			// Each state is an internal node of the code tree, and the shortest code is 5 bits,
+			// so at most one symbol is decoded per nibble.
+			struct DecodeEntry
+			{
+				uint8_t next_state = 0;
+				uint8_t flags = 0;
+				uint8_t symbol = 0;
 			};
 
-			// 
-			Node* _tree = new Node();
-			std::unordered_map<uint8_t, std::pair<uint32_t, uint8_t>> _map;
+			// Build Map and Tree
+			void Build(uint32_t code, uint8_t length, uint16_t symbol);
+			// Build the decoding state machine from the tree
+			void BuildDecodeTable();
+
+			// Symbol (0 ~ 256) : Code
+			Code _codes[257];
+			// Index 0 is the root (Only used to build _decode_table)
+			std::vector<Node> _tree;
+			// The code tree has 256 internal nodes (= number of symbols - 1)
+			DecodeEntry _decode_table[256][16];
 		};
 	}
 }
\ No newline at end of file
@@ -68,14 +68,14 @@ namespace http
 
 				_table_usage += header_field.GetSize();
 
-				return false;
+				return true;
 			};
 
 			// Return: <Name indexed, Value indexed, Index Number>
 			std::tuple<bool, bool, uint32_t> LookupIndex(const HeaderField &header_field)
 			{
 				// If name/value pair is matched in the table, return the index number.
-				auto it = _header_field_sequence_map.find(header_field.GetKey().CStr());
+				auto it = _header_field_sequence_map.find(header_field.GetKey());
 				if (it != _header_field_sequence_map.end())
 				{
 					// Found {name, value} in static table
@@ -86,7 +86,7 @@ namespace http
 				}
 
 				// Else if only name is matched in the table, return the index number.
-				it = _header_field_name_sequence_map.find(header_field.GetName().CStr());
+				it = _header_field_name_sequence_map.find(header_field.GetName());
 				if (it != _header_field_name_sequence_map.end())
 				{
 					// Found {name, value} in table
@@ -102,7 +102,7 @@ namespace http
 
 			bool UpdateTableSize(size_t size)
 			{
-				while (_table_usage >= size)
+				while (_table_usage > size)
 				{
 					// Pop the oldest entry from the table.
 					if (PopHeaderField() == 0)
@@ -140,7 +140,23 @@ namespace http
 
 				auto header_field = _header_fields_table.back();
 				_header_fields_table.pop_back();
-				
+
+				// The oldest entry is always removed first, so the sequence of the removed entry is (_removed_count + 1).
+				// If a newer entry has the same name (or name/value), the map already points to the newer one.
+				auto sequence = _removed_count + 1;
+
+				auto name_item = _header_field_name_sequence_map.find(header_field.GetName());
+				if ((name_item != _header_field_name_sequence_map.end()) && (name_item->second == sequence))
+				{
+					_header_field_name_sequence_map.erase(name_item);
+				}
+
+				auto key_item = _header_field_sequence_map.find(header_field.GetKey());
+				if ((key_item != _header_field_sequence_map.end()) && (key_item->second == sequence))
+				{
+					_header_field_sequence_map.erase(key_item);
+				}
+
 				_removed_count ++;
 				_table_usage -= header_field.GetSize();
 
@@ -153,8 +169,9 @@ namespace http
 			// Map for performance 
 			// name : inserted order
 			std::unordered_map<ov::String, uint32_t, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> _header_field_name_sequence_map;
-			// key(name + value) : inserted order
-			std::unordered_map<ov::String, uint32_t, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> _header_field_sequence_map;
+			// key(name + LF + value) : inserted order
+			// (Header field names are lowercase in HTTP/2, but values are case-sensitive)
+			std::unordered_map<ov::String, uint32_t> _header_field_sequence_map;
 
 		private:
 			virtual bool Insert(const HeaderField &header_field) = 0;
@@ -8,6 +8,8 @@
 //==============================================================================
 #include "http_parser.h"
 
+#include <strings.h>
+
 #include "../http_protocol_private.h"
 
 namespace http
@@ -16,6 +18,33 @@ namespace http
 	{
 		namespace h1
 		{
+			// Returns the position of "\r\n\r\n" in [data + from, data + length), or -1 if not found
+			static ssize_t FindEndOfHeader(const char *data, size_t from, size_t length)
+			{
+				// memchr() is vectorized, so look for '\n' first and then check the characters around it
+				auto current = data + from + 3;
+				auto end = data + length;
+
+				while (current < end)
+				{
+					current = static_cast<const char *>(::memchr(current, '\n', end - current));
+
+					if (current == nullptr)
+					{
+						break;
+					}
+
+					if ((current[-1] == '\r') && (current[-2] == '\n') && (current[-3] == '\r'))
+					{
+						return (current - 3) - data;
+					}
+
+					current++;
+				}
+
+				return -1L;
+			}
+
 			ssize_t HttpParser::AppendData(const std::shared_ptr<const ov::Data> &data)
 			{
 				if (_is_header_found)
@@ -36,7 +65,10 @@ namespace http
 
 				// ov::String is binary-safe
 				_header_string.Append(data->GetDataAs<char>(), data->GetLength());
-				ssize_t newline_position = _header_string.IndexOf(&(new_lines[0]));
+
+				// "\r\n\r\n" may be split across the previous data and this data,
+				// so only the last 3 bytes of the previous data are searched again
+				ssize_t newline_position = FindEndOfHeader(_header_string.CStr(), std::max(previous_length - (new_lines_length - 1), 0L), _header_string.GetLength());
 
 				if (newline_position >= 0)
 				{
@@ -64,19 +96,19 @@ namespace http
 					// Need more data
 
 					// Check if data consists of non-binary data
-					auto data_to_check = data->GetDataAs<char>();
+					auto data_to_check = data->GetDataAs<uint8_t>();
 					auto remained = data->GetLength();
 
 					while (remained > 0)
 					{
-						char character = *data_to_check;
+						uint8_t character = *data_to_check;
 
-						// isprint(): 32 <= character <= 126
-						// isspace(): 9 <= character <= 13
-						// reference: https://en.cppreference.com/w/cpp/string/byte/isprint
-						if (::isprint(character) || ::isspace(character))
+						// Reject NUL and the control characters except HTAB, CR and LF.
+						// obs-text (0x80-0xFF) is allowed in the field values (RFC 9110 5.5)
+						bool is_control = (character < 0x20) || (character == 0x7F);
+						if ((is_control == false) || (character == '\t') || (character == '\r') || (character == '\n'))
 						{
-							character++;
+							data_to_check++;
 							remained--;
 
 							continue;
@@ -105,40 +137,74 @@ namespace http
 				// RFC7230 - 3.1. Start Line
 				// start-line     = request-line / status-line
 
-				// Tokenize by "\r\n"
-				std::vector<ov::String> tokens = _header_string.Split("\r\n");
+				// Tokenize by "\r\n" without copying the lines
+				const char *header = _header_string.CStr();
+				const size_t header_length = _header_string.GetLength();
 
-				StatusCode status_code;
+				StatusCode status_code = StatusCode::OK;
+				size_t line_offset = 0;
+				bool is_first_line = true;
 
-				status_code = ParseFirstLine(tokens[0]);
-				tokens.erase(tokens.begin());
+				_header_fields.clear();
 
-				if (status_code == StatusCode::OK)
+				while ((status_code == StatusCode::OK) && (line_offset <= header_length))
 				{
-					for (const ov::String &token : tokens)
+					size_t line_end = header_length;
+					size_t search_offset = line_offset;
+
+					while (search_offset < header_length)
 					{
-						status_code = ParseHeader(token);
+						auto new_line = static_cast<const char *>(::memchr(header + search_offset, '\n', header_length - search_offset));
 
-						if (status_code != StatusCode::OK)
+						if (new_line == nullptr)
 						{
 							break;
 						}
+
+						// A bare LF is a part of the line like before
+						if ((new_line > (header + line_offset)) && (new_line[-1] == '\r'))
+						{
+							line_end = (new_line - 1) - header;
+							break;
+						}
+
+						search_offset = (new_line - header) + 1;
 					}
+
+					if (is_first_line)
+					{
+						status_code = ParseFirstLine(std::string_view(header + line_offset, line_end - line_offset));
+						is_first_line = false;
+					}
+					else
+					{
+						status_code = ParseHeader(line_offset, line_end - line_offset);
+					}
+
+					// Skip CRLF
+					line_offset = line_end + 2;
 				}
 
-				logtd("Headers: %ld:", _headers.size());
+#if DEBUG
+				logtd("Headers: %zu:", _header_fields.size());
 
-				std::for_each(_headers.begin(), _headers.end(), [](const auto &pair) -> void {
-					logtd("\t>> %s: %s", pair.first.CStr(), pair.second.CStr());
-				});
+				for (const auto &field : _header_fields)
+				{
+					logtd("\t>> %.*s: %.*s",
+						  static_cast<int>(field.name_length), header + field.name_offset,
+						  static_cast<int>(field.value_length), header + field.value_offset);
+				}
+#endif	// DEBUG
 
-				_has_content_length = IsHeaderExists("CONTENT-LENGTH");
-				_content_length = ov::Converter::ToInt64(GetHeader("CONTENT-LENGTH", "0"));
+				auto content_length = FindHeaderField("CONTENT-LENGTH");
+				_has_content_length = (content_length != nullptr);
+				// The value is followed by CRLF or the end of the string, so strtoll() stops there
+				_content_length = _has_content_length ? ::strtoll(header + content_length->value_offset, nullptr, 10) : 0L;
 
 				return status_code;
 			}
 
-			StatusCode HttpParser::ParseHeader(const ov::String &line)
+			StatusCode HttpParser::ParseHeader(size_t offset, size_t length)
 			{
 				// RFC7230 - 3.2.  Header Fields
 				// header-field   = field-name ":" OWS field-value OWS
@@ -164,23 +230,106 @@ namespace http
 				// the obs-fold rule) unless the message is intended for packaging
 				// within the message/http media type.
 
-				ssize_t colon_index = line.IndexOf(':');
+				const char *line = _header_string.CStr() + offset;
+				auto colon = static_cast<const char *>(::memchr(line, ':', length));
 
-				if (colon_index == -1)
+				if (colon == nullptr)
 				{
-					logtw("Invalid header (could not find colon): %s", line.CStr());
+					logtw("Invalid header (could not find colon): %.*s", static_cast<int>(length), line);
 					return StatusCode::BadRequest;
 				}
 
-				// Convert all header names to lower case
-				ov::String field_name = line.Left(static_cast<size_t>(colon_index)).LowerCaseString();
 				// Eliminate OWS(optional white space) to simplify processing
-				ov::String field_value = line.Substring(colon_index + 1).Trim();
+				auto is_space = [](char character) {
+					return ::isspace(static_cast<unsigned char>(character)) != 0;
+				};
+
+				size_t name_begin = 0;
+				size_t name_end = colon - line;
+				size_t value_begin = name_end + 1;
+				size_t value_end = length;
+
+				while ((name_begin < name_end) && is_space(line[name_begin]))
+				{
+					name_begin++;
+				}
+				while ((name_end > name_begin) && is_space(line[name_end - 1]))
+				{
+					name_end--;
+				}
+				while ((value_begin < value_end) && is_space(line[value_begin]))
+				{
+					value_begin++;
+				}
+				while ((value_end > value_begin) && is_space(line[value_end - 1]))
+				{
+					value_end--;
+				}
 
-				_headers[field_name.Trim()] = field_value.Trim();
+				_header_fields.push_back({static_cast<uint32_t>(offset + name_begin), static_cast<uint32_t>(name_end - name_begin),
+										  static_cast<uint32_t>(offset + value_begin), static_cast<uint32_t>(value_end - value_begin)});
 
 				return StatusCode::OK;
 			}
+
+			bool HttpParser::ParseHttpVersion(std::string_view http_version)
+			{
+				// RFC7230 - 2.6. Protocol Versioning
+				// HTTP-version  = HTTP-name "/" DIGIT "." DIGIT
+				// HTTP-name     = %x48.54.54.50 ; "HTTP", case-sensitive
+				_http_version = ov::String(http_version.data(), http_version.length());
+
+				auto slash_index = http_version.find('/');
+
+				if ((slash_index == std::string_view::npos) ||
+					(http_version.substr(0, slash_index) != "HTTP") ||
+					(http_version.find('/', slash_index + 1) != std::string_view::npos))
+				{
+					return false;
+				}
+
+				_http_version_number = ov::String(http_version.data() + slash_index + 1, http_version.length() - slash_index - 1);
+				_http_version_as_number = ov::Converter::ToDouble(_http_version_number);
+
+				return true;
+			}
+
+			const HttpParser::HeaderField *HttpParser::FindHeaderField(const ov::String &key) const noexcept
+			{
+				const char *header = _header_string.CStr();
+				const size_t key_length = key.GetLength();
+
+				// Headers are looked up a few times per request, so a linear search is faster than building a map
+				for (auto field = _header_fields.rbegin(); field != _header_fields.rend(); ++field)
+				{
+					if ((field->name_length == key_length) &&
+						(::strncasecmp(header + field->name_offset, key.CStr(), key_length) == 0))
+					{
+						return &(*field);
+					}
+				}
+
+				return nullptr;
+			}
+
+			const std::unordered_map<ov::String, ov::String, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> &HttpParser::GetHeaders() const noexcept
+			{
+				if (_is_headers_built == false)
+				{
+					const char *header = _header_string.CStr();
+
+					for (const auto &field : _header_fields)
+					{
+						// Convert all header names to lower case
+						ov::String name = ov::String(header + field.name_offset, field.name_length).LowerCaseString();
+						_headers[name] = ov::String(header + field.value_offset, field.value_length);
+					}
+
+					_is_headers_built = true;
+				}
+
+				return _headers;
+			}
 		}  // namespace h1
 	}	   // namespace prot
 }  // namespace http
@@ -11,6 +11,7 @@
 #include <base/ovlibrary/ovlibrary.h>
 
 #include <map>
+#include <string_view>
 
 #include "../../http_datastructure.h"
 
@@ -40,10 +41,8 @@ namespace http
 					return _parse_status;
 				}
 
-				const std::unordered_map<ov::String, ov::String, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> &GetHeaders() const noexcept
-				{
-					return _headers;
-				}
+				// The map is built at the first call, GetHeader() is cheaper to look up a few headers
+				const std::unordered_map<ov::String, ov::String, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> &GetHeaders() const noexcept;
 
 				Method GetMethod() const noexcept
 				{
@@ -52,25 +51,12 @@ namespace http
 
 				ov::String GetHttpVersion() const noexcept
 				{
-					auto tokens = _http_version.Split("/");
-					if (tokens.size() != 2)
-					{
-						return "1.1";
-					}
-					
-					return tokens[1];
+					return _http_version_number;
 				}
 
 				double GetHttpVersionAsNumber() const noexcept
 				{
-					auto tokens = _http_version.Split("/");
-
-					if (tokens.size() != 2)
-					{
-						return 0.0;
-					}
-
-					return ov::Converter::ToDouble(tokens[1]);
+					return _http_version_as_number;
 				}
 
 				ov::String GetHeader(const ov::String &key) const noexcept
@@ -80,19 +66,19 @@ namespace http
 
 				ov::String GetHeader(const ov::String &key, ov::String default_value) const noexcept
 				{
-					auto item = _headers.find(key.LowerCaseString());
+					auto field = FindHeaderField(key);
 
-					if (item == _headers.cend())
+					if (field == nullptr)
 					{
 						return default_value;
 					}
 
-					return item->second;
+					return ov::String(_header_string.CStr() + field->value_offset, field->value_length);
 				}
 
 				const bool IsHeaderExists(const ov::String &key) const noexcept
 				{
-					return _headers.find(key.LowerCaseString()) != _headers.cend();
+					return FindHeaderField(key) != nullptr;
 				}
 
 				bool HasContentLength() const
@@ -106,9 +92,25 @@ namespace http
 				}
 
 			protected:
+				// Position of a header field in _header_string.
+				// Offsets are used instead of pointers so that the parser can be copied.
+				struct HeaderField
+				{
+					uint32_t name_offset;
+					uint32_t name_length;
+					uint32_t value_offset;
+					uint32_t value_length;
+				};
+
 				StatusCode ParseMessage();
-				virtual StatusCode ParseFirstLine(const ov::String &line) = 0;
-				StatusCode ParseHeader(const ov::String &line);
+				// line: Points to _header_string, and does not contain CRLF
+				virtual StatusCode ParseFirstLine(std::string_view line) = 0;
+				StatusCode ParseHeader(size_t offset, size_t length);
+				// Parses HTTP-version (e.g. "HTTP/1.1") of the first line
+				bool ParseHttpVersion(std::string_view http_version);
+
+				// Returns the last field if there are multiple fields with the same name
+				const HeaderField *FindHeaderField(const ov::String &key) const noexcept;
 
 				StatusCode _parse_status = StatusCode::PartialContent;
 
@@ -116,9 +118,16 @@ namespace http
 				ov::String _http_version;
 
 				bool _is_header_found = false;
-				// A temporary buffer to extract HTTP header
+				// Received data until the end of the header (except "\r\n\r\n").
+				// Header fields are not copied, they are referenced by HeaderField.
 				ov::String _header_string;
-				std::unordered_map<ov::String, ov::String, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> _headers;
+				std::vector<HeaderField> _header_fields;
+				mutable std::unordered_map<ov::String, ov::String, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> _headers;
+				mutable bool _is_headers_built = false;
+
+				// "1.1" of "HTTP/1.1"
+				ov::String _http_version_number = "1.1";
+				double _http_version_as_number = 0.0;
 
 				// Frequently used headers
 				size_t _content_length = 0L;
@@ -16,27 +16,55 @@ namespace http
 	{
 		namespace h1
 		{
-			StatusCode HttpRequestHeaderParser::ParseFirstLine(const ov::String &line)
+			static Method ParseMethod(std::string_view method)
+			{
+				// RFC7231 - 4.1. Overview
+				// The method token is case-sensitive
+				static const std::pair<std::string_view, Method> methods[] = {
+					{"GET", Method::Get},
+					{"HEAD", Method::Head},
+					{"POST", Method::Post},
+					{"PUT", Method::Put},
+					{"DELETE", Method::Delete},
+					{"CONNECT", Method::Connect},
+					{"OPTIONS", Method::Options},
+					{"TRACE", Method::Trace},
+					{"PATCH", Method::Patch}};
+
+				for (const auto &item : methods)
+				{
+					if (item.first == method)
+					{
+						return item.second;
+					}
+				}
+
+				return Method::Unknown;
+			}
+
+			StatusCode HttpRequestHeaderParser::ParseFirstLine(std::string_view line)
 			{
 				// RFC7230 - 3.1.1. Request Line
 				// request-line   = method SP request-target SP HTTP-version CRLF
-				ssize_t first_space_index = line.IndexOf(' ');
-				ssize_t last_space_index = line.IndexOfRev(' ');
+				auto first_space_index = line.find(' ');
+				auto last_space_index = line.rfind(' ');
 
-				if ((first_space_index < 0) || (last_space_index < 0) || (first_space_index == last_space_index))
+				if ((first_space_index == std::string_view::npos) || (last_space_index == std::string_view::npos) || (first_space_index == last_space_index))
 				{
-					logtw("Invalid space index: first: %d, last: %d, line: %s", first_space_index, last_space_index, line.CStr());
+					logtw("Invalid space index: first: %zd, last: %zd, line: %.*s",
+						  static_cast<ssize_t>(first_space_index), static_cast<ssize_t>(last_space_index),
+						  static_cast<int>(line.length()), line.data());
 					return StatusCode::BadRequest;
 				}
 
 				// RFC7231 - 4. Request Methods
-				ov::String method = line.Left(static_cast<size_t>(first_space_index));
+				auto method = line.substr(0, first_space_index);
 
-				_method = MethodFromString(method);
+				_method = ParseMethod(method);
 
 				if (_method == Method::Unknown)
 				{
-					logtw("Unknown method: %s", method.CStr());
+					logtw("Unknown method: %.*s", static_cast<int>(method.length()), method.data());
 					return StatusCode::MethodNotAllowed;
 				}
 
@@ -45,21 +73,17 @@ namespace http
 				//            / absolute-form
 				//            / authority-form
 				//            / asterisk-form
-				_request_target = line.Substring(first_space_index + 1, static_cast<size_t>(last_space_index - first_space_index - 1));
+				auto request_target = line.substr(first_space_index + 1, last_space_index - first_space_index - 1);
+				_request_target = ov::String(request_target.data(), request_target.length());
 
 				// RFC7230 - 2.6. Protocol Versioning
-				// HTTP-version  = HTTP-name "/" DIGIT "." DIGIT
-				// HTTP-name     = %x48.54.54.50 ; "HTTP", case-sensitive
-				_http_version = line.Substring(last_space_index + 1);
-
-				auto tokens = _http_version.Split("/");
-				if ((tokens.size() != 2) || (tokens[0] != "HTTP"))
+				if (ParseHttpVersion(line.substr(last_space_index + 1)) == false)
 				{
 					logtw("Invalid HTTP version: %s", _http_version.CStr());
 					return StatusCode::BadRequest;
 				}
 
-				logtd("Method: [%s], uri: [%s], version: [%s]", method.CStr(), _request_target.CStr(), _http_version.CStr());
+				logtd("Method: [%.*s], uri: [%s], version: [%s]", static_cast<int>(method.length()), method.data(), _request_target.CStr(), _http_version.CStr());
 				return StatusCode::OK;
 			}
 		}  // namespace h1
@@ -26,7 +26,7 @@ namespace http
 
 			protected:
 				// Parse Request Line
-				StatusCode ParseFirstLine(const ov::String &line) override;
+				StatusCode ParseFirstLine(std::string_view line) override;
 
 				// Information parsed when HTTP request
 				ov::String _request_target;
@@ -16,39 +16,37 @@ namespace http
 	{
 		namespace h1
 		{
-			StatusCode HttpResponseParser::ParseFirstLine(const ov::String &line)
+			StatusCode HttpResponseParser::ParseFirstLine(std::string_view line)
 			{
 				// RFC7230 - 3.1.2. Status Line
 				// request-line   = method SP request-target SP HTTP-version CRLF
 
 				// status-line = HTTP-version SP status-code SP reason-phrase CRLF
-				ssize_t first_space_index = line.IndexOf(' ');
-				ssize_t second_space_index = line.IndexOf(' ', first_space_index + 1);
+				auto first_space_index = line.find(' ');
+				auto second_space_index = (first_space_index == std::string_view::npos) ? std::string_view::npos : line.find(' ', first_space_index + 1);
 
-				if ((first_space_index < 0) || (second_space_index < 0) || (first_space_index == second_space_index))
+				if ((first_space_index == std::string_view::npos) || (second_space_index == std::string_view::npos))
 				{
-					logtw("Invalid space index: first: %d, last: %d, line: %s", first_space_index, second_space_index, line.CStr());
+					logtw("Invalid space index: first: %zd, last: %zd, line: %.*s",
+						  static_cast<ssize_t>(first_space_index), static_cast<ssize_t>(second_space_index),
+						  static_cast<int>(line.length()), line.data());
 					return StatusCode::BadRequest;
 				}
 
 				// RFC7230 - 2.6. Protocol Versioning
-				// HTTP-version  = HTTP-name "/" DIGIT "." DIGIT
-				// HTTP-name     = %x48.54.54.50 ; "HTTP", case-sensitive
-				_http_version = line.Left(static_cast<size_t>(first_space_index));
-				auto tokens = _http_version.Split("/");
-				if ((tokens.size() != 2) || (tokens[0] != "HTTP"))
+				if (ParseHttpVersion(line.substr(0, first_space_index)) == false)
 				{
 					return StatusCode::BadRequest;
 				}
 
 				// RFC7230 - 3.1.2. Status Line
 				// status-code   = 3DIGIT
-				auto status_code = line.Substring(first_space_index + 1, static_cast<size_t>(second_space_index - first_space_index - 1));
-				if (status_code.GetLength() != 3)
+				auto status_code = line.substr(first_space_index + 1, second_space_index - first_space_index - 1);
+				if (status_code.length() != 3)
 				{
 					return StatusCode::BadRequest;
 				}
-				_status_code = static_cast<StatusCode>(ov::Converter::ToInt32(status_code));
+				_status_code = static_cast<StatusCode>(ov::Converter::ToInt32(ov::String(status_code.data(), status_code.length())));
 
 				if (IsValidStatusCode(_status_code) == false)
 				{
@@ -57,9 +55,10 @@ namespace http
 
 				// RFC7230 - 3.1.2. Status Line
 				// reason-phrase  = *( HTAB / SP / VCHAR / obs-text )
-				_reason_phrase = line.Substring(second_space_index + 1);
+				auto reason_phrase = line.substr(second_space_index + 1);
+				_reason_phrase = ov::String(reason_phrase.data(), reason_phrase.length());
 
-				logtd("Version: [%s], status code: [\"%s\" (%d)], reason: [%s]", _http_version.CStr(), status_code.CStr(), _status_code, _reason_phrase.CStr());
+				logtd("Version: [%s], status code: [\"%.*s\" (%d)], reason: [%s]", _http_version.CStr(), static_cast<int>(status_code.length()), status_code.data(), _status_code, _reason_phrase.CStr());
 
 				return StatusCode::OK;
 			}
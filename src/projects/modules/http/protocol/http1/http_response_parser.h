@@ -26,7 +26,7 @@ namespace http
 
 			protected:
 				// Parse Status Line
-				StatusCode ParseFirstLine(const ov::String &line) override;
+				StatusCode ParseFirstLine(std::string_view line) override;
 
 				StatusCode _status_code = StatusCode::Unknown;
 				ov::String _reason_phrase;
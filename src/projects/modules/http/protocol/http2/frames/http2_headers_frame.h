@@ -73,6 +73,23 @@ namespace http
 					_header_block_fragment = data;
 				}
 
+				// Valid only if the Priority flag is set
+				bool IsExclusive() const
+				{
+					return _is_exclusive;
+				}
+
+				uint32_t GetStreamDependency() const
+				{
+					return _stream_dependency;
+				}
+
+				// The weight of the stream in the range 0 to 255 (add one to get the actual weight)
+				uint8_t GetWeight() const
+				{
+					return _weight;
+				}
+
 				// Get Header Block Fragment
 				const std::shared_ptr<const ov::Data> &GetHeaderBlockFragment() const
 				{
@@ -41,6 +41,23 @@ namespace http
 					_weight = weight;
 				}
 
+				// Getters
+				bool IsExclusive() const
+				{
+					return _is_exclusive;
+				}
+
+				uint32_t GetStreamDependency() const
+				{
+					return _stream_dependency;
+				}
+
+				// The weight of the stream in the range 0 to 255 (add one to get the actual weight)
+				uint8_t GetWeight() const
+				{
+					return _weight;
+				}
+
 				// To String
 				ov::String ToString() const override
 				{
@@ -63,6 +63,25 @@ namespace http
 					Unknown = 0xA,
 				};
 
+				// https://www.rfc-editor.org/rfc/rfc9113.html#section-7
+				enum class ErrorCode : uint32_t
+				{
+					NoError = 0x0,
+					ProtocolError = 0x1,
+					InternalError = 0x2,
+					FlowControlError = 0x3,
+					SettingsTimeout = 0x4,
+					StreamClosed = 0x5,
+					FrameSizeError = 0x6,
+					RefusedStream = 0x7,
+					Cancel = 0x8,
+					CompressionError = 0x9,
+					ConnectError = 0xA,
+					EnhanceYourCalm = 0xB,
+					InadequateSecurity = 0xC,
+					Http11Required = 0xD,
+				};
+
 				Http2Frame();
 				Http2Frame(uint32_t stream_id);
 
@@ -43,6 +43,41 @@ namespace http
 	{
 		namespace ws
 		{
+			// Copies the masked payload from src to dst while unmasking it, 8 bytes at a time
+			//
+			// offset: The position of src in the payload, to find the byte of masking_key to start with
+			static void UnmaskPayload(uint8_t *dst, const uint8_t *src, size_t length, uint32_t masking_key, uint64_t offset)
+			{
+				uint8_t key[sizeof(masking_key)];
+				::memcpy(key, &masking_key, sizeof(key));
+
+				// masking_key repeated twice, starting from the byte for offset
+				uint8_t rotated_key[sizeof(uint64_t)];
+				for (size_t index = 0; index < sizeof(rotated_key); index++)
+				{
+					rotated_key[index] = key[(offset + index) % sizeof(key)];
+				}
+
+				uint64_t mask;
+				::memcpy(&mask, rotated_key, sizeof(mask));
+
+				size_t index = 0;
+
+				// memcpy() is used for unaligned access, and is compiled into plain loads/stores
+				for (; (index + sizeof(uint64_t)) <= length; index += sizeof(uint64_t))
+				{
+					uint64_t block;
+					::memcpy(&block, src + index, sizeof(block));
+					block ^= mask;
+					::memcpy(dst + index, &block, sizeof(block));
+				}
+
+				for (; index < length; index++)
+				{
+					dst[index] = src[index] ^ rotated_key[index % sizeof(key)];
+				}
+			}
+
 			Frame::Frame()
 			{
 				_previous_data = std::make_shared<ov::Data>(sizeof(_header) + sizeof(uint64_t) + sizeof(_frame_masking_key));
@@ -258,9 +293,12 @@ namespace http
 						break;
 				}
 
-				// To optimize the speed, masking is processed with a multiple of 8, which is set to a multiple of 8 in advance to prevent buffer reallocation
-				ssize_t total_length = _header.mask ? (((_payload_length + 7L) / 8L) * 8L) : _payload_length;
-				_payload = std::make_shared<ov::Data>(total_length);
+				// Check the length before the payload is allocated
+				if (_payload_length > MAX_WEBSOCKET_FRAME_SIZE)
+				{
+					logte("Payload is too large: %" PRIu64 " bytes (max: %lld bytes)", _payload_length, MAX_WEBSOCKET_FRAME_SIZE);
+					return -1;
+				}
 
 				_last_status = FrameParseStatus::ParseMask;
 
@@ -288,6 +326,13 @@ namespace http
 					_last_status = FrameParseStatus::ParsePayload;
 				}
 
+				if ((_last_status == FrameParseStatus::ParsePayload) && (_payload_length == 0UL))
+				{
+					// There is no payload to wait for (e.g. Ping without application data)
+					_payload = std::make_shared<ov::Data>();
+					_last_status = FrameParseStatus::Completed;
+				}
+
 				return consumed_bytes;
 			}
 
@@ -298,12 +343,36 @@ namespace http
 
 				size_t bytes_to_read = std::min(data->GetLength(), static_cast<size_t>(_remained_payload_length));
 
-				if (bytes_to_read > 0)
+				if ((_header.mask == false) && (bytes_to_read == _payload_length))
+				{
+					// The whole payload is in data, so refer to it without copying
+					_payload = data->Subdata(0, bytes_to_read);
+				}
+				else if (bytes_to_read > 0)
 				{
-					if (_payload->Append(data->GetData(), bytes_to_read) == false)
+					if (_payload_buffer == nullptr)
+					{
+						_payload_buffer = std::make_shared<ov::Data>(_payload_length);
+					}
+
+					auto offset = _payload_buffer->GetLength();
+
+					if (_payload_buffer->SetLength(offset + bytes_to_read) == false)
 					{
 						return -1;
 					}
+
+					auto destination = _payload_buffer->GetWritableDataAs<uint8_t>() + offset;
+
+					if (_header.mask)
+					{
+						// Unmask the payload in the same pass as the copy
+						UnmaskPayload(destination, data->GetDataAs<uint8_t>(), bytes_to_read, _frame_masking_key, offset);
+					}
+					else
+					{
+						::memcpy(destination, data->GetData(), bytes_to_read);
+					}
 				}
 
 				_remained_payload_length -= bytes_to_read;
@@ -311,30 +380,13 @@ namespace http
 				if (_remained_payload_length == 0)
 				{
 					// Frame is completed
-					OV_ASSERT2(_payload->GetLength() == _payload_length);
-
-					if (_header.mask)
+					if (_payload_buffer != nullptr)
 					{
-						size_t payload_length = _payload->GetLength();
-
-						// For quick calculation, we'll adjust it to a multiple of 8
-						// (When _header.mask is on, it has already been allocated as a multiple of 8 when allocating data)
-
-						static_assert(sizeof(_frame_masking_key) == 4, "sizeof(_frame_masking_key) must be 4 bytes");
-
-						uint64_t mask = static_cast<uint64_t>(_frame_masking_key) << (sizeof(_frame_masking_key) * 8) | static_cast<uint64_t>(_frame_masking_key);
-
-						size_t block_count = ((payload_length + 7L) / 8L);
-
-						auto current = _payload->GetWritableDataAs<uint64_t>();
-
-						for (size_t index = 0; index < block_count; index++)
-						{
-							*current ^= mask;
-							current++;
-						}
+						_payload = std::move(_payload_buffer);
 					}
 
+					OV_ASSERT2(_payload->GetLength() == _payload_length);
+
 					logtd("The frame is finished: %s", ToString().CStr());
 
 					_last_status = FrameParseStatus::Completed;
@@ -360,6 +412,7 @@ namespace http
 
 				_previous_data->SetLength(0);
 				_payload = nullptr;
+				_payload_buffer = nullptr;
 			}
 
 			ov::String Frame::ToString() const
@@ -154,6 +154,7 @@ namespace http
 
 				uint64_t _remained_payload_length = 0UL;
 				uint64_t _payload_length = 0UL;
+				// Masking-key in the order of the bytes on the wire
 				uint32_t _frame_masking_key = 0U;
 
 				FrameParseStatus _last_status = FrameParseStatus::ParseHeader;
@@ -161,7 +162,10 @@ namespace http
 				// Temporary buffer used only in steps ParseHeader, ParseLength, and ParseMask
 				std::shared_ptr<ov::Data> _previous_data;
 
-				std::shared_ptr<ov::Data> _payload;
+				// If an unmasked payload is received at once, it refers to the received data without copying.
+				// Otherwise, the payload is unmasked while it is copied into _payload_buffer.
+				std::shared_ptr<const ov::Data> _payload;
+				std::shared_ptr<ov::Data> _payload_buffer;
 			};
 		}  // namespace ws
 	} // namespace prot
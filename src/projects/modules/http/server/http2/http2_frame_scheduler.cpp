@@ -0,0 +1,532 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "http2_frame_scheduler.h"
+
+#include "../http_server_private.h"
+#include "http2_response.h"
+
+namespace http
+{
+	namespace svr
+	{
+		namespace h2
+		{
+			Http2FrameScheduler::Http2FrameScheduler(const std::shared_ptr<ov::ClientSocket> &client_socket, const std::shared_ptr<ov::TlsServerData> &tls_data)
+				: _client_socket(client_socket),
+				  _tls_data(tls_data)
+			{
+			}
+
+			void Http2FrameScheduler::Start()
+			{
+				std::weak_ptr<Http2FrameScheduler> weak_scheduler = GetSharedPtr();
+
+				_client_socket->SetDrainedCallback([weak_scheduler]() {
+					auto scheduler = weak_scheduler.lock();
+
+					if (scheduler != nullptr)
+					{
+						scheduler->Flush();
+					}
+				});
+			}
+
+			void Http2FrameScheduler::Stop()
+			{
+				_client_socket->SetDrainedCallback(nullptr);
+
+				std::lock_guard lock_guard(_mutex);
+
+				_stopped = true;
+				_streams.clear();
+				_active_streams.clear();
+			}
+
+			bool Http2FrameScheduler::SendFrame(const std::shared_ptr<const prot::h2::Http2Frame> &frame)
+			{
+				OV_ASSERT2(frame->GetType() != prot::h2::Http2Frame::Type::Data);
+
+				std::lock_guard lock_guard(_mutex);
+
+				if (_stopped)
+				{
+					return false;
+				}
+
+				return WriteData(frame->ToData());
+			}
+
+			int32_t Http2FrameScheduler::SendHeaderBlock(uint32_t stream_id, uint32_t weight, const std::vector<hpack::HeaderField> &header_fields, bool end_stream)
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				if (_stopped)
+				{
+					return -1;
+				}
+
+				auto header_block = std::make_shared<ov::Data>(65535);
+
+				for (const auto &header_field : header_fields)
+				{
+					auto encoded_field = _hpack_encoder.Encode(header_field, hpack::Encoder::EncodingType::LiteralWithIndexing);
+
+					if (encoded_field == nullptr)
+					{
+						logte("Failed to encode the header field: %s", header_field.GetName().CStr());
+						return -1;
+					}
+
+					header_block->Append(encoded_field);
+				}
+
+				logtd("Send header block of stream %u: size(%zu)", stream_id, header_block->GetLength());
+
+				// The frames are written with a single buffer
+				auto data = std::make_shared<ov::Data>(header_block->GetLength() + HTTP2_FRAME_HEADER_SIZE * (header_block->GetLength() / MAX_HTTP2_DATA_SIZE + 1));
+				size_t offset = 0;
+
+				do
+				{
+					auto fragment_size = std::min<size_t>(header_block->GetLength() - offset, MAX_HTTP2_DATA_SIZE);
+					auto fragment = header_block->Subdata(offset, fragment_size);
+					bool end_headers = (offset + fragment_size) == header_block->GetLength();
+
+					std::shared_ptr<prot::h2::Http2Frame> frame;
+
+					if (offset == 0)
+					{
+						auto headers_frame = std::make_shared<prot::h2::Http2HeadersFrame>(stream_id);
+						headers_frame->SetHeaderBlockFragment(fragment);
+
+						if (end_headers)
+						{
+							headers_frame->SetEndHeaders();
+						}
+
+						if (end_stream)
+						{
+							headers_frame->SetEndStream();
+						}
+
+						frame = headers_frame;
+					}
+					else
+					{
+						auto continuation_frame = std::make_shared<prot::h2::Http2ContinuationFrame>(stream_id);
+						continuation_frame->SetHeaderBlockFragment(fragment);
+
+						if (end_headers)
+						{
+							continuation_frame->SetEndHeaders();
+						}
+
+						frame = continuation_frame;
+					}
+
+					data->Append(frame->ToData());
+					offset += fragment_size;
+				} while (offset < header_block->GetLength());
+
+				if (end_stream == false)
+				{
+					GetStream(stream_id).weight = std::clamp(weight, 1U, 256U);
+				}
+				else
+				{
+					// No DATA frame follows the header block unless some are still queued (trailers)
+					auto item = _streams.find(stream_id);
+
+					if ((item != _streams.end()) && item->second.chunks.empty())
+					{
+						EraseStream(stream_id);
+					}
+				}
+
+				if (WriteData(data) == false)
+				{
+					return -1;
+				}
+
+				return header_block->GetLength();
+			}
+
+			bool Http2FrameScheduler::SendData(uint32_t stream_id, const std::shared_ptr<const ov::Data> &data, bool end_stream)
+			{
+				if (((data == nullptr) || data->IsEmpty()) && (end_stream == false))
+				{
+					// Nothing to send
+					return true;
+				}
+
+				std::lock_guard lock_guard(_mutex);
+
+				if (_stopped)
+				{
+					return false;
+				}
+
+				auto &stream = GetStream(stream_id);
+				stream.chunks.push_back({(data != nullptr) ? data : std::make_shared<ov::Data>(), 0, end_stream});
+
+				ActivateIfNeeded(stream_id, stream);
+
+				FlushInternal();
+
+				return (_stopped == false);
+			}
+
+			void Http2FrameScheduler::OpenStream(uint32_t stream_id)
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				if (_stopped)
+				{
+					return;
+				}
+
+				GetStream(stream_id);
+			}
+
+			void Http2FrameScheduler::CloseStream(uint32_t stream_id)
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				auto item = _streams.find(stream_id);
+
+				if (item == _streams.end())
+				{
+					return;
+				}
+
+				if (item->second.chunks.empty())
+				{
+					EraseStream(stream_id);
+				}
+				else
+				{
+					// Erased by FlushInternal() once the queued data is written
+					item->second.closed = true;
+				}
+			}
+
+			void Http2FrameScheduler::SetWeight(uint32_t stream_id, uint32_t weight)
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				auto item = _streams.find(stream_id);
+
+				if (item != _streams.end())
+				{
+					item->second.weight = std::clamp(weight, 1U, 256U);
+				}
+			}
+
+			void Http2FrameScheduler::ResetStream(uint32_t stream_id)
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				EraseStream(stream_id);
+			}
+
+			void Http2FrameScheduler::OnHeaderTableSizeChanged(uint32_t header_table_size)
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				_hpack_encoder.UpdateDynamicTableSize(header_table_size);
+			}
+
+			bool Http2FrameScheduler::OnInitialWindowSizeChanged(uint32_t initial_window_size)
+			{
+				// https://www.rfc-editor.org/rfc/rfc9113.html#section-6.5.2
+				// Values above the maximum flow-control window size of 2^31-1 MUST be treated as a connection error of type FLOW_CONTROL_ERROR
+				if (initial_window_size > HTTP2_MAX_WINDOW_SIZE)
+				{
+					logte("Invalid SETTINGS_INITIAL_WINDOW_SIZE: %u", initial_window_size);
+					return false;
+				}
+
+				std::lock_guard lock_guard(_mutex);
+
+				// https://www.rfc-editor.org/rfc/rfc9113.html#section-6.9.2
+				// When the value of SETTINGS_INITIAL_WINDOW_SIZE changes, a receiver MUST adjust the size of all stream flow-control windows
+				// that it maintains by the difference between the new value and the old value.
+				auto delta = static_cast<int64_t>(initial_window_size) - _initial_window_size;
+				_initial_window_size = initial_window_size;
+
+				for (auto &[stream_id, stream] : _streams)
+				{
+					stream.window += delta;
+					ActivateIfNeeded(stream_id, stream);
+				}
+
+				FlushInternal();
+
+				return true;
+			}
+
+			bool Http2FrameScheduler::OnWindowUpdate(uint32_t stream_id, uint32_t increment)
+			{
+				// https://www.rfc-editor.org/rfc/rfc9113.html#section-6.9
+				// A receiver MUST treat the receipt of a WINDOW_UPDATE frame with a flow-control window increment of 0 as a stream error
+				// of type PROTOCOL_ERROR; errors on the connection flow-control window MUST be treated as a connection error
+				if (increment == 0)
+				{
+					logte("WINDOW_UPDATE with an increment of 0 is received for stream %u", stream_id);
+					return false;
+				}
+
+				std::lock_guard lock_guard(_mutex);
+
+				if (stream_id == 0)
+				{
+					_connection_window += increment;
+
+					if (_connection_window > HTTP2_MAX_WINDOW_SIZE)
+					{
+						logte("The connection flow-control window exceeds the maximum: %" PRId64, _connection_window);
+						return false;
+					}
+				}
+				else
+				{
+					auto item = _streams.find(stream_id);
+
+					if (item == _streams.end())
+					{
+						// The stream is already closed (the streams are opened by their request HEADERS)
+						return true;
+					}
+
+					auto &stream = item->second;
+					stream.window += increment;
+
+					if (stream.window > HTTP2_MAX_WINDOW_SIZE)
+					{
+						logte("The flow-control window of stream %u exceeds the maximum: %" PRId64, stream_id, stream.window);
+						return false;
+					}
+
+					ActivateIfNeeded(stream_id, stream);
+				}
+
+				FlushInternal();
+
+				return true;
+			}
+
+			bool Http2FrameScheduler::OnDataReceived(uint32_t length)
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				_received_bytes += length;
+
+				if (_received_bytes < (HTTP2_RECEIVE_WINDOW_SIZE / 2))
+				{
+					return true;
+				}
+
+				auto window_update_frame = std::make_shared<prot::h2::Http2WindowUpdateFrame>(0);
+				window_update_frame->SetWindowSizeIncrement(_received_bytes);
+				_received_bytes = 0;
+
+				return WriteData(window_update_frame->ToData());
+			}
+
+			Http2FrameScheduler::Stream &Http2FrameScheduler::GetStream(uint32_t stream_id)
+			{
+				auto item = _streams.find(stream_id);
+
+				if (item == _streams.end())
+				{
+					item = _streams.emplace(stream_id, Stream()).first;
+					item->second.window = _initial_window_size;
+				}
+
+				return item->second;
+			}
+
+			void Http2FrameScheduler::EraseStream(uint32_t stream_id)
+			{
+				if (_streams.erase(stream_id) == 0)
+				{
+					return;
+				}
+
+				auto item = std::find(_active_streams.begin(), _active_streams.end(), stream_id);
+
+				if (item != _active_streams.end())
+				{
+					if (item == _active_streams.begin())
+					{
+						_quantum_given = false;
+					}
+
+					_active_streams.erase(item);
+				}
+			}
+
+			void Http2FrameScheduler::ActivateIfNeeded(uint32_t stream_id, Stream &stream)
+			{
+				if ((stream.active == false) && (stream.chunks.empty() == false) && (stream.window > 0))
+				{
+					stream.active = true;
+					_active_streams.push_back(stream_id);
+				}
+			}
+
+			void Http2FrameScheduler::Flush()
+			{
+				std::lock_guard lock_guard(_mutex);
+
+				FlushInternal();
+			}
+
+			void Http2FrameScheduler::FlushInternal()
+			{
+				while ((_stopped == false) && (_active_streams.empty() == false))
+				{
+					// Frames queued in the socket cannot be reordered anymore, so wait until the socket is drained
+					if (_client_socket->HasCommand())
+					{
+						return;
+					}
+
+					auto stream_id = _active_streams.front();
+					auto &stream = _streams[stream_id];
+
+					if (_quantum_given == false)
+					{
+						stream.deficit += stream.weight * HTTP2_QUANTUM_PER_WEIGHT;
+						_quantum_given = true;
+					}
+
+					auto &chunk = stream.chunks.front();
+					auto remaining = chunk.data->GetLength() - chunk.offset;
+					// An empty DATA frame with END_STREAM does not consume the windows
+					auto length = (remaining > 0) ? std::min<int64_t>({static_cast<int64_t>(remaining), MAX_HTTP2_DATA_SIZE, stream.window, _connection_window}) : 0;
+
+					if ((length <= 0) && (remaining > 0))
+					{
+						if (_connection_window <= 0)
+						{
+							// Wait for WINDOW_UPDATE of the connection
+							return;
+						}
+
+						// Wait for WINDOW_UPDATE of the stream
+						stream.active = false;
+						stream.deficit = 0;
+						_active_streams.pop_front();
+						_quantum_given = false;
+						continue;
+					}
+
+					if (length > stream.deficit)
+					{
+						// Next round
+						_active_streams.pop_front();
+						_active_streams.push_back(stream_id);
+						_quantum_given = false;
+						continue;
+					}
+
+					bool end_stream = chunk.end_stream && (static_cast<size_t>(length) == remaining);
+
+					if (WriteDataFrame(stream_id, chunk.data->GetDataAs<uint8_t>() + chunk.offset, length, end_stream) == false)
+					{
+						_stopped = true;
+						_streams.clear();
+						_active_streams.clear();
+						return;
+					}
+
+					stream.deficit -= length;
+					stream.window -= length;
+					_connection_window -= length;
+					chunk.offset += length;
+
+					if (chunk.offset < chunk.data->GetLength())
+					{
+						continue;
+					}
+
+					stream.chunks.pop_front();
+
+					if (stream.chunks.empty())
+					{
+						_active_streams.pop_front();
+						_quantum_given = false;
+
+						if (end_stream || stream.closed)
+						{
+							_streams.erase(stream_id);
+						}
+						else
+						{
+							stream.active = false;
+							stream.deficit = 0;
+						}
+					}
+				}
+			}
+
+			bool Http2FrameScheduler::WriteData(const std::shared_ptr<const ov::Data> &data)
+			{
+				std::shared_ptr<const ov::Data> send_data;
+
+				if (_tls_data == nullptr)
+				{
+					send_data = data;
+				}
+				else
+				{
+					if (_tls_data->Encrypt(data, &send_data) == false)
+					{
+						logte("Failed to encrypt data: %s", _client_socket->ToString().CStr());
+						return false;
+					}
+
+					if ((send_data == nullptr) || send_data->IsEmpty())
+					{
+						// There is no data to send
+						return true;
+					}
+				}
+
+				return _client_socket->Send(send_data);
+			}
+
+			bool Http2FrameScheduler::WriteDataFrame(uint32_t stream_id, const uint8_t *payload, size_t length, bool end_stream)
+			{
+				// Build the frame in a single buffer instead of copying the payload into an Http2DataFrame
+				auto data = std::make_shared<ov::Data>(HTTP2_FRAME_HEADER_SIZE + length);
+				data->SetLength(HTTP2_FRAME_HEADER_SIZE);
+
+				auto header = data->GetWritableDataAs<uint8_t>();
+				header[0] = (length >> 16) & 0xFF;
+				header[1] = (length >> 8) & 0xFF;
+				header[2] = length & 0xFF;
+				header[3] = static_cast<uint8_t>(prot::h2::Http2Frame::Type::Data);
+				header[4] = end_stream ? static_cast<uint8_t>(prot::h2::Http2DataFrame::Flags::EndStream) : 0;
+				header[5] = (stream_id >> 24) & 0x7F;
+				header[6] = (stream_id >> 16) & 0xFF;
+				header[7] = (stream_id >> 8) & 0xFF;
+				header[8] = stream_id & 0xFF;
+
+				if (length > 0)
+				{
+					data->Append(payload, length);
+				}
+
+				return WriteData(data);
+			}
+		}  // namespace h2
+	}  // namespace svr
+}  // namespace http
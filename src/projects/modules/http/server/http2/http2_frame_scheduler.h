@@ -0,0 +1,138 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovcrypto/ovcrypto.h>
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovsocket/ovsocket.h>
+
+#include "../../hpack/encoder.h"
+#include "../../protocol/http2/frames/http2_frames.h"
+
+// https://www.rfc-editor.org/rfc/rfc9113.html#section-6.9.2
+// The initial value for the flow-control window is 65,535 octets for both new streams and the overall connection
+#define HTTP2_DEFAULT_WINDOW_SIZE 65535
+#define HTTP2_MAX_WINDOW_SIZE 0x7FFFFFFF
+// The window size that is announced to the client for receiving
+#define HTTP2_RECEIVE_WINDOW_SIZE 6291456
+// https://www.rfc-editor.org/rfc/rfc9113.html#section-5.3.2
+#define HTTP2_DEFAULT_WEIGHT 16
+// A stream of weight N can send up to N * HTTP2_QUANTUM_PER_WEIGHT bytes per round (one full DATA frame per round for the default weight)
+#define HTTP2_QUANTUM_PER_WEIGHT 1024
+
+namespace http
+{
+	namespace svr
+	{
+		namespace h2
+		{
+			// Writes the frames of all the streams of an HTTP/2 connection.
+			//
+			// The HPACK encoder of the connection is owned by the scheduler, so the header blocks are written
+			// in the order they are encoded and the dynamic table of the client stays in sync.
+			//
+			// Control frames and header blocks are written immediately, but DATA frames are queued per stream
+			// and interleaved by weight (Deficit Round Robin), within the send windows of the streams and the connection.
+			// DATA frames are only written while the socket has nothing queued, so the frames of a small response
+			// (e.g. LL-HLS playlists and parts) are not delayed behind the queued frames of large responses (e.g. segments).
+			class Http2FrameScheduler : public ov::EnableSharedFromThis<Http2FrameScheduler>
+			{
+			public:
+				Http2FrameScheduler(const std::shared_ptr<ov::ClientSocket> &client_socket, const std::shared_ptr<ov::TlsServerData> &tls_data);
+
+				// Registers the drained callback of the socket
+				void Start();
+				// Drops all the queued frames
+				void Stop();
+
+				// Writes the frame immediately (DATA frames must be sent using SendData())
+				bool SendFrame(const std::shared_ptr<const prot::h2::Http2Frame> &frame);
+				// Encodes the header fields and writes the header block as a HEADERS frame followed by CONTINUATION frames at once,
+				// so no frame of another stream is written between them (RFC 9113 6.10).
+				// Returns the size of the header block, or -1 if it is failed to send
+				int32_t SendHeaderBlock(uint32_t stream_id, uint32_t weight, const std::vector<hpack::HeaderField> &header_fields, bool end_stream);
+				// Queues the data to be sent as DATA frames of the stream
+				bool SendData(uint32_t stream_id, const std::shared_ptr<const ov::Data> &data, bool end_stream);
+
+				// Adds the stream when its request HEADERS is received,
+				// so WINDOW_UPDATE and PRIORITY that arrive before the response are applied
+				void OpenStream(uint32_t stream_id);
+				// The exchange of the stream is completed, so the stream is removed once its queued data is written
+				void CloseStream(uint32_t stream_id);
+				// weight: 1 ~ 256, ignored if the stream is not open
+				void SetWeight(uint32_t stream_id, uint32_t weight);
+				// The stream is closed before the end of the stream (RST_STREAM), so the queued data is dropped
+				void ResetStream(uint32_t stream_id);
+
+				// SETTINGS_HEADER_TABLE_SIZE of the client
+				void OnHeaderTableSizeChanged(uint32_t header_table_size);
+				// SETTINGS_INITIAL_WINDOW_SIZE of the client
+				bool OnInitialWindowSizeChanged(uint32_t initial_window_size);
+				// WINDOW_UPDATE of the client (stream_id 0 means the connection)
+				// Returns false if the increment is 0 or the window exceeds the maximum
+				bool OnWindowUpdate(uint32_t stream_id, uint32_t increment);
+				// Sends WINDOW_UPDATE for the connection once half of the receive window is consumed
+				bool OnDataReceived(uint32_t length);
+
+			private:
+				struct Chunk
+				{
+					std::shared_ptr<const ov::Data> data;
+					size_t offset = 0;
+					bool end_stream = false;
+				};
+
+				struct Stream
+				{
+					int64_t window = HTTP2_DEFAULT_WINDOW_SIZE;
+					uint32_t weight = HTTP2_DEFAULT_WEIGHT;
+					int64_t deficit = 0;
+
+					std::deque<Chunk> chunks;
+					// Whether the stream is in _active_streams
+					bool active = false;
+					// Whether CloseStream() is called
+					bool closed = false;
+				};
+
+				Stream &GetStream(uint32_t stream_id);
+				void EraseStream(uint32_t stream_id);
+				// Adds the stream to _active_streams if it has data to send and the window is open
+				void ActivateIfNeeded(uint32_t stream_id, Stream &stream);
+
+				// Writes the queued DATA frames until the socket is backlogged or the windows are exhausted
+				void Flush();
+				void FlushInternal();
+
+				bool WriteData(const std::shared_ptr<const ov::Data> &data);
+				bool WriteDataFrame(uint32_t stream_id, const uint8_t *payload, size_t length, bool end_stream);
+
+				std::shared_ptr<ov::ClientSocket> _client_socket;
+				std::shared_ptr<ov::TlsServerData> _tls_data;
+
+				std::mutex _mutex;
+				bool _stopped = false;
+
+				// Used only under _mutex
+				hpack::Encoder _hpack_encoder;
+
+				int64_t _connection_window = HTTP2_DEFAULT_WINDOW_SIZE;
+				int64_t _initial_window_size = HTTP2_DEFAULT_WINDOW_SIZE;
+				// Bytes received since the last WINDOW_UPDATE for the connection
+				uint32_t _received_bytes = 0;
+
+				std::unordered_map<uint32_t, Stream> _streams;
+				// The streams that have data to send in the order of the round
+				std::deque<uint32_t> _active_streams;
+				// Whether the quantum of this round is given to the first stream of _active_streams
+				bool _quantum_given = false;
+			};
+		}  // namespace h2
+	}  // namespace svr
+}  // namespace http
@@ -11,9 +11,8 @@
 
 #include "../http_response.h"
 #include "../../protocol/http2/frames/http2_frames.h"
-#include "../../hpack/encoder.h"
+#include "http2_frame_scheduler.h"
 
-#define MAX_HTTP2_HEADER_SIZE (1024 * 1024)
 #define MAX_HTTP2_DATA_SIZE (16384)
 
 namespace http
@@ -26,10 +25,14 @@ namespace http
 			{
 			public:
 				// Constructor
-				Http2Response(uint32_t stream_id, const std::shared_ptr<ov::ClientSocket> &client_socket, const std::shared_ptr<hpack::Encoder> &hpack_encoder);
+				Http2Response(uint32_t stream_id, const std::shared_ptr<ov::ClientSocket> &client_socket, const std::shared_ptr<Http2FrameScheduler> &frame_scheduler);
 
+				// Sends a control frame or a header block immediately
 				bool Send(const std::shared_ptr<prot::h2::Http2Frame> &frame);
 
+				// weight: 1 ~ 256 (PRIORITY of the client)
+				void SetWeight(uint32_t weight);
+
 				// After Response(), EndStream flag is not sent.
 				void SetKeepStream(bool keep_stream);
 				bool Send(const std::shared_ptr<prot::h2::Http2DataFrame> &data_frame, bool end_stream);
@@ -43,7 +46,9 @@ namespace http
 
 				uint32_t _stream_id = 0;
 				bool _keep_stream = false;
-				std::shared_ptr<hpack::Encoder> _hpack_encoder;
+				uint32_t _weight = HTTP2_DEFAULT_WEIGHT;
+				// Shared by all the streams of the connection
+				std::shared_ptr<Http2FrameScheduler> _frame_scheduler;
 			};
 		}
 	}
@@ -24,7 +24,7 @@ namespace http
 				_request->SetConnectionType(ConnectionType::Http20);
 				_request->SetTlsData(GetConnection()->GetTlsData());
 
-				_response = std::make_shared<Http2Response>(stream_id, GetConnection()->GetSocket(), GetConnection()->GetHpackEncoder());
+				_response = std::make_shared<Http2Response>(stream_id, GetConnection()->GetSocket(), GetConnection()->GetHttp2FrameScheduler());
 				_response->SetTlsData(GetConnection()->GetTlsData());
 				_response->SetHeader("server", "OvenMediaEngine");
 				_response->SetHeader("content-type", "text/html");
@@ -124,14 +124,14 @@ namespace http
 				// Max decoder table size, encoder(client) will use this value for encoder and notify by DecodeDynamicTableSizeUpdate in HPACK
 				settings_frame->SetParameter(Http2SettingsFrame::Parameters::HeaderTableSize, MAX_HEADER_TABLE_SIZE); 
 				settings_frame->SetParameter(Http2SettingsFrame::Parameters::MaxConcurrentStreams, 100);
-				settings_frame->SetParameter(Http2SettingsFrame::Parameters::InitialWindowSize, 6291456);
+				settings_frame->SetParameter(Http2SettingsFrame::Parameters::InitialWindowSize, HTTP2_RECEIVE_WINDOW_SIZE);
 				settings_frame->SetParameter(Http2SettingsFrame::Parameters::MaxHeaderListSize, 262144);
 
 				auto result = _response->Send(settings_frame);
 
-				// WindowUpdate Frame
+				// WindowUpdate Frame (The window of the connection is not affected by SETTINGS_INITIAL_WINDOW_SIZE)
 				auto window_update_frame = std::make_shared<Http2WindowUpdateFrame>(0);
-				window_update_frame->SetWindowSizeIncrement(6291456);
+				window_update_frame->SetWindowSizeIncrement(HTTP2_RECEIVE_WINDOW_SIZE - HTTP2_DEFAULT_WINDOW_SIZE);
 
 				result = result ? _response->Send(window_update_frame) : false;
 				
@@ -229,9 +229,20 @@ namespace http
 					_header_block = std::make_shared<ov::Data>();
 				}
 
+				if ((_headers_frame == nullptr) && (_stream_id != 0))
+				{
+					// WINDOW_UPDATE for the stream can be received before the response is started
+					GetConnection()->GetHttp2FrameScheduler()->OpenStream(_stream_id);
+				}
+
 				_header_block->Append(frame->GetHeaderBlockFragment());
 				_headers_frame = frame;
 
+				if (frame->IS_HTTP2_FRAME_FLAG_ON(Http2HeadersFrame::Flags::Priority))
+				{
+					_response->SetWeight(frame->GetWeight() + 1);
+				}
+
 				if (frame->IS_HTTP2_FRAME_FLAG_ON(Http2HeadersFrame::Flags::EndHeaders))
 				{
 					return OnEndHeaders();
@@ -243,6 +254,13 @@ namespace http
 			// Data frame received
 			bool HttpStream::OnDataFrameReceived(const std::shared_ptr<const Http2DataFrame> &frame)
 			{
+				// https://www.rfc-editor.org/rfc/rfc9113.html#section-6.9
+				// The entire DATA frame payload is included in flow control, including the Pad Length and Padding fields if present.
+				if (UpdateReceiveWindow(frame->GetLength(), frame->IS_HTTP2_FRAME_FLAG_ON(Http2DataFrame::Flags::EndStream)) == false)
+				{
+					return false;
+				}
+
 				if (OnDataReceived(frame->GetData()) == false)
 				{
 					return false;
@@ -258,13 +276,16 @@ namespace http
 
 			bool HttpStream::OnPriorityFrameReceived(const std::shared_ptr<const Http2PriorityFrame> &frame)
 			{
-				// Nothing to do yet, just ignore
+				// Only the weight is used to share the bandwidth among the streams, the dependency tree is not built
+				// (The priority signaling of RFC 7540 is deprecated by RFC 9113)
+				_response->SetWeight(frame->GetWeight() + 1);
 				return true;
 			}
 
 			bool HttpStream::OnRstStreamFrameReceived(const std::shared_ptr<const Http2RstStreamFrame> &frame)
 			{
 				logtd("%s", frame->ToString().CStr());
+				GetConnection()->GetHttp2FrameScheduler()->ResetStream(_stream_id);
 				SetStatus(HttpExchange::Status::Error);
 				return true;
 			}
@@ -277,8 +298,17 @@ namespace http
 					auto [exist, size] = frame->GetParameter(Http2SettingsFrame::Parameters::HeaderTableSize);
 					if (exist)
 					{
-						auto hpack_encoder = GetConnection()->GetHpackEncoder();
-						hpack_encoder->UpdateDynamicTableSize(std::min(size, MAX_HEADER_TABLE_SIZE));
+						GetConnection()->GetHttp2FrameScheduler()->OnHeaderTableSizeChanged(std::min(size, MAX_HEADER_TABLE_SIZE));
+					}
+
+					// Apply SETTINGS_INITIAL_WINDOW_SIZE to the send windows of the streams
+					std::tie(exist, size) = frame->GetParameter(Http2SettingsFrame::Parameters::InitialWindowSize);
+					if (exist)
+					{
+						if (GetConnection()->GetHttp2FrameScheduler()->OnInitialWindowSizeChanged(size) == false)
+						{
+							return false;
+						}
 					}
 					
 					// Settings Frame
@@ -312,7 +342,60 @@ namespace http
 
 			bool HttpStream::OnWindowUpdateFrameReceived(const std::shared_ptr<const Http2WindowUpdateFrame> &frame)
 			{
-				// Nothing to do yet, just ignore
+				if (GetConnection()->GetHttp2FrameScheduler()->OnWindowUpdate(_stream_id, frame->GetWindowSizeIncrement()) == false)
+				{
+					auto error_code = (frame->GetWindowSizeIncrement() == 0) ? Http2Frame::ErrorCode::ProtocolError : Http2Frame::ErrorCode::FlowControlError;
+
+					return (_stream_id == 0) ? OnConnectionError(error_code) : OnStreamError(error_code);
+				}
+
+				return true;
+			}
+
+			bool HttpStream::OnStreamError(Http2Frame::ErrorCode error_code)
+			{
+				auto rst_stream_frame = std::make_shared<Http2RstStreamFrame>(_stream_id);
+				rst_stream_frame->SetErrorCode(static_cast<uint32_t>(error_code));
+				_response->Send(rst_stream_frame);
+
+				GetConnection()->GetHttp2FrameScheduler()->ResetStream(_stream_id);
+				SetStatus(HttpExchange::Status::Error);
+
+				return false;
+			}
+
+			bool HttpStream::OnConnectionError(Http2Frame::ErrorCode error_code)
+			{
+				auto goaway_frame = std::make_shared<Http2GoAwayFrame>();
+				goaway_frame->SetErrorCode(static_cast<uint32_t>(error_code));
+				_response->Send(goaway_frame);
+
+				GetConnection()->Close(PhysicalPortDisconnectReason::Error);
+
+				return false;
+			}
+
+			bool HttpStream::UpdateReceiveWindow(uint32_t length, bool end_stream)
+			{
+				auto frame_scheduler = GetConnection()->GetHttp2FrameScheduler();
+
+				if (frame_scheduler->OnDataReceived(length) == false)
+				{
+					return false;
+				}
+
+				_received_bytes += length;
+
+				// No more DATA frames will be received if END_STREAM is set
+				if ((end_stream == false) && (_received_bytes >= (HTTP2_RECEIVE_WINDOW_SIZE / 2)))
+				{
+					auto window_update_frame = std::make_shared<Http2WindowUpdateFrame>(_stream_id);
+					window_update_frame->SetWindowSizeIncrement(_received_bytes);
+					_received_bytes = 0;
+
+					return _response->Send(window_update_frame);
+				}
+
 				return true;
 			}
 
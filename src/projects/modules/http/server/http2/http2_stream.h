@@ -65,7 +65,19 @@ namespace http
 				bool OnWindowUpdateFrameReceived(const std::shared_ptr<const Http2WindowUpdateFrame> &frame);
 				// Continuation frame received
 				bool OnContinuationFrameReceived(const std::shared_ptr<const Http2ContinuationFrame> &frame);
+
+				// Sends WINDOW_UPDATE once half of the receive window is consumed
+				bool UpdateReceiveWindow(uint32_t length, bool end_stream);
+
+				// https://www.rfc-editor.org/rfc/rfc9113.html#section-5.4
+				// Sends RST_STREAM and closes the stream
+				bool OnStreamError(Http2Frame::ErrorCode error_code);
+				// Sends GOAWAY and closes the connection
+				bool OnConnectionError(Http2Frame::ErrorCode error_code);
+
 				uint32_t _stream_id = 0;
+				// Bytes received since the last WINDOW_UPDATE for this stream
+				uint32_t _received_bytes = 0;
 
 				std::shared_ptr<const Http2HeadersFrame> _headers_frame;
 				std::shared_ptr<ov::Data> _header_block = nullptr;
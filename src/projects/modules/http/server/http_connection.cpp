@@ -125,6 +125,12 @@ namespace http
 					// Lock
 					std::unique_lock<std::mutex> lock(_http_stream_map_guard);
 					_http_stream_map.erase(http2_stream->GetStreamId());
+					lock.unlock();
+
+					if (_http2_frame_scheduler != nullptr)
+					{
+						_http2_frame_scheduler->CloseStream(http2_stream->GetStreamId());
+					}
 					break;
 				}
 				case ConnectionType::Http10:
@@ -171,6 +177,8 @@ namespace http
 		// Get Interceptor
 		std::shared_ptr<RequestInterceptor> HttpConnection::GetInterceptor() const
 		{
+			std::lock_guard<std::mutex> lock(_interceptor_mutex);
+
 			return _interceptor;
 		}
 
@@ -189,31 +197,38 @@ namespace http
 			return _connection_type;
 		}
 
-		std::shared_ptr<hpack::Encoder> HttpConnection::GetHpackEncoder() const
+		std::shared_ptr<hpack::Decoder> HttpConnection::GetHpackDecoder() const
 		{
-			return _hpack_encoder;
+			return _hpack_decoder;
 		}
 
-		std::shared_ptr<hpack::Decoder> HttpConnection::GetHpackDecoder() const
+		std::shared_ptr<h2::Http2FrameScheduler> HttpConnection::GetHttp2FrameScheduler() const
 		{
-			return _hpack_decoder;
+			return _http2_frame_scheduler;
 		}
 
 		// Find Interceptor
 		std::shared_ptr<RequestInterceptor> HttpConnection::FindInterceptor(const std::shared_ptr<HttpExchange> &exchange)
 		{
-			if (_interceptor != nullptr)
+			auto request_router = _server->GetRequestRouter();
+			if (request_router == nullptr)
 			{
-				return _interceptor;
+				return nullptr;
 			}
-			else 
+
+			auto interceptor = request_router->FindInterceptor(exchange);
+
+			std::lock_guard<std::mutex> lock(_interceptor_mutex);
+
+			_interceptor = interceptor;
+
+			if ((interceptor != nullptr) &&
+				(std::find(_interceptor_list.begin(), _interceptor_list.end(), interceptor) == _interceptor_list.end()))
 			{
-				// Cache interceptor
-				_interceptor = _server->FindInterceptor(exchange);
+				_interceptor_list.push_back(interceptor);
 			}
 
-			// Find interceptor from server
-			return _interceptor;
+			return interceptor;
 		}
 
 		bool HttpConnection::UpgradeToWebSocket(const std::shared_ptr<HttpExchange> &exchange)
@@ -235,9 +250,14 @@ namespace http
 				return;
 			}
 
-			if (_interceptor != nullptr)
+			std::unique_lock<std::mutex> interceptor_lock(_interceptor_mutex);
+			auto interceptor_list = std::move(_interceptor_list);
+			_interceptor = nullptr;
+			interceptor_lock.unlock();
+
+			for (auto &interceptor : interceptor_list)
 			{
-				_interceptor->OnClosed(GetSharedPtr(), reason);
+				interceptor->OnClosed(GetSharedPtr(), reason);
 			}
 
 			if (_http_transaction != nullptr)
@@ -259,6 +279,11 @@ namespace http
 			_http_stream_map.clear();
 			map_guard.unlock();
 
+			if (_http2_frame_scheduler != nullptr)
+			{
+				_http2_frame_scheduler->Stop();
+			}
+
 			if (reason != PhysicalPortDisconnectReason::Disconnected)
 			{
 				_client_socket->Close();
@@ -477,6 +502,12 @@ namespace http
 				stream->OnFrameReceived(_http2_frame);
 
 				_http2_frame.reset();
+
+				// The connection is closed by a connection error
+				if (_closed)
+				{
+					return -1;
+				}
 			}
 
 			return consumed_bytes;
@@ -486,9 +517,11 @@ namespace http
 		{
 			logtd("Initialize HTTP/2 connection");
 
-			_hpack_encoder = std::make_shared<hpack::Encoder>();
 			_hpack_decoder = std::make_shared<hpack::Decoder>();
 
+			_http2_frame_scheduler = std::make_shared<h2::Http2FrameScheduler>(_client_socket, _tls_data);
+			_http2_frame_scheduler->Start();
+
 			// Control Stream (stream id : 0) is always open
 			std::unique_lock<std::mutex> lock(_http_stream_map_guard);
 			_http_stream_map.emplace(0, std::make_shared<h2::HttpStream>(GetSharedPtr(), 0));
@@ -13,10 +13,10 @@
 
 #include "http1/http_transaction.h"
 #include "http2/http2_stream.h"
+#include "http_request_router.h"
 #include "web_socket/web_socket_session.h"
 
 #include "../protocol/http2/http2_preface.h"
-#include "../hpack/encoder.h"
 #include "../hpack/decoder.h"
 
 //TODO(Getroot) : Move to Server.xml
@@ -55,14 +55,16 @@ namespace http
 			// Get ID
 			uint32_t GetId() const;
 
-			// Get interceptor, return cached interceptor
+			// Get interceptor, return the interceptor of the last routed request
 			std::shared_ptr<RequestInterceptor> GetInterceptor() const;
-			// Find interceptor
+			// Find interceptor for the request of the exchange
+			// (HttpExchange keeps the result, so this is called once per request)
 			std::shared_ptr<RequestInterceptor> FindInterceptor(const std::shared_ptr<HttpExchange> &exchange);
 
 			// Get HPACK Codec
-			std::shared_ptr<hpack::Encoder> GetHpackEncoder() const;
 			std::shared_ptr<hpack::Decoder> GetHpackDecoder() const;
+			// Get HTTP/2 frame scheduler, which is shared by all the streams
+			std::shared_ptr<h2::Http2FrameScheduler> GetHttp2FrameScheduler() const;
 
 			// To string
 			virtual ov::String ToString() const;
@@ -120,8 +122,8 @@ namespace http
 			// mutex
 			std::mutex _http_stream_map_guard;
 			// HTTP/2 HPACK Codec
-			std::shared_ptr<hpack::Encoder> _hpack_encoder = nullptr;
 			std::shared_ptr<hpack::Decoder> _hpack_decoder = nullptr;
+			std::shared_ptr<h2::Http2FrameScheduler> _http2_frame_scheduler = nullptr;
 
 			///////////////////////
 			// For Websocket
@@ -130,7 +132,10 @@ namespace http
 			// Websocket Frame
 			std::shared_ptr<prot::ws::Frame> _websocket_frame = nullptr;
 
+			mutable std::mutex _interceptor_mutex;
 			std::shared_ptr<RequestInterceptor> _interceptor = nullptr;
+			// Interceptors that have processed the requests of this connection, to be notified when it is closed
+			std::vector<std::shared_ptr<RequestInterceptor>> _interceptor_list;
 
 			std::recursive_mutex _close_mutex;
 			bool _closed = false;
@@ -27,6 +27,7 @@ namespace http
 			_connection = exchange->_connection;
 			_extra = exchange->_extra;
 			_keep_alive = exchange->_keep_alive;
+			_interceptor = exchange->_interceptor;
 		}
 
 		HttpExchange::~HttpExchange()
@@ -224,10 +225,20 @@ namespace http
 			}
 		}
 
+		std::shared_ptr<RequestInterceptor> HttpExchange::FindInterceptor()
+		{
+			if (_interceptor == nullptr)
+			{
+				_interceptor = GetConnection()->FindInterceptor(GetSharedPtr());
+			}
+
+			return _interceptor;
+		}
+
 		bool HttpExchange::OnRequestPrepared()
 		{
 			// Find interceptor using received header
-			auto interceptor = GetConnection()->FindInterceptor(GetSharedPtr());
+			auto interceptor = FindInterceptor();
 			if (interceptor == nullptr)
 			{
 				logtd("Interceptor is nullptr");
@@ -244,7 +255,7 @@ namespace http
 
 		bool HttpExchange::OnDataReceived(const std::shared_ptr<const ov::Data> &data)
 		{
-			auto interceptor = GetConnection()->FindInterceptor(GetSharedPtr());
+			auto interceptor = FindInterceptor();
 			if (interceptor == nullptr)
 			{
 				logtd("Interceptor is nullptr");
@@ -260,7 +271,7 @@ namespace http
 
 		InterceptorResult HttpExchange::OnRequestCompleted()
 		{
-			auto interceptor = GetConnection()->FindInterceptor(GetSharedPtr());
+			auto interceptor = FindInterceptor();
 			if (interceptor == nullptr)
 			{
 				logtd("Interceptor is nullptr");
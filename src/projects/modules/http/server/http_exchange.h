@@ -84,6 +84,9 @@ namespace http
 			bool IsHttp2UpgradeRequest();
 
 		protected:
+			// Routes the request once, and returns the same interceptor for the rest of the exchange
+			std::shared_ptr<RequestInterceptor> FindInterceptor();
+
 			bool AcceptWebSocketUpgrade();
 			void SetConnectionPolicyByRequest();
 			void SetStatus(Status status);
@@ -98,6 +101,7 @@ namespace http
 			Status _status = Status::None;
 			bool _keep_alive = true; // HTTP/1.1 default
 			std::any _extra;
+			std::shared_ptr<RequestInterceptor> _interceptor = nullptr;
 		};
 	}  // namespace svr
 }  // namespace http
@@ -22,11 +22,31 @@ namespace http
 		class HttpRequest;
 		class HttpConnection;
 		class HttpExchange;
+		// Describes the requests that an interceptor can process.
+		// HttpServer compiles the patterns of all interceptors into a routing table,
+		// and IsInterceptorForRequest() is only called if the method and the path of the request match one of the patterns.
+		struct RequestPattern
+		{
+			// Bitmask of Method
+			Method methods = Method::All;
+
+			// These are compared with the path of the request target (query string is excluded), case-insensitively.
+			// An empty string matches any path.
+			ov::String prefix;
+			ov::String suffix;
+		};
+
 		class RequestInterceptor
 		{
 		public:
 			virtual ~RequestInterceptor() {}
 
+			// If empty, IsInterceptorForRequest() is called for all requests
+			virtual std::vector<RequestPattern> GetRequestPatterns() const
+			{
+				return {};
+			}
+
 			// Returns whether the request is an interceptor capable of processing.
 			// If this method returns true, it will only pass to this interceptor when data is received in the future, but not to another interceptor.
 			virtual bool IsInterceptorForRequest(const std::shared_ptr<const HttpExchange> &client) = 0;
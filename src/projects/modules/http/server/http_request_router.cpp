@@ -0,0 +1,199 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "http_request_router.h"
+
+#include <strings.h>
+
+#include "./http_server_private.h"
+#include "http_exchange.h"
+
+namespace http
+{
+	namespace svr
+	{
+		RequestRouter::RequestRouter(const std::vector<std::shared_ptr<RequestInterceptor>> &interceptors)
+			: _interceptors(interceptors)
+		{
+			OV_ASSERT2(_interceptors.size() <= HTTP_SERVER_MAX_INTERCEPTORS);
+
+			_prefix_trie.emplace_back();
+			_suffix_trie.emplace_back();
+
+			for (size_t index = 0; index < _interceptors.size(); index++)
+			{
+				const Candidates interceptor_bit = (1ULL << index);
+				auto patterns = _interceptors[index]->GetRequestPatterns();
+
+				if (patterns.empty())
+				{
+					_any_path_entries.push_back({Method::All, interceptor_bit, ""});
+					continue;
+				}
+
+				for (const auto &pattern : patterns)
+				{
+					if (pattern.suffix.IsEmpty() == false)
+					{
+						Insert(_suffix_trie, pattern.suffix, true, {pattern.methods, interceptor_bit, pattern.prefix});
+					}
+					else if (pattern.prefix.IsEmpty() == false)
+					{
+						Insert(_prefix_trie, pattern.prefix, false, {pattern.methods, interceptor_bit, ""});
+					}
+					else
+					{
+						_any_path_entries.push_back({pattern.methods, interceptor_bit, ""});
+					}
+				}
+			}
+		}
+
+		void RequestRouter::Insert(std::vector<Node> &trie, const ov::String &key, bool reverse, const Entry &entry)
+		{
+			uint32_t node_index = 0;
+			const auto length = key.GetLength();
+
+			for (size_t i = 0; i < length; i++)
+			{
+				const char ch = ::tolower(key[reverse ? (length - 1 - i) : i]);
+				auto child_index = FindChild(trie[node_index], ch);
+
+				if (child_index < 0)
+				{
+					child_index = trie.size();
+
+					// Keep the children sorted by character
+					auto &children = trie[node_index].children;
+					auto position = std::lower_bound(children.begin(), children.end(), ch, [](const std::pair<char, uint32_t> &child, char value) {
+						return child.first < value;
+					});
+					children.emplace(position, ch, child_index);
+
+					// trie[node_index] may be invalidated here
+					trie.emplace_back();
+				}
+
+				node_index = child_index;
+			}
+
+			trie[node_index].entries.push_back(entry);
+		}
+
+		int32_t RequestRouter::FindChild(const Node &node, char ch)
+		{
+			// Most nodes have only a few children
+			for (const auto &child : node.children)
+			{
+				if (child.first == ch)
+				{
+					return child.second;
+				}
+
+				if (child.first > ch)
+				{
+					break;
+				}
+			}
+
+			return -1;
+		}
+
+		void RequestRouter::MatchEntries(const std::vector<Entry> &entries, Method method, const char *path, size_t path_length, Candidates *candidates)
+		{
+			for (const auto &entry : entries)
+			{
+				if ((ov::ToUnderlyingType(entry.methods) & ov::ToUnderlyingType(method)) == 0)
+				{
+					continue;
+				}
+
+				if (entry.prefix.IsEmpty() == false)
+				{
+					if ((path_length < entry.prefix.GetLength()) ||
+						(::strncasecmp(path, entry.prefix.CStr(), entry.prefix.GetLength()) != 0))
+					{
+						continue;
+					}
+				}
+
+				*candidates |= entry.interceptor_bit;
+			}
+		}
+
+		RequestRouter::Candidates RequestRouter::FindCandidates(Method method, const ov::String &request_target) const
+		{
+			const char *path = request_target.CStr();
+			size_t path_length = request_target.GetLength();
+
+			// Query string is not a part of the path
+			auto query = static_cast<const char *>(::memchr(path, '?', path_length));
+			if (query != nullptr)
+			{
+				path_length = query - path;
+			}
+
+			Candidates candidates = 0;
+
+			MatchEntries(_any_path_entries, method, path, path_length, &candidates);
+
+			uint32_t node_index = 0;
+			for (size_t i = 0; i < path_length; i++)
+			{
+				auto child_index = FindChild(_prefix_trie[node_index], ::tolower(path[i]));
+				if (child_index < 0)
+				{
+					break;
+				}
+
+				node_index = child_index;
+				MatchEntries(_prefix_trie[node_index].entries, method, path, path_length, &candidates);
+			}
+
+			node_index = 0;
+			for (size_t i = path_length; i > 0; i--)
+			{
+				auto child_index = FindChild(_suffix_trie[node_index], ::tolower(path[i - 1]));
+				if (child_index < 0)
+				{
+					break;
+				}
+
+				node_index = child_index;
+				MatchEntries(_suffix_trie[node_index].entries, method, path, path_length, &candidates);
+			}
+
+			return candidates;
+		}
+
+		std::shared_ptr<RequestInterceptor> RequestRouter::FindInterceptor(const std::shared_ptr<HttpExchange> &exchange) const
+		{
+			auto request = exchange->GetRequest();
+			auto candidates = FindCandidates(request->GetMethod(), request->GetRequestTarget());
+
+			// The interceptors registered first take precedence
+			for (size_t index = 0; (candidates != 0) && (index < _interceptors.size()); index++)
+			{
+				if ((candidates & (1ULL << index)) == 0)
+				{
+					continue;
+				}
+
+				candidates &= ~(1ULL << index);
+
+				auto &interceptor = _interceptors[index];
+				if (interceptor->IsInterceptorForRequest(exchange))
+				{
+					return interceptor;
+				}
+			}
+
+			return nullptr;
+		}
+	}  // namespace svr
+}  // namespace http
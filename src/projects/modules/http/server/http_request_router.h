@@ -0,0 +1,74 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include "http_request_interceptor.h"
+
+// The routing table uses a 64-bit mask to represent the candidates
+#define HTTP_SERVER_MAX_INTERCEPTORS 64
+
+namespace http
+{
+	namespace svr
+	{
+		// An immutable routing table compiled from the RequestPatterns of the interceptors.
+		//
+		// The prefixes are stored in a trie, and the suffixes are stored in a trie of reversed strings,
+		// so the candidates for a request are found by walking the path once from each end,
+		// regardless of the number of interceptors.
+		// HttpServer creates a new RequestRouter whenever an interceptor is added or removed.
+		class RequestRouter
+		{
+		public:
+			// Bit N is set if the Nth interceptor is a candidate
+			using Candidates = uint64_t;
+
+			// interceptors: In the order of registration (up to HTTP_SERVER_MAX_INTERCEPTORS)
+			RequestRouter(const std::vector<std::shared_ptr<RequestInterceptor>> &interceptors);
+
+			// Returns the first interceptor (in the order of registration) that accepts the request
+			std::shared_ptr<RequestInterceptor> FindInterceptor(const std::shared_ptr<HttpExchange> &exchange) const;
+
+			Candidates FindCandidates(Method method, const ov::String &request_target) const;
+
+		private:
+			struct Entry
+			{
+				Method methods = Method::All;
+				Candidates interceptor_bit = 0;
+
+				// If the pattern has both prefix and suffix, the entry is stored in the suffix trie,
+				// and the prefix is compared after the suffix is matched
+				ov::String prefix;
+			};
+
+			struct Node
+			{
+				// Lowercase character : Index of the child node
+				std::vector<std::pair<char, uint32_t>> children;
+				// Entries of the patterns that end at this node
+				std::vector<Entry> entries;
+			};
+
+			static void Insert(std::vector<Node> &trie, const ov::String &key, bool reverse, const Entry &entry);
+			static int32_t FindChild(const Node &node, char ch);
+			static void MatchEntries(const std::vector<Entry> &entries, Method method, const char *path, size_t path_length, Candidates *candidates);
+
+			std::vector<std::shared_ptr<RequestInterceptor>> _interceptors;
+
+			// Index 0 is the root
+			std::vector<Node> _prefix_trie;
+			std::vector<Node> _suffix_trie;
+			// Patterns without prefix and suffix
+			std::vector<Entry> _any_path_entries;
+		};
+	}  // namespace svr
+}  // namespace http
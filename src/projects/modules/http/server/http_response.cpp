@@ -284,7 +284,8 @@ namespace http
 
 			if (_tls_data == nullptr)
 			{
-				send_data = data->Clone();
+				// ov::Socket::Send() copies the data if it cannot be sent immediately
+				send_data = data;
 			}
 			else
 			{
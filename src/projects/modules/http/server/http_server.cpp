@@ -97,7 +97,11 @@ namespace http
 				client.second->Close(PhysicalPortDisconnectReason::Disconnect);
 			}
 
-			_interceptor_list.clear();
+			{
+				std::lock_guard<std::shared_mutex> guard(_interceptor_list_mutex);
+				_interceptor_list.clear();
+				_request_router = nullptr;
+			}
 
 			_repeater.Stop();
 
@@ -241,26 +245,23 @@ namespace http
 				return false;
 			}
 
+			if (_interceptor_list.size() >= HTTP_SERVER_MAX_INTERCEPTORS)
+			{
+				logte("Too many interceptors are registered (max: %d)", HTTP_SERVER_MAX_INTERCEPTORS);
+				return false;
+			}
+
 			_interceptor_list.push_back(interceptor);
+			_request_router = std::make_shared<RequestRouter>(_interceptor_list);
+
 			return true;
 		}
 
-		std::shared_ptr<RequestInterceptor> HttpServer::FindInterceptor(const std::shared_ptr<HttpExchange> &exchange)
+		std::shared_ptr<const RequestRouter> HttpServer::GetRequestRouter() const
 		{
-			// Find interceptor for the request
 			std::shared_lock<std::shared_mutex> guard(_interceptor_list_mutex);
 
-			for (auto &interceptor : _interceptor_list)
-			{
-				if (interceptor->IsInterceptorForRequest(exchange))
-				{
-					return interceptor;
-				}
-			}
-
-			// TODO(h2) : Check if default interceptor should be used
-
-			return nullptr;
+			return _request_router;
 		}
 
 		bool HttpServer::RemoveInterceptor(const std::shared_ptr<RequestInterceptor> &interceptor)
@@ -280,6 +281,8 @@ namespace http
 			}
 
 			_interceptor_list.erase(item);
+			_request_router = std::make_shared<RequestRouter>(_interceptor_list);
+
 			return true;
 		}
 
@@ -15,6 +15,7 @@
 #include "../http_error.h"
 #include "http_connection.h"
 #include "http_default_interceptor.h"
+#include "http_request_router.h"
 
 #define HTTP_SERVER_USE_DEFAULT_COUNT PHYSICAL_PORT_USE_DEFAULT_COUNT
 
@@ -52,9 +53,11 @@ namespace http
 			bool IsHttp2Enabled() const;
 
 			bool AddInterceptor(const std::shared_ptr<RequestInterceptor> &interceptor);
-			std::shared_ptr<RequestInterceptor> FindInterceptor(const std::shared_ptr<HttpExchange> &exchange);
 			bool RemoveInterceptor(const std::shared_ptr<RequestInterceptor> &interceptor);
 
+			// Returns the routing table compiled from the current interceptors
+			std::shared_ptr<const RequestRouter> GetRequestRouter() const;
+
 			// If the iterator returns true, FindClient() will return the client
 			ov::Socket *FindClient(ClientIterator iterator);
 
@@ -86,8 +89,10 @@ namespace http
 			std::shared_mutex _client_list_mutex;
 			ClientList _connection_list;
 
-			std::shared_mutex _interceptor_list_mutex;
+			mutable std::shared_mutex _interceptor_list_mutex;
 			std::vector<std::shared_ptr<RequestInterceptor>> _interceptor_list;
+			// Rebuilt when _interceptor_list is changed
+			std::shared_ptr<const RequestRouter> _request_router;
 			std::vector<std::shared_ptr<ocst::VirtualHost>> _virtual_host_list;
 
 		private:
@@ -33,6 +33,12 @@ namespace http
 			{
 			}
 
+			std::vector<RequestPattern> Interceptor::GetRequestPatterns() const
+			{
+				// The opening handshake of WebSocket is a GET request (RFC6455 - 4.1)
+				return {{Method::Get, "", ""}};
+			}
+
 			bool Interceptor::IsInterceptorForRequest(const std::shared_ptr<const HttpExchange> &client)
 			{
 				const auto request = client->GetRequest();
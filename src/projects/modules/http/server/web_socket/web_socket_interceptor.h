@@ -37,6 +37,7 @@ namespace http
 				//--------------------------------------------------------------------
 				// Implementation of HttpRequestInterceptorInterface
 				//--------------------------------------------------------------------
+				std::vector<RequestPattern> GetRequestPatterns() const override;
 				bool IsInterceptorForRequest(const std::shared_ptr<const HttpExchange> &client) override;
 
 				// If these handler return false, the connection will be disconnected
@@ -29,7 +29,7 @@ namespace http
 			{
 			}
 
-			ssize_t WebSocketResponse::Send(const std::shared_ptr<const ov::Data> &data, prot::ws::FrameOpcode opcode)
+			std::shared_ptr<const ov::Data> WebSocketResponse::MakeFrame(const void *payload, size_t length, prot::ws::FrameOpcode opcode)
 			{
 				// RFC6455 - 5.2.  Base Framing Protocol
 				//
@@ -41,9 +41,9 @@ namespace http
 					.payload_length = 0,
 					.mask = false};
 
-				size_t length = (data == nullptr) ? 0LL : data->GetLength();
+				size_t extra_length_size = 0;
 
-				if (length < 0x7D)
+				if (length <= 0x7D)
 				{
 					// frame-payload-length    = ( %x00-7D )
 					//                         / ( %x7E frame-payload-length-16 )
@@ -52,51 +52,80 @@ namespace http
 					//                         ; respectively
 					header.payload_length = static_cast<uint8_t>(length);
 				}
-				else if (length < 0xFFFF)
+				else if (length <= 0xFFFF)
 				{
 					// frame-payload-length-16 = %x0000-FFFF ; 16 bits in length
 					header.payload_length = 126;
+					extra_length_size = sizeof(uint16_t);
 				}
 				else
 				{
 					// frame-payload-length-63 = %x0000000000000000-7FFFFFFFFFFFFFFF
 					//                         ; 64 bits in length
 					header.payload_length = 127;
+					extra_length_size = sizeof(uint64_t);
 				}
 
-				auto response_data = std::make_shared<ov::Data>(65535);
+				auto frame = std::make_shared<ov::Data>(sizeof(header) + extra_length_size + length);
 
-				response_data->Append(&header, sizeof(header));
+				frame->Append(&header, sizeof(header));
 
 				if (header.payload_length == 126)
 				{
 					auto payload_length = ov::HostToNetwork16(static_cast<uint16_t>(length));
-					response_data->Append(&payload_length, sizeof(payload_length));
+					frame->Append(&payload_length, sizeof(payload_length));
 				}
 				else if (header.payload_length == 127)
 				{
 					auto payload_length = ov::HostToNetwork64(static_cast<uint64_t>(length));
-					response_data->Append(&payload_length, sizeof(payload_length));
+					frame->Append(&payload_length, sizeof(payload_length));
+				}
+
+				if (length > 0)
+				{
+					frame->Append(payload, length);
+				}
+
+				return frame;
+			}
+
+			std::shared_ptr<const ov::Data> WebSocketResponse::MakeFrame(const std::shared_ptr<const ov::Data> &payload, prot::ws::FrameOpcode opcode)
+			{
+				if (payload == nullptr)
+				{
+					return MakeFrame(nullptr, 0, opcode);
 				}
 
+				return MakeFrame(payload->GetData(), payload->GetLength(), opcode);
+			}
+
+			ssize_t WebSocketResponse::Send(const std::shared_ptr<const ov::Data> &data, prot::ws::FrameOpcode opcode)
+			{
+				size_t length = (data == nullptr) ? 0LL : data->GetLength();
+
 				if (length > 0LL)
 				{
 					logtd("Trying to send data\n%s", data->Dump(32).CStr());
-					response_data->Append(data);
 				}
 
-				return HttpResponse::Send(response_data) ? length : -1LL;
+				return SendFrame(MakeFrame(data, opcode)) ? length : -1LL;
 			}
 
 			ssize_t WebSocketResponse::Send(const ov::String &string)
 			{
-				return Send(string.ToData(false), prot::ws::FrameOpcode::Text);
+				// Make the frame directly from the string to avoid copying it into an intermediate ov::Data
+				return SendFrame(MakeFrame(string.CStr(), string.GetLength(), prot::ws::FrameOpcode::Text)) ? string.GetLength() : -1LL;
 			}
 
 			ssize_t WebSocketResponse::Send(const Json::Value &value)
 			{
 				return Send(ov::Json::Stringify(value));
 			}
+
+			bool WebSocketResponse::SendFrame(const std::shared_ptr<const ov::Data> &frame)
+			{
+				return HttpResponse::Send(frame);
+			}
 		}  // namespace ws
 	}	   // namespace svr
 }  // namespace http
@@ -38,6 +38,14 @@ namespace http
 
 			protected:
 				using HttpResponse::Send;
+
+			private:
+				// Serializes a frame with the payload into a single buffer (frames from the server are not masked)
+				static std::shared_ptr<const ov::Data> MakeFrame(const void *payload, size_t length, prot::ws::FrameOpcode opcode);
+				static std::shared_ptr<const ov::Data> MakeFrame(const std::shared_ptr<const ov::Data> &payload, prot::ws::FrameOpcode opcode);
+
+				// Sends a frame made by MakeFrame()
+				bool SendFrame(const std::shared_ptr<const ov::Data> &frame);
 			};
 		}  // namespace ws
 	}	   // namespace svr
@@ -53,7 +53,7 @@ namespace http
 			bool WebSocketSession::Upgrade()
 			{
 				// Find Interceptor
-				auto interceptor = GetConnection()->FindInterceptor(GetSharedPtr());
+				auto interceptor = FindInterceptor();
 				if (interceptor == nullptr)
 				{
 					SetStatus(Status::Error);
@@ -101,7 +101,7 @@ namespace http
 
 			bool WebSocketSession::OnFrameReceived(const std::shared_ptr<const prot::ws::Frame> &frame)
 			{
-				auto interceptor = GetConnection()->FindInterceptor(GetSharedPtr());
+				auto interceptor = FindInterceptor();
 				if (interceptor == nullptr)
 				{
 					SetStatus(Status::Error);
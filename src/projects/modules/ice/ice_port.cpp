@@ -738,6 +738,11 @@ void IcePort::OnChannelDataPacketReceived(const std::shared_ptr<ov::Socket> &rem
 
 void IcePort::OnStunPacketReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &gate_info, const std::shared_ptr<const ov::Data> &data)
 {
+	if (OnReceivedStunBindingRequestOfConnectedSession(remote, address_pair, gate_info, data))
+	{
+		return;
+	}
+
 	ov::ByteStream stream(data.get());
 	StunMessage message;
 
@@ -956,6 +961,65 @@ bool IcePort::OnReceivedStunBindingRequest(const std::shared_ptr<ov::Socket> &re
 	return true;
 }
 
+bool IcePort::OnReceivedStunBindingRequestOfConnectedSession(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &gate_info, const std::shared_ptr<const ov::Data> &data)
+{
+	// Relayed requests are wrapped in TURN messages, so they are not handled here
+	if (gate_info.input_method != GateInfo::GateType::DIRECT)
+	{
+		return false;
+	}
+
+	StunBindingRequestView request;
+	if (StunBindingFastPath::ParseRequest(data->GetData(), data->GetLength(), &request) == false)
+	{
+		return false;
+	}
+
+	auto ice_session = FindIceSession(address_pair);
+	if ((ice_session == nullptr) || (ice_session->GetState() != IceConnectionState::Connected))
+	{
+		return false;
+	}
+
+	auto connected_candidate_pair = ice_session->GetConnectedCandidatePair();
+	if ((connected_candidate_pair == nullptr) || (connected_candidate_pair->GetAddressPair() != address_pair))
+	{
+		return false;
+	}
+
+	const auto &local_ufrag = ice_session->GetLocalUfrag();
+	if (request.local_ufrag != std::string_view(local_ufrag.CStr(), local_ufrag.GetLength()))
+	{
+		return false;
+	}
+
+	auto &integrity_key = ice_session->GetLocalIntegrityKey();
+	if (StunBindingFastPath::CheckIntegrity(data->GetData(), request, integrity_key) == false)
+	{
+		// The request is not from the peer of the session
+		logtd("[%s] Failed to check integrity of the binding request", address_pair.ToString().CStr());
+		return true;
+	}
+
+	ice_session->Refresh();
+	ice_session->OnReceivedStunBindingRequest(address_pair, remote);
+
+	uint8_t response[OV_STUN_FAST_PATH_MAX_RESPONSE_LENGTH];
+	auto response_length = StunBindingFastPath::WriteResponse(request, address_pair.GetRemoteAddress(), integrity_key, response, sizeof(response));
+	if (response_length == 0)
+	{
+		logte("[%s] Could not write the binding response", address_pair.ToString().CStr());
+		return true;
+	}
+
+	remote->SendFromTo(address_pair, response, response_length);
+
+	// OvenMediaEngine sends Stun Binding Request to peer at this point
+	SendStunBindingRequest(remote, address_pair, gate_info, ice_session);
+
+	return true;
+}
+
 bool IcePort::SendStunBindingRequest(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &gate_info, const std::shared_ptr<IceSession> &ice_session)
 {
 	logtd("IceSession : %s", ice_session->ToString().CStr());
@@ -183,6 +183,9 @@ private:
 	// [Server] <-- 4. Binding Success Response --- [Player]
 	// (State: Connected)
 	bool OnReceivedStunBindingRequest(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &packet_info, const StunMessage &message);
+	// Handles the consent freshness binding requests of connected sessions without StunMessage.
+	// Returns false if the request has to be handled by OnReceivedStunBindingRequest().
+	bool OnReceivedStunBindingRequestOfConnectedSession(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &packet_info, const std::shared_ptr<const ov::Data> &data);
 	bool OnReceivedStunBindingResponse(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &packet_info, const StunMessage &message);
 	bool OnReceivedTurnAllocateRequest(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &packet_info, const StunMessage &message);
 	bool OnReceivedTurnRefreshRequest(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, GateInfo &packet_info, const StunMessage &message);
@@ -18,6 +18,9 @@ IceSession::IceSession(session_id_t session_id, IceSession::Role role,
 				_expire_after_ms(expired_ms), _lifetime_epoch_ms(life_time_epoch_ms), 
 				_user_data(user_data), _observer(observer)
 {
+	_local_ufrag = _local_sdp->GetIceUfrag();
+	_local_integrity_key.Create(_local_sdp->GetIcePwd());
+
 	Refresh();
 }
 
@@ -78,9 +81,14 @@ uint32_t IceSession::GetSessionID() const
 	return _session_id;
 }
 
-ov::String IceSession::GetLocalUfrag() const
+const ov::String &IceSession::GetLocalUfrag() const
+{
+	return _local_ufrag;
+}
+
+StunIntegrityKey &IceSession::GetLocalIntegrityKey()
 {
-	return _local_sdp->GetIceUfrag();
+	return _local_integrity_key;
 }
 
 std::shared_ptr<IcePortObserver> IceSession::GetObserver() const
@@ -12,6 +12,7 @@
 
 #include "ice_port_observer.h"
 #include "ice_candidate_pair.h"
+#include "stun/stun_binding_fast_path.h"
 
 class IceSession
 {
@@ -46,7 +47,9 @@ public:
 	// Session ID
 	uint32_t GetSessionID() const;
 	// Local ufrag, used for identifying StunBindingRequest
-	ov::String GetLocalUfrag() const;
+	const ov::String &GetLocalUfrag() const;
+	// MESSAGE-INTEGRITY key of the binding requests from the peer
+	StunIntegrityKey &GetLocalIntegrityKey();
 
 	// Observer
 	std::shared_ptr<IcePortObserver> GetObserver() const;
@@ -98,6 +101,9 @@ private:
 	uint32_t _session_id;
 	std::shared_ptr<const SessionDescription> _local_sdp = nullptr;
 	std::shared_ptr<const SessionDescription> _peer_sdp = nullptr;
+
+	ov::String _local_ufrag;
+	StunIntegrityKey _local_integrity_key;
 	
 	Role _role = Role::UNDEFINED;
 
@@ -0,0 +1,291 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "stun_binding_fast_path.h"
+
+#include <openssl/crypto.h>
+
+#include "stun_private.h"
+
+#define OV_STUN_HEADER_LENGTH 20
+#define OV_STUN_ATTRIBUTE_HEADER_LENGTH 4
+// MESSAGE-INTEGRITY attribute including its header
+#define OV_STUN_INTEGRITY_ATTRIBUTE_LENGTH (OV_STUN_ATTRIBUTE_HEADER_LENGTH + OV_STUN_HASH_LENGTH)
+// FINGERPRINT attribute including its header
+#define OV_STUN_FINGERPRINT_ATTRIBUTE_LENGTH (OV_STUN_ATTRIBUTE_HEADER_LENGTH + 4)
+
+// Binding request/success response (RFC 5389, 6. STUN Message Structure)
+#define OV_STUN_BINDING_REQUEST_TYPE 0x0001
+#define OV_STUN_BINDING_SUCCESS_RESPONSE_TYPE 0x0101
+
+static inline uint16_t ReadNE16(const uint8_t *data)
+{
+	uint16_t value;
+	::memcpy(&value, data, sizeof(value));
+	return ov::NetworkToHost16(value);
+}
+
+static inline uint32_t ReadNE32(const uint8_t *data)
+{
+	uint32_t value;
+	::memcpy(&value, data, sizeof(value));
+	return ov::NetworkToHost32(value);
+}
+
+static inline void WriteNE16(uint8_t *data, uint16_t value)
+{
+	value = ov::HostToNetwork16(value);
+	::memcpy(data, &value, sizeof(value));
+}
+
+static inline void WriteNE32(uint8_t *data, uint32_t value)
+{
+	value = ov::HostToNetwork32(value);
+	::memcpy(data, &value, sizeof(value));
+}
+
+static inline size_t PaddedLength(size_t length)
+{
+	return (length + 3) & ~static_cast<size_t>(3);
+}
+
+bool StunIntegrityKey::Create(const ov::String &password)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	// The key is the password as it is, the same as the key that IcePort passes to StunMessage.
+	// ice-pwd only consists of ice-chars (RFC 8445 5.3), which SASLprep doesn't change.
+	return _context.Create(ov::CryptoAlgorithm::Sha1, password.CStr(), password.GetLength());
+}
+
+bool StunIntegrityKey::Compute(const void *input, size_t input_length, uint8_t hash[OV_STUN_HASH_LENGTH])
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _context.Compute(input, input_length, hash, OV_STUN_HASH_LENGTH);
+}
+
+bool StunBindingFastPath::ParseRequest(const void *data, size_t length, StunBindingRequestView *request)
+{
+	auto buffer = static_cast<const uint8_t *>(data);
+
+	if ((length < OV_STUN_HEADER_LENGTH) || (length > OV_STUN_FAST_PATH_MAX_REQUEST_LENGTH))
+	{
+		return false;
+	}
+
+	if ((ReadNE16(buffer) != OV_STUN_BINDING_REQUEST_TYPE) ||
+		(ReadNE32(buffer + 4) != OV_STUN_MAGIC_COOKIE) ||
+		((static_cast<size_t>(ReadNE16(buffer + 2)) + OV_STUN_HEADER_LENGTH) != length))
+	{
+		return false;
+	}
+
+	StunBindingRequestView view;
+	view.transaction_id = buffer + 8;
+
+	bool has_fingerprint = false;
+	size_t offset = OV_STUN_HEADER_LENGTH;
+
+	while (offset < length)
+	{
+		if ((length - offset) < OV_STUN_ATTRIBUTE_HEADER_LENGTH)
+		{
+			return false;
+		}
+
+		const auto type = static_cast<StunAttributeType>(ReadNE16(buffer + offset));
+		const size_t attribute_length = ReadNE16(buffer + offset + 2);
+		const auto value = buffer + offset + OV_STUN_ATTRIBUTE_HEADER_LENGTH;
+		const size_t next_offset = offset + OV_STUN_ATTRIBUTE_HEADER_LENGTH + PaddedLength(attribute_length);
+
+		if (next_offset > length)
+		{
+			return false;
+		}
+
+		if (view.integrity != nullptr)
+		{
+			// Only FINGERPRINT may follow MESSAGE-INTEGRITY (RFC 5389, 15.4)
+			if ((type != StunAttributeType::Fingerprint) || (attribute_length != 4) || (next_offset != length))
+			{
+				return false;
+			}
+
+			const uint32_t crc = ov::Crc32::Calculate(buffer, offset) ^ OV_STUN_FINGERPRINT_XOR_VALUE;
+			if (crc != ReadNE32(value))
+			{
+				return false;
+			}
+
+			has_fingerprint = true;
+			break;
+		}
+
+		switch (type)
+		{
+			case StunAttributeType::UserName: {
+				// USERNAME of a request is "<local ufrag>:<peer ufrag>"
+				std::string_view user_name(reinterpret_cast<const char *>(value), attribute_length);
+				auto colon = user_name.find(':');
+
+				if (colon == std::string_view::npos)
+				{
+					return false;
+				}
+
+				view.local_ufrag = user_name.substr(0, colon);
+				view.peer_ufrag = user_name.substr(colon + 1);
+				break;
+			}
+
+			case StunAttributeType::MessageIntegrity:
+				if (attribute_length != OV_STUN_HASH_LENGTH)
+				{
+					return false;
+				}
+
+				view.integrity_offset = offset;
+				view.integrity = value;
+				break;
+
+			case StunAttributeType::UseCandidate:
+				view.use_candidate = true;
+				break;
+
+			case StunAttributeType::Priority:
+				break;
+
+			default:
+				// Unknown comprehension-required attributes need an error response
+				if (static_cast<uint16_t>(type) < 0x8000)
+				{
+					return false;
+				}
+				break;
+		}
+
+		offset = next_offset;
+	}
+
+	// Requests without credentials are handled by StunMessage
+	if ((view.local_ufrag.empty()) || (view.integrity == nullptr) || (has_fingerprint == false))
+	{
+		return false;
+	}
+
+	*request = view;
+
+	return true;
+}
+
+bool StunBindingFastPath::CheckIntegrity(const void *data, const StunBindingRequestView &request, StunIntegrityKey &key)
+{
+	if ((request.integrity == nullptr) || (request.integrity_offset > OV_STUN_FAST_PATH_MAX_REQUEST_LENGTH))
+	{
+		return false;
+	}
+
+	// The HMAC is computed with the length field covering up to MESSAGE-INTEGRITY,
+	// so the message is copied to change the length (RFC 5389, 15.4)
+	uint8_t input[OV_STUN_FAST_PATH_MAX_REQUEST_LENGTH];
+	::memcpy(input, data, request.integrity_offset);
+	WriteNE16(input + 2, static_cast<uint16_t>(request.integrity_offset + OV_STUN_INTEGRITY_ATTRIBUTE_LENGTH - OV_STUN_HEADER_LENGTH));
+
+	uint8_t hash[OV_STUN_HASH_LENGTH];
+	if (key.Compute(input, request.integrity_offset, hash) == false)
+	{
+		return false;
+	}
+
+	return CRYPTO_memcmp(hash, request.integrity, OV_STUN_HASH_LENGTH) == 0;
+}
+
+size_t StunBindingFastPath::WriteResponse(const StunBindingRequestView &request, const ov::SocketAddress &mapped_address, StunIntegrityKey &key,
+										  uint8_t *buffer, size_t buffer_length)
+{
+	if ((request.transaction_id == nullptr) || (buffer_length < OV_STUN_FAST_PATH_MAX_RESPONSE_LENGTH))
+	{
+		return 0;
+	}
+
+	// Header
+	WriteNE16(buffer, OV_STUN_BINDING_SUCCESS_RESPONSE_TYPE);
+	WriteNE32(buffer + 4, OV_STUN_MAGIC_COOKIE);
+	::memcpy(buffer + 8, request.transaction_id, OV_STUN_TRANSACTION_ID_LENGTH);
+
+	size_t offset = OV_STUN_HEADER_LENGTH;
+
+	// XOR-MAPPED-ADDRESS
+	//  0                   1                   2                   3
+	//  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+	// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+	// |x x x x x x x x|    Family     |         X-Port                |
+	// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+	// |                X-Address (Variable)
+	// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+	auto value = buffer + offset + OV_STUN_ATTRIBUTE_HEADER_LENGTH;
+	size_t address_length = 0;
+
+	switch (mapped_address.GetFamily())
+	{
+		case ov::SocketFamily::Inet:
+			address_length = sizeof(in_addr);
+			value[1] = static_cast<uint8_t>(StunAddressFamily::IPv4);
+			::memcpy(value + 4, mapped_address.ToIn4Addr(), address_length);
+			break;
+
+		case ov::SocketFamily::Inet6:
+			address_length = sizeof(in6_addr);
+			value[1] = static_cast<uint8_t>(StunAddressFamily::IPv6);
+			::memcpy(value + 4, mapped_address.ToIn6Addr()->s6_addr, address_length);
+			break;
+
+		default:
+			return 0;
+	}
+
+	value[0] = 0x00;
+	WriteNE16(value + 2, static_cast<uint16_t>(mapped_address.Port() ^ (OV_STUN_MAGIC_COOKIE >> 16)));
+
+	// X-Address is XOR'ed with the magic cookie (IPv4), or with the magic cookie followed by the transaction ID (IPv6)
+	uint8_t mask[sizeof(in6_addr)];
+	WriteNE32(mask, OV_STUN_MAGIC_COOKIE);
+	::memcpy(mask + 4, request.transaction_id, OV_STUN_TRANSACTION_ID_LENGTH);
+
+	for (size_t index = 0; index < address_length; index++)
+	{
+		value[4 + index] ^= mask[index];
+	}
+
+	WriteNE16(buffer + offset, static_cast<uint16_t>(StunAttributeType::XorMappedAddress));
+	WriteNE16(buffer + offset + 2, static_cast<uint16_t>(4 + address_length));
+	offset += OV_STUN_ATTRIBUTE_HEADER_LENGTH + 4 + address_length;
+
+	// MESSAGE-INTEGRITY - The length field covers up to this attribute
+	WriteNE16(buffer + 2, static_cast<uint16_t>(offset + OV_STUN_INTEGRITY_ATTRIBUTE_LENGTH - OV_STUN_HEADER_LENGTH));
+	WriteNE16(buffer + offset, static_cast<uint16_t>(StunAttributeType::MessageIntegrity));
+	WriteNE16(buffer + offset + 2, OV_STUN_HASH_LENGTH);
+
+	if (key.Compute(buffer, offset, buffer + offset + OV_STUN_ATTRIBUTE_HEADER_LENGTH) == false)
+	{
+		return 0;
+	}
+
+	offset += OV_STUN_INTEGRITY_ATTRIBUTE_LENGTH;
+
+	// FINGERPRINT - The length field covers the whole message
+	WriteNE16(buffer + 2, static_cast<uint16_t>(offset + OV_STUN_FINGERPRINT_ATTRIBUTE_LENGTH - OV_STUN_HEADER_LENGTH));
+	WriteNE16(buffer + offset, static_cast<uint16_t>(StunAttributeType::Fingerprint));
+	WriteNE16(buffer + offset + 2, 4);
+	WriteNE32(buffer + offset + OV_STUN_ATTRIBUTE_HEADER_LENGTH, ov::Crc32::Calculate(buffer, offset) ^ OV_STUN_FINGERPRINT_XOR_VALUE);
+
+	offset += OV_STUN_FINGERPRINT_ATTRIBUTE_LENGTH;
+
+	return offset;
+}
@@ -0,0 +1,76 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovcrypto/ovcrypto.h>
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovsocket/socket_address.h>
+
+#include <mutex>
+#include <string_view>
+
+#include "stun_datastructure.h"
+
+// Requests larger than this are handled by StunMessage (RFC 5389 recommends 548 bytes or less over UDP)
+#define OV_STUN_FAST_PATH_MAX_REQUEST_LENGTH 548
+// Header(20) + XOR-MAPPED-ADDRESS(IPv6, 24) + MESSAGE-INTEGRITY(24) + FINGERPRINT(8)
+#define OV_STUN_FAST_PATH_MAX_RESPONSE_LENGTH 76
+
+// HMAC-SHA1 key state of MESSAGE-INTEGRITY, computed once from the ICE password
+class StunIntegrityKey
+{
+public:
+	bool Create(const ov::String &password);
+
+	bool IsCreated() const
+	{
+		return _context.IsCreated();
+	}
+
+	bool Compute(const void *input, size_t input_length, uint8_t hash[OV_STUN_HASH_LENGTH]);
+
+private:
+	// The sockets of a session may be processed by different threads
+	std::mutex _mutex;
+	ov::HmacContext _context;
+};
+
+// Fields of a binding request that point into the received data
+struct StunBindingRequestView
+{
+	const uint8_t *transaction_id = nullptr;
+
+	std::string_view local_ufrag;
+	std::string_view peer_ufrag;
+
+	bool use_candidate = false;
+
+	// Offset of the MESSAGE-INTEGRITY attribute from the beginning of the message
+	size_t integrity_offset = 0;
+	const uint8_t *integrity = nullptr;
+};
+
+// Validates binding requests and writes their responses without StunMessage.
+//
+// Browsers send a binding request every few seconds for each session to check consent freshness (RFC 7675),
+// and StunMessage allocates for every attribute. The requests of connected sessions are handled on the stack
+// with the HMAC key state of the session instead.
+class StunBindingFastPath
+{
+public:
+	// Returns false if the data is not a binding request that can be handled here
+	// (The caller has to parse it with StunMessage)
+	static bool ParseRequest(const void *data, size_t length, StunBindingRequestView *request);
+
+	static bool CheckIntegrity(const void *data, const StunBindingRequestView &request, StunIntegrityKey &key);
+
+	// Returns the length of the response, or 0 if it could not be written
+	static size_t WriteResponse(const StunBindingRequestView &request, const ov::SocketAddress &mapped_address, StunIntegrityKey &key,
+								uint8_t *buffer, size_t buffer_length);
+};
@@ -0,0 +1,171 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "json_writer.h"
+
+#include <charconv>
+
+namespace serdes
+{
+	JsonWriter::JsonWriter(ov::String *output)
+		: _output(output)
+	{
+		_has_value.reserve(8);
+	}
+
+	void JsonWriter::BeginValue()
+	{
+		if (_after_key)
+		{
+			_after_key = false;
+			return;
+		}
+
+		if (_has_value.empty() == false)
+		{
+			if (_has_value.back())
+			{
+				_output->Append(',');
+			}
+
+			_has_value.back() = true;
+		}
+	}
+
+	void JsonWriter::BeginObject()
+	{
+		BeginValue();
+		_output->Append('{');
+		_has_value.push_back(false);
+	}
+
+	void JsonWriter::EndObject()
+	{
+		OV_ASSERT2(_has_value.empty() == false);
+
+		_has_value.pop_back();
+		_output->Append('}');
+	}
+
+	void JsonWriter::BeginArray()
+	{
+		BeginValue();
+		_output->Append('[');
+		_has_value.push_back(false);
+	}
+
+	void JsonWriter::EndArray()
+	{
+		OV_ASSERT2(_has_value.empty() == false);
+
+		_has_value.pop_back();
+		_output->Append(']');
+	}
+
+	void JsonWriter::Key(const char *key)
+	{
+		OV_ASSERT2(_after_key == false);
+
+		String(key, ::strlen(key));
+		_output->Append(':');
+
+		_after_key = true;
+	}
+
+	void JsonWriter::String(const char *value, size_t length)
+	{
+		BeginValue();
+
+		_output->Append('"');
+
+		// Copy the runs of characters that don't need to be escaped at once
+		size_t run_start = 0;
+
+		for (size_t index = 0; index < length; index++)
+		{
+			auto ch = static_cast<uint8_t>(value[index]);
+
+			if ((ch >= 0x20) && (ch != '"') && (ch != '\\'))
+			{
+				continue;
+			}
+
+			_output->Append(value + run_start, index - run_start);
+			run_start = index + 1;
+
+			switch (ch)
+			{
+				case '"':
+					_output->Append("\\\"");
+					break;
+				case '\\':
+					_output->Append("\\\\");
+					break;
+				case '\b':
+					_output->Append("\\b");
+					break;
+				case '\f':
+					_output->Append("\\f");
+					break;
+				case '\n':
+					_output->Append("\\n");
+					break;
+				case '\r':
+					_output->Append("\\r");
+					break;
+				case '\t':
+					_output->Append("\\t");
+					break;
+				default:
+					_output->AppendFormat("\\u%04x", ch);
+					break;
+			}
+		}
+
+		_output->Append(value + run_start, length - run_start);
+		_output->Append('"');
+	}
+
+	void JsonWriter::String(const ov::String &value)
+	{
+		String(value.CStr(), value.GetLength());
+	}
+
+	void JsonWriter::Int64(int64_t value)
+	{
+		BeginValue();
+
+		char buffer[24];
+		auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+		_output->Append(buffer, result.ptr - buffer);
+	}
+
+	void JsonWriter::Bool(bool value)
+	{
+		BeginValue();
+		_output->Append(value ? "true" : "false");
+	}
+
+	void JsonWriter::Null()
+	{
+		BeginValue();
+		_output->Append("null");
+	}
+
+	void JsonWriter::Raw(const char *json, size_t length)
+	{
+		BeginValue();
+		_output->Append(json, length);
+	}
+
+	void JsonWriter::Timestamp(const std::chrono::system_clock::time_point &time_point)
+	{
+		String(ov::Converter::ToISO8601String(time_point));
+	}
+}  // namespace serdes
@@ -0,0 +1,54 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+namespace serdes
+{
+	// Writes compact JSON directly into a string without building a Json::Value.
+	//
+	// The members are written in the order of the calls, so callers that need the same output as
+	// ov::Json::Stringify() must write the keys in sorted order (Json::Value sorts the keys of an object).
+	class JsonWriter
+	{
+	public:
+		explicit JsonWriter(ov::String *output);
+
+		void BeginObject();
+		void EndObject();
+		void BeginArray();
+		void EndArray();
+
+		// Writes the key of the next member of the current object
+		void Key(const char *key);
+
+		void String(const char *value, size_t length);
+		void String(const ov::String &value);
+		void Int64(int64_t value);
+		void Bool(bool value);
+		void Null();
+		// Writes a JSON text that is already serialized as is
+		void Raw(const char *json, size_t length);
+
+		// Writes the time point in the same format as serdes::SetTimestamp()
+		void Timestamp(const std::chrono::system_clock::time_point &time_point);
+
+	private:
+		// Writes ',' if the value is not the first one of the current container
+		void BeginValue();
+
+		ov::String *_output;
+
+		// Whether a value has been written in each container
+		std::vector<bool> _has_value;
+		// Whether the next value is the value of a key
+		bool _after_key = false;
+	};
+}  // namespace serdes
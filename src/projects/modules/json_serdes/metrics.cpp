@@ -8,6 +8,8 @@
 //==============================================================================
 #include "application.h"
 #include "common.h"
+#include "metrics.h"
+
 namespace serdes
 {
 	Json::Value JsonFromMetrics(const std::shared_ptr<const mon::CommonMetrics> &metrics)
@@ -50,6 +52,104 @@ namespace serdes
 		return value;
 	}
 
+	// deduplicated_encodes is written only for the streams
+	static void WriteMetricsInternal(JsonWriter &writer, const mon::MetricsSnapshot::Values &values, const int32_t *deduplicated_encodes)
+	{
+		// The same connection types as JsonFromMetrics(), sorted by key
+		static const auto connection_types = []() {
+			std::vector<std::pair<ov::String, PublisherType>> types;
+
+			for (auto type : {PublisherType::Webrtc, PublisherType::LLDash, PublisherType::Hls, PublisherType::LLHls, PublisherType::Dash,
+							  PublisherType::Ovt, PublisherType::File, PublisherType::RtmpPush, PublisherType::MpegtsPush, PublisherType::Thumbnail})
+			{
+				types.emplace_back(StringFromPublisherType(type).LowerCaseString(), type);
+			}
+
+			std::sort(types.begin(), types.end(), [](const auto &a, const auto &b) {
+				return ::strcmp(a.first.CStr(), b.first.CStr()) < 0;
+			});
+
+			return types;
+		}();
+
+		// Keys are written in the sorted order of Json::Value, so the output is the same as Stringify(JsonFromMetrics())
+		writer.BeginObject();
+
+		writer.Key("avgThroughputIn");
+		writer.Int64(values.avg_throughput_in);
+		writer.Key("avgThroughputOut");
+		writer.Int64(values.avg_throughput_out);
+
+		writer.Key("connections");
+		writer.BeginObject();
+		for (const auto &[name, type] : connection_types)
+		{
+			writer.Key(name.CStr());
+			writer.Int64(static_cast<int32_t>(values.connections[static_cast<int8_t>(type)]));
+		}
+		writer.EndObject();
+
+		writer.Key("createdTime");
+		writer.Timestamp(values.created_time);
+
+		if (deduplicated_encodes != nullptr)
+		{
+			writer.Key("deduplicatedEncodes");
+			writer.Int64(*deduplicated_encodes);
+		}
+
+		writer.Key("lastRecvTime");
+		writer.Timestamp(values.last_recv_time);
+		writer.Key("lastSentTime");
+		writer.Timestamp(values.last_sent_time);
+		writer.Key("lastThroughputIn");
+		writer.Int64(values.last_throughput_in);
+		writer.Key("lastThroughputOut");
+		writer.Int64(values.last_throughput_out);
+		writer.Key("lastUpdatedTime");
+		writer.Timestamp(values.last_updated_time);
+		writer.Key("maxThroughputIn");
+		writer.Int64(values.max_throughput_in);
+		writer.Key("maxThroughputOut");
+		writer.Int64(values.max_throughput_out);
+		writer.Key("maxTotalConnectionTime");
+		writer.Timestamp(values.max_total_connections_time);
+		writer.Key("maxTotalConnections");
+		writer.Int64(static_cast<int32_t>(values.max_total_connections));
+		writer.Key("totalBytesIn");
+		writer.Int64(values.total_bytes_in);
+		writer.Key("totalBytesOut");
+		writer.Int64(values.total_bytes_out);
+		writer.Key("totalConnections");
+		writer.Int64(static_cast<int32_t>(values.total_connections));
+
+		writer.EndObject();
+	}
+
+	void WriteMetrics(JsonWriter &writer, const mon::MetricsSnapshot::Values &values)
+	{
+		WriteMetricsInternal(writer, values, nullptr);
+	}
+
+	void WriteStreamMetrics(JsonWriter &writer, const mon::MetricsSnapshot::Stream &stream)
+	{
+		WriteMetricsInternal(writer, stream.values, &stream.deduplicated_encodes);
+	}
+
+	Json::Value JsonFromStreamStats(const std::shared_ptr<const mon::StreamMetrics> &metrics)
+	{
+		Json::Value value = JsonFromMetrics(metrics);
+
+		if (value.isNull())
+		{
+			return value;
+		}
+
+		SetInt(value, "deduplicatedEncodes", metrics->GetDeduplicatedEncodes());
+
+		return value;
+	}
+
 	Json::Value JsonFromStreamMetrics(const std::shared_ptr<const mon::StreamMetrics> &metrics)
 	{
 		Json::Value value = JsonFromMetrics(metrics);
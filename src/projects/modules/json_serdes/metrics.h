@@ -10,9 +10,18 @@
 
 #include <monitoring/monitoring.h>
 
+#include "./json_writer.h"
+
 namespace serdes
 {
 	Json::Value JsonFromMetrics(const std::shared_ptr<const mon::CommonMetrics> &metrics);
 	Json::Value JsonFromStreamMetrics(const std::shared_ptr<const mon::StreamMetrics> &metrics);
+	// The same as the stream statistics API: JsonFromMetrics() with "deduplicatedEncodes"
+	Json::Value JsonFromStreamStats(const std::shared_ptr<const mon::StreamMetrics> &metrics);
 	Json::Value JsonFromQueueMetrics(const std::shared_ptr<const mon::QueueMetrics> &metrics);
+
+	// Writes the values of a snapshot in the same format as JsonFromMetrics()
+	void WriteMetrics(JsonWriter &writer, const mon::MetricsSnapshot::Values &values);
+	// Writes the metrics of a stream in the same format as JsonFromStreamStats()
+	void WriteStreamMetrics(JsonWriter &writer, const mon::MetricsSnapshot::Stream &stream);
 }  // namespace serdes
\ No newline at end of file
@@ -16,8 +16,15 @@ namespace mpegts
 {
 
 	MpegTsDepacketizer::MpegTsDepacketizer()
+		: _pid_states(MPEGTS_PID_COUNT)
 	{
+		_pid_states[static_cast<uint16_t>(WellKnownPacketId::PAT)].type = PacketType::SUPPORTED_SECTION;
 
+		_pid_states[static_cast<uint16_t>(WellKnownPacketId::CAT)].type = PacketType::UNSUPPORTED_SECTION;
+		_pid_states[static_cast<uint16_t>(WellKnownPacketId::TSDT)].type = PacketType::UNSUPPORTED_SECTION;
+		_pid_states[static_cast<uint16_t>(WellKnownPacketId::NIT)].type = PacketType::UNSUPPORTED_SECTION;
+		_pid_states[static_cast<uint16_t>(WellKnownPacketId::SDT)].type = PacketType::UNSUPPORTED_SECTION;
+		_pid_states[static_cast<uint16_t>(WellKnownPacketId::NULL_PACKET)].type = PacketType::UNSUPPORTED_SECTION;
 	}
 
 	MpegTsDepacketizer::~MpegTsDepacketizer()
@@ -27,72 +34,113 @@ namespace mpegts
 
 	bool MpegTsDepacketizer::AddPacket(const std::shared_ptr<const ov::Data> &packet)
 	{
-		_buffer->Append(packet);
+		return AddPacket(packet->GetDataAs<uint8_t>(), packet->GetLength());
+	}
+
+	bool MpegTsDepacketizer::AddPacket(const uint8_t *data, size_t length)
+	{
+		bool result = true;
 
-		while(_buffer->GetLength() >= MPEGTS_MIN_PACKET_SIZE)
+		// Complete the packet that was split at the end of the previous data
+		if(_partial_packet_length > 0)
 		{
-			auto packet = std::make_shared<MpegTsPacket>(_buffer);
-			
-			uint32_t parsed_length = packet->Parse();
-			if(parsed_length == 0)
+			auto copy_length = std::min(static_cast<size_t>(MPEGTS_MIN_PACKET_SIZE) - _partial_packet_length, length);
+
+			::memcpy(_partial_packet + _partial_packet_length, data, copy_length);
+			_partial_packet_length += copy_length;
+			data += copy_length;
+			length -= copy_length;
+
+			if(_partial_packet_length < MPEGTS_MIN_PACKET_SIZE)
 			{
-				_buffer = _buffer->Subdata(MPEGTS_MIN_PACKET_SIZE);
-				return false;
+				return true;
 			}
 
-			_buffer = _buffer->Subdata(parsed_length);
+			_partial_packet_length = 0;
+			result = ParsePacket(_partial_packet) && result;
+		}
 
-			if(AddPacket(packet) == false)
+		while(length > 0)
+		{
+			if(data[0] != MPEGTS_SYNC_BYTE)
 			{
-				return false;
+				// Lost sync, skip to the next sync byte
+				auto sync = static_cast<const uint8_t *>(::memchr(data, MPEGTS_SYNC_BYTE, length));
+				if(sync == nullptr)
+				{
+					logtw("Could not find the sync byte, %zu bytes are dropped", length);
+					return false;
+				}
+
+				logtw("Sync byte is lost, %zu bytes are dropped", static_cast<size_t>(sync - data));
+
+				length -= (sync - data);
+				data = sync;
+				result = false;
+			}
+
+			if(length < MPEGTS_MIN_PACKET_SIZE)
+			{
+				::memcpy(_partial_packet, data, length);
+				_partial_packet_length = length;
+				break;
 			}
+
+			result = ParsePacket(data) && result;
+
+			data += MPEGTS_MIN_PACKET_SIZE;
+			length -= MPEGTS_MIN_PACKET_SIZE;
 		}
 
-		return true;
+		return result;
 	}
 
 	bool MpegTsDepacketizer::AddPacket(const std::shared_ptr<MpegTsPacket> &packet)
 	{
-		auto packet_type = GetPacketType(packet);
+		return ProcessPacket(*packet);
+	}
+
+	bool MpegTsDepacketizer::ParsePacket(const uint8_t *buffer)
+	{
+		// Parsed in place, there is no allocation per packet
+		MpegTsPacket packet(buffer);
+
+		if(packet.Parse() == 0)
+		{
+			return false;
+		}
+
+		return ProcessPacket(packet);
+	}
+
+	bool MpegTsDepacketizer::ProcessPacket(MpegTsPacket &packet)
+	{
+		auto &pid_state = _pid_states[packet.PacketIdentifier()];
+		auto packet_type = pid_state.type;
 
 		if(packet_type == PacketType::UNSUPPORTED_SECTION || packet_type == PacketType::UNKNOWN)
 		{
 			// FFMPEG ususally sends PID 17 (DVB - SDT), but we don't use this table now
-			logtd("Ignored unsupported or unknown MPEG-TS packets.(PID: %d)", packet->PacketIdentifier());
+			logtd("Ignored unsupported or unknown MPEG-TS packets.(PID: %d)", packet.PacketIdentifier());
 			return false;
 		}
 
 		// Check continuity counter
 		// TODO(Getroot): Later, it can be used for jitter buffer to correct the UDP packet order
-		if (packet->HasPayload())
+		if (packet.HasPayload())
 		{	
-			auto it = _last_continuity_counter_map.find(packet->PacketIdentifier());
-			if(it == _last_continuity_counter_map.end())
-			{
-				_last_continuity_counter_map.emplace(packet->PacketIdentifier(), packet->ContinuityCounter());
-			}
-			else
+			if(pid_state.last_continuity_counter >= 0)
 			{
-				auto prev_counter = it->second;
-				uint8_t expected_counter;
-
-				if(prev_counter < 0x0f)
-				{
-					expected_counter = prev_counter + 1;
-				}
-				else
-				{
-					expected_counter = 0;
-				}
+				uint8_t expected_counter = (pid_state.last_continuity_counter + 1) & 0x0F;
 
-				if(packet->ContinuityCounter() != expected_counter)
+				if(packet.ContinuityCounter() != expected_counter)
 				{
 					logtw("An out-of-order packet was received.(PID : %d Expected : %d, Received : %d",
-						packet->PacketIdentifier(), expected_counter, packet->ContinuityCounter());
+						packet.PacketIdentifier(), expected_counter, packet.ContinuityCounter());
 				}
+			}
 
-				_last_continuity_counter_map[packet->PacketIdentifier()] = packet->ContinuityCounter();
-			}	
+			pid_state.last_continuity_counter = packet.ContinuityCounter();
 		}
 
 		// If PAT and PMT are completed, it doesn't need to parse anymore
@@ -105,7 +153,7 @@ namespace mpegts
 		}
 		else if(packet_type == PacketType::PES)
 		{
-			return ParsePes(packet);
+			return ParsePes(packet, _es_states[pid_state.es_index]);
 		}
 		
 		return true;
@@ -170,7 +218,6 @@ namespace mpegts
 
 	const std::shared_ptr<Pes> MpegTsDepacketizer::PopES()
 	{	
-		std::lock_guard<std::shared_mutex> lock(_es_list_lock);
 		if(_es_list.size() == 0)
 		{
 			return nullptr;
@@ -182,47 +229,18 @@ namespace mpegts
 		return es;
 	}
 
-	PacketType MpegTsDepacketizer::GetPacketType(const std::shared_ptr<MpegTsPacket> &packet)
+	bool MpegTsDepacketizer::ParseSection(MpegTsPacket &packet)
 	{
-		switch(packet->PacketIdentifier())
-		{
-			// Well known PIDs
-			case static_cast<uint16_t>(WellKnownPacketId::PAT):
-				return PacketType::SUPPORTED_SECTION;
-
-			case static_cast<uint16_t>(WellKnownPacketId::CAT):
-			case static_cast<uint16_t>(WellKnownPacketId::TSDT):
-			case static_cast<uint16_t>(WellKnownPacketId::NIT):
-			case static_cast<uint16_t>(WellKnownPacketId::SDT):
-			case static_cast<uint16_t>(WellKnownPacketId::NULL_PACKET):
-				return PacketType::UNSUPPORTED_SECTION;
-		}
-
-		// PMT's PID are in PAT, PES's PID are in PMT
-		// For quickly search they are stored in packet_type_table
-		auto it = _packet_type_table.find(packet->PacketIdentifier());
-		if(it == _packet_type_table.end())
-		{
-			return PacketType::UNKNOWN;
-		}
-
-		auto packet_type = it->second;
-
-		return packet_type;
-	}
-
-	bool MpegTsDepacketizer::ParseSection(const std::shared_ptr<MpegTsPacket> &packet)
-	{
-		BitReader bit_reader(packet->Payload(), packet->PayloadLength());
+		BitReader bit_reader(packet.Payload(), packet.PayloadLength());
 
 		// First packet of section, it means need to create new section draft and completed previous section
-		if(packet->PayloadUnitStartIndicator())
+		if(packet.PayloadUnitStartIndicator())
 		{
 			// read pointer field - 8 bits
 			auto pointer_field = bit_reader.ReadBytes<uint8_t>();
 
 			// Check if there was an incomplete section
-			auto prev_section = GetSectionDraft(packet->PacketIdentifier());
+			auto prev_section = GetSectionDraft(packet.PacketIdentifier());
 			if(prev_section != nullptr)
 			{
 				// Extract remaining data of previous section
@@ -234,14 +252,14 @@ namespace mpegts
 					// Previous section completed
 					if(CompleteSection(prev_section) == false)
 					{
-						logte("Could not complete section(PID: %d)", packet->PacketIdentifier());
+						logte("Could not complete section(PID: %d)", packet.PacketIdentifier());
 						return false;
 					}
 				}
 				else
 				{
 					// Somethind wrong
-					logte("Could not complete section(PID: %d)", packet->PacketIdentifier());
+					logte("Could not complete section(PID: %d)", packet.PacketIdentifier());
 				}
 			}
 
@@ -251,13 +269,13 @@ namespace mpegts
 			// Parsing new section
 			while(bit_reader.BytesRemained() > 0)
 			{
-				auto new_section = std::make_shared<Section>(packet->PacketIdentifier());
+				auto new_section = std::make_shared<Section>(packet.PacketIdentifier());
 				// There can be more than 2 sections
 				auto consumed_bytes = new_section->AppendData(bit_reader.CurrentPosition(), bit_reader.BytesRemained());
 				if(consumed_bytes == 0)
 				{
 					// Something wrong
-					logte("Could not parse section(PID: %d)", packet->PacketIdentifier());
+					logte("Could not parse section(PID: %d)", packet.PacketIdentifier());
 					return false;
 				}
 
@@ -267,7 +285,7 @@ namespace mpegts
 				{
 					if(CompleteSection(new_section) == false)
 					{
-						logte("Could not complete section(PID: %d)", packet->PacketIdentifier());
+						logte("Could not complete section(PID: %d)", packet.PacketIdentifier());
 						return false;
 					}
 				}
@@ -281,17 +299,17 @@ namespace mpegts
 		// There is only continuation of section data
 		else
 		{
-			auto section = GetSectionDraft(packet->PacketIdentifier());
+			auto section = GetSectionDraft(packet.PacketIdentifier());
 			if(section == nullptr)
 			{
 				// Something wrong
-				logte("Could not find section(PID: %d) for depacketizing", packet->PacketIdentifier());
+				logte("Could not find section(PID: %d) for depacketizing", packet.PacketIdentifier());
 				return false;
 			}
 
 			// There is no new section in this packet, so all remained data has to be consumed
-			auto consumed_length = section->AppendData(packet->Payload(), packet->PayloadLength());
-			if(consumed_length != packet->PayloadLength())
+			auto consumed_length = section->AppendData(packet.Payload(), packet.PayloadLength());
+			if(consumed_length != packet.PayloadLength())
 			{
 				return false;
 			}
@@ -305,21 +323,20 @@ namespace mpegts
 		return true;
 	}
 
-	bool MpegTsDepacketizer::ParsePes(const std::shared_ptr<MpegTsPacket> &packet)
+	bool MpegTsDepacketizer::ParsePes(MpegTsPacket &packet, EsState &es_state)
 	{
 		// First packet of pes, it has pes header
-		if(packet->PayloadUnitStartIndicator())
+		if(packet.PayloadUnitStartIndicator())
 		{
 			// If there is previous PES, that is completed
-			auto prev_pes = GetPesDraft(packet->PacketIdentifier());
-			if(prev_pes != nullptr)
+			if(es_state.pes_draft != nullptr)
 			{
-				CompletePes(prev_pes);
+				CompletePes(es_state, es_state.pes_draft);
 			}
 
-			auto pes = std::make_shared<Pes>(packet->PacketIdentifier());
-			auto consumed_length = pes->AppendData(packet->Payload(), packet->PayloadLength());
-			if(consumed_length != packet->PayloadLength())
+			auto pes = std::make_shared<Pes>(packet.PacketIdentifier(), es_state.last_pes_length);
+			auto consumed_length = pes->AppendData(packet.Payload(), packet.PayloadLength());
+			if(consumed_length != packet.PayloadLength())
 			{
 				logte("Something wrong with parsing PES");
 				return false;
@@ -328,29 +345,26 @@ namespace mpegts
 			// If PES Packet Length of pes header is not zero, we can know if PES is completed
 			if(pes->IsCompleted())
 			{
-				CompletePes(pes);
+				CompletePes(es_state, pes);
 			}
 			else
 			{
-				if(SavePesDraft(pes) == false)
-				{
-					return false;
-				}
+				es_state.pes_draft = pes;
 			}
 		}
 		else
 		{
-			auto pes = GetPesDraft(packet->PacketIdentifier());
+			auto pes = es_state.pes_draft;
 			if(pes == nullptr)
 			{
 				// This can be called if the encoder sends faster than the server starts. 
 				// These packets can be ignored. 
-				logtd("Could not find the pes draft (PID: %d)", packet->PacketIdentifier());
+				logtd("Could not find the pes draft (PID: %d)", packet.PacketIdentifier());
 				return false;
 			}
 
-			auto consumed_length = pes->AppendData(packet->Payload(), packet->PayloadLength());
-			if(consumed_length != packet->PayloadLength())
+			auto consumed_length = pes->AppendData(packet.Payload(), packet.PayloadLength());
+			if(consumed_length != packet.PayloadLength())
 			{
 				logte("Something wrong with parsing PES");
 				return false;
@@ -359,7 +373,7 @@ namespace mpegts
 			// If PES Packet Length of pes header is not zero, we can know if PES is completed
 			if(pes->IsCompleted())
 			{
-				CompletePes(pes);
+				CompletePes(es_state, pes);
 			}
 		}
 
@@ -368,8 +382,6 @@ namespace mpegts
 
 	const std::shared_ptr<Section> MpegTsDepacketizer::GetSectionDraft(uint16_t pid)
 	{
-		std::shared_lock<std::shared_mutex> lock(_section_draft_map_lock);
-
 		auto it = _section_draft_map.find(pid);
 		if(it == _section_draft_map.end())
 		{
@@ -382,8 +394,6 @@ namespace mpegts
 	// incompleted section will be inserted
 	bool MpegTsDepacketizer::SaveSectionDraft(const std::shared_ptr<Section> &section)
 	{
-		std::lock_guard<std::shared_mutex> lock(_section_draft_map_lock);
-
 		_section_draft_map.emplace(section->PID(), section);
 
 		return true;
@@ -392,8 +402,6 @@ namespace mpegts
 	// completed section will be removed
 	bool MpegTsDepacketizer::CompleteSection(const std::shared_ptr<Section> &section)
 	{
-		std::lock_guard<std::shared_mutex> lock(_section_draft_map_lock);
-
 		if(section->IsCompleted() == false)
 		{
 			return false;
@@ -414,7 +422,11 @@ namespace mpegts
 			// PAT
 			_pat_map.emplace(pat->_program_num, section);
 			// Reserve PMT's PID
-			_packet_type_table.emplace(pat->_program_map_pid, PacketType::SUPPORTED_SECTION);
+			auto &pid_state = _pid_states[pat->_program_map_pid & (MPEGTS_PID_COUNT - 1)];
+			if(pid_state.type == PacketType::UNKNOWN)
+			{
+				pid_state.type = PacketType::SUPPORTED_SECTION;
+			}
 
 			// The last section for PAT
 			// section number starts from 0
@@ -428,7 +440,18 @@ namespace mpegts
 			auto pmt = section->GetPMT();
 			for(const auto &es_info : pmt->_es_info_list)
 			{
-				_packet_type_table.emplace(es_info->_elementary_pid, PacketType::PES);
+				auto &pid_state = _pid_states[es_info->_elementary_pid & (MPEGTS_PID_COUNT - 1)];
+				if((pid_state.type != PacketType::UNKNOWN) || (_es_states.size() >= UINT8_MAX))
+				{
+					continue;
+				}
+
+				pid_state.type = PacketType::PES;
+				pid_state.es_index = _es_states.size();
+
+				EsState es_state;
+				es_state.pid = es_info->_elementary_pid;
+				_es_states.push_back(std::move(es_state));
 			}
 
 			// PMT
@@ -462,49 +485,25 @@ namespace mpegts
 		return true;
 	}
 
-	const std::shared_ptr<Pes> MpegTsDepacketizer::GetPesDraft(uint16_t pid)
-	{
-		std::shared_lock<std::shared_mutex> lock(_pes_draft_map_lock);
-		auto it = _pes_draft_map.find(pid);
-		if(it == _pes_draft_map.end())
-		{
-			return nullptr;
-		}
-
-		return it->second;
-	}
-
-	// incompleted section will be inserted
-	bool MpegTsDepacketizer::SavePesDraft(const std::shared_ptr<Pes> &pes)
-	{
-		std::lock_guard<std::shared_mutex> lock(_pes_draft_map_lock);
-		_pes_draft_map.emplace(pes->PID(), pes);
-
-		return true;
-	}
-
 	// process completed section and remove, extract a elementary stream (es)
-	bool MpegTsDepacketizer::CompletePes(const std::shared_ptr<Pes> &pes)
+	bool MpegTsDepacketizer::CompletePes(EsState &es_state, std::shared_ptr<Pes> pes)
 	{
+		es_state.pes_draft = nullptr;
+
 		if(pes->SetEndOfData() == false)
 		{
 			return false;
 		}
 
+		es_state.last_pes_length = pes->GetLength();
+
 		// there is no media track, extracts it
 		if(_media_tracks.find(pes->PID()) == _media_tracks.end())
 		{
 			CreateTrackInfo(pes);
 		}
 
-		std::unique_lock<std::shared_mutex> lock(_es_list_lock);
 		_es_list.push(pes);
-		lock.unlock();
-
-		std::unique_lock<std::shared_mutex> lock2(_pes_draft_map_lock);
-		// if there is the pes in _pes_draft_map, remove it
-		_pes_draft_map.erase(pes->PID());
-		lock2.unlock();
 
 		return true;
 	}
@@ -37,13 +37,20 @@ namespace mpegts
 		PES = 3
 	};
 
+	// Demuxes MPEG-TS in place.
+	//
+	// TS packets are parsed over 188-byte strides of the received data without being copied,
+	// and the state of each PID is kept in a table indexed by PID instead of maps.
+	// This class is not thread-safe, the caller has to serialize the calls.
 	class MpegTsDepacketizer
 	{
 	public:
 		MpegTsDepacketizer();
 		~MpegTsDepacketizer();
 
+		// Returns false if any of the packets could not be processed
 		bool AddPacket(const std::shared_ptr<const ov::Data> &packet);
+		bool AddPacket(const uint8_t *data, size_t length);
 		bool AddPacket(const std::shared_ptr<MpegTsPacket> &packet);
 
 		bool IsTrackInfoAvailable();
@@ -57,10 +64,31 @@ namespace mpegts
 		const std::shared_ptr<Pes> PopES();
 
 	private:
-		PacketType GetPacketType(const std::shared_ptr<MpegTsPacket> &packet);
-
-		bool ParseSection(const std::shared_ptr<MpegTsPacket> &packet);
-		bool ParsePes(const std::shared_ptr<MpegTsPacket> &packet);
+		struct PidState
+		{
+			PacketType type = PacketType::UNKNOWN;
+			// -1 if no packet has been received
+			int8_t last_continuity_counter = -1;
+			// Index of _es_states (PES only)
+			uint8_t es_index = UINT8_MAX;
+		};
+
+		struct EsState
+		{
+			uint16_t pid = 0;
+			// there is only one pes saved per pid
+			std::shared_ptr<Pes> pes_draft;
+			// Video PES usually has no PES_packet_length,
+			// so the buffer of the next PES is reserved with the length of the previous one
+			size_t last_pes_length = 0;
+		};
+
+		// Parses 188 bytes of buffer
+		bool ParsePacket(const uint8_t *buffer);
+		bool ProcessPacket(MpegTsPacket &packet);
+
+		bool ParseSection(MpegTsPacket &packet);
+		bool ParsePes(MpegTsPacket &packet, EsState &es_state);
 		
 		const std::shared_ptr<Section> GetSectionDraft(uint16_t pid);	
 		// incompleted section will be inserted
@@ -68,26 +96,21 @@ namespace mpegts
 		// process completed section and remove, extract a table
 		bool CompleteSection(const std::shared_ptr<Section> &section);
 
-		const std::shared_ptr<Pes> GetPesDraft(uint16_t pid);	
-		// incompleted section will be inserted
-		bool SavePesDraft(const std::shared_ptr<Pes> &pes);
-		// process completed section and remove, extract a elementary stream (es)
-		bool CompletePes(const std::shared_ptr<Pes> &pes);
+		// process completed pes, extract a elementary stream (es)
+		bool CompletePes(EsState &es_state, std::shared_ptr<Pes> pes);
 
 		bool CreateTrackInfo(const std::shared_ptr<Pes> &pes);
 		bool ExtractH264TrackInfo(const std::shared_ptr<Pes> &pes);
 		bool ExtractAACTrackInfo(const std::shared_ptr<Pes> &pes);
 		
 		// PID : Section
-		std::shared_mutex _section_draft_map_lock;
 		std::map<uint16_t, std::shared_ptr<Section>> _section_draft_map;
-		// PID : PES
-		// there is only one pes saved per pid
-		std::shared_mutex _pes_draft_map_lock;
-		std::map<uint16_t, std::shared_ptr<Pes>> _pes_draft_map;
 
-		// PID : Last continuity counter
-		std::map<uint16_t, uint8_t> _last_continuity_counter_map;
+		// PID : State
+		// PMT's PID comes from PAT
+		// PES's PID comes from PMT/ES_INFO
+		std::vector<PidState> _pid_states;
+		std::vector<EsState> _es_states;
 
 		// PAT
 		bool _pat_list_completed = false;
@@ -109,15 +132,10 @@ namespace mpegts
 		bool _track_list_completed = false;
 		std::map<uint16_t, std::shared_ptr<MediaTrack>> _media_tracks;
 		
-		std::shared_mutex _es_list_lock;
 		std::queue<std::shared_ptr<Pes>> _es_list;
-		
-		// PMT, PES quickly search PMT, PES
-		// PID : PacketType 
-		// PMT's PID comes from PAT
-		// PES's PID comes from PMT/ES_INFO
-		std::map<uint16_t, PacketType>	_packet_type_table;
 
-		std::shared_ptr<ov::Data> _buffer = std::make_shared<ov::Data>();
+		// A packet that is split over two AddPacket() calls
+		uint8_t _partial_packet[MPEGTS_MIN_PACKET_SIZE];
+		size_t _partial_packet_length = 0;
 	};
 }
\ No newline at end of file
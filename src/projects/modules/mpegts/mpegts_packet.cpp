@@ -19,6 +19,7 @@ namespace mpegts
 	{
 		_data = std::make_shared<ov::Data>(MPEGTS_MIN_PACKET_SIZE);
 		_buffer = _data->GetWritableDataAs<uint8_t>();
+		_buffer_length = _data->GetLength();
 	}
 
 	MpegTsPacket::MpegTsPacket(const std::shared_ptr<ov::Data> &data)
@@ -30,6 +31,13 @@ namespace mpegts
 
 		_data = data;
 		_buffer = _data->GetWritableDataAs<uint8_t>();
+		_buffer_length = _data->GetLength();
+	}
+
+	MpegTsPacket::MpegTsPacket(const uint8_t *buffer)
+		: _buffer(buffer),
+		  _buffer_length(MPEGTS_MIN_PACKET_SIZE)
+	{
 	}
 
 	MpegTsPacket::~MpegTsPacket()
@@ -107,40 +115,44 @@ namespace mpegts
 	uint32_t MpegTsPacket::Parse()
 	{
 		// already parsed
-		if(_ts_parser != nullptr)
+		if(_parsed)
 		{
 			return 0;
 		}
 
 		// this time, ome only supports for 188 bytes mpegts packet
-		if(_data->GetLength() < MPEGTS_MIN_PACKET_SIZE)
+		if((_buffer == nullptr) || (_buffer_length < MPEGTS_MIN_PACKET_SIZE))
 		{
 			return 0;
 		}
 
-		_ts_parser = std::make_shared<BitReader>(_buffer, _data->GetLength());
+		_parsed = true;
 
 		//  76543210  76543210  76543210  76543210
 		// [ssssssss][tpTPPPPP][PPPPPPPP][SSaacccc]...
-
-		_sync_byte = _ts_parser->ReadBytes<uint8_t>();
-		_transport_error_indicator = _ts_parser->ReadBoolBit();
+		//
+		// The header is read byte by byte because this is called for every packet
+		_sync_byte = _buffer[0];
+		_transport_error_indicator = OV_GET_BIT(_buffer[1], 7);
 		if(_transport_error_indicator)
 		{
 			// error
 			return 0;	
 		}
 
-		_payload_unit_start_indicator = _ts_parser->ReadBoolBit();
-		_transport_priority = _ts_parser->ReadBit();
-		_packet_identifier = _ts_parser->ReadBits<uint16_t>(13);
-		_transport_scrambling_control = _ts_parser->ReadBits<uint8_t>(2);
-		_adaptation_field_control = _ts_parser->ReadBits<uint8_t>(2);
-		_continuity_counter = _ts_parser->ReadBits<uint8_t>(4);
+		_payload_unit_start_indicator = OV_GET_BIT(_buffer[1], 6);
+		_transport_priority = OV_GET_BIT(_buffer[1], 5);
+		_packet_identifier = ((_buffer[1] & 0x1F) << 8) | _buffer[2];
+		_transport_scrambling_control = (_buffer[3] >> 6) & 0x03;
+		_adaptation_field_control = (_buffer[3] >> 4) & 0x03;
+		_continuity_counter = _buffer[3] & 0x0F;
+
+		BitReader parser(_buffer, MPEGTS_MIN_PACKET_SIZE);
+		parser.SkipBytes(4);
 		
 		if(HasAdaptationField())
 		{
-			if(ParseAdaptationHeader() == false)
+			if(ParseAdaptationHeader(&parser) == false)
 			{
 				logte("Could not parse adaptation header");
 				return 0;
@@ -149,49 +161,49 @@ namespace mpegts
 
 		if(HasPayload())
 		{
-			ParsePayload();
+			ParsePayload(&parser);
 		}
 		
 		// Now, it must be 188 bytes
-		return _ts_parser->BytesConsumed();
+		return MPEGTS_MIN_PACKET_SIZE;
 	}
 
-	bool MpegTsPacket::ParseAdaptationHeader()
+	bool MpegTsPacket::ParseAdaptationHeader(BitReader *parser)
 	{
-		_adaptation_field._length = _ts_parser->ReadBytes<uint8_t>();
+		_adaptation_field._length = parser->ReadBytes<uint8_t>();
 		
-		_ts_parser->StartSection();
+		parser->StartSection();
 
 		if(_adaptation_field._length > 0)
 		{
-			_adaptation_field._discontinuity_indicator = _ts_parser->ReadBoolBit();
-			_adaptation_field._random_access_indicator = _ts_parser->ReadBoolBit();
-			_adaptation_field._elementary_stream_priority_indicator = _ts_parser->ReadBoolBit();
+			_adaptation_field._discontinuity_indicator = parser->ReadBoolBit();
+			_adaptation_field._random_access_indicator = parser->ReadBoolBit();
+			_adaptation_field._elementary_stream_priority_indicator = parser->ReadBoolBit();
 
 			// 5 flags
-			_adaptation_field._pcr_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._opcr_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._splicing_point_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._transport_private_data_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._adaptation_field_extension_flag = _ts_parser->ReadBoolBit();
+			_adaptation_field._pcr_flag = parser->ReadBoolBit();
+			_adaptation_field._opcr_flag = parser->ReadBoolBit();
+			_adaptation_field._splicing_point_flag = parser->ReadBoolBit();
+			_adaptation_field._transport_private_data_flag = parser->ReadBoolBit();
+			_adaptation_field._adaptation_field_extension_flag = parser->ReadBoolBit();
 
 			// Need to parse pcr, opcr, splicing_point_flag, _transport_private_data_flag, _adaptation_field_extension_flag
 			if(_adaptation_field._pcr_flag == true)
 			{
-				_adaptation_field._pcr._base = _ts_parser->ReadBits<uint64_t>(33);
-				_adaptation_field._pcr._reserved = _ts_parser->ReadBits<uint8_t>(6);
-				_adaptation_field._pcr._extension = _ts_parser->ReadBits<uint16_t>(9);
+				_adaptation_field._pcr._base = parser->ReadBits<uint64_t>(33);
+				_adaptation_field._pcr._reserved = parser->ReadBits<uint8_t>(6);
+				_adaptation_field._pcr._extension = parser->ReadBits<uint16_t>(9);
 			}
 
 			if(_adaptation_field._opcr_flag == true)
 			{
 				// We don't use it now, skip for splicing point flag
-				_ts_parser->SkipBytes(6);
+				parser->SkipBytes(6);
 			}
 
 			if(_adaptation_field._splicing_point_flag == true)
 			{
-				_adaptation_field._splice_countdown = _ts_parser->ReadBytes<uint8_t>();
+				_adaptation_field._splice_countdown = parser->ReadBytes<uint8_t>();
 			}
 
 			if(_adaptation_field._transport_private_data_flag)
@@ -206,17 +218,17 @@ namespace mpegts
 		}	
 		
 		// It may contain 
-		auto skip_bytes = _adaptation_field._length - _ts_parser->BytesSetionConsumed();
+		auto skip_bytes = _adaptation_field._length - parser->BytesSetionConsumed();
 
-		return _ts_parser->SkipBytes(skip_bytes);
+		return parser->SkipBytes(skip_bytes);
 	}
 
-	bool MpegTsPacket::ParsePayload()
+	bool MpegTsPacket::ParsePayload(BitReader *parser)
 	{
-		_payload = _ts_parser->CurrentPosition();
-		_payload_length = _packet_size - _ts_parser->BytesConsumed();
+		_payload = parser->CurrentPosition();
+		_payload_length = _packet_size - parser->BytesConsumed();
 		
 		// Just skip A packet
-		return _ts_parser->SkipBytes(_payload_length);
+		return parser->SkipBytes(_payload_length);
 	}
 }
\ No newline at end of file
@@ -53,6 +53,8 @@
 // MPEGTS Packet's length must be 188, 192 or 204
 #define MPEGTS_MIN_PACKET_SIZE		188
 #define MPEGTS_SYNC_BYTE 			0x47
+// PID is 13 bits
+#define MPEGTS_PID_COUNT			8192
 
 namespace mpegts
 {
@@ -153,6 +155,8 @@ namespace mpegts
 	public:
 		MpegTsPacket();
 		MpegTsPacket(const std::shared_ptr<ov::Data> &data);
+		// Parses the 188 bytes of buffer in place (buffer must be valid while the packet is used)
+		explicit MpegTsPacket(const uint8_t *buffer);
 		virtual ~MpegTsPacket();
 
 		//Note: Now, it only supports 188 bytes of mpegts packet
@@ -208,13 +212,14 @@ namespace mpegts
 
 		AdaptationField	_adaptation_field;
 
-		std::shared_ptr<BitReader>	_ts_parser = nullptr;
+		bool						_parsed = false;
 		const uint8_t *				_buffer = nullptr;
+		size_t						_buffer_length = 0;
 		const uint8_t *				_payload = nullptr;
 		size_t						_payload_length = 0;
 		std::shared_ptr<ov::Data>	_data = nullptr;
 
-		bool ParseAdaptationHeader();
-		bool ParsePayload();
+		bool ParseAdaptationHeader(BitReader *parser);
+		bool ParsePayload(BitReader *parser);
 	};
 }
@@ -0,0 +1,514 @@
+//==============================================================================
+//
+//  MPEGTS Packetizer
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "mpegts_packetizer.h"
+
+#include <base/ovlibrary/crc.h>
+
+#define OV_LOG_TAG "MpegTsPacketizer"
+
+#define MPEGTS_PACKET_HEADER_SIZE 4
+#define MPEGTS_MAX_PAYLOAD_SIZE (MPEGTS_MIN_PACKET_SIZE - MPEGTS_PACKET_HEADER_SIZE)
+// Adaptation field length(1) + flags(1) + PCR(6)
+#define MPEGTS_ADAPTATION_FIELD_PCR_SIZE 8
+
+// PAT/PMT are repeated at this interval even if there is no video key frame (Unit: 90 kHz)
+#define MPEGTS_PACKETIZER_TABLES_INTERVAL (90000 / 2)
+// PCR is behind DTS by this value to give the decoder buffer room (same as the default max_delay of libavformat, 0.7 seconds)
+#define MPEGTS_PACKETIZER_PCR_DELAY 63000
+
+#define MPEGTS_TIMESTAMP_MASK 0x1FFFFFFFFLL
+
+#define MPEGTS_VIDEO_STREAM_ID 0xE0
+#define MPEGTS_AUDIO_STREAM_ID 0xC0
+
+namespace mpegts
+{
+	// Access unit delimiters that are inserted if a frame doesn't start with one
+	static const uint8_t H264_AUD[] = {0x00, 0x00, 0x00, 0x01, 0x09, 0xF0};
+	static const uint8_t H265_AUD[] = {0x00, 0x00, 0x00, 0x01, 0x46, 0x01, 0x50};
+
+	// Returns the type of the first NAL unit of an Annex B frame, or -1
+	static int GetFirstNalUnitType(const uint8_t *data, size_t length, bool is_h265)
+	{
+		size_t offset;
+
+		if ((length >= 4) && (data[0] == 0x00) && (data[1] == 0x00) && (data[2] == 0x00) && (data[3] == 0x01))
+		{
+			offset = 4;
+		}
+		else if ((length >= 3) && (data[0] == 0x00) && (data[1] == 0x00) && (data[2] == 0x01))
+		{
+			offset = 3;
+		}
+		else
+		{
+			return -1;
+		}
+
+		if (offset >= length)
+		{
+			return -1;
+		}
+
+		return is_h265 ? ((data[offset] >> 1) & 0x3F) : (data[offset] & 0x1F);
+	}
+
+	static inline void WriteTimestamp(uint8_t *buffer, uint8_t prefix, int64_t timestamp)
+	{
+		buffer[0] = (prefix << 4) | ((timestamp >> 29) & 0x0E) | 0x01;
+		buffer[1] = (timestamp >> 22) & 0xFF;
+		buffer[2] = ((timestamp >> 14) & 0xFE) | 0x01;
+		buffer[3] = (timestamp >> 7) & 0xFF;
+		buffer[4] = ((timestamp << 1) & 0xFE) | 0x01;
+	}
+
+	MpegTsPacketizer::MpegTsPacketizer(ChunkHandler chunk_handler)
+		: _chunk_handler(std::move(chunk_handler))
+	{
+	}
+
+	bool MpegTsPacketizer::AddTrack(const std::shared_ptr<MediaTrack> &track)
+	{
+		Track item;
+
+		switch (track->GetCodecId())
+		{
+			case cmn::MediaCodecId::H264:
+				item.stream_type = static_cast<uint8_t>(WellKnownStreamTypes::H264);
+				break;
+
+			case cmn::MediaCodecId::H265:
+				item.stream_type = static_cast<uint8_t>(WellKnownStreamTypes::H265);
+				break;
+
+			case cmn::MediaCodecId::Aac:
+				item.stream_type = static_cast<uint8_t>(WellKnownStreamTypes::AAC);
+				break;
+
+			case cmn::MediaCodecId::Mp3:
+				item.stream_type = static_cast<uint8_t>(WellKnownStreamTypes::MP3);
+				break;
+
+			default:
+				logtw("Not supported codec: %s (track: %d)", ::StringFromMediaCodecId(track->GetCodecId()).CStr(), track->GetId());
+				return false;
+		}
+
+		// PMT is written in a TS packet
+		if (_tracks.size() >= MPEGTS_PACKETIZER_MAX_TRACKS)
+		{
+			logtw("Too many tracks: %zu (track: %d)", _tracks.size(), track->GetId());
+			return false;
+		}
+
+		auto &timebase = track->GetTimeBase();
+		if ((timebase.GetNum() <= 0) || (timebase.GetDen() <= 0))
+		{
+			logtw("Invalid timebase: %s (track: %d)", timebase.ToString().CStr(), track->GetId());
+			return false;
+		}
+
+		size_t video_count = 0;
+		size_t audio_count = 0;
+		for (auto &added_track : _tracks)
+		{
+			(added_track.track->GetMediaType() == cmn::MediaType::Video) ? video_count++ : audio_count++;
+		}
+
+		item.track = track;
+		item.pid = MPEGTS_PACKETIZER_FIRST_ES_PID + _tracks.size();
+		item.stream_id = (track->GetMediaType() == cmn::MediaType::Video)
+							 ? (MPEGTS_VIDEO_STREAM_ID + video_count)
+							 : (MPEGTS_AUDIO_STREAM_ID + audio_count);
+		item.timescale_to_90khz = 90000.0 * timebase.GetNum() / timebase.GetDen();
+
+		// PCR is carried by the first video track, or the first audio track if there is no video
+		if ((track->GetMediaType() == cmn::MediaType::Video) ? (video_count == 0) : (_tracks.empty()))
+		{
+			_pcr_pid = item.pid;
+		}
+
+		_track_index_map[track->GetId()] = _tracks.size();
+		_tracks.push_back(std::move(item));
+
+		_tables_required = true;
+
+		return true;
+	}
+
+	void MpegTsPacketizer::RequestTables()
+	{
+		_tables_required = true;
+	}
+
+	bool MpegTsPacketizer::AppendFrame(const std::shared_ptr<const MediaPacket> &media_packet)
+	{
+		auto track_item = _track_index_map.find(media_packet->GetTrackId());
+		if (track_item == _track_index_map.end())
+		{
+			return false;
+		}
+
+		auto &track = _tracks[track_item->second];
+
+		auto data = media_packet->GetData();
+		if ((data == nullptr) || (data->GetLength() == 0))
+		{
+			return false;
+		}
+
+		auto payload = data->GetDataAs<uint8_t>();
+		auto payload_length = data->GetLength();
+
+		const uint8_t *prefix = nullptr;
+		size_t prefix_length = 0;
+		const auto codec_id = track.track->GetCodecId();
+
+		switch (codec_id)
+		{
+			case cmn::MediaCodecId::H264:
+			case cmn::MediaCodecId::H265: {
+				const bool is_h265 = (codec_id == cmn::MediaCodecId::H265);
+
+				if (media_packet->GetBitstreamFormat() != (is_h265 ? cmn::BitstreamFormat::H265_ANNEXB : cmn::BitstreamFormat::H264_ANNEXB))
+				{
+					logte("Not supported bitstream format: %d (track: %d)", static_cast<int>(media_packet->GetBitstreamFormat()), track.track->GetId());
+					return false;
+				}
+
+				// AUD (H.264: 9, H.265: 35) is mandatory in MPEG-TS
+				if (GetFirstNalUnitType(payload, payload_length, is_h265) != (is_h265 ? 35 : 9))
+				{
+					prefix = is_h265 ? H265_AUD : H264_AUD;
+					prefix_length = is_h265 ? sizeof(H265_AUD) : sizeof(H264_AUD);
+				}
+				break;
+			}
+
+			case cmn::MediaCodecId::Aac:
+				if (media_packet->GetBitstreamFormat() != cmn::BitstreamFormat::AAC_ADTS)
+				{
+					logte("Not supported bitstream format: %d (track: %d)", static_cast<int>(media_packet->GetBitstreamFormat()), track.track->GetId());
+					return false;
+				}
+				break;
+
+			default:
+				break;
+		}
+
+		int64_t pts = static_cast<int64_t>(media_packet->GetPts() * track.timescale_to_90khz);
+		int64_t dts = static_cast<int64_t>(media_packet->GetDts() * track.timescale_to_90khz);
+
+		if (_rebase_timestamp)
+		{
+			if (_timestamp_offset == -1LL)
+			{
+				// The first frame starts at the PCR delay, so the frames of other tracks that are slightly earlier don't go negative
+				_timestamp_offset = dts - MPEGTS_PACKETIZER_PCR_DELAY;
+			}
+
+			pts -= _timestamp_offset;
+			dts -= _timestamp_offset;
+		}
+		const bool is_video = (track.track->GetMediaType() == cmn::MediaType::Video);
+		const bool is_key_frame = (media_packet->GetFlag() == MediaPacketFlag::Key);
+
+		if (_tables_required ||
+			(is_video && is_key_frame) ||
+			(dts < _last_tables_dts) ||
+			((dts - _last_tables_dts) >= MPEGTS_PACKETIZER_TABLES_INTERVAL))
+		{
+			WriteTables();
+
+			_tables_required = false;
+			_last_tables_dts = dts;
+		}
+
+		// PES header
+		//
+		// packet_start_code_prefix(24) + stream_id(8) + PES_packet_length(16)
+		// '10'(2) + flags(6) + PTS_DTS_flags(2) + flags(6) + PES_header_data_length(8)
+		// PTS(40) + DTS(40)
+		const bool has_dts = (pts != dts);
+		const size_t pes_header_length = 9 + (has_dts ? 10 : 5);
+		const size_t pes_length = pes_header_length + prefix_length + payload_length;
+
+		// Unbounded PES_packet_length is allowed only for video
+		const size_t pes_packet_length = pes_length - 6;
+		if ((is_video == false) && (pes_packet_length > 0xFFFF))
+		{
+			logte("Too large audio frame: %zu bytes (track: %d)", payload_length, track.track->GetId());
+			return false;
+		}
+
+		size_t remaining = pes_length;
+		bool is_first = true;
+
+		while (remaining > 0)
+		{
+			const bool has_pcr = is_first && (track.pid == _pcr_pid);
+
+			auto packet = AllocatePacket();
+			auto packet_payload = WritePacketHeader(
+				packet, track.pid, track.continuity_counter, is_first,
+				has_pcr ? std::max<int64_t>(dts - MPEGTS_PACKETIZER_PCR_DELAY, 0) : -1LL,
+				is_first && is_key_frame,
+				remaining);
+			const size_t packet_payload_length = (packet + MPEGTS_MIN_PACKET_SIZE) - packet_payload;
+
+			size_t written = 0;
+
+			if (is_first)
+			{
+				// The first packet always has room for the PES header and AUD (at most 26 bytes)
+				packet_payload[0] = 0x00;
+				packet_payload[1] = 0x00;
+				packet_payload[2] = 0x01;
+				packet_payload[3] = track.stream_id;
+				packet_payload[4] = (is_video && (pes_packet_length > 0xFFFF)) ? 0x00 : ((pes_packet_length >> 8) & 0xFF);
+				packet_payload[5] = (is_video && (pes_packet_length > 0xFFFF)) ? 0x00 : (pes_packet_length & 0xFF);
+				packet_payload[6] = 0x80;
+				packet_payload[7] = has_dts ? 0xC0 : 0x80;
+				packet_payload[8] = has_dts ? 10 : 5;
+
+				WriteTimestamp(packet_payload + 9, has_dts ? 0x03 : 0x02, pts & MPEGTS_TIMESTAMP_MASK);
+				if (has_dts)
+				{
+					WriteTimestamp(packet_payload + 14, 0x01, dts & MPEGTS_TIMESTAMP_MASK);
+				}
+
+				written = pes_header_length;
+
+				if (prefix_length > 0)
+				{
+					::memcpy(packet_payload + written, prefix, prefix_length);
+					written += prefix_length;
+				}
+
+				is_first = false;
+			}
+
+			const size_t copy_length = packet_payload_length - written;
+			::memcpy(packet_payload + written, payload, copy_length);
+
+			payload += copy_length;
+			remaining -= packet_payload_length;
+
+			CommitPacket();
+		}
+
+		return true;
+	}
+
+	void MpegTsPacketizer::Flush()
+	{
+		if ((_chunk == nullptr) || (_chunk_offset == 0))
+		{
+			return;
+		}
+
+		_chunk->SetLength(_chunk_offset);
+
+		auto chunk = std::move(_chunk);
+		_chunk = nullptr;
+		_chunk_offset = 0;
+
+		if (_chunk_handler != nullptr)
+		{
+			_chunk_handler(chunk);
+		}
+	}
+
+	std::shared_ptr<ov::Data> MpegTsPacketizer::AcquireChunk()
+	{
+		// A chunk that is referenced only by the pool has been released by the consumer
+		for (auto &chunk : _chunk_pool)
+		{
+			if (chunk.use_count() == 1)
+			{
+				chunk->SetLength(MPEGTS_PACKETIZER_CHUNK_SIZE);
+				return chunk;
+			}
+		}
+
+		auto chunk = std::make_shared<ov::Data>(MPEGTS_PACKETIZER_CHUNK_SIZE);
+		chunk->SetLength(MPEGTS_PACKETIZER_CHUNK_SIZE);
+
+		if (_chunk_pool.size() < MPEGTS_PACKETIZER_MAX_POOLED_CHUNKS)
+		{
+			_chunk_pool.push_back(chunk);
+		}
+
+		return chunk;
+	}
+
+	uint8_t *MpegTsPacketizer::AllocatePacket()
+	{
+		if (_chunk == nullptr)
+		{
+			_chunk = AcquireChunk();
+			_chunk_offset = 0;
+		}
+
+		auto packet = _chunk->GetWritableDataAs<uint8_t>() + _chunk_offset;
+		_chunk_offset += MPEGTS_MIN_PACKET_SIZE;
+
+		return packet;
+	}
+
+	void MpegTsPacketizer::CommitPacket()
+	{
+		if (_chunk_offset >= MPEGTS_PACKETIZER_CHUNK_SIZE)
+		{
+			Flush();
+		}
+	}
+
+	uint8_t *MpegTsPacketizer::WritePacketHeader(uint8_t *packet, uint16_t pid, uint8_t &continuity_counter, bool payload_unit_start,
+												 int64_t pcr, bool random_access, size_t payload_length)
+	{
+		const bool has_pcr = (pcr >= 0);
+
+		// The adaptation field is needed for PCR/random_access_indicator, and to stuff the last packet of a PES
+		const size_t min_adaptation_field_length = has_pcr ? MPEGTS_ADAPTATION_FIELD_PCR_SIZE : (random_access ? 2 : 0);
+		size_t adaptation_field_length = min_adaptation_field_length;
+
+		if (payload_length < (MPEGTS_MAX_PAYLOAD_SIZE - min_adaptation_field_length))
+		{
+			adaptation_field_length = MPEGTS_MAX_PAYLOAD_SIZE - payload_length;
+		}
+
+		packet[0] = MPEGTS_SYNC_BYTE;
+		packet[1] = (payload_unit_start ? 0x40 : 0x00) | ((pid >> 8) & 0x1F);
+		packet[2] = pid & 0xFF;
+		packet[3] = ((adaptation_field_length > 0) ? 0x30 : 0x10) | continuity_counter;
+
+		continuity_counter = (continuity_counter + 1) & 0x0F;
+
+		if (adaptation_field_length > 0)
+		{
+			auto adaptation_field = packet + MPEGTS_PACKET_HEADER_SIZE;
+
+			// adaptation_field_length doesn't include itself
+			adaptation_field[0] = adaptation_field_length - 1;
+
+			if (adaptation_field_length > 1)
+			{
+				size_t offset = 2;
+
+				adaptation_field[1] = (random_access ? 0x40 : 0x00) | (has_pcr ? 0x10 : 0x00);
+
+				if (has_pcr)
+				{
+					// program_clock_reference_base(33) + reserved(6) + program_clock_reference_extension(9)
+					const int64_t pcr_base = pcr & MPEGTS_TIMESTAMP_MASK;
+
+					adaptation_field[2] = (pcr_base >> 25) & 0xFF;
+					adaptation_field[3] = (pcr_base >> 17) & 0xFF;
+					adaptation_field[4] = (pcr_base >> 9) & 0xFF;
+					adaptation_field[5] = (pcr_base >> 1) & 0xFF;
+					adaptation_field[6] = ((pcr_base & 0x01) << 7) | 0x7E;
+					adaptation_field[7] = 0x00;
+
+					offset += 6;
+				}
+
+				// Stuffing bytes
+				::memset(adaptation_field + offset, 0xFF, adaptation_field_length - offset);
+			}
+		}
+
+		return packet + MPEGTS_PACKET_HEADER_SIZE + adaptation_field_length;
+	}
+
+	void MpegTsPacketizer::WriteTables()
+	{
+		uint8_t section[MPEGTS_MAX_PAYLOAD_SIZE - 1];
+		size_t offset;
+
+		// PAT
+		//
+		// table_id(8) + section_syntax_indicator(1) + '0'(1) + reserved(2) + section_length(12)
+		// transport_stream_id(16) + reserved(2) + version_number(5) + current_next_indicator(1)
+		// section_number(8) + last_section_number(8)
+		// program_number(16) + reserved(3) + program_map_PID(13)
+		// CRC_32(32)
+		section[0] = 0x00;
+		section[3] = 0x00;
+		section[4] = 0x01;
+		section[5] = 0xC1;
+		section[6] = 0x00;
+		section[7] = 0x00;
+		section[8] = (MPEGTS_PACKETIZER_PROGRAM_NUMBER >> 8) & 0xFF;
+		section[9] = MPEGTS_PACKETIZER_PROGRAM_NUMBER & 0xFF;
+		section[10] = 0xE0 | ((MPEGTS_PACKETIZER_PMT_PID >> 8) & 0x1F);
+		section[11] = MPEGTS_PACKETIZER_PMT_PID & 0xFF;
+		offset = 12;
+
+		WriteSection(static_cast<uint16_t>(WellKnownPacketId::PAT), _pat_continuity_counter, section, offset);
+
+		// PMT
+		//
+		// table_id(8) + section_syntax_indicator(1) + '0'(1) + reserved(2) + section_length(12)
+		// program_number(16) + reserved(2) + version_number(5) + current_next_indicator(1)
+		// section_number(8) + last_section_number(8)
+		// reserved(3) + PCR_PID(13) + reserved(4) + program_info_length(12)
+		// N * (stream_type(8) + reserved(3) + elementary_PID(13) + reserved(4) + ES_info_length(12))
+		// CRC_32(32)
+		section[0] = 0x02;
+		section[3] = (MPEGTS_PACKETIZER_PROGRAM_NUMBER >> 8) & 0xFF;
+		section[4] = MPEGTS_PACKETIZER_PROGRAM_NUMBER & 0xFF;
+		section[5] = 0xC1;
+		section[6] = 0x00;
+		section[7] = 0x00;
+		section[8] = 0xE0 | ((_pcr_pid >> 8) & 0x1F);
+		section[9] = _pcr_pid & 0xFF;
+		section[10] = 0xF0;
+		section[11] = 0x00;
+		offset = 12;
+
+		for (auto &track : _tracks)
+		{
+			section[offset + 0] = track.stream_type;
+			section[offset + 1] = 0xE0 | ((track.pid >> 8) & 0x1F);
+			section[offset + 2] = track.pid & 0xFF;
+			section[offset + 3] = 0xF0;
+			section[offset + 4] = 0x00;
+			offset += 5;
+		}
+
+		WriteSection(MPEGTS_PACKETIZER_PMT_PID, _pmt_continuity_counter, section, offset);
+	}
+
+	void MpegTsPacketizer::WriteSection(uint16_t pid, uint8_t &continuity_counter, uint8_t *section, size_t length)
+	{
+		// section_length counts the bytes after itself including CRC_32
+		const size_t section_length = length - 3 + 4;
+		section[1] = 0xB0 | ((section_length >> 8) & 0x0F);
+		section[2] = section_length & 0xFF;
+
+		const uint32_t crc = ov::CRC::Crc32Mpeg2(section, length);
+		section[length + 0] = (crc >> 24) & 0xFF;
+		section[length + 1] = (crc >> 16) & 0xFF;
+		section[length + 2] = (crc >> 8) & 0xFF;
+		section[length + 3] = crc & 0xFF;
+		length += 4;
+
+		auto packet = AllocatePacket();
+		auto payload = WritePacketHeader(packet, pid, continuity_counter, true, -1LL, false, MPEGTS_MAX_PAYLOAD_SIZE);
+
+		// pointer_field(8) + section + stuffing
+		payload[0] = 0x00;
+		::memcpy(payload + 1, section, length);
+		::memset(payload + 1 + length, 0xFF, MPEGTS_MAX_PAYLOAD_SIZE - 1 - length);
+
+		CommitPacket();
+	}
+}  // namespace mpegts
@@ -0,0 +1,112 @@
+//==============================================================================
+//
+//  MPEGTS Packetizer
+//
+//  Created by Getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/info/media_track.h>
+#include <base/mediarouter/media_buffer.h>
+#include <base/ovlibrary/ovlibrary.h>
+
+#include "mpegts_packet.h"
+#include "mpegts_section.h"
+
+// 7 TS packets (1316 bytes) fit in an UDP datagram over ethernet
+#define MPEGTS_PACKETIZER_PACKETS_PER_CHUNK 7
+#define MPEGTS_PACKETIZER_CHUNK_SIZE (MPEGTS_MIN_PACKET_SIZE * MPEGTS_PACKETIZER_PACKETS_PER_CHUNK)
+// Chunks that are still referenced by the consumer are not reused, so the pool grows up to this count
+#define MPEGTS_PACKETIZER_MAX_POOLED_CHUNKS 64
+
+#define MPEGTS_PACKETIZER_PMT_PID 0x1000
+#define MPEGTS_PACKETIZER_FIRST_ES_PID 0x0100
+#define MPEGTS_PACKETIZER_PROGRAM_NUMBER 1
+#define MPEGTS_PACKETIZER_MAX_TRACKS 32
+
+namespace mpegts
+{
+	// Muxes MediaPackets into MPEG-TS without libavformat.
+	//
+	// TS packets are written straight into pooled chunks of MPEGTS_PACKETIZER_CHUNK_SIZE bytes:
+	// The PES header is written in place in the first TS packet of a frame, and the payload is copied
+	// from the MediaPacket only once, into the chunk that is delivered to the consumer.
+	// Supported formats: H264_ANNEXB, H265_ANNEXB, AAC_ADTS, MP3
+	class MpegTsPacketizer
+	{
+	public:
+		// Called for every full chunk (and the partial chunk on Flush()).
+		// The chunk is reused once the consumer releases it.
+		using ChunkHandler = std::function<void(const std::shared_ptr<const ov::Data> &chunk)>;
+
+		MpegTsPacketizer(ChunkHandler chunk_handler);
+
+		bool AddTrack(const std::shared_ptr<MediaTrack> &track);
+
+		// If true, timestamps are rebased so that the PCR starts from 0 (like TIMESTAMP_STARTZERO_MODE of ffmpeg::Writer).
+		// Otherwise, the timestamps of the MediaPackets are used as they are.
+		void SetRebaseTimestamp(bool rebase_timestamp)
+		{
+			_rebase_timestamp = rebase_timestamp;
+		}
+
+		// PAT/PMT are written before the next frame (They are also written before every video key frame)
+		void RequestTables();
+
+		bool AppendFrame(const std::shared_ptr<const MediaPacket> &media_packet);
+
+		// Delivers the partially filled chunk
+		void Flush();
+
+	private:
+		struct Track
+		{
+			std::shared_ptr<MediaTrack> track;
+
+			uint16_t pid = 0;
+			uint8_t stream_type = 0;
+			uint8_t stream_id = 0;
+			uint8_t continuity_counter = 0;
+
+			// Multiply by this to convert the timestamp to 90 kHz
+			double timescale_to_90khz = 0.0;
+		};
+
+		// Returns the next 188 bytes of the current chunk
+		uint8_t *AllocatePacket();
+		// Delivers the current chunk if it is full. Must be called after a packet is written.
+		void CommitPacket();
+		std::shared_ptr<ov::Data> AcquireChunk();
+
+		// Writes the TS header and the adaptation field, and returns the payload
+		uint8_t *WritePacketHeader(uint8_t *packet, uint16_t pid, uint8_t &continuity_counter, bool payload_unit_start,
+								   int64_t pcr, bool random_access, size_t payload_length);
+
+		void WriteTables();
+		// section: Has room for CRC_32 after the length bytes, and section_length/CRC_32 are written here
+		void WriteSection(uint16_t pid, uint8_t &continuity_counter, uint8_t *section, size_t length);
+
+		ChunkHandler _chunk_handler;
+
+		std::vector<Track> _tracks;
+		// Track ID : Index of _tracks
+		std::map<int32_t, size_t> _track_index_map;
+
+		uint16_t _pcr_pid = 0x1FFF;
+
+		bool _rebase_timestamp = false;
+		// Unit: 90 kHz
+		int64_t _timestamp_offset = -1LL;
+
+		bool _tables_required = true;
+		int64_t _last_tables_dts = -1LL;
+		uint8_t _pat_continuity_counter = 0;
+		uint8_t _pmt_continuity_counter = 0;
+
+		std::shared_ptr<ov::Data> _chunk;
+		size_t _chunk_offset = 0;
+		std::vector<std::shared_ptr<ov::Data>> _chunk_pool;
+	};
+}  // namespace mpegts
@@ -4,9 +4,14 @@
 
 namespace mpegts
 {
-	Pes::Pes(uint16_t pid)
+	Pes::Pes(uint16_t pid, size_t capacity_hint)
 	{
 		_pid = pid;
+
+		if (capacity_hint > 0)
+		{
+			_data.Reserve(capacity_hint);
+		}
 	}
 
 	Pes::~Pes()
@@ -134,6 +139,12 @@ namespace mpegts
 		_stream_id = parser->ReadBytes<uint8_t>();
 		_pes_packet_length = parser->ReadBytes<uint16_t>();
 
+		// Assemble the PES into a buffer of the exact length if it is known
+		if (_pes_packet_length != 0)
+		{
+			_data.Reserve(MPEGTS_PES_HEADER_SIZE + _pes_packet_length);
+		}
+
 		_pes_header_parsed = true;
 		return true;
 	}
@@ -352,4 +363,14 @@ namespace mpegts
 	{
 		return _payload_length;
 	}
+
+	std::shared_ptr<ov::Data> Pes::GetPayloadData()
+	{
+		if (_completed == false)
+		{
+			return nullptr;
+		}
+
+		return _data.Subdata(_payload - _data.GetDataAs<uint8_t>(), _payload_length);
+	}
 }
\ No newline at end of file
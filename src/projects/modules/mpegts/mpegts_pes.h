@@ -45,7 +45,8 @@ namespace mpegts
 	class Pes
 	{
 	public:
-		Pes(uint16_t pid);
+		// capacity_hint: Expected length of the PES to reserve the buffer
+		Pes(uint16_t pid, size_t capacity_hint = 0);
 		~Pes();
 		
 		// return consumed length
@@ -74,6 +75,13 @@ namespace mpegts
 
 		const uint8_t* Payload();
 		uint32_t PayloadLength();
+		// Payload that shares the buffer of the PES without copying
+		std::shared_ptr<ov::Data> GetPayloadData();
+		// Length of the PES including the header
+		size_t GetLength() const
+		{
+			return _data.GetLength();
+		}
 
 		inline bool IsAudioStream() const
 		{
@@ -43,6 +43,7 @@ namespace mpegts
 
 	enum class WellKnownStreamTypes : uint8_t
 	{
+		MP3 = 0x03, // ISO/IEC 11172-3 audio
 		H264 = 0x1B,
 		H265 = 0x24,
 		AAC = 0x0F, // AAC ADTS
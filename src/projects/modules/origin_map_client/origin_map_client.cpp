@@ -11,6 +11,9 @@
 
 #define OV_LOG_TAG "OriginMapClient"
 
+// Relay nodes that have not been updated for this time are regarded as dead
+#define OV_ORIGIN_MAP_RELAY_EXPIRE_SEC 10
+
 OriginMapClient::OriginMapClient(const ov::String &redis_host, const ov::String &redis_password)
 {
 	// Parse ip:port 
@@ -35,10 +38,23 @@ OriginMapClient::OriginMapClient(const ov::String &redis_host, const ov::String
 
 bool OriginMapClient::NofifyStreamsAlive()
 {
-	std::lock_guard<std::mutex> lock(_origin_map_mutex);
-	for (auto &[key, value] : _origin_map)
 	{
-		Update(key, value);
+		std::lock_guard<std::mutex> lock(_origin_map_mutex);
+		for (auto &[key, value] : _origin_map)
+		{
+			Update(key, value);
+		}
+	}
+
+	std::map<ov::String, RelayNode> relay_map;
+	{
+		std::lock_guard<std::mutex> lock(_relay_map_mutex);
+		relay_map = _relay_map;
+	}
+
+	for (auto &[key, node] : relay_map)
+	{
+		UpdateRelay(key, node);
 	}
 
 	return true;
@@ -152,6 +168,234 @@ CommonErrorCode OriginMapClient::GetOrigin(const ov::String &app_stream_name, ov
 	return CommonErrorCode::SUCCESS;
 }
 
+bool OriginMapClient::RegisterRelay(const ov::String &app_stream_name, const ov::String &relay_url, uint32_t depth)
+{
+	RelayNode node;
+	node.url = relay_url;
+	node.depth = depth;
+
+	if (UpdateRelay(app_stream_name, node) == false)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> relay_map_lock(_relay_map_mutex);
+	_relay_map[app_stream_name] = node;
+
+	logti("<%s> is registered as a relay node (depth: %u, url: %s)", app_stream_name.CStr(), depth, relay_url.CStr());
+
+	return true;
+}
+
+bool OriginMapClient::UnregisterRelay(const ov::String &app_stream_name)
+{
+	ov::String relay_url;
+	{
+		std::lock_guard<std::mutex> relay_map_lock(_relay_map_mutex);
+		auto item = _relay_map.find(app_stream_name);
+		if (item == _relay_map.end())
+		{
+			return true;
+		}
+
+		relay_url = item->second.url;
+		_relay_map.erase(item);
+	}
+
+	if (ConnectRedis() == false)
+	{
+		logte("Failed to connect redis server : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, _redis_context!=nullptr?_redis_context->errstr:"nil");
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_redis_context_mutex);
+
+	auto reply = (redisReply *)redisCommand(_redis_context, "HDEL %s@relays %s", app_stream_name.CStr(), relay_url.CStr());
+	if (reply != nullptr)
+	{
+		freeReplyObject(reply);
+	}
+
+	reply = (redisReply *)redisCommand(_redis_context, "HDEL %s@fanout %s", app_stream_name.CStr(), relay_url.CStr());
+	if (reply != nullptr)
+	{
+		freeReplyObject(reply);
+	}
+
+	return true;
+}
+
+void OriginMapClient::UpdateFanOut(const ov::String &app_stream_name, uint32_t fan_out)
+{
+	std::lock_guard<std::mutex> relay_map_lock(_relay_map_mutex);
+	auto item = _relay_map.find(app_stream_name);
+	if (item != _relay_map.end())
+	{
+		item->second.fan_out = fan_out;
+	}
+}
+
+bool OriginMapClient::UpdateRelay(const ov::String &app_stream_name, const RelayNode &node)
+{
+	if (ConnectRedis() == false)
+	{
+		logte("Failed to connect redis server : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, _redis_context!=nullptr?_redis_context->errstr:"nil");
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_redis_context_mutex);
+
+	auto relay_key = ov::String::FormatString("%s@relays", app_stream_name.CStr());
+	auto fan_out_key = ov::String::FormatString("%s@fanout", app_stream_name.CStr());
+	auto value = ov::String::FormatString("%u:%lld", node.depth, static_cast<long long>(ov::Time::GetTimestamp()));
+
+	auto fan_out = ov::Converter::ToString(node.fan_out);
+
+	// The hashes are expired together with the last relay node, like the origin key
+	std::vector<std::pair<ov::String, ov::String>> fields = {
+		{relay_key, value},
+		{fan_out_key, fan_out}};
+
+	for (auto &[key, field_value] : fields)
+	{
+		auto reply = (redisReply *)redisCommand(_redis_context, "HSET %s %s %s", key.CStr(), node.url.CStr(), field_value.CStr());
+		if (reply == nullptr || reply->type == REDIS_REPLY_ERROR)
+		{
+			logte("Failed to set relay node to redis : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, reply!=nullptr?reply->str:"nil");
+			if (reply != nullptr)
+			{
+				freeReplyObject(reply);
+			}
+			return false;
+		}
+		freeReplyObject(reply);
+
+		reply = (redisReply *)redisCommand(_redis_context, "EXPIRE %s %d", key.CStr(), OV_ORIGIN_MAP_RELAY_EXPIRE_SEC);
+		if (reply != nullptr)
+		{
+			freeReplyObject(reply);
+		}
+	}
+
+	return true;
+}
+
+CommonErrorCode OriginMapClient::GetRelayOrigin(const ov::String &app_stream_name, uint32_t max_depth, uint32_t max_fan_out, ov::String &origin_host, uint32_t &depth)
+{
+	auto result = GetOrigin(app_stream_name, origin_host);
+	depth = 0;
+	if (result != CommonErrorCode::SUCCESS)
+	{
+		return result;
+	}
+
+	std::lock_guard<std::mutex> lock(_redis_context_mutex);
+
+	std::map<ov::String, uint32_t> fan_out_map;
+	auto reply = (redisReply *)redisCommand(_redis_context, "HGETALL %s@fanout", app_stream_name.CStr());
+	if (reply != nullptr && reply->type == REDIS_REPLY_ARRAY)
+	{
+		for (size_t index = 0; index + 1 < reply->elements; index += 2)
+		{
+			fan_out_map[reply->element[index]->str] = ov::Converter::ToUInt32(reply->element[index + 1]->str);
+		}
+	}
+	if (reply != nullptr)
+	{
+		freeReplyObject(reply);
+	}
+
+	reply = (redisReply *)redisCommand(_redis_context, "HGETALL %s@relays", app_stream_name.CStr());
+	if (reply == nullptr || reply->type != REDIS_REPLY_ARRAY)
+	{
+		if (reply != nullptr)
+		{
+			freeReplyObject(reply);
+		}
+
+		// Relay tree is not used by the origin, use the origin
+		return CommonErrorCode::SUCCESS;
+	}
+
+	auto now = ov::Time::GetTimestamp();
+	const RelayNode *selected = nullptr;
+	std::vector<RelayNode> nodes;
+	std::vector<ov::String> expired_urls;
+
+	nodes.reserve(reply->elements / 2);
+	for (size_t index = 0; index + 1 < reply->elements; index += 2)
+	{
+		ov::String url = reply->element[index]->str;
+		auto tokens = ov::String(reply->element[index + 1]->str).Split(":");
+		if (tokens.size() != 2)
+		{
+			continue;
+		}
+
+		if ((now - ov::Converter::ToInt64(tokens[1])) > OV_ORIGIN_MAP_RELAY_EXPIRE_SEC)
+		{
+			// The relay node has been stopped unexpectedly
+			expired_urls.push_back(url);
+			continue;
+		}
+
+		RelayNode node;
+		node.url = url;
+		node.depth = ov::Converter::ToUInt32(tokens[0]);
+		auto fan_out = fan_out_map.find(url);
+		node.fan_out = (fan_out != fan_out_map.end()) ? fan_out->second : 0;
+
+		nodes.push_back(node);
+	}
+	freeReplyObject(reply);
+
+	for (auto &node : nodes)
+	{
+		// The edge that pulls from this node will be (depth + 1)
+		if ((node.depth >= max_depth) || (max_fan_out > 0 && node.fan_out >= max_fan_out))
+		{
+			continue;
+		}
+
+		// The shallowest node first, then the least loaded node
+		if ((selected == nullptr) ||
+			(node.depth < selected->depth) ||
+			(node.depth == selected->depth && node.fan_out < selected->fan_out))
+		{
+			selected = &node;
+		}
+	}
+
+	for (auto &url : expired_urls)
+	{
+		reply = (redisReply *)redisCommand(_redis_context, "HDEL %s@relays %s", app_stream_name.CStr(), url.CStr());
+		if (reply != nullptr)
+		{
+			freeReplyObject(reply);
+		}
+	}
+
+	if (selected == nullptr)
+	{
+		// All nodes are full, fall back to the origin
+		logtw("<%s> There is no relay node with room (max depth: %u, max fan-out: %u), use the origin", app_stream_name.CStr(), max_depth, max_fan_out);
+		return CommonErrorCode::SUCCESS;
+	}
+
+	// Reserve a slot on the selected node so that a burst of edges does not pile on the same node
+	// until the node reports its real fan-out
+	reply = (redisReply *)redisCommand(_redis_context, "HINCRBY %s@fanout %s 1", app_stream_name.CStr(), selected->url.CStr());
+	if (reply != nullptr)
+	{
+		freeReplyObject(reply);
+	}
+
+	origin_host = selected->url;
+	depth = selected->depth;
+
+	return CommonErrorCode::SUCCESS;
+}
+
 bool OriginMapClient::ConnectRedis()
 {
 	std::lock_guard<std::mutex> lock(_redis_context_mutex);
@@ -30,7 +30,31 @@ public:
 
 	CommonErrorCode GetOrigin(const ov::String &app_stream_name, ov::String &origin_host);
 
+	// Relay tree
+	// An origin registers itself as a node of depth 0, and an edge that re-publishes a pulled stream via OVT
+	// registers itself as a node of (depth of its source + 1). Other edges are attached to the shallowest node
+	// that still has room (fan-out < max_fan_out), and the least loaded one among them.
+	//
+	// <app/stream>@relays : hash of { relay_url : "depth:updated_time" }
+	// <app/stream>@fanout : hash of { relay_url : number of OVT sessions }
+	bool RegisterRelay(const ov::String &app_stream_name, const ov::String &relay_url, uint32_t depth);
+	bool UnregisterRelay(const ov::String &app_stream_name);
+	// The fan-out is reported to redis by _update_timer
+	void UpdateFanOut(const ov::String &app_stream_name, uint32_t fan_out);
+
+	// If there is no relay node with room, the origin is returned with depth 0
+	CommonErrorCode GetRelayOrigin(const ov::String &app_stream_name, uint32_t max_depth, uint32_t max_fan_out, ov::String &origin_host, uint32_t &depth);
+
 private:
+	struct RelayNode
+	{
+		ov::String url;
+		uint32_t depth = 0;
+		uint32_t fan_out = 0;
+	};
+
+	bool UpdateRelay(const ov::String &app_stream_name, const RelayNode &node);
+
 	bool CheckConnection();
 	bool ConnectRedis();
 
@@ -45,6 +69,10 @@ private:
 	std::map<ov::String, ov::String> _origin_map;
 	std::mutex _origin_map_mutex;
 
+	// key : app/stream
+	std::map<ov::String, RelayNode> _relay_map;
+	std::mutex _relay_map_mutex;
+
 	redisContext *_redis_context = nullptr;
 	std::mutex _redis_context_mutex;
 };
\ No newline at end of file
@@ -73,6 +73,12 @@ public:
 		return _lost_ids[index];
 	}
 
+	// Lost IDs should be added in ascending order to be packed into fewer FCIs
+	void AddLostId(uint16_t id)
+	{
+		_lost_ids.push_back(id);
+	}
+
 private:
 	uint32_t	_src_ssrc = 0;
 	uint32_t	_media_ssrc = 0;
@@ -1,7 +1,7 @@
 #include <base/ovlibrary/byte_io.h>
 #include "rtp_depacketizer_generic_audio.h"
 
-std::shared_ptr<ov::Data> RtpDepacketizerGenericAudio::ParseAndAssembleFrame(std::vector<std::shared_ptr<ov::Data>> payload_list)
+std::shared_ptr<ov::Data> RtpDepacketizerGenericAudio::ParseAndAssembleFrame(const std::vector<std::shared_ptr<ov::Data>> &payload_list)
 {
 	if(payload_list.size() <= 0)
 	{
@@ -10,14 +10,15 @@ std::shared_ptr<ov::Data> RtpDepacketizerGenericAudio::ParseAndAssembleFrame(std
 
 	if(payload_list.size() == 1)
 	{
-		return payload_list.at(0);
+		// Copy the payload since it may refer to the memory of the RTP packet
+		auto &payload = payload_list.at(0);
+		return std::make_shared<ov::Data>(payload->GetData(), payload->GetLength());
 	}
 
 	auto reserve_size = 0;
 	for(auto &payload : payload_list)
 	{
 		reserve_size += payload->GetLength();
-		reserve_size += 16; // spare
 	}
 
 	auto bitstream = std::make_shared<ov::Data>(reserve_size);
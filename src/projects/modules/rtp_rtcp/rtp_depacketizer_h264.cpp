@@ -1,57 +1,51 @@
 #include <base/ovlibrary/byte_io.h>
 #include "rtp_depacketizer_h264.h"
 
-std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseAndAssembleFrame(std::vector<std::shared_ptr<ov::Data>> payload_list)
+std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseAndAssembleFrame(const std::vector<std::shared_ptr<ov::Data>> &payload_list)
 {
 	if(payload_list.size() <= 0)
 	{
 		return nullptr;
 	}
 
-	auto reserve_size = 0;
-	for(auto &payload : payload_list)
+	// The size of the frame is known from the payloads, so the frame is assembled into a single buffer
+	size_t reserve_size = 0;
+	bool start_payload = true;
+	for(const auto &payload : payload_list)
 	{
-		reserve_size += payload->GetLength();
-		reserve_size += 16; // spare
+		reserve_size += GetAnnexBSize(payload, start_payload);
+		start_payload = false;
 	}
 
 	auto bitstream = std::make_shared<ov::Data>(reserve_size);
-	bool start_payload = true;
+	start_payload = true;
 	for(const auto &payload : payload_list)
 	{
+		if(payload->GetLength() < NAL_HEADER_SIZE)
+		{
+			return nullptr;
+		}
+
 		uint8_t nal_type = (payload->GetDataAs<uint8_t>()[0]) & NAL_TYPE_MASK;
-		std::shared_ptr<ov::Data> result;
+		bool result;
 
 		// Fragmented NAL units
 		if(nal_type == NaluType::kFuA)
 		{
-			result = ParseFuaAndConvertAnnexB(payload, start_payload);
-			if(result == nullptr)
-			{
-				return nullptr;
-			}
-
-			bitstream->Append(result);
+			result = ParseFuaAndConvertAnnexB(payload, start_payload, bitstream);
 		}
 		else if(nal_type == NaluType::kStapA)
 		{
-			result = ParseStapAAndConvertToAnnexB(payload);
-			if(result == nullptr)
-			{
-				return nullptr;
-			}
-
-			bitstream->Append(result);
+			result = ParseStapAAndConvertToAnnexB(payload, bitstream);
 		}
 		else
 		{
-			result = ConvertSingleNaluToAnnexB(payload);
-			if(result == nullptr)
-			{
-				return nullptr;
-			}
+			result = ConvertSingleNaluToAnnexB(payload, bitstream);
+		}
 
-			bitstream->Append(result);
+		if(result == false)
+		{
+			return nullptr;
 		}
 
 		start_payload = false;
@@ -60,14 +54,54 @@ std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseAndAssembleFrame(std::vector
 	return bitstream;
 }
 
-std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseFuaAndConvertAnnexB(const std::shared_ptr<ov::Data> &payload, bool start)
+size_t RtpDepacketizerH264::GetAnnexBSize(const std::shared_ptr<ov::Data> &payload, bool start)
 {
-	auto bitstream = std::make_shared<ov::Data>(payload->GetLength() + 16);
+	auto length = payload->GetLength();
+
+	if(length < NAL_HEADER_SIZE)
+	{
+		return 0;
+	}
+
+	auto buffer = payload->GetDataAs<uint8_t>();
+	uint8_t nal_type = buffer[0] & NAL_TYPE_MASK;
+
+	if(nal_type == NaluType::kFuA)
+	{
+		if(length < FUA_HEADER_SIZE)
+		{
+			return 0;
+		}
+
+		bool first_fragment = (buffer[1] & FUA_SBIT) > 0;
+
+		return (length - FUA_HEADER_SIZE) + ((first_fragment || start) ? (ANNEXB_START_PREFIX_LENGTH + NAL_HEADER_SIZE) : 0);
+	}
+	else if(nal_type == NaluType::kStapA)
+	{
+		// Each length field (2 bytes) is replaced with a start prefix (4 bytes)
+		size_t size = 0;
+		size_t offset = NAL_HEADER_SIZE;
 
+		while(offset + LENGTH_FIELD_SIZE <= length)
+		{
+			uint16_t nalu_size = ByteReader<uint16_t>::ReadBigEndian(&buffer[offset]);
+			offset += LENGTH_FIELD_SIZE + nalu_size;
+			size += ANNEXB_START_PREFIX_LENGTH + nalu_size;
+		}
+
+		return size;
+	}
+
+	return ANNEXB_START_PREFIX_LENGTH + length;
+}
+
+bool RtpDepacketizerH264::ParseFuaAndConvertAnnexB(const std::shared_ptr<ov::Data> &payload, bool start, const std::shared_ptr<ov::Data> &bitstream)
+{
 	if(payload->GetLength() < FUA_HEADER_SIZE)
 	{
 		// Invalid Data
-		return nullptr;
+		return false;
 	}
 
 	auto buffer = payload->GetDataAs<uint8_t>();
@@ -89,12 +123,10 @@ std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseFuaAndConvertAnnexB(const st
 		bitstream->Append(start_prefix_and_nal_header, ANNEXB_START_PREFIX_LENGTH + NAL_HEADER_SIZE);
 	}
 	
-	bitstream->Append(payload->Subdata(FUA_HEADER_SIZE));
-
-	return bitstream;
+	return bitstream->Append(buffer + FUA_HEADER_SIZE, payload->GetLength() - FUA_HEADER_SIZE);
 }
 
-std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseStapAAndConvertToAnnexB(const std::shared_ptr<ov::Data> &payload)
+bool RtpDepacketizerH264::ParseStapAAndConvertToAnnexB(const std::shared_ptr<ov::Data> &payload, const std::shared_ptr<ov::Data> &bitstream)
 {
 	/*
 	https://tools.ietf.org/html/rfc6184#section-5.7.1
@@ -118,12 +150,11 @@ std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseStapAAndConvertToAnnexB(cons
     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 	*/
 
-	auto bitstream = std::make_shared<ov::Data>(payload->GetLength() + 1024);
 	uint8_t start_prefix[ANNEXB_START_PREFIX_LENGTH] = {0, 0, 0, 1};
 
 	if(payload->GetLength() < NAL_HEADER_SIZE + LENGTH_FIELD_SIZE)
 	{
-		return nullptr;
+		return false;
 	}
 
 	auto payload_buffer = payload->GetDataAs<uint8_t>();
@@ -140,7 +171,7 @@ std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseStapAAndConvertToAnnexB(cons
 
 		if(offset + nalu_size > payload_length)
 		{
-			return nullptr;
+			return false;
 		}
 
 		// Start Prefix
@@ -156,12 +187,11 @@ std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseStapAAndConvertToAnnexB(cons
 		offset += nalu_size;
 	}
 
-	return bitstream;
+	return true;
 }
 
-std::shared_ptr<ov::Data> RtpDepacketizerH264::ConvertSingleNaluToAnnexB(const std::shared_ptr<ov::Data> &payload)
+bool RtpDepacketizerH264::ConvertSingleNaluToAnnexB(const std::shared_ptr<ov::Data> &payload, const std::shared_ptr<ov::Data> &bitstream)
 {
-	auto bitstream = std::make_shared<ov::Data>(payload->GetLength() + ANNEXB_START_PREFIX_LENGTH);
 	uint8_t start_prefix[ANNEXB_START_PREFIX_LENGTH] = {0, 0, 0, 1};
 
 	bitstream->Append(start_prefix, ANNEXB_START_PREFIX_LENGTH);
@@ -170,5 +200,5 @@ std::shared_ptr<ov::Data> RtpDepacketizerH264::ConvertSingleNaluToAnnexB(const s
 	[[maybe_unused]] uint8_t nal_type = payload->GetDataAs<uint8_t>()[0] & NAL_TYPE_MASK;
 	logd("DEBUG", "Single Nal Type : %d", nal_type);
 
-	return bitstream;
-}
\ No newline at end of file
+	return true;
+}
@@ -20,10 +20,14 @@
 class RtpDepacketizerH264 : public RtpDepacketizingManager
 {
 public:
-	std::shared_ptr<ov::Data> ParseAndAssembleFrame(std::vector<std::shared_ptr<ov::Data>> payload_list) override;
+	std::shared_ptr<ov::Data> ParseAndAssembleFrame(const std::vector<std::shared_ptr<ov::Data>> &payload_list) override;
 
 private:
-	std::shared_ptr<ov::Data> ParseFuaAndConvertAnnexB(const std::shared_ptr<ov::Data> &payload, bool start=false);
-	std::shared_ptr<ov::Data> ParseStapAAndConvertToAnnexB(const std::shared_ptr<ov::Data> &payload);
-	std::shared_ptr<ov::Data> ConvertSingleNaluToAnnexB(const std::shared_ptr<ov::Data> &payload);
+	// Returns the size of the payload after conversion to Annex B
+	size_t GetAnnexBSize(const std::shared_ptr<ov::Data> &payload, bool start);
+
+	// These functions append the converted data to the bitstream
+	bool ParseFuaAndConvertAnnexB(const std::shared_ptr<ov::Data> &payload, bool start, const std::shared_ptr<ov::Data> &bitstream);
+	bool ParseStapAAndConvertToAnnexB(const std::shared_ptr<ov::Data> &payload, const std::shared_ptr<ov::Data> &bitstream);
+	bool ConvertSingleNaluToAnnexB(const std::shared_ptr<ov::Data> &payload, const std::shared_ptr<ov::Data> &bitstream);
 };
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 #define OV_LOG_TAG "RtpDepacketizerMpeg4GenericAudio"
 
-std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::ParseAndAssembleFrame(std::vector<std::shared_ptr<ov::Data>> payload_list)
+std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::ParseAndAssembleFrame(const std::vector<std::shared_ptr<ov::Data>> &payload_list)
 {
 	if (_aac_config.IsValid() == false)
 	{
@@ -19,16 +19,24 @@ std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::ParseAndAssembleFram
 	// One or more complete AU
 	if (payload_list.size() == 1)
 	{
-		return Convert(payload_list.at(0), true);
+		auto &payload = payload_list.at(0);
+		auto bitstream = std::make_shared<ov::Data>(payload->GetLength() * 2);
+
+		if (Convert(payload, true, bitstream) == false)
+		{
+			return nullptr;
+		}
+
+		return bitstream;
 	}
 	// Fragmented AU
 	else
 	{
-		auto reserve_size = 0;
+		// ADTS header + payloads
+		size_t reserve_size = 16;
 		for (auto &payload : payload_list)
 		{
 			reserve_size += payload->GetLength();
-			reserve_size += 16;	 // spare
 		}
 
 		auto bitstream = std::make_shared<ov::Data>(reserve_size);
@@ -63,13 +71,10 @@ std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::ParseAndAssembleFram
 				first = false;
 			}
 
-			auto raw_data = Convert(payload, false);
-			if (raw_data == nullptr)
+			if (Convert(payload, false, bitstream) == false)
 			{
 				return nullptr;
 			}
-
-			bitstream->Append(raw_data);
 		}
 
 		return bitstream;
@@ -94,9 +99,8 @@ bool RtpDepacketizerMpeg4GenericAudio::SetConfigParams(RtpDepacketizerMpeg4Gener
 	return _aac_config.Parse(config);
 }
 
-std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::Convert(const std::shared_ptr<ov::Data> &payload, bool include_adts_header)
+bool RtpDepacketizerMpeg4GenericAudio::Convert(const std::shared_ptr<ov::Data> &payload, bool include_adts_header, const std::shared_ptr<ov::Data> &aac_data)
 {
-	auto aac_data = std::make_shared<ov::Data>(payload->GetLength() * 2);
 	auto payload_ptr = payload->GetDataAs<uint8_t>();
 	size_t payload_len = payload->GetLength();
 
@@ -160,7 +164,7 @@ std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::Convert(const std::s
 			if (adts_data == nullptr)
 			{
 				logte("Could not extract raw aac data in mpeg4-generic audio");
-				return nullptr;
+				return false;
 			}
 
 			aac_data->Append(adts_data);
@@ -171,7 +175,7 @@ std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::Convert(const std::s
 			if (data_section_offset != 0)
 			{
 				logte("RTP packet should carry a single fragment of one AU");
-				return nullptr;
+				return false;
 			}
 
 			// (RFC) In this case, the size of the fragment is known from the size of the AU data section.
@@ -183,5 +187,5 @@ std::shared_ptr<ov::Data> RtpDepacketizerMpeg4GenericAudio::Convert(const std::s
 		au_number++;
 	}
 
-	return aac_data;
+	return true;
 }
\ No newline at end of file
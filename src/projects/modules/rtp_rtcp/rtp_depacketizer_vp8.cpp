@@ -1,45 +1,42 @@
 #include <base/ovlibrary/bit_reader.h>
 #include "rtp_depacketizer_vp8.h"
 
-std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParseAndAssembleFrame(std::vector<std::shared_ptr<ov::Data>> payload_list)
+std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParseAndAssembleFrame(const std::vector<std::shared_ptr<ov::Data>> &payload_list)
 {
 	if(payload_list.size() <= 0)
 	{
 		return nullptr;
 	}
 
-	auto reserve_size = 0;
+	size_t reserve_size = 0;
 	for(auto &payload : payload_list)
 	{
 		reserve_size += payload->GetLength();
-		reserve_size += 16; // spare
 	}
 
 	auto bitstream = std::make_shared<ov::Data>(reserve_size);
 	bool first_packet = true;
 	for(const auto &payload : payload_list)
 	{
-		auto parsed_data = ParsePayloadDescriptor(payload, first_packet);
-		if(parsed_data == nullptr)
+		if(ParsePayloadDescriptor(payload, first_packet, bitstream) == false)
 		{
 			logc("DEBUG", "failed to depacketize VP8");
 			return nullptr;
 		}
 
-		bitstream->Append(parsed_data);
 		first_packet = false;
 	}
 
 	return bitstream;
 }
 
-std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParsePayloadDescriptor(const std::shared_ptr<ov::Data> &payload, bool first_packet)
+bool RtpDepacketizerVP8::ParsePayloadDescriptor(const std::shared_ptr<ov::Data> &payload, bool first_packet, const std::shared_ptr<ov::Data> &bitstream)
 {
 	BitReader parser(payload->GetDataAs<uint8_t>(), payload->GetLength());
 
 	if(parser.BytesRemained() < 1)
 	{
-		return nullptr;
+		return false;
 	}
 
 	// TODO(Getroot): The parsed value should be used for validation.
@@ -55,7 +52,7 @@ std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParsePayloadDescriptor(const std::
 	{
 		if(parser.BytesRemained() < 1)
 		{
-			return nullptr;
+			return false;
 		}
 
 		[[maybe_unused]] auto ibit = parser.ReadBoolBit();
@@ -68,7 +65,7 @@ std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParsePayloadDescriptor(const std::
 		{
 			if(parser.BytesRemained() < 1)
 			{
-				return nullptr;
+				return false;
 			}
 
 			[[maybe_unused]]auto mbit = parser.ReadBoolBit();
@@ -76,7 +73,7 @@ std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParsePayloadDescriptor(const std::
 			{
 				if(parser.BytesRemained() < 1)
 				{
-					return nullptr;
+					return false;
 				}
 
 				[[maybe_unused]] auto pic_id = parser.ReadBits<uint16_t>(15);
@@ -91,7 +88,7 @@ std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParsePayloadDescriptor(const std::
 		{
 			if(parser.BytesRemained() < 1)
 			{
-				return nullptr;
+				return false;
 			}
 
 			[[maybe_unused]] auto tl0_pic_idx = parser.ReadBytes<uint8_t>();
@@ -120,10 +117,10 @@ std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParsePayloadDescriptor(const std::
 
 	if(parser.BytesRemained() < 1)
 	{
-		return nullptr;
+		return false;
 	}
 
-	auto bitstream = std::make_shared<ov::Data>(parser.CurrentPosition(), parser.BytesRemained());
+	bitstream->Append(parser.CurrentPosition(), parser.BytesRemained());
 
 	auto current = parser.CurrentPosition();
 
@@ -133,5 +130,5 @@ std::shared_ptr<ov::Data> RtpDepacketizerVP8::ParsePayloadDescriptor(const std::
 		logd("DEBUG", "VP8 Keyframe!");
 	}
 
-	return bitstream;
+	return true;
 }
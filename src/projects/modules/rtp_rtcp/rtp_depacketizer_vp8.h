@@ -89,9 +89,9 @@
 class RtpDepacketizerVP8 : public RtpDepacketizingManager
 {
 public:
-	std::shared_ptr<ov::Data> ParseAndAssembleFrame(std::vector<std::shared_ptr<ov::Data>> payload_list) override;
+	std::shared_ptr<ov::Data> ParseAndAssembleFrame(const std::vector<std::shared_ptr<ov::Data>> &payload_list) override;
 
 private:
-	// Parse VP8 payload descriptor and return payload
-	std::shared_ptr<ov::Data> ParsePayloadDescriptor(const std::shared_ptr<ov::Data> &payload, bool first_packet);
+	// Parse VP8 payload descriptor and append payload to the bitstream
+	bool ParsePayloadDescriptor(const std::shared_ptr<ov::Data> &payload, bool first_packet, const std::shared_ptr<ov::Data> &bitstream);
 };
\ No newline at end of file
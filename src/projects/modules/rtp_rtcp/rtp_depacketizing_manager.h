@@ -15,5 +15,7 @@ public:
 	};
 
 	static std::shared_ptr<RtpDepacketizingManager> Create(SupportedDepacketizerType type);
-	virtual std::shared_ptr<ov::Data> ParseAndAssembleFrame(std::vector<std::shared_ptr<ov::Data>> payload_list) = 0;
+	// Assembles the payloads of a frame into a newly allocated bitstream.
+	// payload_list may refer to the memory of RTP packets, so the result must not refer to it.
+	virtual std::shared_ptr<ov::Data> ParseAndAssembleFrame(const std::vector<std::shared_ptr<ov::Data>> &payload_list) = 0;
 };
@@ -6,281 +6,144 @@
  * 								RTPFrame
  ***********************************************************************/
 
-RtpFrame::RtpFrame(uint32_t timestamp)
+RtpFrame::RtpFrame(uint32_t timestamp, std::vector<std::shared_ptr<RtpPacket>> packets, size_t payload_size)
+	: _timestamp(timestamp),
+	  _packets(std::move(packets)),
+	  _payload_size(payload_size)
 {
-	_timestamp = timestamp;
-	_stop_watch.Start();
 }
 
-std::shared_ptr<RtpPacket> RtpFrame::GetFirstRtpPacket()
-{
-	if (IsCompleted() == false)
-	{
-		return nullptr;
-	}
-
-	_curr_order_number = _min_order_number;
-
-	auto it = _packets.find(_curr_order_number);
-	if (it == _packets.end())
-	{
-		return nullptr;
-	}
+/************************************************************************
+ * 							Jitter Buffer
+ ***********************************************************************/
 
-	return it->second;
+RtpFrameJitterBuffer::RtpFrameJitterBuffer()
+	: _packet_ring(RTP_FRAME_JITTER_BUFFER_CAPACITY)
+{
 }
 
-std::shared_ptr<RtpPacket> RtpFrame::GetNextRtpPacket()
+bool RtpFrameJitterBuffer::InsertPacket(const std::shared_ptr<RtpPacket> &packet)
 {
-	if (IsCompleted() == false)
-	{
-		return nullptr;
-	}
+	logtd("Insert packet : %s", packet->Dump().CStr());
 
-	_curr_order_number ++;
+	auto result = _packet_ring.Insert(packet);
 
-	auto it = _packets.find(_curr_order_number);
-	if (it == _packets.end())
+	if (result == RtpPacketRing::InsertResult::TooOld)
 	{
-		return nullptr;
+		logtd("Packet arrived too late (the frame has already been popped or discarded) : %s", packet->Dump().CStr());
+		return false;
 	}
 
-	return it->second;
+	return true;
 }
 
-uint16_t RtpFrame::GetOrderNumber(uint16_t sequence_number)
+bool RtpFrameJitterBuffer::FindAvailableFrame(uint64_t *begin, uint64_t *end)
 {
-	if (_first_packet == true)
+	uint64_t marker;
+
+	while (_packet_ring.FindNextMarker(_packet_ring.GetHead(), &marker))
 	{
-		_first_packet = false;
-		_first_sequence_number = sequence_number;
-		_base_order_number = std::numeric_limits<uint16_t>::max() / 2;
+		auto head = _packet_ring.GetHead();
+		auto timestamp = _packet_ring.GetPacket(marker)->Timestamp();
 
-		return _base_order_number;
-	}
+		// Find the beginning of the frame
+		auto first = marker;
+		bool boundary_found = false;
 
-	if (sequence_number > _first_sequence_number)
-	{
-		if (sequence_number - _first_sequence_number > (std::numeric_limits<uint16_t>::max() / 2))
-		{
-			// out of order : 0 -> 65535 ==> gap : -1 
-			uint16_t gap = std::numeric_limits<uint16_t>::max() - sequence_number + _first_sequence_number + 1;
-			return _base_order_number - gap;
-		}
-		else
+		while (true)
 		{
-			// In order : 1 -> 2 ==> gap : +1
-			return _base_order_number + (sequence_number - _first_sequence_number);
+			if (first == head)
+			{
+				// Everything before head has already been popped
+				boundary_found = true;
+				break;
+			}
+
+			auto prev = first - 1;
+
+			if (_packet_ring.IsReceived(prev) == false)
+			{
+				// A packet is missing - it may belong to this frame
+				break;
+			}
+
+			if (_packet_ring.IsMarked(prev) || (_packet_ring.GetPacket(prev)->Timestamp() != timestamp))
+			{
+				// The previous packet belongs to another frame
+				boundary_found = true;
+				break;
+			}
+
+			first = prev;
 		}
-	}
-	else
-	{
-		if (_first_sequence_number - sequence_number > (std::numeric_limits<uint16_t>::max() / 2))
+
+		if (boundary_found)
 		{
-			// Roll over : 65535 -> 0 ==> gpa : +1
-			uint16_t gap = std::numeric_limits<uint16_t>::max() - _first_sequence_number + sequence_number + 1;
-			return _base_order_number + gap;
+			*begin = first;
+			*end = marker;
+
+			return true;
 		}
-		else
+
+		if ((ov::Clock::NowMSec() - _packet_ring.GetReceivedTimeMSec(marker)) < _max_buffering_time_ms)
 		{
-			// Out of order : 2 -> 1
-			return _base_order_number - (_first_sequence_number - sequence_number);
+			// Wait for the missing packets (they may be retransmitted) to keep the frame order
+			return false;
 		}
-	}
-
-	// Should not reach here
-	return 0;
-}
-
-bool RtpFrame::InsertPacket(const std::shared_ptr<RtpPacket> &packet)
-{
-	if (packet == nullptr || packet->Timestamp() != _timestamp)
-	{
-		logte("Invalid packet : %s (expected ts : %u)", packet->Dump().CStr(), _timestamp);
-		return false;
-	}
-
-	logtd("Insert packet : %s", packet->Dump().CStr());
-
-	auto order_number = GetOrderNumber(packet->SequenceNumber());
-
-	_packets.emplace(order_number, packet);
-
-	// First packet
-	_min_order_number = std::min(_min_order_number, order_number);
-	_max_order_number = std::max(_max_order_number, order_number);
-
-	if (packet->Marker())
-	{
-		_marked = true;
-		_marker_sequence_number = packet->SequenceNumber();
-	}
-
-	// Check if frame is completed
-	if (_marked == true)
-	{
-		CheckCompleted();
-	}
-
-	return true;
-}
-
-bool RtpFrame::IsMarked()
-{
-	return _marked;
-}
-
-bool RtpFrame::IsCompleted()
-{
-	if (_completed == true)
-	{
-		return true;
-	}
 
-	if (_marked == true)
-	{
-		return CheckCompleted();
+		// The missing packets did not arrive within the buffering time
+		logtd("Frame discarded (packet lost) - timestamp(%u) sequence(%llu ~ %llu)", timestamp, head, marker);
+		_packet_ring.DiscardUntil(marker + 1);
 	}
 
 	return false;
 }
 
-bool RtpFrame::CheckCompleted()
+bool RtpFrameJitterBuffer::HasAvailableFrame()
 {
-	// Already completed
-	if (_completed == true)
-	{
-		return true;
-	}
+	uint64_t begin, end;
 
-	if (_marked == false)
-	{
-		return false;
-	}
-
-	// Check number of packets
-	uint16_t need_number_of_packets = _max_order_number - _min_order_number + 1;
-
-	// Check if frame is valid
-	if (need_number_of_packets == _packets.size())
-	{
-		_completed = true;
-		logtd("Frame completed: timestamp(%u) packets(%u) need packets(%u)", _timestamp, _packets.size(), need_number_of_packets);
-	}
-	else
-	{
-		logte("Invalid frame: timestamp(%u) %u/%u", _timestamp, _packets.size(), need_number_of_packets);
-	}
-
-	return _completed;
+	return FindAvailableFrame(&begin, &end);
 }
 
-uint64_t RtpFrame::GetElapsed()
+std::shared_ptr<RtpFrame> RtpFrameJitterBuffer::PopAvailableFrame()
 {
-	return _stop_watch.Elapsed();
-}
-
-/************************************************************************
- * 							Jitter Buffer
- ***********************************************************************/
+	uint64_t begin, end;
 
-uint64_t RtpFrameJitterBuffer::GetExtentedTimestamp(uint32_t timestamp)
-{
-	// If the timestamp is less than the previous timestamp, it is assumed that the timestamp has been rolled over.
-	if (timestamp < _last_timestamp && _last_timestamp - timestamp > 0x80000000)
+	if (FindAvailableFrame(&begin, &end) == false)
 	{
-		_timestamp_cycle++;
+		return nullptr;
 	}
 
-	_last_timestamp = timestamp;
-
-	return (static_cast<uint64_t>(_timestamp_cycle) << 32) | timestamp;
-}
-
-bool RtpFrameJitterBuffer::InsertPacket(const std::shared_ptr<RtpPacket> &packet)
-{
-	auto timestamp = GetExtentedTimestamp(packet->Timestamp());
-
-	auto it = _rtp_frames.find(timestamp);
-	std::shared_ptr<RtpFrame> frame;
-
-	if (it == _rtp_frames.end())
-	{
-		logtd("Create frame buffer for timestamp %llu", timestamp);
-		// First packet of frame
-		frame = std::make_shared<RtpFrame>(packet->Timestamp());
-		_rtp_frames[timestamp] = frame;
-	}
-	else
+	if (begin > _packet_ring.GetHead())
 	{
-		frame = it->second;
+		logtd("Packets discarded (It may be PADDING frame for BWE or lost frame) - sequence(%llu ~ %llu)", _packet_ring.GetHead(), begin - 1);
 	}
 
-	frame->InsertPacket(packet);
+	std::vector<std::shared_ptr<RtpPacket>> packets;
+	size_t payload_size = 0;
 
-	return true;
-}
-
-void RtpFrameJitterBuffer::BurnOutExpiredFrames()
-{
-	// If there are completed frames among the frames, all previous frames are deleted.
+	packets.reserve(end - begin + 1);
 
-	// Find first completed frame
-	auto completed_frame_it = _rtp_frames.begin();
-	while (completed_frame_it != _rtp_frames.end())
+	for (auto sequence_number = begin; sequence_number <= end; sequence_number++)
 	{
-		auto frame = completed_frame_it->second;
-		if (frame->IsCompleted())
-		{
-			break;
-		}
-		++completed_frame_it;
-	}
+		const auto &packet = _packet_ring.GetPacket(sequence_number);
 
-	if (completed_frame_it == _rtp_frames.begin() || completed_frame_it == _rtp_frames.end())
-	{
-		// No burn outted frame and completed frame
-		return;
+		payload_size += packet->PayloadSize();
+		packets.push_back(packet);
 	}
 
-	// Delete from begin to completed frame (not included)
-	auto it = _rtp_frames.begin();
-	while (it != completed_frame_it)
-	{
-		auto frame = it->second;
-		logtd("Frame discarded (It may be PADDING frame for BWE) - timestamp(%u) packets(%d) marked(%s)", frame->Timestamp(), frame->PacketCount(), frame->IsMarked() ? "true" : "false");
-		it = _rtp_frames.erase(it);
-	}
-}
+	auto timestamp = packets.back()->Timestamp();
 
-bool RtpFrameJitterBuffer::HasAvailableFrame()
-{
-	BurnOutExpiredFrames();
+	// Remove the frame and the preceding packets
+	_packet_ring.DiscardUntil(end + 1);
 
-	auto it = _rtp_frames.begin();
-	if (it == _rtp_frames.end())
-	{
-		return false;
-	}
+	logtd("Pop frame - timestamp(%u) packets(%zu) payload(%zu)", timestamp, packets.size(), payload_size);
 
-	auto first_frame = it->second;
-	return first_frame->IsCompleted();
+	return std::make_shared<RtpFrame>(timestamp, std::move(packets), payload_size);
 }
 
-std::shared_ptr<RtpFrame> RtpFrameJitterBuffer::PopAvailableFrame()
+size_t RtpFrameJitterBuffer::CollectLostSequenceNumbers(std::vector<uint16_t> &lost_list, size_t max_count)
 {
-	if (HasAvailableFrame() == false)
-	{
-		return nullptr;
-	}
-
-	auto it = _rtp_frames.begin();
-	auto frame = it->second;
-
-	logtd("Pop frame - extended(%llu) timestamp(%u) packets(%d) frames(%u)", it->first, frame->Timestamp(), frame->PacketCount(), _rtp_frames.size());
-
-	// remove front frame
-	_rtp_frames.erase(it);
-
-	return frame;
-}
\ No newline at end of file
+	return _packet_ring.CollectLostSequenceNumbers(lost_list, max_count, RTP_FRAME_JITTER_BUFFER_REORDER_THRESHOLD);
+}
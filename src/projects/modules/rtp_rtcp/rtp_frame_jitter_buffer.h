@@ -2,68 +2,71 @@
 
 #include "base/ovlibrary/ovlibrary.h"
 #include "rtp_packet.h"
-#include <unordered_map>
+#include "rtp_packet_ring.h"
 
 #define DEFAULT_VIDEO_MAX_BUFFERING_TIME_MS	100	 // 500ms
+// Number of packets that can be buffered (must be a power of 2)
+#define RTP_FRAME_JITTER_BUFFER_CAPACITY	4096
+// Missing packets are regarded as lost once this many later packets have been received
+#define RTP_FRAME_JITTER_BUFFER_REORDER_THRESHOLD	3
 
 // RTP Packet Group by Frame
 class RtpFrame
 {
 public:
-	RtpFrame(uint32_t timestamp);
-	bool InsertPacket(const std::shared_ptr<RtpPacket> &packet);
-	bool IsCompleted();
-	bool IsMarked();
-	uint64_t GetElapsed();
-
-	std::shared_ptr<RtpPacket> GetFirstRtpPacket();
-	std::shared_ptr<RtpPacket> GetNextRtpPacket();
-
-	uint32_t Timestamp(){return _timestamp;}
-	size_t PacketCount(){return _packets.size();}
-
-private:
-	bool CheckCompleted();
-	uint16_t GetOrderNumber(uint16_t sequence_number);
+	RtpFrame(uint32_t timestamp, std::vector<std::shared_ptr<RtpPacket>> packets, size_t payload_size);
 
-	ov::StopWatch _stop_watch;
+	uint32_t Timestamp() const
+	{
+		return _timestamp;
+	}
 
-	uint32_t	_timestamp = 0;
-	
-	uint32_t	_marker_sequence_number = 0;
-	bool		_marked = false;
-	bool		_completed = false;
+	size_t PacketCount() const
+	{
+		return _packets.size();
+	}
 
-	uint16_t 	_first_sequence_number = 0;
-	bool		_first_packet = true;
-	uint16_t 	_base_order_number = 0;
+	// Packets ordered by sequence number
+	const std::vector<std::shared_ptr<RtpPacket>> &GetPackets() const
+	{
+		return _packets;
+	}
 
-	uint16_t 	_curr_order_number = 0;
-	uint16_t 	_min_order_number = 65535;
-	uint16_t 	_max_order_number = 0;
+	// Sum of payload sizes of all packets, it can be used to preallocate a buffer for assembling the frame
+	size_t GetPayloadSize() const
+	{
+		return _payload_size;
+	}
 
-	// Order Number : RtpPacket
-	std::unordered_map<uint16_t, std::shared_ptr<RtpPacket>> _packets;
+private:
+	uint32_t _timestamp = 0;
+	std::vector<std::shared_ptr<RtpPacket>> _packets;
+	size_t _payload_size = 0;
 };
 
 // A jitter buffer for a media stream in the form that the frame is fragmented
 // and the rtp marker bit indicates that it is the last fragment.
+//
+// Packets are stored in a sequence-indexed circular buffer. A frame is available when all packets
+// from the frame boundary to the marked packet have been received. If a frame cannot be completed within
+// the buffering time, the whole incomplete frame (up to and including its marked packet) is discarded.
 class RtpFrameJitterBuffer
 {
 public:
+	RtpFrameJitterBuffer();
+
 	bool InsertPacket(const std::shared_ptr<RtpPacket> &packet);
 	bool HasAvailableFrame();
 	std::shared_ptr<RtpFrame> PopAvailableFrame();
-	
-private:	
-	void BurnOutExpiredFrames();
 
-	uint64_t GetExtentedTimestamp(uint32_t timestamp);
+	// Collects the sequence numbers of missing packets that have not been reported yet (for generating NACK)
+	size_t CollectLostSequenceNumbers(std::vector<uint16_t> &lost_list, size_t max_count);
 
-	uint32_t _last_timestamp = 0;
-	uint32_t _timestamp_cycle = 0;
+private:
+	// Finds the first available frame [begin, end]
+	bool FindAvailableFrame(uint64_t *begin, uint64_t *end);
 
-	// timestamp : RtpFrameInfo
-	// it should be ordered, so use std::map
-	std::map<uint64_t, std::shared_ptr<RtpFrame>> _rtp_frames;
-};
\ No newline at end of file
+	uint32_t _max_buffering_time_ms = DEFAULT_VIDEO_MAX_BUFFERING_TIME_MS;
+
+	RtpPacketRing _packet_ring;
+};
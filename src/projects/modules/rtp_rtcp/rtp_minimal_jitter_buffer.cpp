@@ -2,80 +2,49 @@
 
 #define OV_LOG_TAG "RtpVideoJitterBuffer"
 
+RtpMinimalJitterBuffer::RtpMinimalJitterBuffer()
+	: _packet_ring(RTP_MINIMAL_JITTER_BUFFER_CAPACITY)
+{
+}
+
 bool RtpMinimalJitterBuffer::InsertPacket(const std::shared_ptr<RtpPacket> &packet)
 {
 	// Already it determined this packet was lost
-	if(packet->SequenceNumber() < _next_sequence_number)
-	{
-		return false;
-	}
-
-	_rtp_packets.emplace(packet->SequenceNumber(), std::make_shared<RtpPacketBox>(ov::Clock::NowMSec(), packet));
-	return true;
+	return _packet_ring.Insert(packet) != RtpPacketRing::InsertResult::TooOld;
 }
 
 bool RtpMinimalJitterBuffer::HasAvailablePacket()
 {
-	if(_rtp_packets.size() <= 0)
-	{
-		return false;
-	}
+	uint64_t found;
 
-	return true;
+	return _packet_ring.FindNextReceived(_packet_ring.GetHead(), &found);
 }
 
 std::shared_ptr<RtpPacket> RtpMinimalJitterBuffer::PopAvailablePacket()
 {
-	std::shared_ptr<RtpPacketBox> packet_box = nullptr;
+	auto head = _packet_ring.GetHead();
+	uint64_t sequence_number;
 
-	// First packet
-	if(_next_sequence_number == 0)
+	if (_packet_ring.FindNextReceived(head, &sequence_number) == false)
 	{
-		auto it = _rtp_packets.begin();
-		if(it == _rtp_packets.end())
-		{
-			return nullptr;
-		}
-		packet_box = it->second;
-		_rtp_packets.erase(it);
+		return nullptr;
 	}
-	else
-	{
-		auto it = _rtp_packets.find(_next_sequence_number);
-		// There is no next packet
-		if(it == _rtp_packets.end())
-		{
-			// Check the first packet in the buffer
-			auto front_it = _rtp_packets.begin();
-			if(front_it == _rtp_packets.end())
-			{
-				return nullptr;
-			}
 
-			// Check the time spent in the buffer
-			packet_box = front_it->second;
-			
-			// If next of next packet is Available and wait for 1/2 buffering time in buffer
-			if(ov::Clock::NowMSec() - packet_box->_packaging_time_ms > _max_buffering_time_ms / 2)
-			{
-				// It is determined that the next packet is lost.
-				_rtp_packets.erase(front_it);
-			}
-			// Wait a little more 
-			else
-			{
-				return nullptr;
-			}
-		}
-		else
+	// There is no next packet
+	if (sequence_number != head)
+	{
+		// If next of next packet is Available and wait for 1/2 buffering time in buffer
+		if ((ov::Clock::NowMSec() - _packet_ring.GetReceivedTimeMSec(sequence_number)) <= _max_buffering_time_ms / 2)
 		{
-			// There is a next packet
-			packet_box = it->second;
-			_rtp_packets.erase(it);
+			// Wait a little more
+			return nullptr;
 		}
+
+		// It is determined that the next packet is lost.
 	}
 
-	auto packet = packet_box->_packet;
-	_next_sequence_number = packet->SequenceNumber() + 1;
+	auto packet = _packet_ring.GetPacket(sequence_number);
+	_packet_ring.DiscardUntil(sequence_number + 1);
+
 	return packet;
-}
\ No newline at end of file
+}
@@ -0,0 +1,252 @@
+#include "rtp_packet_ring.h"
+
+#define OV_LOG_TAG "RtpPacketRing"
+
+RtpPacketRing::RtpPacketRing(size_t capacity)
+	: _capacity(capacity),
+	  _index_mask(capacity - 1),
+	  _slots(capacity),
+	  _received_bitmap(capacity / 64, 0),
+	  _marker_bitmap(capacity / 64, 0),
+	  _reported_bitmap(capacity / 64, 0)
+{
+	OV_ASSERT(((capacity & (capacity - 1)) == 0) && ((capacity % 64) == 0), "Capacity must be a power of 2 and a multiple of 64: %zu", capacity);
+}
+
+uint64_t RtpPacketRing::GetExtendedSequenceNumber(uint16_t sequence_number) const
+{
+	// The difference from the highest sequence number in the range of [-32768, 32767]
+	auto delta = static_cast<int16_t>(sequence_number - static_cast<uint16_t>(_highest));
+
+	return _highest + delta;
+}
+
+bool RtpPacketRing::GetBit(const std::vector<uint64_t> &bitmap, uint64_t extended_sequence_number) const
+{
+	auto index = ToIndex(extended_sequence_number);
+
+	return (bitmap[index >> 6] >> (index & 63)) & 1;
+}
+
+void RtpPacketRing::SetBit(std::vector<uint64_t> &bitmap, uint64_t extended_sequence_number, bool value)
+{
+	auto index = ToIndex(extended_sequence_number);
+	auto mask = static_cast<uint64_t>(1) << (index & 63);
+
+	if (value)
+	{
+		bitmap[index >> 6] |= mask;
+	}
+	else
+	{
+		bitmap[index >> 6] &= ~mask;
+	}
+}
+
+bool RtpPacketRing::FindNextBit(const std::vector<uint64_t> &bitmap, uint64_t from, uint64_t *found) const
+{
+	if (_started == false)
+	{
+		return false;
+	}
+
+	from = std::max(from, _head);
+
+	while (from <= _highest)
+	{
+		auto index = ToIndex(from);
+		auto bits = bitmap[index >> 6] >> (index & 63);
+
+		if (bits != 0)
+		{
+			auto candidate = from + __builtin_ctzll(bits);
+
+			if (candidate > _highest)
+			{
+				return false;
+			}
+
+			*found = candidate;
+			return true;
+		}
+
+		// Move to the beginning of the next word
+		from += 64 - (index & 63);
+	}
+
+	return false;
+}
+
+RtpPacketRing::InsertResult RtpPacketRing::Insert(const std::shared_ptr<RtpPacket> &packet, uint64_t *extended_sequence_number)
+{
+	uint64_t sequence_number;
+
+	if (_started == false)
+	{
+		// Start from 65536 so that reordered packets before the first packet can be handled without underflow
+		sequence_number = (static_cast<uint64_t>(1) << 16) | packet->SequenceNumber();
+
+		_started = true;
+		_head = sequence_number;
+		_highest = sequence_number;
+	}
+	else
+	{
+		sequence_number = GetExtendedSequenceNumber(packet->SequenceNumber());
+	}
+
+	if (sequence_number < _head)
+	{
+		if (_head_fixed || ((_highest - sequence_number) >= _capacity))
+		{
+			return InsertResult::TooOld;
+		}
+
+		// Nothing has been popped yet, so a packet reordered before the first packet can be accepted
+		_head = sequence_number;
+	}
+
+	if (sequence_number >= _head + _capacity)
+	{
+		// Make room for the packet
+		DiscardUntil(sequence_number - _capacity + 1);
+	}
+
+	if (GetBit(_received_bitmap, sequence_number))
+	{
+		return InsertResult::Duplicated;
+	}
+
+	auto &slot = _slots[ToIndex(sequence_number)];
+	slot.packet = packet;
+	slot.received_time_ms = ov::Clock::NowMSec();
+
+	SetBit(_received_bitmap, sequence_number, true);
+	SetBit(_marker_bitmap, sequence_number, packet->Marker());
+
+	_highest = std::max(_highest, sequence_number);
+
+	if (extended_sequence_number != nullptr)
+	{
+		*extended_sequence_number = sequence_number;
+	}
+
+	return InsertResult::Inserted;
+}
+
+void RtpPacketRing::DiscardUntil(uint64_t extended_sequence_number)
+{
+	_head_fixed = true;
+
+	if (extended_sequence_number <= _head)
+	{
+		return;
+	}
+
+	if (extended_sequence_number - _head >= _capacity)
+	{
+		// Everything is discarded
+		for (auto &slot : _slots)
+		{
+			slot.packet = nullptr;
+		}
+
+		std::fill(_received_bitmap.begin(), _received_bitmap.end(), 0);
+		std::fill(_marker_bitmap.begin(), _marker_bitmap.end(), 0);
+		std::fill(_reported_bitmap.begin(), _reported_bitmap.end(), 0);
+	}
+	else
+	{
+		for (auto sequence_number = _head; sequence_number < extended_sequence_number; sequence_number++)
+		{
+			_slots[ToIndex(sequence_number)].packet = nullptr;
+
+			SetBit(_received_bitmap, sequence_number, false);
+			SetBit(_marker_bitmap, sequence_number, false);
+			SetBit(_reported_bitmap, sequence_number, false);
+		}
+	}
+
+	_head = extended_sequence_number;
+	_highest = std::max(_highest, _head - 1);
+}
+
+bool RtpPacketRing::IsReceived(uint64_t extended_sequence_number) const
+{
+	if ((extended_sequence_number < _head) || (extended_sequence_number > _highest))
+	{
+		return false;
+	}
+
+	return GetBit(_received_bitmap, extended_sequence_number);
+}
+
+bool RtpPacketRing::IsMarked(uint64_t extended_sequence_number) const
+{
+	return IsReceived(extended_sequence_number) && GetBit(_marker_bitmap, extended_sequence_number);
+}
+
+const std::shared_ptr<RtpPacket> &RtpPacketRing::GetPacket(uint64_t extended_sequence_number) const
+{
+	return _slots[ToIndex(extended_sequence_number)].packet;
+}
+
+uint64_t RtpPacketRing::GetReceivedTimeMSec(uint64_t extended_sequence_number) const
+{
+	return _slots[ToIndex(extended_sequence_number)].received_time_ms;
+}
+
+bool RtpPacketRing::FindNextReceived(uint64_t from, uint64_t *found) const
+{
+	return FindNextBit(_received_bitmap, from, found);
+}
+
+bool RtpPacketRing::FindNextMarker(uint64_t from, uint64_t *found) const
+{
+	return FindNextBit(_marker_bitmap, from, found);
+}
+
+size_t RtpPacketRing::CollectLostSequenceNumbers(std::vector<uint16_t> &lost_list, size_t max_count, uint64_t reorder_threshold)
+{
+	size_t count = 0;
+
+	if ((_started == false) || (_highest < _head + reorder_threshold))
+	{
+		return 0;
+	}
+
+	// Packets that arrive slightly out of order are not regarded as lost
+	auto limit = _highest - reorder_threshold;
+	auto sequence_number = _head;
+
+	while ((sequence_number < limit) && (count < max_count))
+	{
+		auto index = ToIndex(sequence_number);
+		auto word_index = index >> 6;
+		auto bit_index = index & 63;
+
+		// Bits of packets that are neither received nor reported
+		auto bits = ~(_received_bitmap[word_index] | _reported_bitmap[word_index]) >> bit_index;
+
+		if (bits == 0)
+		{
+			sequence_number += 64 - bit_index;
+			continue;
+		}
+
+		sequence_number += __builtin_ctzll(bits);
+
+		if (sequence_number >= limit)
+		{
+			break;
+		}
+
+		lost_list.push_back(static_cast<uint16_t>(sequence_number));
+		SetBit(_reported_bitmap, sequence_number, true);
+
+		count++;
+		sequence_number++;
+	}
+
+	return count;
+}
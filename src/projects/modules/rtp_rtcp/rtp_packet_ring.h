@@ -0,0 +1,90 @@
+#pragma once
+
+#include "base/ovlibrary/ovlibrary.h"
+#include "rtp_packet.h"
+
+// A flat circular buffer of RTP packets indexed by the extended sequence number.
+// Received packets, marker bits and NACK-reported packets are tracked using bitmaps,
+// so jitter buffers can find frame boundaries and gaps without tree lookups.
+class RtpPacketRing
+{
+public:
+	enum class InsertResult
+	{
+		Inserted,
+		// Already received (e.g. retransmitted packet)
+		Duplicated,
+		// The sequence number has already been popped or discarded
+		TooOld
+	};
+
+	// capacity must be a power of 2 and a multiple of 64
+	explicit RtpPacketRing(size_t capacity);
+
+	InsertResult Insert(const std::shared_ptr<RtpPacket> &packet, uint64_t *extended_sequence_number = nullptr);
+
+	// Removes packets in [head, extended_sequence_number)
+	void DiscardUntil(uint64_t extended_sequence_number);
+
+	bool IsStarted() const
+	{
+		return _started;
+	}
+
+	// The first extended sequence number that has not been popped or discarded
+	uint64_t GetHead() const
+	{
+		return _head;
+	}
+
+	// The highest extended sequence number received so far
+	uint64_t GetHighest() const
+	{
+		return _highest;
+	}
+
+	bool IsReceived(uint64_t extended_sequence_number) const;
+	bool IsMarked(uint64_t extended_sequence_number) const;
+	const std::shared_ptr<RtpPacket> &GetPacket(uint64_t extended_sequence_number) const;
+	uint64_t GetReceivedTimeMSec(uint64_t extended_sequence_number) const;
+
+	// Finds the first received/marked packet in [from, highest]
+	bool FindNextReceived(uint64_t from, uint64_t *found) const;
+	bool FindNextMarker(uint64_t from, uint64_t *found) const;
+
+	// Collects the sequence numbers of packets in [head, highest - reorder_threshold) that have not been received and reported yet.
+	// Each lost packet is reported only once.
+	size_t CollectLostSequenceNumbers(std::vector<uint16_t> &lost_list, size_t max_count, uint64_t reorder_threshold = 0);
+
+private:
+	struct Slot
+	{
+		std::shared_ptr<RtpPacket> packet;
+		uint64_t received_time_ms = 0;
+	};
+
+	uint64_t GetExtendedSequenceNumber(uint16_t sequence_number) const;
+
+	size_t ToIndex(uint64_t extended_sequence_number) const
+	{
+		return extended_sequence_number & _index_mask;
+	}
+
+	bool GetBit(const std::vector<uint64_t> &bitmap, uint64_t extended_sequence_number) const;
+	void SetBit(std::vector<uint64_t> &bitmap, uint64_t extended_sequence_number, bool value);
+	bool FindNextBit(const std::vector<uint64_t> &bitmap, uint64_t from, uint64_t *found) const;
+
+	const size_t _capacity;
+	const size_t _index_mask;
+
+	std::vector<Slot> _slots;
+	std::vector<uint64_t> _received_bitmap;
+	std::vector<uint64_t> _marker_bitmap;
+	std::vector<uint64_t> _reported_bitmap;
+
+	bool _started = false;
+	// Whether any packet has been popped or discarded
+	bool _head_fixed = false;
+	uint64_t _head = 0;
+	uint64_t _highest = 0;
+};
@@ -5,6 +5,7 @@
 #include "publishers/webrtc/rtc_stream.h"
 #include "rtcp_receiver.h"
 #include "rtcp_info/fir.h"
+#include "rtcp_info/nack.h"
 #include "rtcp_info/pli.h"
 
 #include "modules/rtsp/rtsp_data.h"
@@ -176,6 +177,38 @@ bool RtpRtcp::SendPLI(uint32_t media_ssrc)
 	return SendDataToNextNode(NodeType::Rtcp, rtcp_packet->GetData());
 }
 
+bool RtpRtcp::SendNACK(uint32_t media_ssrc, const std::vector<uint16_t> &lost_ids)
+{
+	auto stat_it = _receive_statistics.find(media_ssrc);
+	if(stat_it == _receive_statistics.end())
+	{
+		// Never received such SSRC packet
+		return false;
+	}
+
+	auto stat = stat_it->second;
+
+	auto nack = std::make_shared<NACK>();
+
+	nack->SetSrcSsrc(stat->GetReceiverSSRC());
+	nack->SetMediaSsrc(media_ssrc);
+
+	for(auto id : lost_ids)
+	{
+		nack->AddLostId(id);
+	}
+
+	auto rtcp_packet = std::make_shared<RtcpPacket>();
+	if(rtcp_packet->Build(nack) == false)
+	{
+		return false;
+	}
+
+	_last_sent_rtcp_packet = rtcp_packet;
+
+	return SendDataToNextNode(NodeType::Rtcp, rtcp_packet->GetData());
+}
+
 bool RtpRtcp::SendFIR(uint32_t media_ssrc)
 {
 	auto stat_it = _receive_statistics.find(media_ssrc);
@@ -220,6 +253,16 @@ void RtpRtcp::DisableTransportCcFeedback()
 	_transport_cc_feedback_enabled = false;
 }
 
+bool RtpRtcp::IsNackEnabled() const
+{
+	return _nack_enabled;
+}
+
+void RtpRtcp::EnableNack()
+{
+	_nack_enabled = true;
+}
+
 // In general, since RTP_RTCP is the first node, there is no previous node. So it will not be called
 bool RtpRtcp::OnDataReceivedFromPrevNode(NodeType from_node, const std::shared_ptr<ov::Data> &data)
 {
@@ -426,33 +469,24 @@ bool RtpRtcp::OnRtpReceived(NodeType from_node, const std::shared_ptr<const ov::
 
 		jitter_buffer->InsertPacket(packet);
 
-		auto frame = jitter_buffer->PopAvailableFrame();
-		if(frame != nullptr && _observer != nullptr)
+		if(_nack_enabled == true)
 		{
-			std::vector<std::shared_ptr<RtpPacket>> rtp_packets;
-
-			auto packet = frame->GetFirstRtpPacket();
-			if(packet == nullptr)
+			// Request retransmission of the packets found missing in the jitter buffer
+			std::vector<uint16_t> lost_ids;
+			if(jitter_buffer->CollectLostSequenceNumbers(lost_ids, NACK_MAX_LOST_IDS) > 0)
 			{
-				// can not happen
-				logtw("Could not get first rtp packet from jitter buffer - track(%u)", track_id);
-				return false;
+				SendNACK(packet->Ssrc(), lost_ids);
 			}
+		}
 
-			rtp_packets.push_back(packet);
-
-			while(true)
+		// A retransmitted packet can complete several frames at once
+		std::shared_ptr<RtpFrame> frame;
+		while((frame = jitter_buffer->PopAvailableFrame()) != nullptr)
+		{
+			if(_observer != nullptr)
 			{
-				packet = frame->GetNextRtpPacket();
-				if(packet == nullptr)
-				{
-					break;
-				}
-
-				rtp_packets.push_back(packet);
+				_observer->OnRtpFrameReceived(frame->GetPackets());
 			}
-
-			_observer->OnRtpFrameReceived(rtp_packets);
 		}
 	}
 	else if(jitter_buffer_type == 2)
@@ -16,6 +16,8 @@
 #define RECEIVER_REPORT_CYCLE_MS	500
 #define TRANSPORT_CC_CYCLE_MS		50
 #define SDES_CYCLE_MS 500
+// Maximum number of lost packets to request in a NACK
+#define NACK_MAX_LOST_IDS	64
 
 class RtpRtcpInterface : public ov::EnableSharedFromThis<RtpRtcpInterface>
 {
@@ -37,11 +39,16 @@ public:
 	bool SendRtpPacket(const std::shared_ptr<RtpPacket> &packet);
 	bool SendPLI(uint32_t media_ssrc);
 	bool SendFIR(uint32_t media_ssrc);
+	bool SendNACK(uint32_t media_ssrc, const std::vector<uint16_t> &lost_ids);
 
 	bool IsTransportCcFeedbackEnabled() const;
 	bool EnableTransportCcFeedback(uint8_t extension_id);
 	void DisableTransportCcFeedback();
 
+	// Generic NACK (RFC 4585) for the tracks using the frame jitter buffer
+	bool IsNackEnabled() const;
+	void EnableNack();
+
 	// These functions help the next node to not have to parse the packet again.
 	// Because next node receives raw data format.
 	std::shared_ptr<RtpPacket> GetLastSentRtpPacket();
@@ -73,6 +80,8 @@ private:
 
 	bool _transport_cc_feedback_enabled = false;
 	uint8_t _transport_cc_feedback_extension_id = 0;
+
+	bool _nack_enabled = false;
 	
 	// Receiver SSRC (For RTCP RR, FIR... etc)
 	std::unordered_map<uint32_t, std::shared_ptr<RtpReceiveStatistics>> _receive_statistics;
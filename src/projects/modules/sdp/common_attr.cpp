@@ -9,9 +9,7 @@
 
 #include "common_attr.h"
 
-#include <regex>
-
-#include "sdp_regex_pattern.h"
+#include "sdp_tokenizer.h"
 
 CommonAttr::CommonAttr()
 {
@@ -68,136 +66,62 @@ bool CommonAttr::SerializeCommonAttr(ov::String &sdp)
 	return true;
 }
 
-bool CommonAttr::ParsingCommonAttrLine(char type, std::string content)
+bool CommonAttr::ParsingCommonAttrLine(char type, std::string_view content)
 {
-	std::smatch matches;
+	SdpTokenizer tokenizer(content);
 
 	// a=fingerprint:sha-256 D7:81:CF:01:46:FB:2D
-	if (content.compare(0, OV_COUNTOF("fi") - 1, "fi") == 0)
+	if (tokenizer.Skip("fingerprint:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^fingerprint:(\\S*) (\\S*)")))
-		{
-			_fingerprint_algorithm = std::string(matches[1]).c_str();
-			_fingerprint_value = std::string(matches[2]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchFingerprint(content.c_str());
-		if (match.GetGroupCount() != 2 + 1)
+		auto algorithm = tokenizer.ReadToken();
+		if (tokenizer.Skip(' ') == false)
 		{
 			return false;
 		}
 
-		_fingerprint_algorithm = match.GetGroupAt(1).GetValue();
-		_fingerprint_value = match.GetGroupAt(2).GetValue();
+		_fingerprint_algorithm = SdpTokenizer::ToString(algorithm);
+		_fingerprint_value = SdpTokenizer::ToString(tokenizer.ReadToken());
 	}
 	// a=ice-options:trickle
-	else if (content.compare(0, OV_COUNTOF("ice-o") - 1, "ice-o") == 0)
+	else if (tokenizer.Skip("ice-options:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^ice-options:(\\S*)")))
-		{
-			_ice_option = std::string(matches[1]).c_str();
-		}
-		*/
-
-		auto match = SDPRegexPattern::GetInstance()->MatchIceOption(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_ice_option = match.GetGroupAt(1).GetValue();
+		_ice_option = SdpTokenizer::ToString(tokenizer.ReadToken());
 	}
 	// a=ice-ufrag:0dfa46c9
-	else if (content.compare(0, OV_COUNTOF("ice-u") - 1, "ice-u") == 0)
+	else if (tokenizer.Skip("ice-ufrag:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^ice-ufrag:(\\S*)")))
-		{
-			_ice_ufrag = std::string(matches[1]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchIceUfrag(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_ice_ufrag = match.GetGroupAt(1).GetValue();
+		_ice_ufrag = SdpTokenizer::ToString(tokenizer.ReadToken());
 	}
-	else if (content.compare(0, OV_COUNTOF("ice-p") - 1, "ice-p") == 0)
+	else if (tokenizer.Skip("ice-pwd:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^ice-pwd:(\\S*)")))
-		{
-			_ice_pwd = std::string(matches[1]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchIcePwd(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_ice_pwd = match.GetGroupAt(1).GetValue();
+		_ice_pwd = SdpTokenizer::ToString(tokenizer.ReadToken());
 	}
-	else if (content.compare(0, OV_COUNTOF("cand") - 1, "cand") == 0)
+	else if (tokenizer.Skip("candidate:"))
 	{
 		// candidate:1 1 UDP 2130706431 198.51.100.1 39132 typ host
 		auto candidate = std::make_shared<IceCandidate>();
-		if (candidate->ParseFromString(content.c_str()) == true)
+		if (candidate->ParseFromString(SdpTokenizer::ToString(content)) == true)
 		{
 			AddIceCandidate(candidate);
 		}
 	}
-	else if (content.compare(0, OV_COUNTOF("con") - 1, "con") == 0)
+	else if (tokenizer.Skip("control:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^control:(\\S*)")))
-		{
-			_control = std::string(matches[1]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchControl(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_control = match.GetGroupAt(1).GetValue();
+		_control = SdpTokenizer::ToString(tokenizer.ReadToken());
 	}
-	else if (content.compare(0, OV_COUNTOF("set") - 1, "set") == 0)
+	// a=setup:actpass
+	else if (tokenizer.Skip("setup:"))
 	{
-		// a=setup:actpass
-		/*
-		if(std::regex_search(content, matches, std::regex("^setup:(\\w*)")))
-		{
-			if(matches.size() != 1 + 1)
-			{
-				parsing_error = true;
-				break;
-			}
-
-			SetSetup(std::string(matches[1]).c_str());
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchSetup(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		SetSetup(match.GetGroupAt(1).GetValue());
+		SetSetup(SdpTokenizer::ToString(tokenizer.ReadWord()));
 	}
 	// a=end-of-candidates
-	else if (content.compare(0, OV_COUNTOF("end-of") - 1, "end-of") == 0)
+	else if (tokenizer.Skip("end-of-candidates"))
 	{
 		// Nothing to do
 	}
 	else
 	{
-		logw("SDP", "Unknown attribute type: %c=%s", type, content.c_str());
+		logw("SDP", "Unknown attribute type: %c=%.*s", type, static_cast<int>(content.size()), content.data());
 	}
 
 	return true;
@@ -8,6 +8,8 @@
 //==============================================================================
 
 #pragma once
+#include <string_view>
+
 #include "modules/ice/ice_candidate.h"
 #include "sdp_base.h"
 
@@ -19,7 +21,7 @@ protected:
 	~CommonAttr();
 
 	bool SerializeCommonAttr(ov::String& sdp);
-	bool ParsingCommonAttrLine(char type, std::string content);
+	bool ParsingCommonAttrLine(char type, std::string_view content);
 
 public:
 	enum class SetupType
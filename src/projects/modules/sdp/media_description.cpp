@@ -9,9 +9,7 @@
 
 #include "media_description.h"
 
-#include <regex>
-
-#include "sdp_regex_pattern.h"
+#include "sdp_tokenizer.h"
 #include "session_description.h"
 
 MediaDescription::MediaDescription()
@@ -182,22 +180,15 @@ bool MediaDescription::SetMediaType(const ov::String &type)
 
 bool MediaDescription::FromString(const ov::String &desc)
 {
-	std::stringstream sdpstream(desc.CStr());
-	std::string line;
+	std::string_view text(desc.CStr(), desc.GetLength());
+	char type;
+	std::string_view content;
 
-	while (std::getline(sdpstream, line, '\n'))
+	while (SdpTokenizer::NextLine(text, &type, &content))
 	{
-		if (line.size() && line[line.length() - 1] == '\r')
-		{
-			line.pop_back();
-		}
-
-		char type = line[0];
-		std::string content = line.substr(2);
-
 		if (ParsingMediaLine(type, content) == false)
 		{
-			logw("SDP", "Could not parse line: %c: %s (%s)", type, content.c_str(), line.c_str());
+			logw("SDP", "Could not parse line: %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			return false;
 		}
 	}
@@ -233,460 +224,273 @@ bool MediaDescription::SetDirection(const ov::String &dir)
 	return true;
 }
 
-bool MediaDescription::ParsingMediaLine(char type, std::string content)
+bool MediaDescription::ParsingMediaLine(char type, std::string_view content)
 {
 	bool parsing_error = false;
-	std::smatch matches;
+	SdpTokenizer tokenizer(content);
 
 	switch (type)
 	{
-		case 'm':
+		case 'm': {
 			// m=video 9 UDP/TLS/RTP/SAVPF 97
-			/*
-			if(std::regex_search(content, matches, std::regex("^(\\w*) (\\d*) ([\\w\\/]*)(?: (.*))?")))
+			auto media_type = tokenizer.ReadWord();
+			if (tokenizer.Skip(' ') == false)
 			{
-				if(matches.size() < 4 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
+				parsing_error = true;
+				break;
+			}
 
-				if(!SetMediaType(std::string(matches[1]).c_str()))
-				{
-					parsing_error = true;
-					break;
-				}
+			auto port = tokenizer.ReadDigits();
+			if (tokenizer.Skip(' ') == false)
+			{
+				parsing_error = true;
+				break;
+			}
 
-				SetPort(std::stoul(matches[2]));
+			auto protocol_value = tokenizer.ReadWord("/");
+			if (tokenizer.Skip(' ') == false)
+			{
+				parsing_error = true;
+				break;
+			}
 
-				ov::String protocol = std::string(matches[3]).c_str();
-				if(protocol.UpperCaseString() == "UDP/TLS/RTP/SAVPF")
-				{
-					UseDtls(true);
-				}
-				else if(protocol.UpperCaseString() == "RTP/AVPF" || protocol.UpperCaseString() == "RTP/AVP")
-				{
-					UseDtls(false);
-				}
-				else
-				{
-					loge("SDP", "Cannot support %s protocol", protocol.CStr());
-					parsing_error = true;
-					break;
-				}
+			if (!SetMediaType(SdpTokenizer::ToString(media_type)))
+			{
+				parsing_error = true;
+				break;
+			}
 
-				std::string payload_number;
-				std::stringstream payload_numbers(matches[4]);
-				while(std::getline(payload_numbers, payload_number, ' '))
-				{
-					auto payload = std::make_shared<PayloadAttr>();
-					payload->SetId(static_cast<uint8_t>(std::stoul(payload_number)));
-					AddPayload(payload);
-				}
+			SetPort(SdpTokenizer::ToUInt32(port));
+
+			ov::String protocol = SdpTokenizer::ToString(protocol_value);
+			if (protocol.UpperCaseString() == "UDP/TLS/RTP/SAVPF")
+			{
+				UseDtls(true);
+			}
+			else if (protocol.UpperCaseString() == "RTP/AVPF" || protocol.UpperCaseString() == "RTP/AVP")
+			{
+				UseDtls(false);
 			}
 			else
 			{
+				loge("SDP", "Cannot support %s protocol", protocol.CStr());
 				parsing_error = true;
+				break;
 			}
-			*/
+
+			while (tokenizer.IsEnd() == false)
 			{
-				auto match = SDPRegexPattern::GetInstance()->MatchMedia(content.c_str());
-				if (match.GetGroupCount() != 4 + 1)
+				auto payload_number = tokenizer.ReadToken();
+				if (payload_number.empty())
 				{
-					parsing_error = true;
-					break;
+					tokenizer.SkipSpace();
+					continue;
 				}
 
-				if (!SetMediaType(match.GetGroupAt(1).GetValue()))
-				{
-					parsing_error = true;
-					break;
-				}
-
-				SetPort(ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr()));
+				auto payload = std::make_shared<PayloadAttr>();
+				payload->SetId(SdpTokenizer::ToUInt32(payload_number));
+				AddPayload(payload);
+			}
+			break;
+		}
 
-				ov::String protocol = match.GetGroupAt(3).GetValue();
-				if (protocol.UpperCaseString() == "UDP/TLS/RTP/SAVPF")
-				{
-					UseDtls(true);
-				}
-				else if (protocol.UpperCaseString() == "RTP/AVPF" || protocol.UpperCaseString() == "RTP/AVP")
-				{
-					UseDtls(false);
-				}
-				else
-				{
-					loge("SDP", "Cannot support %s protocol", protocol.CStr());
-					parsing_error = true;
-					break;
-				}
+		case 'c': {
+			// c=IN IP4 0.0.0.0
+			if (tokenizer.Skip("IN IP") == false)
+			{
+				break;
+			}
 
-				auto payload_numbers = match.GetGroupAt(4).GetValue();
-				auto items = payload_numbers.Split(" ");
-				for (const auto &item : items)
-				{
-					auto payload = std::make_shared<PayloadAttr>();
-					payload->SetId(ov::Converter::ToUInt32(item.CStr()));
-					AddPayload(payload);
-				}
+			auto version = tokenizer.ReadDigits();
+			if ((version.size() != 1) || (tokenizer.Skip(' ') == false))
+			{
+				break;
 			}
+
+			SetConnection(SdpTokenizer::ToUInt32(version), SdpTokenizer::ToString(tokenizer.ReadToken()));
 			break;
-		case 'c':
-			// c=IN IP4 0.0.0.0
-			/*
-			if(std::regex_search(content, matches, std::regex("^IN IP(\\d) (\\S*)")))
+		}
+
+		case 'a':
+			// a=rtpmap:96 VP8/50000/?
+			if (tokenizer.Skip("rtpmap:"))
 			{
-				if(matches.size() != 2 + 1)
+				auto payload_type = tokenizer.ReadDigits();
+				if (tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetConnection(std::stoul(matches[1]), std::string(matches[2]).c_str());
-			}
-			else
-			{
-				parsing_error = true;
-			}
-			*/
+				auto codec = tokenizer.ReadWord("-.");
+				while (tokenizer.SkipSpace())
+				{
+				}
 
-			{
-				auto match = SDPRegexPattern::GetInstance()->MatchConnection(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+				// The rate is mandatory
+				if (tokenizer.Skip('/') == false)
 				{
+					parsing_error = true;
 					break;
 				}
 
-				SetConnection(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue());
-			}
-			break;
+				auto rate = tokenizer.ReadDigits();
+				std::string_view parameters;
 
-		case 'a':
-			// For Performance
-			if (content.compare(0, OV_COUNTOF("rtp") - 1, "rtp") == 0)
-			{
-				// a=rtpmap:96 VP8/50000/?
-				/*
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("rtpmap:(\\d*) ([\\w\\-\\.]*)(?:\\s*\\/(\\d*)(?:\\s*\\/(\\S*))?)?")))
+				auto rest = tokenizer;
+				while (rest.SkipSpace())
 				{
-					if(matches.size() < 3 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					AddRtpmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(),
-					          static_cast<uint32_t>(std::stoul(matches[3])), std::string(matches[4]).c_str());
 				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchRtpmap(content.c_str());
-				if (match.GetGroupCount() < 3 + 1)
+				if (rest.Skip('/'))
 				{
-					parsing_error = true;
-					break;
+					parameters = rest.ReadToken();
 				}
 
 				AddRtpmap(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue(),
-					ov::Converter::ToUInt32(match.GetGroupAt(3).GetValue().CStr()),
-					match.GetGroupAt(4).GetValue());
+					SdpTokenizer::ToUInt32(payload_type),
+					SdpTokenizer::ToString(codec),
+					SdpTokenizer::ToUInt32(rate),
+					SdpTokenizer::ToString(parameters));
 			}
 			// a=rtcp-mux
-			else if (content.compare(0, OV_COUNTOF("rtcp-m") - 1, "rtcp-m") == 0)
+			else if (tokenizer.Skip("rtcp-mux"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^(rtcp-mux)")))
-				{
-					UseRtcpMux(true);
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchRtcpMux(content.c_str());
-				if (match.GetError() == nullptr)
-				{
-					UseRtcpMux(true);
-				}
+				UseRtcpMux(true);
 			}
-			else if (content.compare(0, OV_COUNTOF("rtcp-r") - 1, "rtcp-r") == 0)
+			else if (tokenizer.Skip("rtcp-rsize"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^(rtcp-rsize)")))
-				{
-					UseRtcpRsize(true);
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchRtcpRsize(content.c_str());
-				if (match.GetError() == nullptr)
-				{
-					UseRtcpRsize(true);
-				}
+				UseRtcpRsize(true);
 			}
-			else if (content.compare(0, OV_COUNTOF("rtcp-f") - 1, "rtcp-f") == 0)
+			else if (tokenizer.Skip("rtcp-fb:"))
 			{
 				//TODO(Getroot): Implement full spec
 				//https://datatracker.ietf.org/doc/html/rfc5104#section-7.1
 				// a=rtcp-fb:96 nack pli
-				/*
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("rtcp-fb:(\\*|\\d*) (.*)")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					EnableRtcpFb(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(), true);
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchRtcpFb(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+				auto id = tokenizer.Skip('*') ? std::string_view() : tokenizer.ReadDigits();
+				if (tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
 				EnableRtcpFb(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue(),
+					SdpTokenizer::ToUInt32(id),
+					SdpTokenizer::ToString(tokenizer.ReadRest()),
 					true);
 			}
-			else if (content.compare(0, OV_COUNTOF("mid") - 1, "mid") == 0)
+			else if (tokenizer.Skip("mid:"))
 			{
 				// a=mid:video,
-				/*
-				if(std::regex_search(content, matches, std::regex("^mid:([^\\s]*)")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetMid(std::string(matches[1]).c_str());
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchMid(content.c_str());
-				if (match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				SetMid(match.GetGroupAt(1).GetValue());
+				SetMid(SdpTokenizer::ToString(tokenizer.ReadToken()));
 			}
-			else if (content.compare(0, OV_COUNTOF("msid") - 1, "msid") == 0)
+			else if (tokenizer.Skip("msid:"))
 			{
 				// a=msid:0nm3jPz5YtRJ1NF26G9IKrUCBlWavuwbeiSf 6jHsvxRPcpiEVZbA5QegGowmCtOlh8kTaXJ4
-				/*
-				if(std::regex_search(content, matches, std::regex("^msid:(.*) (.*)")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetMsid(std::string(matches[1]).c_str(), std::string(matches[2]).c_str());
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchMsid(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+				auto value = tokenizer.ReadRest();
+				auto space = value.rfind(' ');
+				if (space == std::string_view::npos)
 				{
 					parsing_error = true;
 					break;
 				}
 
 				SetMsid(
-					match.GetGroupAt(1).GetValue(),
-					match.GetGroupAt(2).GetValue());
+					SdpTokenizer::ToString(value.substr(0, space)),
+					SdpTokenizer::ToString(value.substr(space + 1)));
 			}
-			else if (content.compare(0, OV_COUNTOF("ss") - 1, "ss") == 0)
+			else if (tokenizer.Skip("ssrc:"))
 			{
 				// a=ssrc:2064629418 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
-				/*
-				if(std::regex_search(content, matches, std::regex("^ssrc:(\\d*) cname(?::(.*))?")))
+				auto ssrc = tokenizer.ReadDigits();
+				if ((tokenizer.Skip(" cname") == false))
 				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-					SetSsrc(stoul(matches[1]));
-					SetCname(std::string(matches[2]).c_str());
-				}
-				else if(std::regex_search(content, matches, std::regex("^ssrc-group:FID ([0-9]*) ([0-9]*)")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetSsrc(stoul(matches[1]));
-					SetRtxSsrc(stoul(matches[2]));
+					// Other attributes of the SSRC are not used
+					break;
 				}
-				*/
 
-				auto match = SDPRegexPattern::GetInstance()->MatchSsrcCname(content.c_str());
-				if (match.GetError() == nullptr)
+				if (tokenizer.Skip(':') == false)
 				{
-					if (match.GetGroupCount() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetSsrc(ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()));
-					SetCname(match.GetGroupAt(2).GetValue());
+					parsing_error = true;
+					break;
 				}
-				else
+
+				SetSsrc(SdpTokenizer::ToUInt32(ssrc));
+				SetCname(SdpTokenizer::ToString(tokenizer.ReadRest()));
+			}
+			else if (tokenizer.Skip("ssrc-group:FID "))
+			{
+				// a=ssrc-group:FID 2064629418 2064629419
+				auto ssrc = tokenizer.ReadDigits();
+				if (tokenizer.Skip(' ') == false)
 				{
-					auto match = SDPRegexPattern::GetInstance()->MatchSsrcFid(content.c_str());
-					if (match.GetError() == nullptr)
-					{
-						if (match.GetGroupCount() != 2 + 1)
-						{
-							parsing_error = true;
-							break;
-						}
-
-						SetSsrc(ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()));
-						SetRtxSsrc(ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr()));
-					}
-					else
-					{
-						// unknown pattern
-					}
+					// unknown pattern
+					break;
 				}
+
+				SetSsrc(SdpTokenizer::ToUInt32(ssrc));
+				SetRtxSsrc(SdpTokenizer::ToUInt32(tokenizer.ReadDigits()));
 			}
-			else if (content.compare(0, OV_COUNTOF("fra") - 1, "fra") == 0)
+			else if (tokenizer.Skip("framerate:"))
 			{
 				// a=framerate:29.97
-				/*
-				if(std::regex_search(content, matches, std::regex("^framerate:(\\d+(?:$|\\.\\d+))")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
+				auto value = tokenizer.GetRest();
+				auto integer = tokenizer.ReadDigits();
+				bool is_valid = (integer.empty() == false);
 
-					SetFramerate(std::stof(matches[1]));
+				if (is_valid && (tokenizer.IsEnd() == false))
+				{
+					is_valid = tokenizer.Skip('.') && (tokenizer.ReadDigits().empty() == false);
 				}
-				*/
 
-				auto match = SDPRegexPattern::GetInstance()->MatchFramerate(content.c_str());
-				if (match.GetGroupCount() != 1 + 1)
+				if (is_valid == false)
 				{
 					// Not critical error
 					// parsing_error = true;
-					logw("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
+					logw("SDP", "Sdp parsing error : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 
 					break;
 				}
 
-				SetFramerate(ov::Converter::ToFloat(match.GetGroupAt(1).GetValue().CStr()));
+				value = value.substr(0, value.size() - tokenizer.GetRest().size());
+				SetFramerate(ov::Converter::ToFloat(SdpTokenizer::ToString(value).CStr()));
 			}
 			// a=sendonly
-			else if (content.compare(0, OV_COUNTOF("sen") - 1, "sen") == 0 ||
-					 content.compare(0, OV_COUNTOF("rec") - 1, "rec") == 0 ||
-					 content.compare(0, OV_COUNTOF("ina") - 1, "ina") == 0)
+			else if (tokenizer.Skip("sendrecv") || tokenizer.Skip("recvonly") ||
+					 tokenizer.Skip("sendonly") || tokenizer.Skip("inactive"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^(sendrecv|recvonly|sendonly|inactive)")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					if(!SetDirection(std::string(matches[1]).c_str()))
-					{
-						parsing_error = true;
-						break;
-					}
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchDirection(content.c_str());
-				if (match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				SetDirection(match.GetGroupAt(1).GetValue());
+				SetDirection(SdpTokenizer::ToString(content.substr(0, content.size() - tokenizer.GetRest().size())));
 			}
-			else if (content.compare(0, OV_COUNTOF("fmtp") - 1, "fmtp") == 0)
+			else if (tokenizer.Skip("fmtp:"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("fmtp:(\\*|\\d*) (.*)")))
-				{
-					SetFmtp(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str());
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchFmtp(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+				// a=fmtp:96 packetization-mode=1;profile-level-id=42e01f
+				auto id = tokenizer.Skip('*') ? std::string_view() : tokenizer.ReadDigits();
+				if (tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
 				SetFmtp(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue());
+					SdpTokenizer::ToUInt32(id),
+					SdpTokenizer::ToString(tokenizer.ReadRest()));
 			}
-			else if (content.compare(0, OV_COUNTOF("rtcp:") - 1, "rtcp:") == 0)
+			else if (tokenizer.Skip("rtcp:"))
 			{
 				// No need
 			}
-			else if (content.compare(0, OV_COUNTOF("ext") - 1, "ext") == 0)
+			else if (tokenizer.Skip("extmap:"))
 			{
 				// a=extmap:1[/direction] urn:ietf:params:rtp-hdrext:framemarking
-				/*
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("extmap:(\\*|\\d*) (.*)")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					AddExtmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str());
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchExtmap(content.c_str());
-				if (match.GetGroupCount() < 2 + 1)
+				auto value = tokenizer.ReadWord("/");
+				if (tokenizer.Skip(' ') == false)
 				{
 					break;
 				}
 
-				auto value = match.GetGroupAt(1).GetValue();
-				uint8_t id = 0;
-				if (value.IndexOf("/") == -1)
-				{
-					id = ov::Converter::ToUInt32(value.CStr());
-				}
-				else
-				{
-					id = ov::Converter::ToUInt32(value.Left(value.IndexOf("/")).CStr());
-				}
-
+				// The direction is ignored
 				AddExtmap(
-					id,
-					match.GetGroupAt(2).GetValue());
+					SdpTokenizer::ToUInt32(value.substr(0, value.find('/'))),
+					SdpTokenizer::ToString(tokenizer.ReadToken()));
 			}
 			else if (ParsingCommonAttrLine(type, content))
 			{
@@ -694,18 +498,18 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 			else
 			{
 				// Other attributes are ignored because they are not required.
-				logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+				logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			}
 
 			break;
 		default:
-			logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+			logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			break;
 	}
 
 	if (parsing_error)
 	{
-		logw("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
+		logw("SDP", "Sdp parsing error : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 	}
 
 	return true;
@@ -117,7 +117,7 @@ public:
 
 private:
 	bool UpdateData(ov::String &sdp) override;
-	bool ParsingMediaLine(char type, std::string content);
+	bool ParsingMediaLine(char type, std::string_view content);
 
 	MediaType _media_type = MediaType::Unknown;
 	ov::String _media_type_str = "UNKNOWN";
@@ -0,0 +1,139 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "sdp_tokenizer.h"
+
+static inline bool IsSpace(char character)
+{
+	return (character == ' ') || (character == '\t') || (character == '\r') || (character == '\n') || (character == '\f') || (character == '\v');
+}
+
+static inline bool IsDigit(char character)
+{
+	return (character >= '0') && (character <= '9');
+}
+
+static inline bool IsWord(char character)
+{
+	return ((character >= 'a') && (character <= 'z')) ||
+		   ((character >= 'A') && (character <= 'Z')) ||
+		   IsDigit(character) ||
+		   (character == '_');
+}
+
+bool SdpTokenizer::NextLine(std::string_view &text, char *type, std::string_view *content, std::string_view *line)
+{
+	while (text.empty() == false)
+	{
+		auto line_end = text.find('\n');
+		auto current_line = text.substr(0, line_end);
+
+		text.remove_prefix((line_end == std::string_view::npos) ? text.size() : (line_end + 1));
+
+		if ((current_line.empty() == false) && (current_line.back() == '\r'))
+		{
+			current_line.remove_suffix(1);
+		}
+
+		// ^([a-z])=(.*)
+		if ((current_line.size() >= 2) && (current_line[0] >= 'a') && (current_line[0] <= 'z') && (current_line[1] == '='))
+		{
+			*type = current_line[0];
+			*content = current_line.substr(2);
+
+			if (line != nullptr)
+			{
+				*line = current_line;
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint32_t SdpTokenizer::ToUInt32(std::string_view digits)
+{
+	// Same as ov::Converter::ToUInt32() for the values used in SDP, without exceptions for empty values
+	uint64_t value = 0;
+
+	for (auto character : digits)
+	{
+		if (IsDigit(character) == false)
+		{
+			break;
+		}
+
+		value = (value * 10) + (character - '0');
+	}
+
+	return static_cast<uint32_t>(value);
+}
+
+bool SdpTokenizer::Skip(std::string_view text)
+{
+	if (_text.compare(_position, text.size(), text) != 0)
+	{
+		return false;
+	}
+
+	_position += text.size();
+	return true;
+}
+
+bool SdpTokenizer::Skip(char character)
+{
+	if ((IsEnd()) || (_text[_position] != character))
+	{
+		return false;
+	}
+
+	_position++;
+	return true;
+}
+
+bool SdpTokenizer::SkipSpace()
+{
+	if ((IsEnd()) || (IsSpace(_text[_position]) == false))
+	{
+		return false;
+	}
+
+	_position++;
+	return true;
+}
+
+std::string_view SdpTokenizer::ReadToken()
+{
+	return ReadWhile([](char character) { return IsSpace(character) == false; });
+}
+
+std::string_view SdpTokenizer::ReadWord()
+{
+	return ReadWhile(IsWord);
+}
+
+std::string_view SdpTokenizer::ReadDigits()
+{
+	return ReadWhile(IsDigit);
+}
+
+std::string_view SdpTokenizer::ReadWord(std::string_view extra_characters)
+{
+	return ReadWhile([extra_characters](char character) {
+		return IsWord(character) || (extra_characters.find(character) != std::string_view::npos);
+	});
+}
+
+std::string_view SdpTokenizer::ReadRest()
+{
+	auto rest = GetRest();
+	_position = _text.size();
+	return rest;
+}
@@ -0,0 +1,82 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <string_view>
+
+#include "base/ovlibrary/ovlibrary.h"
+
+// Scans a line of SDP without copying it.
+//
+// The lines of offers/answers are parsed for every WebRTC/WHIP session, so they are
+// parsed by hand instead of regular expressions. Each Read*() function consumes the characters it returns,
+// and the functions that return bool don't consume anything if they fail.
+class SdpTokenizer
+{
+public:
+	explicit SdpTokenizer(std::string_view text)
+		: _text(text)
+	{
+	}
+
+	// Gets the next "<type>=<value>" line from the text, and removes it from the text.
+	// Lines that are not in this form are skipped.
+	static bool NextLine(std::string_view &text, char *type, std::string_view *content, std::string_view *line = nullptr);
+
+	static uint32_t ToUInt32(std::string_view digits);
+
+	static ov::String ToString(std::string_view value)
+	{
+		return ov::String(value.data(), value.size());
+	}
+
+	bool IsEnd() const
+	{
+		return _position >= _text.size();
+	}
+
+	std::string_view GetRest() const
+	{
+		return _text.substr(_position);
+	}
+
+	// Consumes the text if the rest starts with it
+	bool Skip(std::string_view text);
+	bool Skip(char character);
+	// Consumes a whitespace if there is
+	bool SkipSpace();
+
+	// \S*
+	std::string_view ReadToken();
+	// \w*
+	std::string_view ReadWord();
+	// \d*
+	std::string_view ReadDigits();
+	// Characters of \w and <extra_characters>
+	std::string_view ReadWord(std::string_view extra_characters);
+	// .*
+	std::string_view ReadRest();
+
+private:
+	template <typename Tpredicate>
+	std::string_view ReadWhile(Tpredicate predicate)
+	{
+		auto start = _position;
+
+		while ((_position < _text.size()) && predicate(_text[_position]))
+		{
+			_position++;
+		}
+
+		return _text.substr(start, _position - start);
+	}
+
+	std::string_view _text;
+	size_t _position = 0;
+};
@@ -1,16 +1,6 @@
-/*
- *
- * The REGEX pattern in this source code is refers to libsdptransform.
- * https://github.com/ibc/libsdptransform [MIT LICENSE]
- *
- *
- */
-
 #include "session_description.h"
-#include <sstream>
-#include <regex>
 
-#include "sdp_regex_pattern.h"
+#include "sdp_tokenizer.h"
 
 SessionDescription::SessionDescription()
 {
@@ -95,63 +85,48 @@ bool SessionDescription::UpdateData(ov::String &sdp)
 
 bool SessionDescription::FromString(const ov::String &sdp)
 {
-	static const std::regex ValidLineRegex("^([a-z])=(.*)");
-	std::stringstream sdpstream(sdp.CStr());
-	std::string line;
+	std::string_view text(sdp.CStr(), sdp.GetLength());
+	char type;
+	std::string_view content;
+	std::string_view line;
 
-	ov::String media_desc_sdp;
-	bool media_level = false;
+	// The lines of the current media section
+	const char *media_section_begin = nullptr;
+	const char *media_section_end = nullptr;
 
-	while(std::getline(sdpstream, line, '\n'))
+	while (true)
 	{
-		if(line.size() && line[line.length() - 1] == '\r')
+		bool has_line = SdpTokenizer::NextLine(text, &type, &content, &line);
+
+		if ((media_section_begin != nullptr) && ((has_line == false) || (type == 'm')))
 		{
-			line.pop_back();
+			auto media_desc = std::make_shared<MediaDescription>();
+			if (media_desc->FromString(ov::String(media_section_begin, media_section_end - media_section_begin)) == false)
+			{
+				return false;
+			}
+			AddMedia(media_desc);
+
+			media_section_begin = nullptr;
 		}
 
-		if(!std::regex_search(line, ValidLineRegex))
+		if (has_line == false)
 		{
-			continue;
+			break;
 		}
-		char type = line[0];
-		std::string content = line.substr(2);
 
-		if(type == 'm')
+		if (type == 'm')
 		{
-			if(media_level == true)
-			{
-				auto media_desc = std::make_shared<MediaDescription>();
-				if(media_desc->FromString(media_desc_sdp) == false)
-				{
-					return false;
-				}
-				AddMedia(media_desc);
-			}
-
-			media_desc_sdp.Clear();
-			media_desc_sdp.AppendFormat("%s\n", line.c_str());
-			media_level = true;
+			media_section_begin = line.data();
 		}
-		else if(media_level == true)
-		{
-			media_desc_sdp.AppendFormat("%s\n", line.c_str());
 
-			if(sdpstream.rdbuf()->in_avail() == 0)
-			{
-				auto media_desc = std::make_shared<MediaDescription>();
-				if(media_desc->FromString(media_desc_sdp) == false)
-				{
-					return false;
-				}
-				AddMedia(media_desc);
-			}
+		if (media_section_begin != nullptr)
+		{
+			media_section_end = line.data() + line.size();
 		}
-		else
+		else if (ParsingSessionLine(type, content) == false)
 		{
-			if(ParsingSessionLine(type, content) == false)
-			{
-				return false;
-			}
+			return false;
 		}
 	}
 
@@ -160,215 +135,146 @@ bool SessionDescription::FromString(const ov::String &sdp)
 	return true;
 }
 
-bool SessionDescription::ParsingSessionLine(char type, std::string content)
+bool SessionDescription::ParsingSessionLine(char type, std::string_view content)
 {
 	bool parsing_error = false;
-	std::smatch matches;
+	SdpTokenizer tokenizer(content);
 
 	switch(type)
 	{
-		case 'v':
-			/*
+		case 'v': {
 			// v=0
-			if(std::regex_search(content, matches, std::regex("^(\\d*)$")))
+			auto version = tokenizer.ReadDigits();
+			if(tokenizer.IsEnd() == false)
 			{
-				if(matches.size() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-				SetVersion(static_cast<uint8_t>(std::stoi(matches[1])));
+				parsing_error = true;
+				break;
 			}
-			*/
-			{
-				auto match = SDPRegexPattern::GetInstance()->MatchVersion(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
 
-				SetVersion(ov::Converter::ToInt32(match.GetGroupAt(1).GetValue().CStr()));
-			}
+			SetVersion(SdpTokenizer::ToUInt32(version));
 			break;
-		case 'o':
+		}
+
+		case 'o': {
 			// o=OvenMediaEngine 1882243660 2 IN IP4 127.0.0.1
-			/*
-			if(std::regex_search(content, matches, std::regex("^(\\S*) (\\d*) (\\d*) (\\S*) IP(\\d) (\\S*)")))
+			auto user_name = tokenizer.ReadToken();
+			if(tokenizer.Skip(' ') == false)
 			{
-				if(matches.size() != 6 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				SetOrigin(std::string(matches[1]).c_str(),
-				          static_cast<uint32_t>(std::stoul(matches[2])),
-				          static_cast<uint32_t>(std::stoul(matches[3])),
-				          std::string(matches[4]).c_str(),
-				          static_cast<uint8_t>(std::stoul(matches[5])),
-				          std::string(matches[6]).c_str());
+				parsing_error = true;
+				break;
 			}
-			*/
+
+			auto session_id = tokenizer.ReadDigits();
+			if(tokenizer.Skip(' ') == false)
 			{
-				auto match = SDPRegexPattern::GetInstance()->MatchOrigin(content.c_str());
-				if(match.GetGroupCount() != 6 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
+				parsing_error = true;
+				break;
+			}
 
-				SetOrigin(
-						match.GetGroupAt(1).GetValue(), // user name
-						ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr()), // session id
-						ov::Converter::ToUInt32(match.GetGroupAt(3).GetValue().CStr()), // session version
-						match.GetGroupAt(4).GetValue(), // net_type
-						ov::Converter::ToInt32(match.GetGroupAt(5).GetValue().CStr()), // ip_version
-						match.GetGroupAt(6).GetValue() // address
-						);
+			auto session_version = tokenizer.ReadDigits();
+			if(tokenizer.Skip(' ') == false)
+			{
+				parsing_error = true;
+				break;
 			}
 
-			break;
-		case 's':
-			// s=-
-			/*
-			if(std::regex_search(content, matches, std::regex("^(.*)")))
+			auto net_type = tokenizer.ReadToken();
+			if((tokenizer.Skip(" IP") == false))
 			{
-				if(matches.size() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
+				parsing_error = true;
+				break;
+			}
 
-				SetSessionName(std::string(matches[1]).c_str());
-			}*/
+			auto ip_version = tokenizer.ReadDigits();
+			if((ip_version.size() != 1) || (tokenizer.Skip(' ') == false))
 			{
-				auto match = SDPRegexPattern::GetInstance()->MatchSessionName(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-				
-				SetSessionName(match.GetGroupAt(1).GetValue());
+				parsing_error = true;
+				break;
 			}
+
+			SetOrigin(
+					SdpTokenizer::ToString(user_name),
+					SdpTokenizer::ToUInt32(session_id),
+					SdpTokenizer::ToUInt32(session_version),
+					SdpTokenizer::ToString(net_type),
+					SdpTokenizer::ToUInt32(ip_version),
+					SdpTokenizer::ToString(tokenizer.ReadToken())
+					);
 			break;
-		case 't':
-			// t=0 0
-			/*
-			if(std::regex_search(content, matches, std::regex("^(\\d*) (\\d*)")))
-			{
-				if(matches.size() != 2 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
+		}
 
-				SetTiming(static_cast<uint32_t>(std::stoul(matches[1])),
-				          static_cast<uint32_t>(std::stoul(matches[2])));
-			}
-			*/
+		case 's':
+			// s=-
+			SetSessionName(SdpTokenizer::ToString(content));
+			break;
+
+		case 't': {
+			// t=0 0
+			auto start_time = tokenizer.ReadDigits();
+			if(tokenizer.Skip(' ') == false)
 			{
-				auto match = SDPRegexPattern::GetInstance()->MatchTiming(content.c_str());
-				if(match.GetGroupCount() != 2 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-				
-				SetTiming(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr())
-				);
+				parsing_error = true;
+				break;
 			}
 
+			SetTiming(
+				SdpTokenizer::ToUInt32(start_time),
+				SdpTokenizer::ToUInt32(tokenizer.ReadDigits())
+			);
 			break;
+		}
+
 		case 'a':
 			// a=group:BUNDLE video audio ...
-			if(content.compare(0, OV_COUNTOF("group:B") - 1, "group:B") == 0)
+			if(tokenizer.Skip("group:BUNDLE"))
 			{
-				auto match = SDPRegexPattern::GetInstance()->MatchGourpBundle(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
+				if(tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
-				
-				auto bundles = match.GetGroupAt(1).GetValue();
-				auto items = bundles.Split(" ");
-				for(const auto &item : items)
+
+				while(tokenizer.IsEnd() == false)
 				{
-					_bundles.emplace_back(item);
+					auto item = tokenizer.ReadToken();
+					if(item.empty())
+					{
+						tokenizer.SkipSpace();
+						continue;
+					}
+
+					_bundles.emplace_back(SdpTokenizer::ToString(item));
 				}
 			}
 			// a=group:LS video audio ...
-			else if (content.compare(0, OV_COUNTOF("group:L") - 1, "group:L") == 0)
+			else if(tokenizer.Skip("group:LS"))
 			{
 				// Skip
 			}
 			// a=msid-semantic:WMS *
-			else if(content.compare(0, OV_COUNTOF("ms") - 1, "ms") == 0)
+			else if(tokenizer.Skip("msid-semantic:"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex(R"(^msid-semantic:\s?(\w*) (\S*))")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
+				tokenizer.SkipSpace();
 
-					SetMsidSemantic(std::string(matches[1]).c_str(), std::string(matches[2]).c_str());
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchMsidSemantic(content.c_str());
-				if(match.GetGroupCount() != 2 + 1)
+				auto semantic = tokenizer.ReadWord();
+				if(tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
 				SetMsidSemantic(
-					match.GetGroupAt(1).GetValue(),
-					match.GetGroupAt(2).GetValue()
+					SdpTokenizer::ToString(semantic),
+					SdpTokenizer::ToString(tokenizer.ReadToken())
 				);
 			}
-			else if(content.compare(0, OV_COUNTOF("sdpl") - 1, "sdpl") == 0)
+			else if(tokenizer.Skip("sdplang:"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^sdplang:(\\S*)")))
-				{
-					_sdp_lang = std::string(matches[1]).c_str();
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchSdpLang(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				_sdp_lang = match.GetGroupAt(1).GetValue();
+				_sdp_lang = SdpTokenizer::ToString(tokenizer.ReadToken());
 			}
-			else if(content.compare(0, OV_COUNTOF("ran") - 1, "ran") == 0)
+			else if(tokenizer.Skip("range:"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^range:(\\S*)")))
-				{
-					_range = std::string(matches[1]).c_str();
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchRange(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				_range = match.GetGroupAt(1).GetValue();
+				_range = SdpTokenizer::ToString(tokenizer.ReadToken());
 			}
 			else if(ParsingCommonAttrLine(type, content))
 			{
@@ -377,17 +283,17 @@ bool SessionDescription::ParsingSessionLine(char type, std::string content)
 			else
 			{
 				// Other attributes are ignored because they are not required.
-				logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+				logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			}
 
 			break;
 		default:
-			logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+			logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 	}
 
 	if(parsing_error)
 	{
-		logw("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
+		logw("SDP", "Sdp parsing error : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 	}
 
 	return true;
@@ -107,7 +107,7 @@ public:
 
 private:
 	bool UpdateData(ov::String &sdp) override;
-	bool ParsingSessionLine(char type, std::string content);
+	bool ParsingSessionLine(char type, std::string_view content);
 
 	// version
 	uint8_t _version = 0;
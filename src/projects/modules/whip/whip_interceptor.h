@@ -14,6 +14,13 @@
 class WhipInterceptor : public http::svr::DefaultInterceptor
 {
 protected:
+	std::vector<http::svr::RequestPattern> GetRequestPatterns() const override
+	{
+		// WHIP requests are distinguished by the query string, so only the methods are declared
+		return {
+			{http::Method::Post | http::Method::Delete | http::Method::Patch | http::Method::Options, "", ""}};
+	}
+
 	bool IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &exchange) override
 	{
 		auto request = exchange->GetRequest();
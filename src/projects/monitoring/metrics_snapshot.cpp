@@ -0,0 +1,181 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "metrics_snapshot.h"
+
+#include <base/ovsocket/socket_pool/socket_pool.h>
+
+#include "monitoring_private.h"
+#include "server_metrics.h"
+
+namespace mon
+{
+	void MetricsSnapshot::Values::CopyFrom(const CommonMetrics &metrics)
+	{
+		created_time = metrics.GetCreatedTime();
+		last_updated_time = metrics.GetLastUpdatedTime();
+
+		total_bytes_in = metrics.GetTotalBytesIn();
+		total_bytes_out = metrics.GetTotalBytesOut();
+		avg_throughput_in = metrics.GetAvgThroughputIn();
+		avg_throughput_out = metrics.GetAvgThroughputOut();
+		max_throughput_in = metrics.GetMaxThroughputIn();
+		max_throughput_out = metrics.GetMaxThroughputOut();
+		last_throughput_in = metrics.GetLastThroughputIn();
+		last_throughput_out = metrics.GetLastThroughputOut();
+		last_recv_time = metrics.GetLastRecvTime();
+		last_sent_time = metrics.GetLastSentTime();
+
+		total_connections = metrics.GetTotalConnections();
+		max_total_connections = metrics.GetMaxTotalConnections();
+		max_total_connections_time = metrics.GetMaxTotalConnectionsTime();
+
+		for (int8_t type = 0; type < static_cast<int8_t>(PublisherType::NumberOfPublishers); type++)
+		{
+			bytes_out[type] = metrics.GetBytesOut(static_cast<PublisherType>(type));
+			connections[type] = metrics.GetConnections(static_cast<PublisherType>(type));
+		}
+	}
+
+	const MetricsSnapshot::Stream *MetricsSnapshot::Application::FindInputStream(const ov::String &name) const
+	{
+		auto item = input_stream_index.find(name);
+
+		return (item != input_stream_index.end()) ? &(streams[item->second]) : nullptr;
+	}
+
+	const MetricsSnapshot::Application *MetricsSnapshot::Host::FindApplication(const ov::String &name) const
+	{
+		for (const auto &application : applications)
+		{
+			if (application.name == name)
+			{
+				return &application;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const MetricsSnapshot::Host *MetricsSnapshot::FindHost(const ov::String &name) const
+	{
+		for (const auto &host : hosts)
+		{
+			if (host.name == name)
+			{
+				return &host;
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::shared_ptr<const MetricsSnapshot> MetricsSnapshot::Create(uint64_t version, const std::shared_ptr<ServerMetrics> &server_metrics)
+	{
+		auto snapshot = std::make_shared<MetricsSnapshot>();
+
+		snapshot->version = version;
+		snapshot->created_time = std::chrono::system_clock::now();
+
+		if (server_metrics == nullptr)
+		{
+			return snapshot;
+		}
+
+		snapshot->server.CopyFrom(*server_metrics);
+
+		// Each map is copied under its own lock, and the values are read after the lock is released
+		auto host_metrics_list = server_metrics->GetHostMetricsList();
+		snapshot->hosts.reserve(host_metrics_list.size());
+
+		for (const auto &[host_id, host_metrics] : host_metrics_list)
+		{
+			auto &host = snapshot->hosts.emplace_back();
+
+			host.id = host_id;
+			host.name = host_metrics->GetName();
+			host.values.CopyFrom(*host_metrics);
+
+			auto app_metrics_list = host_metrics->GetApplicationMetricsList();
+			host.applications.reserve(app_metrics_list.size());
+
+			for (const auto &[app_id, app_metrics] : app_metrics_list)
+			{
+				auto &application = host.applications.emplace_back();
+
+				application.id = app_id;
+				application.name = app_metrics->GetName().GetAppName();
+				application.values.CopyFrom(*app_metrics);
+
+				auto stream_metrics_map = app_metrics->GetStreamMetricsMap();
+				application.streams.reserve(stream_metrics_map.size());
+
+				for (const auto &[stream_id, stream_metrics] : stream_metrics_map)
+				{
+					auto &stream = application.streams.emplace_back();
+
+					stream.id = stream_id;
+					stream.name = stream_metrics->GetName();
+
+					auto input_stream = stream_metrics->GetLinkedInputStream();
+
+					if (input_stream == nullptr)
+					{
+						// The first input stream wins if there are streams with the same name (same as api::GetStream())
+						application.input_stream_index.emplace(stream.name, application.streams.size() - 1);
+					}
+					else
+					{
+						stream.is_input = false;
+						stream.input_stream_id = input_stream->GetId();
+					}
+
+					stream.values.CopyFrom(*stream_metrics);
+					stream.origin_connection_time_msec = stream_metrics->GetOriginConnectionTimeMSec();
+					stream.origin_subscribe_time_msec = stream_metrics->GetOriginSubscribeTimeMSec();
+					stream.deduplicated_encodes = stream_metrics->GetDeduplicatedEncodes();
+				}
+			}
+		}
+
+		auto queue_metrics_list = server_metrics->GetQueueMetricsList();
+		snapshot->queues.reserve(queue_metrics_list.size());
+
+		for (const auto &[queue_id, queue_metrics] : queue_metrics_list)
+		{
+			auto &queue = snapshot->queues.emplace_back();
+
+			queue.id = queue_id;
+			queue.urn = queue_metrics->GetUrn()->ToString();
+			queue.type_name = queue_metrics->GetTypeName();
+			queue.size = queue_metrics->GetSize();
+			queue.peak = queue_metrics->GetPeak();
+			queue.threshold = queue_metrics->GetThreshold();
+			queue.waiting_time = queue_metrics->GetWaitingTime();
+			queue.input_per_second = queue_metrics->GetInputMessagePerSecond();
+			queue.output_per_second = queue_metrics->GetOutputMessagePerSecond();
+			queue.drop_count = queue_metrics->GetDropCount();
+		}
+
+		auto socket_pool_stats_list = ov::SocketPool::GetStatsList();
+		snapshot->socket_pools.reserve(socket_pool_stats_list.size());
+
+		for (const auto &stats : socket_pool_stats_list)
+		{
+			auto &socket_pool = snapshot->socket_pools.emplace_back();
+
+			socket_pool.name = stats.name;
+			socket_pool.type_name = ov::StringFromSocketType(stats.type);
+			socket_pool.worker_count = stats.worker_count;
+			socket_pool.socket_count = stats.socket_count;
+			socket_pool.total_allocated_count = stats.total_allocated_count;
+		}
+
+		return snapshot;
+	}
+}  // namespace mon
@@ -0,0 +1,140 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by getroot
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include "base/common_types.h"
+
+// The interval to take a snapshot of the metrics
+#define MONITORING_SNAPSHOT_INTERVAL_MS 1000
+
+namespace mon
+{
+	class CommonMetrics;
+	class ServerMetrics;
+
+	// An immutable copy of all the metrics at a point in time.
+	//
+	// The counters are copied from the atomics without locking, and the maps of hosts/applications/streams
+	// are only locked while they are copied, so the readers (REST API, exporters) never touch the live metrics.
+	class MetricsSnapshot
+	{
+	public:
+		struct Values
+		{
+			void CopyFrom(const CommonMetrics &metrics);
+
+			std::chrono::system_clock::time_point created_time;
+			std::chrono::system_clock::time_point last_updated_time;
+
+			uint64_t total_bytes_in = 0;
+			uint64_t total_bytes_out = 0;
+			uint64_t avg_throughput_in = 0;
+			uint64_t avg_throughput_out = 0;
+			uint64_t max_throughput_in = 0;
+			uint64_t max_throughput_out = 0;
+			uint64_t last_throughput_in = 0;
+			uint64_t last_throughput_out = 0;
+			std::chrono::system_clock::time_point last_recv_time;
+			std::chrono::system_clock::time_point last_sent_time;
+
+			uint32_t total_connections = 0;
+			uint32_t max_total_connections = 0;
+			std::chrono::system_clock::time_point max_total_connections_time;
+
+			// Indexed by PublisherType
+			uint64_t bytes_out[static_cast<int8_t>(PublisherType::NumberOfPublishers)]{};
+			uint64_t connections[static_cast<int8_t>(PublisherType::NumberOfPublishers)]{};
+		};
+
+		struct Stream
+		{
+			uint32_t id = 0;
+			ov::String name;
+
+			// Whether the stream is an input stream (not an output stream of the transcoder)
+			bool is_input = true;
+			// Valid only if is_input is false
+			uint32_t input_stream_id = 0;
+
+			Values values;
+
+			int64_t origin_connection_time_msec = 0;
+			int64_t origin_subscribe_time_msec = 0;
+			int32_t deduplicated_encodes = 0;
+		};
+
+		struct Application
+		{
+			const Stream *FindInputStream(const ov::String &name) const;
+
+			uint32_t id = 0;
+			// Application name without the virtual host name
+			ov::String name;
+
+			Values values;
+
+			std::vector<Stream> streams;
+			// Name : Index of streams (input streams only)
+			std::unordered_map<ov::String, size_t> input_stream_index;
+		};
+
+		struct Host
+		{
+			const Application *FindApplication(const ov::String &name) const;
+
+			uint32_t id = 0;
+			ov::String name;
+
+			Values values;
+
+			std::vector<Application> applications;
+		};
+
+		struct Queue
+		{
+			uint32_t id = 0;
+			ov::String urn;
+			ov::String type_name;
+
+			size_t size = 0;
+			size_t peak = 0;
+			size_t threshold = 0;
+			int64_t waiting_time = 0;
+			size_t input_per_second = 0;
+			size_t output_per_second = 0;
+			size_t drop_count = 0;
+		};
+
+		struct SocketPool
+		{
+			ov::String name;
+			ov::String type_name;
+
+			int worker_count = 0;
+			int socket_count = 0;
+			uint64_t total_allocated_count = 0;
+		};
+
+		static std::shared_ptr<const MetricsSnapshot> Create(uint64_t version, const std::shared_ptr<ServerMetrics> &server_metrics);
+
+		const Host *FindHost(const ov::String &name) const;
+
+		// Increased every time a snapshot is taken
+		uint64_t version = 0;
+		std::chrono::system_clock::time_point created_time;
+
+		Values server;
+
+		std::vector<Host> hosts;
+		std::vector<Queue> queues;
+		std::vector<SocketPool> socket_pools;
+	};
+}  // namespace mon
@@ -10,6 +10,9 @@ namespace mon
 {
 	void Monitoring::Release()
 	{
+		_timer.Stop();
+		std::atomic_store(&_metrics_snapshot, std::shared_ptr<const MetricsSnapshot>());
+
 		OV_SAFE_RESET(_server_metric, nullptr, _server_metric->Release(), _server_metric);
 		_forwarder.Stop();
 		_alert.Stop();
@@ -20,6 +23,17 @@ namespace mon
 		return _server_metric;
 	}
 
+	std::shared_ptr<const MetricsSnapshot> Monitoring::GetMetricsSnapshot() const
+	{
+		return std::atomic_load(&_metrics_snapshot);
+	}
+
+	void Monitoring::UpdateMetricsSnapshot()
+	{
+		// Only called from _timer (and once before _timer starts), so the version doesn't need to be synchronized
+		std::atomic_store(&_metrics_snapshot, MetricsSnapshot::Create(++_metrics_snapshot_version, _server_metric));
+	}
+
 	std::map<uint32_t, std::shared_ptr<HostMetrics>> Monitoring::GetHostMetricsList()
 	{
 		return _server_metric->GetHostMetricsList();
@@ -76,6 +90,15 @@ namespace mon
 			server_config->GetName().CStr(), server_config->GetID().CStr(),
 			ov::Converter::ToISO8601String(_server_metric->GetServerStartedTime()).CStr());
 
+		UpdateMetricsSnapshot();
+
+		_timer.Push(
+			[this](void *parameter) -> ov::DelayQueueAction {
+				UpdateMetricsSnapshot();
+				return ov::DelayQueueAction::Repeat;
+			},
+			MONITORING_SNAPSHOT_INTERVAL_MS);
+
 		if(IsAnalyticsOn())
 		{
 			auto event = Event(EventType::ServerStarted, _server_metric);
@@ -90,10 +113,10 @@ namespace mon
 				},
 				5000);
 
-			_timer.Start();
-
 			_forwarder.Start(server_config);
 		}
+
+		_timer.Start();
 	}
 
 	bool Monitoring::OnHostCreated(const info::Host &host_info)
@@ -7,6 +7,7 @@
 #include "base/ovlibrary/delay_queue.h"
 #include "base/info/info.h"
 #include "server_metrics.h"
+#include "metrics_snapshot.h"
 #include "event_logger.h"
 #include "event_forwarder.h"
 #include "./alert/alert.h"
@@ -42,6 +43,9 @@ namespace mon
         std::shared_ptr<ApplicationMetrics> GetApplicationMetrics(const info::Application &app_info);
         std::shared_ptr<StreamMetrics>  GetStreamMetrics(const info::Stream &stream_info);
 
+		// Returns the latest snapshot of the metrics (taken every MONITORING_SNAPSHOT_INTERVAL_MS)
+		std::shared_ptr<const MetricsSnapshot> GetMetricsSnapshot() const;
+
 		// Events
 		void OnServerStarted(const std::shared_ptr<const cfg::Server> &server_config);
 		bool OnHostCreated(const info::Host &host_info);
@@ -59,8 +63,13 @@ namespace mon
 		void OnSessionsDisconnected(const info::Stream &stream_info, PublisherType type, uint64_t number_of_sessions);
 
 	private:
+		void UpdateMetricsSnapshot();
+
 		ov::DelayQueue _timer{"MonLogTimer"};
 		std::shared_ptr<ServerMetrics> _server_metric = nullptr;
+		// Accessed with std::atomic_load()/std::atomic_store()
+		std::shared_ptr<const MetricsSnapshot> _metrics_snapshot = nullptr;
+		uint64_t _metrics_snapshot_version = 0;
 		EventLogger	_logger;
 		EventForwarder _forwarder;
 		alrt::Alert _alert;
@@ -50,6 +50,10 @@ namespace mon
 	{
 		return _subscribe_time_from_origin_msec.load();
 	}
+	int32_t StreamMetrics::GetDeduplicatedEncodes() const
+	{
+		return _deduplicated_encodes.load();
+	}
 
 	// Setter
 	void StreamMetrics::SetOriginConnectionTimeMSec(int64_t value)
@@ -62,6 +66,11 @@ namespace mon
 		_subscribe_time_from_origin_msec = value;
 		UpdateDate();
 	}
+	void StreamMetrics::SetDeduplicatedEncodes(int32_t value)
+	{
+		_deduplicated_encodes = value;
+		UpdateDate();
+	}
 
 	void StreamMetrics::IncreaseBytesIn(uint64_t value)
 	{
@@ -47,6 +47,10 @@ namespace mon
 		void SetOriginConnectionTimeMSec(int64_t value);
 		void SetOriginSubscribeTimeMSec(int64_t value);
 
+		// Number of output tracks that share an encoder with another output track of the same encoding settings
+		int32_t GetDeduplicatedEncodes() const;
+		void SetDeduplicatedEncodes(int32_t value);
+
 		// Overriding from CommonMetrics 
 		void IncreaseBytesIn(uint64_t value) override;
 		void IncreaseBytesOut(PublisherType type, uint64_t value) override;
@@ -58,6 +62,9 @@ namespace mon
 		std::atomic<int64_t> _connection_time_to_origin_msec = 0;
 		std::atomic<int64_t> _subscribe_time_from_origin_msec = 0;
 
+		// From Transcoder
+		std::atomic<int32_t> _deduplicated_encodes = 0;
+
 		// If this stream is from Provider(input stream) it has multiple output streams
 		std::vector<std::shared_ptr<StreamMetrics>> _output_stream_metrics;
 
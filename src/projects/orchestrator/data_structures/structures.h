@@ -167,6 +167,10 @@ namespace ocst
 		bool is_origin_map_store_enabled = false;
 		ov::String origin_base_url;
 		std::shared_ptr<OriginMapClient> origin_map_client = nullptr;
+		// OriginMapStore/RelayTree
+		bool is_relay_tree_enabled = false;
+		uint32_t relay_tree_max_depth = 0;
+		uint32_t relay_tree_max_fan_out = 0;
 
 		// Default CORS manager
 		http::CorsManager default_cors_manager;
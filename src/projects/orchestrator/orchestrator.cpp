@@ -972,7 +972,7 @@ namespace ocst
 		return client->GetOrigin(app_stream_name, temp_str);
 	}
 
-	std::shared_ptr<ov::Url> Orchestrator::GetOriginUrlFromOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name) const
+	std::shared_ptr<ov::Url> Orchestrator::GetOriginUrlFromOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, uint32_t *depth) const
 	{
 		//lock
 		auto scoped_lock = std::scoped_lock(_virtual_host_map_mutex);
@@ -1000,8 +1000,18 @@ namespace ocst
 		auto app_stream_name = ov::String::FormatString("%s/%s", vhost_app_name.GetAppName().CStr(), stream_name.CStr());
 
 		ov::String url_str;
-		if (client->GetOrigin(app_stream_name, url_str) == CommonErrorCode::SUCCESS)
+		uint32_t node_depth = 0;
+		auto result = (vhost->is_relay_tree_enabled)
+						  ? client->GetRelayOrigin(app_stream_name, vhost->relay_tree_max_depth, vhost->relay_tree_max_fan_out, url_str, node_depth)
+						  : client->GetOrigin(app_stream_name, url_str);
+
+		if (result == CommonErrorCode::SUCCESS)
 		{
+			if (depth != nullptr)
+			{
+				*depth = node_depth;
+			}
+
 			return ov::Url::Parse(url_str);
 		}
 
@@ -1037,6 +1047,12 @@ namespace ocst
 		auto ovt_url = ov::String::FormatString("%s/%s", vhost->origin_base_url.CStr(), app_stream_name.CStr());
 		if (client->Register(app_stream_name, ovt_url) == true)
 		{
+			if (vhost->is_relay_tree_enabled)
+			{
+				// The origin is the root of the relay tree
+				client->RegisterRelay(app_stream_name, ovt_url, 0);
+			}
+
 			return CommonErrorCode::SUCCESS;
 		}
 
@@ -1070,6 +1086,8 @@ namespace ocst
 
 		auto app_stream_name = ov::String::FormatString("%s/%s", vhost_app_name.GetAppName().CStr(), stream_name.CStr());
 
+		client->UnregisterRelay(app_stream_name);
+
 		if (client->Unregister(app_stream_name) == true)
 		{
 			return CommonErrorCode::SUCCESS;
@@ -1078,6 +1096,113 @@ namespace ocst
 		return CommonErrorCode::ERROR;
 	}
 
+	CommonErrorCode Orchestrator::RegisterRelayToOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, uint32_t depth)
+	{
+		//lock
+		auto scoped_lock = std::scoped_lock(_virtual_host_map_mutex);
+
+		auto vhost = GetVirtualHost(vhost_app_name);
+		if (vhost == nullptr)
+		{
+			// Error
+			return CommonErrorCode::ERROR;
+		}
+
+		if ((vhost->is_origin_map_store_enabled == false) || (vhost->is_relay_tree_enabled == false) || vhost->origin_base_url.IsEmpty())
+		{
+			// disabled by user, or this server cannot be reached by OVT
+			return CommonErrorCode::DISABLED;
+		}
+
+		if (depth >= vhost->relay_tree_max_depth)
+		{
+			// Edges of the deepest level do not relay
+			return CommonErrorCode::DISABLED;
+		}
+
+		auto client = vhost->origin_map_client;
+		if (client == nullptr)
+		{
+			// Error
+			return CommonErrorCode::ERROR;
+		}
+
+		auto app_stream_name = ov::String::FormatString("%s/%s", vhost_app_name.GetAppName().CStr(), stream_name.CStr());
+		auto ovt_url = ov::String::FormatString("%s/%s", vhost->origin_base_url.CStr(), app_stream_name.CStr());
+		if (client->RegisterRelay(app_stream_name, ovt_url, depth) == true)
+		{
+			return CommonErrorCode::SUCCESS;
+		}
+
+		return CommonErrorCode::ERROR;
+	}
+
+	CommonErrorCode Orchestrator::UnregisterRelayFromOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name)
+	{
+		//lock
+		auto scoped_lock = std::scoped_lock(_virtual_host_map_mutex);
+
+		auto vhost = GetVirtualHost(vhost_app_name);
+		if (vhost == nullptr)
+		{
+			// Error
+			return CommonErrorCode::ERROR;
+		}
+
+		if ((vhost->is_origin_map_store_enabled == false) || (vhost->is_relay_tree_enabled == false))
+		{
+			// disabled by user
+			return CommonErrorCode::DISABLED;
+		}
+
+		auto client = vhost->origin_map_client;
+		if (client == nullptr)
+		{
+			// Error
+			return CommonErrorCode::ERROR;
+		}
+
+		auto app_stream_name = ov::String::FormatString("%s/%s", vhost_app_name.GetAppName().CStr(), stream_name.CStr());
+
+		if (client->UnregisterRelay(app_stream_name) == true)
+		{
+			return CommonErrorCode::SUCCESS;
+		}
+
+		return CommonErrorCode::ERROR;
+	}
+
+	CommonErrorCode Orchestrator::UpdateFanOutToOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, uint32_t fan_out)
+	{
+		//lock
+		auto scoped_lock = std::scoped_lock(_virtual_host_map_mutex);
+
+		auto vhost = GetVirtualHost(vhost_app_name);
+		if (vhost == nullptr)
+		{
+			// Error
+			return CommonErrorCode::ERROR;
+		}
+
+		if ((vhost->is_origin_map_store_enabled == false) || (vhost->is_relay_tree_enabled == false))
+		{
+			// disabled by user
+			return CommonErrorCode::DISABLED;
+		}
+
+		auto client = vhost->origin_map_client;
+		if (client == nullptr)
+		{
+			// Error
+			return CommonErrorCode::ERROR;
+		}
+
+		auto app_stream_name = ov::String::FormatString("%s/%s", vhost_app_name.GetAppName().CStr(), stream_name.CStr());
+		client->UpdateFanOut(app_stream_name, fan_out);
+
+		return CommonErrorCode::SUCCESS;
+	}
+
 	// This feature is set in Application.PersistentStream. Creates a persistent and non-terminating stream based on the input stream.
 	// If the input stream is terminated, it is played as a fallback stream.
 	// - Create a persistent stream only for the input stream.
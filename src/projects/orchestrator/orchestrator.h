@@ -177,10 +177,20 @@ namespace ocst
 		// key : <app/stream>
 		// value : ovt://host:port/<app/stream>
 		CommonErrorCode IsExistStreamInOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name) const;
-		std::shared_ptr<ov::Url> GetOriginUrlFromOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name) const;
+		// If RelayTree is enabled, the url of the shallowest/least loaded relay node can be returned instead of the origin.
+		// depth : depth of the returned node (origin is 0)
+		std::shared_ptr<ov::Url> GetOriginUrlFromOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, uint32_t *depth = nullptr) const;
 		CommonErrorCode RegisterStreamToOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name);
 		CommonErrorCode UnregisterStreamFromOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name);
 
+		// RelayTree
+		// key : <app/stream>@relays, <app/stream>@fanout
+		// A stream pulled from OriginMapStore is registered as a relay node of (depth of its source + 1)
+		CommonErrorCode RegisterRelayToOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, uint32_t depth);
+		CommonErrorCode UnregisterRelayFromOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name);
+		// fan_out : The number of OVT sessions of the stream
+		CommonErrorCode UpdateFanOutToOriginMapStore(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, uint32_t fan_out);
+
 		// Persistent Stream
 		CommonErrorCode CreatePersistentStreamIfNeed(const info::Application &app_info, const std::shared_ptr<info::Stream> &stream_info);
 		
@@ -460,6 +460,20 @@ namespace ocst
 			{
 				logti("OriginMapStore::OriginHostName is not specified. This OriginMapStore can work only as a edge.");
 			}
+
+			bool relay_tree_enabled = false;
+			auto &relay_tree = store.GetRelayTree(&relay_tree_enabled);
+			if (relay_tree_enabled == true)
+			{
+				vhost->is_relay_tree_enabled = true;
+				vhost->relay_tree_max_depth = std::max(relay_tree.GetMaxDepth(), 1);
+				vhost->relay_tree_max_fan_out = std::max(relay_tree.GetMaxFanOut(), 0);
+
+				if (vhost->origin_base_url.IsEmpty())
+				{
+					logti("OriginMapStore::RelayTree is enabled without OriginHostName. This server pulls from relay nodes, but does not work as a relay node.");
+				}
+			}
 		}
 
 		bool is_cors_parsed;
@@ -144,7 +144,8 @@ namespace pvd
 							break;
 					}
 
-					auto data = std::make_shared<ov::Data>(es->Payload(), es->PayloadLength());
+					// The payload is handed over without copying
+					auto data = es->GetPayloadData();
 					auto media_packet = std::make_shared<MediaPacket>(GetMsid(),
 																	  cmn::MediaType::Video,
 																	  es->PID(),
@@ -157,10 +158,7 @@ namespace pvd
 				}
 				else if (es->IsAudioStream())
 				{
-					auto payload = es->Payload();
-					auto payload_length = es->PayloadLength();
-				
-					auto data = std::make_shared<ov::Data>(payload, payload_length);
+					auto data = es->GetPayloadData();
 					auto media_packet = std::make_shared<MediaPacket>(GetMsid(),
 																	  cmn::MediaType::Audio,
 																	  es->PID(),
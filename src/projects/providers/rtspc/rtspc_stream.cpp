@@ -989,11 +989,12 @@ namespace pvd
 			return;
 		}
 
+		// The payloads refer to the memory of the RTP packets, the depacketizer assembles them into a single buffer
 		std::vector<std::shared_ptr<ov::Data>> payload_list;
+		payload_list.reserve(rtp_packets.size());
 		for (const auto &packet : rtp_packets)
 		{
-			auto payload = std::make_shared<ov::Data>(packet->Payload(), packet->PayloadSize());
-			payload_list.push_back(payload);
+			payload_list.push_back(std::make_shared<ov::Data>(packet->Payload(), packet->PayloadSize(), true));
 		}
 
 		auto bitstream = depacketizer->ParseAndAssembleFrame(payload_list);
@@ -219,6 +219,12 @@ namespace pvd
 				AddTrack(video_track);
 				_rtp_rtcp->AddRtpReceiver(ssrc, video_track);
 
+				if (first_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::Nack) == true)
+				{
+					// Request retransmission of lost video packets
+					_rtp_rtcp->EnableNack();
+				}
+
 				if (_rtp_rtcp->IsTransportCcFeedbackEnabled() == false && first_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::TransportCc) == true)
 				{
 					// a=extmap:id http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
@@ -360,12 +366,13 @@ namespace pvd
 			return;
 		}
 
+		// The payloads refer to the memory of the RTP packets, the depacketizer assembles them into a single buffer
 		std::vector<std::shared_ptr<ov::Data>> payload_list;
+		payload_list.reserve(rtp_packets.size());
 		for (const auto &packet : rtp_packets)
 		{
 			logtp("%s", packet->Dump().CStr());
-			auto payload = std::make_shared<ov::Data>(packet->Payload(), packet->PayloadSize());
-			payload_list.push_back(payload);
+			payload_list.push_back(std::make_shared<ov::Data>(packet->Payload(), packet->PayloadSize(), true));
 		}
 
 		auto bitstream = depacketizer->ParseAndAssembleFrame(payload_list);
@@ -14,6 +14,13 @@
 class LLHlsHttpInterceptor : public http::svr::DefaultInterceptor
 {
 protected:
+	std::vector<http::svr::RequestPattern> GetRequestPatterns() const override
+	{
+		return {
+			{http::Method::Get | http::Method::Options, "", ".m3u8"},
+			{http::Method::Get | http::Method::Options, "", "llhls.m4s"}};
+	}
+
 	bool IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &exchange) override
 	{
 		auto request = exchange->GetRequest();
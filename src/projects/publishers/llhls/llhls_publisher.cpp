@@ -289,11 +289,6 @@ std::shared_ptr<LLHlsHttpInterceptor> LLHlsPublisher::CreateInterceptor()
 
 		logtd("LLHLS requested(connection : %u): %s", connection->GetId(), request->GetUri().CStr());
 
-		auto vhost_app_name = ocst::Orchestrator::GetInstance()->ResolveApplicationNameFromDomain(final_url->Host(), final_url->App());
-
-		auto host_name = final_url->Host();
-		auto stream_name = final_url->Stream();
-
 		uint64_t session_life_time = 0;
 		bool access_control_enabled = IsAccessControlEnabled(final_url);
 
@@ -321,196 +316,41 @@ std::shared_ptr<LLHlsHttpInterceptor> LLHlsPublisher::CreateInterceptor()
 			// Admission Webhooks
 			auto request_info = std::make_shared<AccessController::RequestInfo>(final_url, remote_address, request->GetHeader("USER-AGENT"));
 
-			auto [webhooks_result, admission_webhooks] = VerifyByAdmissionWebhooks(request_info);
-			if (webhooks_result == AccessController::VerificationResult::Off)
-			{
-				// Success
-			}
-			else if (webhooks_result == AccessController::VerificationResult::Pass)
-			{
-				// Lifetime
-				if (admission_webhooks->GetLifetime() != 0)
-				{
-					// Choice smaller value
-					auto stream_expired_msec_from_webhooks = ov::Clock::NowMSec() + admission_webhooks->GetLifetime();
-					if (session_life_time == 0 || stream_expired_msec_from_webhooks < session_life_time)
-					{
-						session_life_time = stream_expired_msec_from_webhooks;
-					}
-				}
-
-				// Redirect URL
-				if (admission_webhooks->GetNewURL() != nullptr)
-				{
-					final_url = admission_webhooks->GetNewURL();
-					if (final_url->Port() == 0)
-					{
-						final_url->SetPort(request->GetRemote()->GetLocalAddress()->Port());
-					}
-
-					vhost_app_name = ocst::Orchestrator::GetInstance()->ResolveApplicationNameFromDomain(final_url->Host(), final_url->App());
-					host_name = final_url->Host();
-					stream_name = final_url->Stream();
-				}
-			}
-			else if (webhooks_result == AccessController::VerificationResult::Error)
-			{
-				logtw("AdmissionWebhooks error : %s", final_url->ToUrlString().CStr());
-				response->SetStatusCode(http::StatusCode::Unauthorized);
-				return http::svr::NextHandler::DoNotCall;
-			}
-			else if (webhooks_result == AccessController::VerificationResult::Fail)
-			{
-				logtw("AdmissionWebhooks error : %s", admission_webhooks->GetErrReason().CStr());
-				response->SetStatusCode(http::StatusCode::Unauthorized);
-				return http::svr::NextHandler::DoNotCall;
-			}
-		}
-
-		if (vhost_app_name.IsValid() == false)
-		{
-			logte("Could not resolve application name from domain: %s", final_url->Host().CStr());
-			response->SetStatusCode(http::StatusCode::NotFound);
-			return http::svr::NextHandler::DoNotCall;
-		}
-
-		auto stream = std::static_pointer_cast<LLHlsStream>(GetStream(vhost_app_name, stream_name));
-		if (stream == nullptr)
-		{
-			stream = std::dynamic_pointer_cast<LLHlsStream>(PullStream(final_url, vhost_app_name, host_name, stream_name));
-			if (stream != nullptr)
-			{
-				logti("URL %s is requested", stream->GetMediaSource().CStr());
-			}
-			else
-			{
-				logte("Cannot find stream (%s/%s)", vhost_app_name.CStr(), stream_name.CStr());
-				response->SetStatusCode(http::StatusCode::NotFound);
-				return http::svr::NextHandler::DoNotCall;
-			}
-		}
+			// The control server is queried without blocking the socket worker thread.
+			// If the verdict is ready before VerifyByAdmissionWebhooksAsync() returns (e.g. it is cached), the request is handled here,
+			// otherwise the response is sent in the completion handler.
+			auto deferred_request = std::make_shared<DeferredRequest>();
 
-		if (stream->WaitUntilStart(10000) == false)
-		{
-			logtw("(%s/%s) stream has not started.", vhost_app_name.CStr(), stream_name.CStr());
-			response->SetStatusCode(http::StatusCode::NotFound);
-			return http::svr::NextHandler::DoNotCall;
-		}
+			VerifyByAdmissionWebhooksAsync(request_info, [this, exchange, requested_url, session_life_time, deferred_request](AccessController::VerificationResult webhooks_result, const std::shared_ptr<const AdmissionWebhooks> &admission_webhooks) {
+				auto next_handler = OnAdmissionWebhooksVerified(exchange, requested_url, session_life_time, webhooks_result, admission_webhooks);
 
-		auto application = std::static_pointer_cast<LLHlsApplication>(stream->GetApplication());
-		if (application == nullptr)
-		{
-			logte("Cannot find application (%s)", vhost_app_name.CStr());
-			response->SetStatusCode(http::StatusCode::NotFound);
-			return http::svr::NextHandler::DoNotCall;
-		}
-		auto origin_mode = application->IsOriginMode();
-
-		std::shared_ptr<LLHlsSession> session = nullptr;
+				std::lock_guard<std::mutex> lock(deferred_request->mutex);
 
-		// Master playlist (.m3u8 and NOT *chunklist*.m3u8)
-		if (final_url->File().IndexOf(".m3u8") > 0 && final_url->File().IndexOf("chunklist") == -1)
-		{
-			session_id_t session_id = connection->GetId();
-
-			try
-			{
-				// If this connection has been used by another session in the past, it is reused.
-				session = std::any_cast<std::shared_ptr<LLHlsSession>>(connection->GetUserData(stream->GetUri()));
-			}
-			catch (const std::bad_any_cast &e)
-			{
-				session = std::static_pointer_cast<LLHlsSession>(stream->GetSession(session_id));
-			}
-
-			if (session == nullptr || session->GetStream() != stream)
-			{
-				// New HTTP Connection
-				session = LLHlsSession::Create(session_id, origin_mode, "", stream->GetApplication(), stream, request->GetHeader("USER-AGENT"), session_life_time);
-				if (session == nullptr)
+				if (deferred_request->returned == false)
 				{
-					logte("Could not create llhls session for request: %s", request->ToString().CStr());
-					response->SetStatusCode(http::StatusCode::InternalServerError);
-					return http::svr::NextHandler::DoNotCall;
+					deferred_request->completed = true;
+					deferred_request->next_handler = next_handler;
+					return;
 				}
-				session->SetRequestedUrl(requested_url);
-				session->SetFinalUrl(final_url);
 
-				stream->AddSession(session);
-			}
-		}
-		// chunklist_x_x.m3u8?session=<session id>_<key>
-		// x_x_x.m4s?session=<session id>_<key>
-		else
-		{
-			session_id_t session_id = connection->GetId();
-			ov::String session_key;
-
-			if (origin_mode == false)
-			{
-				// ?session=<session id>_<key>
-				// This collects them into one session even if one player connects through multiple connections.
-				auto query_string = final_url->GetQueryValue("session");
-				auto id_key = query_string.Split("_");
-				if (id_key.size() != 2)
+				if (next_handler == http::svr::NextHandler::DoNotCall)
 				{
-					logte("Invalid session key : %s", final_url->ToUrlString().CStr());
-					response->SetStatusCode(http::StatusCode::Unauthorized);
-					return http::svr::NextHandler::DoNotCall;
+					exchange->GetResponse()->Response();
+					exchange->Release();
 				}
+			});
 
-				session_id = ov::Converter::ToUInt32(id_key[0].CStr());
-				session_key = id_key[1];
-			}
+			std::lock_guard<std::mutex> lock(deferred_request->mutex);
+			deferred_request->returned = true;
 
-			session = std::static_pointer_cast<LLHlsSession>(stream->GetSession(session_id));
-			if (session == nullptr)
-			{
-				if (access_control_enabled == true)
-				{
-					logte("Invalid session_key : %s", final_url->ToUrlString().CStr());
-					response->SetStatusCode(http::StatusCode::Unauthorized);
-					return http::svr::NextHandler::DoNotCall;
-				}
-				else
-				{
-					// New HTTP Connection
-					session = LLHlsSession::Create(session_id, origin_mode, session_key, stream->GetApplication(), stream, session_life_time);
-					if (session == nullptr)
-					{
-						logte("Could not create llhls session for request: %s", request->ToString().CStr());
-						response->SetStatusCode(http::StatusCode::InternalServerError);
-						return http::svr::NextHandler::DoNotCall;
-					}
-					session->SetRequestedUrl(requested_url);
-					session->SetFinalUrl(final_url);
-
-					stream->AddSession(session);
-				}
-			}
-			else
-			{
-				if (access_control_enabled == true && session_key != session->GetSessionKey())
-				{
-					logte("Invalid session_key : %s", final_url->ToUrlString().CStr());
-					response->SetStatusCode(http::StatusCode::Unauthorized);
-					return http::svr::NextHandler::DoNotCall;
-				}
-			}
+			return deferred_request->completed ? deferred_request->next_handler : http::svr::NextHandler::DoNotCallAndDoNotResponse;
 		}
 
-		// It will be used in CloseHandler
-		connection->AddUserData(stream->GetUri(), session);
-		session->UpdateLastRequest(connection->GetId());
-
-		// Cors Setting
-		application->GetCorsManager().SetupHttpCorsHeader(vhost_app_name, request, response);
-		stream->SendMessage(session, std::make_any<std::shared_ptr<http::svr::HttpExchange>>(exchange));
-
-		return http::svr::NextHandler::DoNotCallAndDoNotResponse;
+		return HandleStreamRequest(exchange, requested_url, final_url, session_life_time, access_control_enabled);
 	});
 
 	// Set Close Handler
+
 	http_interceptor->SetCloseHandler([this](const std::shared_ptr<http::svr::HttpConnection> &connection, PhysicalPortDisconnectReason reason) -> void {
 		for (auto &user_data : connection->GetUserDataMap())
 		{
@@ -555,4 +395,210 @@ std::shared_ptr<LLHlsHttpInterceptor> LLHlsPublisher::CreateInterceptor()
 	});
 
 	return http_interceptor;
-}
\ No newline at end of file
+}
+
+http::svr::NextHandler LLHlsPublisher::OnAdmissionWebhooksVerified(const std::shared_ptr<http::svr::HttpExchange> &exchange, const std::shared_ptr<ov::Url> &requested_url, uint64_t session_life_time,
+																	AccessController::VerificationResult webhooks_result, const std::shared_ptr<const AdmissionWebhooks> &admission_webhooks)
+{
+	auto request = exchange->GetRequest();
+	auto response = exchange->GetResponse();
+
+	auto final_url = requested_url;
+
+	if (webhooks_result == AccessController::VerificationResult::Off)
+	{
+		// Success
+	}
+	else if (webhooks_result == AccessController::VerificationResult::Pass)
+	{
+		// Lifetime
+		if (admission_webhooks->GetLifetime() != 0)
+		{
+			// Choice smaller value
+			auto stream_expired_msec_from_webhooks = ov::Clock::NowMSec() + admission_webhooks->GetLifetime();
+			if (session_life_time == 0 || stream_expired_msec_from_webhooks < session_life_time)
+			{
+				session_life_time = stream_expired_msec_from_webhooks;
+			}
+		}
+
+		// Redirect URL
+		if (admission_webhooks->GetNewURL() != nullptr)
+		{
+			// The verdict can be shared by the cached/coalesced queries, so it is copied before it is modified
+			final_url = ov::Url::Parse(admission_webhooks->GetNewURL()->ToUrlString(true));
+			if (final_url->Port() == 0)
+			{
+				final_url->SetPort(request->GetRemote()->GetLocalAddress()->Port());
+			}
+		}
+	}
+	else if (webhooks_result == AccessController::VerificationResult::Error)
+	{
+		logtw("AdmissionWebhooks error : %s", final_url->ToUrlString().CStr());
+		response->SetStatusCode(http::StatusCode::Unauthorized);
+		return http::svr::NextHandler::DoNotCall;
+	}
+	else if (webhooks_result == AccessController::VerificationResult::Fail)
+	{
+		logtw("AdmissionWebhooks error : %s", admission_webhooks->GetErrReason().CStr());
+		response->SetStatusCode(http::StatusCode::Unauthorized);
+		return http::svr::NextHandler::DoNotCall;
+	}
+
+	return HandleStreamRequest(exchange, requested_url, final_url, session_life_time, true);
+}
+
+http::svr::NextHandler LLHlsPublisher::HandleStreamRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const std::shared_ptr<ov::Url> &requested_url, const std::shared_ptr<ov::Url> &final_url,
+														   uint64_t session_life_time, bool access_control_enabled)
+{
+	auto connection = exchange->GetConnection();
+	auto request = exchange->GetRequest();
+	auto response = exchange->GetResponse();
+
+	auto vhost_app_name = ocst::Orchestrator::GetInstance()->ResolveApplicationNameFromDomain(final_url->Host(), final_url->App());
+	auto host_name = final_url->Host();
+	auto stream_name = final_url->Stream();
+
+	if (vhost_app_name.IsValid() == false)
+	{
+		logte("Could not resolve application name from domain: %s", final_url->Host().CStr());
+		response->SetStatusCode(http::StatusCode::NotFound);
+		return http::svr::NextHandler::DoNotCall;
+	}
+
+	auto stream = std::static_pointer_cast<LLHlsStream>(GetStream(vhost_app_name, stream_name));
+	if (stream == nullptr)
+	{
+		stream = std::dynamic_pointer_cast<LLHlsStream>(PullStream(final_url, vhost_app_name, host_name, stream_name));
+		if (stream != nullptr)
+		{
+			logti("URL %s is requested", stream->GetMediaSource().CStr());
+		}
+		else
+		{
+			logte("Cannot find stream (%s/%s)", vhost_app_name.CStr(), stream_name.CStr());
+			response->SetStatusCode(http::StatusCode::NotFound);
+			return http::svr::NextHandler::DoNotCall;
+		}
+	}
+
+	if (stream->WaitUntilStart(10000) == false)
+	{
+		logtw("(%s/%s) stream has not started.", vhost_app_name.CStr(), stream_name.CStr());
+		response->SetStatusCode(http::StatusCode::NotFound);
+		return http::svr::NextHandler::DoNotCall;
+	}
+
+	auto application = std::static_pointer_cast<LLHlsApplication>(stream->GetApplication());
+	if (application == nullptr)
+	{
+		logte("Cannot find application (%s)", vhost_app_name.CStr());
+		response->SetStatusCode(http::StatusCode::NotFound);
+		return http::svr::NextHandler::DoNotCall;
+	}
+	auto origin_mode = application->IsOriginMode();
+
+	std::shared_ptr<LLHlsSession> session = nullptr;
+
+	// Master playlist (.m3u8 and NOT *chunklist*.m3u8)
+	if (final_url->File().IndexOf(".m3u8") > 0 && final_url->File().IndexOf("chunklist") == -1)
+	{
+		session_id_t session_id = connection->GetId();
+
+		try
+		{
+			// If this connection has been used by another session in the past, it is reused.
+			session = std::any_cast<std::shared_ptr<LLHlsSession>>(connection->GetUserData(stream->GetUri()));
+		}
+		catch (const std::bad_any_cast &e)
+		{
+			session = std::static_pointer_cast<LLHlsSession>(stream->GetSession(session_id));
+		}
+
+		if (session == nullptr || session->GetStream() != stream)
+		{
+			// New HTTP Connection
+			session = LLHlsSession::Create(session_id, origin_mode, "", stream->GetApplication(), stream, request->GetHeader("USER-AGENT"), session_life_time);
+			if (session == nullptr)
+			{
+				logte("Could not create llhls session for request: %s", request->ToString().CStr());
+				response->SetStatusCode(http::StatusCode::InternalServerError);
+				return http::svr::NextHandler::DoNotCall;
+			}
+			session->SetRequestedUrl(requested_url);
+			session->SetFinalUrl(final_url);
+
+			stream->AddSession(session);
+		}
+	}
+	// chunklist_x_x.m3u8?session=<session id>_<key>
+	// x_x_x.m4s?session=<session id>_<key>
+	else
+	{
+		session_id_t session_id = connection->GetId();
+		ov::String session_key;
+
+		if (origin_mode == false)
+		{
+			// ?session=<session id>_<key>
+			// This collects them into one session even if one player connects through multiple connections.
+			auto query_string = final_url->GetQueryValue("session");
+			auto id_key = query_string.Split("_");
+			if (id_key.size() != 2)
+			{
+				logte("Invalid session key : %s", final_url->ToUrlString().CStr());
+				response->SetStatusCode(http::StatusCode::Unauthorized);
+				return http::svr::NextHandler::DoNotCall;
+			}
+
+			session_id = ov::Converter::ToUInt32(id_key[0].CStr());
+			session_key = id_key[1];
+		}
+
+		session = std::static_pointer_cast<LLHlsSession>(stream->GetSession(session_id));
+		if (session == nullptr)
+		{
+			if (access_control_enabled == true)
+			{
+				logte("Invalid session_key : %s", final_url->ToUrlString().CStr());
+				response->SetStatusCode(http::StatusCode::Unauthorized);
+				return http::svr::NextHandler::DoNotCall;
+			}
+			else
+			{
+				// New HTTP Connection
+				session = LLHlsSession::Create(session_id, origin_mode, session_key, stream->GetApplication(), stream, session_life_time);
+				if (session == nullptr)
+				{
+					logte("Could not create llhls session for request: %s", request->ToString().CStr());
+					response->SetStatusCode(http::StatusCode::InternalServerError);
+					return http::svr::NextHandler::DoNotCall;
+				}
+				session->SetRequestedUrl(requested_url);
+				session->SetFinalUrl(final_url);
+
+				stream->AddSession(session);
+			}
+		}
+		else
+		{
+			if (access_control_enabled == true && session_key != session->GetSessionKey())
+			{
+				logte("Invalid session_key : %s", final_url->ToUrlString().CStr());
+				response->SetStatusCode(http::StatusCode::Unauthorized);
+				return http::svr::NextHandler::DoNotCall;
+			}
+		}
+	}
+
+	// It will be used in CloseHandler
+	connection->AddUserData(stream->GetUri(), session);
+	session->UpdateLastRequest(connection->GetId());
+
+	// Cors Setting
+	application->GetCorsManager().SetupHttpCorsHeader(vhost_app_name, request, response);
+	stream->SendMessage(session, std::make_any<std::shared_ptr<http::svr::HttpExchange>>(exchange));
+
+	return http::svr::NextHandler::DoNotCallAndDoNotResponse;
+}
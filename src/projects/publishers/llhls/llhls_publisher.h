@@ -53,6 +53,22 @@ private:
 	bool OnDeletePublisherApplication(const std::shared_ptr<pub::Application> &application) override;
 	std::shared_ptr<LLHlsHttpInterceptor> CreateInterceptor();
 
+	// The state of the request that is handled after the admission webhooks query is completed
+	struct DeferredRequest
+	{
+		std::mutex mutex;
+		// Whether the HTTP handler has returned
+		bool returned = false;
+		// Whether the request is handled before the HTTP handler returns
+		bool completed = false;
+		http::svr::NextHandler next_handler = http::svr::NextHandler::DoNotCallAndDoNotResponse;
+	};
+
+	http::svr::NextHandler OnAdmissionWebhooksVerified(const std::shared_ptr<http::svr::HttpExchange> &exchange, const std::shared_ptr<ov::Url> &requested_url, uint64_t session_life_time,
+													   AccessController::VerificationResult webhooks_result, const std::shared_ptr<const AdmissionWebhooks> &admission_webhooks);
+	http::svr::NextHandler HandleStreamRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const std::shared_ptr<ov::Url> &requested_url, const std::shared_ptr<ov::Url> &final_url,
+											   uint64_t session_life_time, bool access_control_enabled);
+
 	std::mutex _http_server_list_mutex;
 	std::vector<std::shared_ptr<http::svr::HttpServer>> _http_server_list;
 	std::vector<std::shared_ptr<http::svr::HttpsServer>> _https_server_list;
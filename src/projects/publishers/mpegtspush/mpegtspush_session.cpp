@@ -21,8 +21,7 @@ MpegtsPushSession::MpegtsPushSession(const info::Session &session_info,
 									 const std::shared_ptr<pub::Stream> &stream,
 									 const std::shared_ptr<info::Push> &push)
 	: pub::Session(session_info, application, stream),
-	  _push(push),
-	  _writer(nullptr)
+	  _push(push)
 {
 }
 
@@ -39,8 +38,7 @@ bool MpegtsPushSession::Start()
 
 	std::lock_guard<std::shared_mutex> lock(_mutex);
 
-	_writer = ffmpeg::Writer::Create();
-	if (_writer == nullptr)
+	if (Connect() == false)
 	{
 		SetState(SessionState::Error);
 		GetPush()->SetState(info::Push::PushState::Error);
@@ -48,15 +46,8 @@ bool MpegtsPushSession::Start()
 		return false;
 	}
 
-	if (_writer->SetUrl(GetPush()->GetUrl(), "mpegts") == false)
-	{
-		SetState(SessionState::Error);
-		GetPush()->SetState(info::Push::PushState::Error);
-
-		_writer = nullptr;
-
-		return false;
-	}
+	_packetizer = std::make_shared<mpegts::MpegTsPacketizer>(std::bind(&MpegtsPushSession::OnChunk, this, std::placeholders::_1));
+	_packetizer->SetRebaseTimestamp(true);
 
 	for (auto &[track_id, track] : GetStream()->GetTracks())
 	{
@@ -72,22 +63,13 @@ bool MpegtsPushSession::Start()
 			continue;
 		}
 
-		bool ret = _writer->AddTrack(track);
+		bool ret = _packetizer->AddTrack(track);
 		if (ret == false)
 		{
 			logtw("Failed to add new track");
 		}
 	}
 
-	if (_writer->Start() == false)
-	{
-		_writer = nullptr;
-		SetState(SessionState::Error);
-		GetPush()->SetState(info::Push::PushState::Error);
-
-		return false;
-	}
-
 	logtd("MpegtsPushSession(%d) has started.", GetId());
 
 	return Session::Start();
@@ -97,13 +79,15 @@ bool MpegtsPushSession::Stop()
 {
 	std::lock_guard<std::shared_mutex> lock(_mutex);
 
-	if (_writer != nullptr)
+	if (_packetizer != nullptr)
 	{
 		GetPush()->SetState(info::Push::PushState::Stopping);
 		GetPush()->UpdatePushStartTime();
 
-		_writer->Stop();
-		_writer = nullptr;
+		_packetizer->Flush();
+		_packetizer = nullptr;
+
+		Disconnect();
 
 		GetPush()->SetState(info::Push::PushState::Stopped);
 		GetPush()->IncreaseSequence();
@@ -135,18 +119,20 @@ void MpegtsPushSession::SendOutgoingData(const std::any &packet)
 
 	std::lock_guard<std::shared_mutex> lock(_mutex);
 
-	if (_writer == nullptr)
+	if (_packetizer == nullptr)
 	{
 		return;
 	}
 
-	bool ret = _writer->SendPacket(session_packet);
-	if (ret == false)
+	// Packets of the tracks that are not added are dropped. This is not an error.
+	_packetizer->AppendFrame(session_packet);
+
+	if (_send_failed)
 	{
 		logte("Failed to send packet");
 
-		_writer->Stop();
-		_writer = nullptr;
+		_packetizer = nullptr;
+		Disconnect();
 
 		SetState(SessionState::Error);
 		GetPush()->SetState(info::Push::PushState::Error);
@@ -158,6 +144,82 @@ void MpegtsPushSession::SendOutgoingData(const std::any &packet)
 	GetPush()->IncreasePushBytes(session_packet->GetData()->GetLength());
 }
 
+bool MpegtsPushSession::Connect()
+{
+	auto url = ov::Url::Parse(GetPush()->GetUrl());
+	if (url == nullptr)
+	{
+		logte("Invalid URL: %s", GetPush()->GetUrl().CStr());
+		return false;
+	}
+
+	auto scheme = url->Scheme().LowerCaseString();
+	if ((scheme != "udp") && (scheme != "tcp"))
+	{
+		logte("Unsupported scheme: %s", url->Scheme().CStr());
+		return false;
+	}
+
+	_is_udp = (scheme == "udp");
+	_remote_address = ov::SocketAddress::CreateAndGetFirst(url->Host(), url->Port());
+	if (_remote_address.IsValid() == false)
+	{
+		logte("Could not resolve the address: %s", GetPush()->GetUrl().CStr());
+		return false;
+	}
+
+	auto socket_pool = _is_udp ? ov::SocketPool::GetUdpPool() : ov::SocketPool::GetTcpPool();
+	_socket = socket_pool->AllocSocket(_remote_address.GetFamily());
+	if (_socket == nullptr)
+	{
+		logte("Could not create a socket for %s", GetPush()->GetUrl().CStr());
+		return false;
+	}
+
+	// Chunks are sent from the stream worker like the AVIO of libavformat did
+	_socket->MakeBlocking();
+
+	if (_is_udp == false)
+	{
+		auto error = _socket->Connect(_remote_address, 3000);
+		if (error != nullptr)
+		{
+			logte("Could not connect to %s: %s", _remote_address.ToString().CStr(), error->What());
+			Disconnect();
+			return false;
+		}
+	}
+
+	_send_failed = false;
+
+	return true;
+}
+
+void MpegtsPushSession::Disconnect()
+{
+	if (_socket != nullptr)
+	{
+		_socket->Close();
+		_socket = nullptr;
+	}
+}
+
+void MpegtsPushSession::OnChunk(const std::shared_ptr<const ov::Data> &chunk)
+{
+	if ((_socket == nullptr) || _send_failed)
+	{
+		return;
+	}
+
+	// A chunk is 7 TS packets, which is an UDP datagram
+	bool result = _is_udp ? _socket->SendTo(_remote_address, chunk) : _socket->Send(chunk);
+
+	if (result == false)
+	{
+		_send_failed = true;
+	}
+}
+
 bool MpegtsPushSession::IsSelectedTrack(const std::shared_ptr<MediaTrack> &track)
 {
 	auto selected_track_ids = GetPush()->GetTrackIds();
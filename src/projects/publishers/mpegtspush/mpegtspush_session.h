@@ -1,8 +1,9 @@
 #pragma once
 
 #include <base/info/media_track.h>
+#include <base/ovsocket/socket_pool/socket_pool.h>
 #include <base/publisher/session.h>
-#include <modules/ffmpeg/ffmpeg_writer.h>
+#include <modules/mpegts/mpegts_packetizer.h>
 
 #include "base/info/push.h"
 
@@ -31,9 +32,18 @@ public:
 private:
 	bool IsSelectedTrack(const std::shared_ptr<MediaTrack> &track);
 
+	bool Connect();
+	void Disconnect();
+	void OnChunk(const std::shared_ptr<const ov::Data> &chunk);
+
 	std::shared_ptr<info::Push> _push;
 
 	std::shared_mutex _mutex;
 
-	std::shared_ptr<ffmpeg::Writer> _writer;
+	std::shared_ptr<mpegts::MpegTsPacketizer> _packetizer;
+
+	bool _is_udp = true;
+	ov::SocketAddress _remote_address;
+	std::shared_ptr<ov::Socket> _socket;
+	bool _send_failed = false;
 };
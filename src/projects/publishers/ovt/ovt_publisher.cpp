@@ -272,6 +272,8 @@ void OvtPublisher::OnDisconnected(const std::shared_ptr<ov::Socket> &remote,
 		{
 			auto stream = it->second;
 			stream->RemoveSessionByConnectorId(remote->GetNativeHandle());
+
+			ocst::Orchestrator::GetInstance()->UpdateFanOutToOriginMapStore(stream->GetApplicationInfo().GetName(), stream->GetName(), stream->GetSessionCount());
 		}
 	}
 	UnlinkRemoteFromStream(remote->GetNativeHandle());
@@ -365,6 +367,9 @@ void OvtPublisher::HandlePlayRequest(const std::shared_ptr<ov::Socket> &remote,
 	ResponseResult(remote, session->GetId(), "play", request_id, 200, "ok");
 
 	stream->AddSession(session);
+
+	// Report the fan-out of this node to the relay tree of OriginMapStore
+	ocst::Orchestrator::GetInstance()->UpdateFanOutToOriginMapStore(vhost_app_name, stream->GetName(), stream->GetSessionCount());
 }
 
 void OvtPublisher::HandleStopRequest(const std::shared_ptr<ov::Socket> &remote, uint32_t session_id, uint32_t request_id, const std::shared_ptr<const ov::Url> &url)
@@ -384,6 +389,8 @@ void OvtPublisher::HandleStopRequest(const std::shared_ptr<ov::Socket> &remote,
 
 	// Session ID is remote socket's ID
 	stream->RemoveSession(remote->GetNativeHandle());
+
+	ocst::Orchestrator::GetInstance()->UpdateFanOutToOriginMapStore(vhost_app_name, stream->GetName(), stream->GetSessionCount());
 }
 
 void OvtPublisher::ResponseResult(const std::shared_ptr<ov::Socket> &remote, uint32_t session_id, const ov::String app, uint32_t request_id, uint32_t code, const ov::String &msg)
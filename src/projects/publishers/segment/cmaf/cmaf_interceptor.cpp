@@ -11,6 +11,14 @@
 #include "../dash/dash_define.h"
 #include "cmaf_private.h"
 
+std::vector<http::svr::RequestPattern> CmafInterceptor::GetRequestPatterns() const
+{
+	return {
+		{http::Method::Get, "", CMAF_MPD_VIDEO_FULL_SUFFIX},
+		{http::Method::Get, "", CMAF_MPD_AUDIO_FULL_SUFFIX},
+		{http::Method::Get, "", CMAF_PLAYLIST_FULL_FILE_NAME}};
+}
+
 bool CmafInterceptor::IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &client)
 {
 	if (SegmentStreamInterceptor::IsInterceptorForRequest(client) == false)
@@ -11,6 +11,14 @@
 #include "dash_define.h"
 #include "dash_private.h"
 
+std::vector<http::svr::RequestPattern> DashInterceptor::GetRequestPatterns() const
+{
+	return {
+		{http::Method::Get, "", DASH_MPD_VIDEO_FULL_SUFFIX},
+		{http::Method::Get, "", DASH_MPD_AUDIO_FULL_SUFFIX},
+		{http::Method::Get, "", DASH_PLAYLIST_FULL_FILE_NAME}};
+}
+
 bool DashInterceptor::IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &client)
 {
 	if (SegmentStreamInterceptor::IsInterceptorForRequest(client) == false)
@@ -16,5 +16,6 @@ public:
 	//--------------------------------------------------------------------
 	// Implementation of HttpRequestInterceptorInterface
 	//--------------------------------------------------------------------
+	std::vector<http::svr::RequestPattern> GetRequestPatterns() const override;
 	bool IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &client) override;
 };
@@ -19,6 +19,16 @@ HlsInterceptor::~HlsInterceptor()
 {
 }
 
+//====================================================================================================
+// GetRequestPatterns
+//====================================================================================================
+std::vector<http::svr::RequestPattern> HlsInterceptor::GetRequestPatterns() const
+{
+	return {
+		{http::Method::Get, "", ".ts"},
+		{http::Method::Get, "", "playlist.m3u8"}};
+}
+
 //====================================================================================================
 // IsInterceptorForRequest
 //====================================================================================================
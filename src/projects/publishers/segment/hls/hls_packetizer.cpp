@@ -9,7 +9,6 @@
 #include "hls_packetizer.h"
 
 #include <base/ovlibrary/ovlibrary.h>
-#include <modules/segment_writer/writer.h>
 #include <publishers/segment/segment_stream/packetizer/packetizer_define.h>
 
 #include <algorithm>
@@ -43,7 +42,12 @@ HlsPacketizer::HlsPacketizer(const ov::String &service_name, const ov::String &a
 				 video_track, audio_track,
 				 chunked_transfer),
 
-	  _ts_writer(Writer::Type::MpegTs, Writer::MediaType::Both)
+	  _ts_packetizer([this](const std::shared_ptr<const ov::Data> &chunk) {
+		  if (_ts_data != nullptr)
+		  {
+			  _ts_data->Append(chunk);
+		  }
+	  })
 {
 	_video_enable = false;
 	_audio_enable = false;
@@ -78,7 +82,7 @@ void HlsPacketizer::SetVideoTrack(const std::shared_ptr<MediaTrack> &video_track
 			}
 			else
 			{
-				if (_ts_writer.AddTrack(video_track))
+				if (_ts_packetizer.AddTrack(video_track))
 				{
 					_ideal_duration_for_video = _segment_duration * _video_timescale;
 					_ideal_duration_for_video_in_ms = static_cast<int64_t>(_segment_duration * 1000);
@@ -120,7 +124,7 @@ void HlsPacketizer::SetAudioTrack(const std::shared_ptr<MediaTrack> &audio_track
 			}
 			else
 			{
-				if (_ts_writer.AddTrack(audio_track))
+				if (_ts_packetizer.AddTrack(audio_track))
 				{
 					_ideal_duration_for_audio = _segment_duration * _audio_timescale;
 					_ideal_duration_for_audio_in_ms = static_cast<int64_t>(_segment_duration * 1000);
@@ -140,7 +144,7 @@ void HlsPacketizer::SetAudioTrack(const std::shared_ptr<MediaTrack> &audio_track
 
 HlsPacketizer::~HlsPacketizer()
 {
-	_ts_writer.Finalize();
+	FinalizeTsSegment();
 }
 
 bool HlsPacketizer::ResetPacketizer(uint32_t new_msid)
@@ -177,18 +181,18 @@ uint32_t HlsPacketizer::FlushIfNeeded()
 
 	if (need_to_flush)
 	{
-		if (_ts_writer.GetData() != nullptr)
+		if (_ts_data != nullptr)
 		{
 			auto target_track = (_video_track != nullptr) ? _video_track : _audio_track;
 
 			if (target_track != nullptr)
 			{
-				auto track_id = target_track->GetId();
+				auto &ts_state = (_video_track != nullptr) ? _video_ts_state : _audio_ts_state;
 				auto timebase_expr_ms = (_video_track != nullptr) ? _video_timebase_expr_ms : _audio_timebase_expr_ms;
 
-				// Flush TS writer
-				auto first_pts = _ts_writer.GetFirstPts(track_id);
-				auto duration = _ts_writer.GetDuration(track_id);
+				// Flush TS packetizer
+				auto first_pts = ts_state.GetFirstPts();
+				auto duration = ts_state.duration;
 
 				WriteSegment(
 					first_pts, first_pts * timebase_expr_ms,
@@ -246,20 +250,16 @@ bool HlsPacketizer::AppendVideoPacket(const std::shared_ptr<const MediaPacket> &
 		_video_key_frame_received = true;
 	}
 
-	if (_ts_writer.PrepareIfNeeded(GetServiceName()) == false)
-	{
-		logte("Could not prepare ts writer");
-		return false;
-	}
+	PrepareTsSegmentIfNeeded();
 
 	bool result = true;
 
 	if ((media_packet->GetFlag() == MediaPacketFlag::Key) && (_first_video_pts >= 0L))
 	{
-		auto first_pts = _ts_writer.GetFirstPts(media_packet->GetTrackId());
+		auto first_pts = _video_ts_state.GetFirstPts();
 		auto duration = std::max(
 			media_packet->GetPts() - first_pts,
-			_ts_writer.GetDuration(media_packet->GetTrackId()));
+			_video_ts_state.duration);
 
 		if (duration >= _ideal_duration_for_video)
 		{
@@ -269,7 +269,7 @@ bool HlsPacketizer::AppendVideoPacket(const std::shared_ptr<const MediaPacket> &
 		}
 	}
 
-	result = result && _ts_writer.WritePacket(media_packet);
+	result = result && WriteTsPacket(media_packet, _video_ts_state);
 
 	if (result)
 	{
@@ -320,20 +320,16 @@ bool HlsPacketizer::AppendAudioPacket(const std::shared_ptr<const MediaPacket> &
 		_audio_key_frame_received = true;
 	}
 
-	if (_ts_writer.PrepareIfNeeded(GetServiceName()) == false)
-	{
-		logte("Could not prepare ts writer");
-		return false;
-	}
+	PrepareTsSegmentIfNeeded();
 
 	bool result = true;
 
 	if ((media_packet->GetFlag() == MediaPacketFlag::Key) && (_first_audio_pts >= 0L))
 	{
-		auto first_pts = _ts_writer.GetFirstPts(media_packet->GetTrackId());
+		auto first_pts = _audio_ts_state.GetFirstPts();
 		auto duration = std::max(
 			media_packet->GetPts() - first_pts,
-			_ts_writer.GetDuration(media_packet->GetTrackId()));
+			_audio_ts_state.duration);
 
 		if (duration >= _ideal_duration_for_audio)
 		{
@@ -347,7 +343,7 @@ bool HlsPacketizer::AppendAudioPacket(const std::shared_ptr<const MediaPacket> &
 		}
 	}
 
-	result = result && _ts_writer.WritePacket(media_packet);
+	result = result && WriteTsPacket(media_packet, _audio_ts_state);
 
 	if (result)
 	{
@@ -360,7 +356,7 @@ bool HlsPacketizer::AppendAudioPacket(const std::shared_ptr<const MediaPacket> &
 
 bool HlsPacketizer::WriteSegment(int64_t timestamp, int64_t timestamp_in_ms, int64_t duration, int64_t duration_in_ms)
 {
-	auto data = _ts_writer.Finalize();
+	auto data = FinalizeTsSegment();
 
 	if (data == nullptr)
 	{
@@ -375,14 +371,52 @@ bool HlsPacketizer::WriteSegment(int64_t timestamp, int64_t timestamp_in_ms, int
 		duration, duration_in_ms,
 		data);
 
-	if (_ts_writer.Prepare(GetServiceName()) == false)
+	PrepareTsSegmentIfNeeded();
+
+	_video_ready = false;
+	_audio_ready = false;
+
+	return true;
+}
+
+void HlsPacketizer::PrepareTsSegmentIfNeeded()
+{
+	if (_ts_data != nullptr)
+	{
+		return;
+	}
+
+	_ts_data = std::make_shared<ov::Data>();
+	_video_ts_state = TsTrackState();
+	_audio_ts_state = TsTrackState();
+
+	// Every segment starts with PAT/PMT to be decodable by itself
+	_ts_packetizer.RequestTables();
+}
+
+std::shared_ptr<const ov::Data> HlsPacketizer::FinalizeTsSegment()
+{
+	_ts_packetizer.Flush();
+
+	auto data = std::move(_ts_data);
+	_ts_data = nullptr;
+
+	return data;
+}
+
+bool HlsPacketizer::WriteTsPacket(const std::shared_ptr<const MediaPacket> &media_packet, TsTrackState &state)
+{
+	if (_ts_packetizer.AppendFrame(media_packet) == false)
 	{
-		logae("Could not prepare ts writer");
 		return false;
 	}
 
-	_video_ready = false;
-	_audio_ready = false;
+	if (state.first_pts < 0LL)
+	{
+		state.first_pts = media_packet->GetPts();
+	}
+
+	state.duration += media_packet->GetDuration();
 
 	return true;
 }
@@ -453,8 +487,8 @@ bool HlsPacketizer::UpdatePlayList()
 	{
 		if ((_video_track != nullptr) && (_audio_track != nullptr))
 		{
-			auto audio_pts_in_ms = static_cast<int64_t>(_ts_writer.GetFirstPts(cmn::MediaType::Audio) * _audio_timebase_expr_ms);
-			auto video_pts_in_ms = static_cast<int64_t>(_ts_writer.GetFirstPts(cmn::MediaType::Video) * _video_timebase_expr_ms);
+			auto audio_pts_in_ms = static_cast<int64_t>(_audio_ts_state.GetFirstPts() * _audio_timebase_expr_ms);
+			auto video_pts_in_ms = static_cast<int64_t>(_video_ts_state.GetFirstPts() * _video_timebase_expr_ms);
 			auto delta_in_ms = audio_pts_in_ms - video_pts_in_ms;
 
 			logas("A-V Sync: %lldms (A: %lldms, V: %lldms)", delta_in_ms, audio_pts_in_ms, video_pts_in_ms);
@@ -8,7 +8,7 @@
 //==============================================================================
 #pragma once
 
-#include <modules/segment_writer/writer.h>
+#include <modules/mpegts/mpegts_packetizer.h>
 
 #include "../segment_stream/packetizer/packetizer.h"
 
@@ -47,6 +47,23 @@ protected:
 
 	bool WriteSegment(int64_t timestamp, int64_t timestamp_in_ms, int64_t duration, int64_t duration_in_ms);
 
+	struct TsTrackState
+	{
+		// Unit: Timebase of the track
+		int64_t first_pts = -1LL;
+		int64_t duration = 0LL;
+
+		int64_t GetFirstPts() const
+		{
+			return (first_pts >= 0LL) ? first_pts : 0LL;
+		}
+	};
+
+	// Starts a new TS segment if there is no segment being written
+	void PrepareTsSegmentIfNeeded();
+	std::shared_ptr<const ov::Data> FinalizeTsSegment();
+	bool WriteTsPacket(const std::shared_ptr<const MediaPacket> &media_packet, TsTrackState &state);
+
 	bool UpdatePlayList();
 
 	uint32_t _last_msid = UINT32_MAX;
@@ -110,7 +127,11 @@ protected:
 	bool _video_ready = false;
 	bool _audio_ready = false;
 
-	Writer _ts_writer;
+	mpegts::MpegTsPacketizer _ts_packetizer;
+	// TS data of the segment being written
+	std::shared_ptr<ov::Data> _ts_data;
+	TsTrackState _video_ts_state;
+	TsTrackState _audio_ts_state;
 
 	ov::StopWatch _stat_stop_watch;
 };
@@ -11,6 +11,11 @@
 
 #include "segment_stream_private.h"
 
+std::vector<http::svr::RequestPattern> TimeInterceptor::GetRequestPatterns() const
+{
+	return {{http::Method::All, "/time", "/time"}};
+}
+
 bool TimeInterceptor::IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &client)
 {
 	auto path = client->GetRequest()->GetRequestTarget();
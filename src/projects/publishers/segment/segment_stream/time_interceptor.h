@@ -13,5 +13,6 @@
 class TimeInterceptor : public http::svr::DefaultInterceptor
 {
 public:
+	std::vector<http::svr::RequestPattern> GetRequestPatterns() const override;
 	bool IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &client) override;
 };
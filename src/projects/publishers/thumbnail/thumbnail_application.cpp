@@ -15,6 +15,8 @@ ThumbnailApplication::ThumbnailApplication(const std::shared_ptr<pub::Publisher>
 {
 	auto thumbnail_config = application_info.GetConfig().GetPublishers().GetThumbnailPublisher();
 
+	_cache_ttl = thumbnail_config.GetCacheTTL();
+
 	bool is_parsed;
 	const auto &cross_domains = thumbnail_config.GetCrossDomainList(&is_parsed);
 
@@ -19,6 +19,11 @@ public:
 		return _cors_manager;
 	}
 
+	int64_t GetCacheTTL() const
+	{
+		return _cache_ttl;
+	}
+
 private:
 	bool Start() override;
 	bool Stop() override;
@@ -30,4 +35,7 @@ private:
 	void SetCrossDomain(const std::vector<ov::String> &url_list);
 
 	http::CorsManager _cors_manager;
+
+	// Milliseconds
+	int64_t _cache_ttl = 0;
 };
@@ -10,6 +10,16 @@
 #include "thumbnail_interceptor.h"
 #include "thumbnail_private.h"
 
+//====================================================================================================
+// GetRequestPatterns
+//====================================================================================================
+std::vector<http::svr::RequestPattern> ThumbnailInterceptor::GetRequestPatterns() const
+{
+	return {
+		{http::Method::Get, "", ".jpg"},
+		{http::Method::Get, "", ".png"}};
+}
+
 //====================================================================================================
 // IsInterceptorForRequest
 //====================================================================================================
@@ -366,21 +366,33 @@ std::shared_ptr<ThumbnailInterceptor> ThumbnailPublisher::CreateInterceptor()
 			return http::svr::NextHandler::DoNotCall;	
 		}
 
-		// Wait O seconds for thumbnail image to be received
-		auto endcoded_video_frame = std::static_pointer_cast<ThumbnailStream>(stream)->GetVideoFrameByCodecId(media_codec_id, 5000);
-		if (endcoded_video_frame == nullptr)
+		// Wait up to 5 seconds for thumbnail image to be received
+		auto image = std::static_pointer_cast<ThumbnailStream>(stream)->GetImageByCodecId(media_codec_id, application->GetCacheTTL(), 5000);
+		if (image == nullptr)
 		{
 			response->AppendString(ov::String::FormatString("There is no thumbnail image"));
 			response->SetStatusCode(http::StatusCode::NotFound);
 			response->Response();
 			exchange->Release();							
+			return http::svr::NextHandler::DoNotCall;
+		}
 
+		response->SetHeader("ETag", image->etag);
+
+		// Conditional GET: the client already has this image
+		auto if_none_match = request->GetHeader("If-None-Match");
+		if ((if_none_match.IsEmpty() == false) && ((if_none_match == "*") || (if_none_match.IndexOf(image->etag) >= 0)))
+		{
+			response->SetStatusCode(http::StatusCode::NotModified);
+			response->Response();
+			exchange->Release();
 			return http::svr::NextHandler::DoNotCall;
 		}
 
 		response->SetHeader("Content-Type", (media_codec_id == cmn::MediaCodecId::Jpeg) ? "image/jpeg" : "image/png");
 		response->SetStatusCode(http::StatusCode::OK);
-		response->AppendData(std::move(endcoded_video_frame->Clone()));
+		response->AppendData(image->data);
+
 		auto sent_size = response->Response();
 		exchange->Release();
 
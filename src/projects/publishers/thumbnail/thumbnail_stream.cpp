@@ -1,6 +1,7 @@
 #include "thumbnail_stream.h"
 
-#include <regex>
+#include <base/mediarouter/on_demand_encoding.h>
+#include <base/ovlibrary/crc.h>
 
 #include "base/publisher/application.h"
 #include "base/publisher/stream.h"
@@ -34,17 +35,15 @@ bool ThumbnailStream::Start()
 		return false;
 	}
 
-	bool found = false;
 	for (const auto &[id, track] : _tracks)
 	{
 		if ((track->GetCodecId() == cmn::MediaCodecId::Png || track->GetCodecId() == cmn::MediaCodecId::Jpeg))
 		{
-			found = true;
-			break;
+			_image_track_ids.emplace(track->GetCodecId(), id);
 		}
 	}
 
-	if (found == false)
+	if (_image_track_ids.empty())
 	{
 		logtw("Stream [%s/%s] was not created because there were no supported codecs by the Thumbnail Publisher.", GetApplication()->GetName().CStr(), GetName().CStr());
 		return false;
@@ -81,9 +80,20 @@ void ThumbnailStream::SendVideoFrame(const std::shared_ptr<MediaPacket> &media_p
 		return;
 	}
 
-	std::lock_guard<std::shared_mutex> lock(_encoded_frame_mutex);
+	auto image = std::make_shared<Image>();
+	auto data = media_packet->GetData()->Clone();
 
-	_encoded_frames[track->GetCodecId()] = std::move(media_packet->GetData()->Clone());
+	image->etag = ov::String::FormatString("\"%08x-%zx\"", ov::CRC::Crc32(0, data->GetDataAs<uint8_t>(), data->GetLength()), data->GetLength());
+	image->data = std::move(data);
+	image->created_time_ms = ov::Clock::NowMSec();
+
+	{
+		std::lock_guard<std::mutex> lock(_image_mutex);
+
+		_images[track->GetCodecId()] = std::move(image);
+	}
+
+	_image_updated.notify_all();
 }
 
 void ThumbnailStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_packet)
@@ -91,34 +101,47 @@ void ThumbnailStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_p
 	// Nothing..
 }
 
-std::shared_ptr<ov::Data> ThumbnailStream::GetVideoFrameByCodecId(cmn::MediaCodecId codec_id, int64_t timeout_ms)
+std::shared_ptr<const ThumbnailStream::Image> ThumbnailStream::GetImageByCodecId(cmn::MediaCodecId codec_id, int64_t cache_ttl_ms, int64_t timeout_ms)
 {
-	ov::StopWatch	watch;
-	
-	watch.Start();
+	std::unique_lock<std::mutex> lock(_image_mutex);
 
-	do
+	auto find_image = [&]() -> std::shared_ptr<const Image> {
+		auto it = _images.find(codec_id);
+		return (it != _images.end()) ? it->second : nullptr;
+	};
+
+	auto image = find_image();
+	if ((image != nullptr) && ((static_cast<int64_t>(ov::Clock::NowMSec()) - image->created_time_ms) < cache_ttl_ms))
 	{
-		if (true)
-		{
-			std::shared_lock<std::shared_mutex> lock(_encoded_frame_mutex);
-			auto it = _encoded_frames.find(codec_id);
-			if (it != _encoded_frames.end())
-			{
-				return it->second;
-			}
-		}
+		return image;
+	}
 
-		if( (timeout_ms > 0) && (watch.Elapsed() < timeout_ms))
-		{
-			usleep(100 * 1000);	 // 100ms
-		}
-		else
-		{
-			break;
-		}
+	// If the track is encoded on demand, ask the transcoder to encode a new image.
+	// Requests from other sessions during the encoding are merged by the encoder.
+	bool on_demand = false;
+	auto track_id_it = _image_track_ids.find(codec_id);
+	if (track_id_it != _image_track_ids.end())
+	{
+		auto track_id = track_id_it->second;
 
-	} while (true);
+		lock.unlock();
+		on_demand = OnDemandEncoding::GetInstance()->Request(GetId(), track_id);
+		lock.lock();
+	}
 
-	return nullptr;
-}
\ No newline at end of file
+	// Continuously encoded images are always the latest
+	if ((on_demand == false) && (image != nullptr))
+	{
+		return image;
+	}
+
+	if (timeout_ms > 0)
+	{
+		_image_updated.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&]() {
+			return find_image() != image;
+		});
+	}
+
+	// If no new image is received in time, the previous one is used
+	return find_image();
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <base/common_types.h>
+#include <condition_variable>
 #include <base/publisher/stream.h>
 #include <modules/ovt_packetizer/ovt_packetizer.h>
 
@@ -9,6 +10,14 @@
 class ThumbnailStream : public pub::Stream
 {
 public:
+	struct Image
+	{
+		std::shared_ptr<const ov::Data> data;
+		ov::String etag;
+		// When the image was received
+		int64_t created_time_ms = 0;
+	};
+
 	static std::shared_ptr<ThumbnailStream> Create(const std::shared_ptr<pub::Application> application,
 												   const info::Stream &info);
 
@@ -20,12 +29,17 @@ public:
 	void SendAudioFrame(const std::shared_ptr<MediaPacket> &media_packet) override;
 	void SendDataFrame(const std::shared_ptr<MediaPacket> &media_packet) override {} // Not supported
 
-	std::shared_ptr<ov::Data> GetVideoFrameByCodecId(cmn::MediaCodecId codec_id, int64_t timeout_ms = 0);
+	// Returns the latest image. If the track is encoded on demand and the image is older than cache_ttl_ms,
+	// a new image is requested and waited for up to timeout_ms.
+	std::shared_ptr<const Image> GetImageByCodecId(cmn::MediaCodecId codec_id, int64_t cache_ttl_ms, int64_t timeout_ms = 0);
 private:
 	bool Start() override;
 	bool Stop() override;
 
-	std::shared_mutex _encoded_frame_mutex;
-	std::map<cmn::MediaCodecId, std::shared_ptr<ov::Data>> _encoded_frames;
+	std::mutex _image_mutex;
+	std::condition_variable _image_updated;
+	std::map<cmn::MediaCodecId, std::shared_ptr<const Image>> _images;
+	// Track to request a new image
+	std::map<cmn::MediaCodecId, MediaTrackId> _image_track_ids;
 	std::shared_ptr<mon::StreamMetrics> _stream_metrics;
 };
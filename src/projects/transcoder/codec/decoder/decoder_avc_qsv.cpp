@@ -82,6 +82,10 @@ void DecoderAVCxQSV::CodecThread()
 		}
 
 		auto buffer = std::move(obj.value());
+		if (ApplyFlush(buffer) == false)
+		{
+			continue;
+		}
 
 		auto packet_data = buffer->GetData();
 
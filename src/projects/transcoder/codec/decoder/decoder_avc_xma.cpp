@@ -144,6 +144,10 @@ void DecoderAVCxXMA::CodecThread()
 		}
 
 		auto buffer = std::move(obj.value());
+		if (ApplyFlush(buffer) == false)
+		{
+			continue;
+		}
 
 		auto packet_data = NalStreamConverter::ConvertAnnexbToXvcc(buffer->GetData(), buffer->GetFragHeader());
 		if (packet_data == nullptr)
@@ -80,6 +80,13 @@ void DecoderHEVC::CodecThread()
 		}
 
 		auto buffer = std::move(obj.value());
+		if (ApplyFlush(buffer) == false)
+		{
+			continue;
+		}
+
+		// Frames that no output needs are not decoded (See TranscodeDecoder::SetMaxOutputFrameRate())
+		_context->skip_frame = _discard_non_reference_frames ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
 
 		auto packet_data = buffer->GetData();
 
@@ -104,6 +104,10 @@ void DecoderHEVCxNV::CodecThread()
 		}
 
 		auto buffer = std::move(obj.value());
+		if (ApplyFlush(buffer) == false)
+		{
+			continue;
+		}
 		auto packet_data = buffer->GetData();
 
 		off_t offset = 0LL;
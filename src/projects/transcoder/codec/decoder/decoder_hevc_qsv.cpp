@@ -80,6 +80,10 @@ void DecoderHEVCxQSV::CodecThread()
 		}
 
 		auto buffer = std::move(obj.value());
+		if (ApplyFlush(buffer) == false)
+		{
+			continue;
+		}
 
 		auto packet_data = buffer->GetData();
 
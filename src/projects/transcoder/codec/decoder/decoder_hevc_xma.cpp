@@ -145,6 +145,10 @@ void DecoderHEVCxXMA::CodecThread()
 		}
 
 		auto buffer = std::move(obj.value());
+		if (ApplyFlush(buffer) == false)
+		{
+			continue;
+		}
 
 		// auto packet_data = H264Converter::ConvertAnnexbToAvcc(buffer->GetData());
 		auto packet_data = NalStreamConverter::ConvertAnnexbToXvcc(buffer->GetData(), buffer->GetFragHeader());
@@ -87,6 +87,12 @@ void DecoderOPUS::CodecThread()
 
 			no_data_to_encode = false;
 			_cur_pkt = std::move(obj.value());
+			if ((_cur_pkt != nullptr) && (ApplyFlush(_cur_pkt) == false))
+			{
+				_cur_pkt = nullptr;
+				continue;
+			}
+
 			if (_cur_pkt != nullptr)
 			{
 				_cur_data = _cur_pkt->GetData();
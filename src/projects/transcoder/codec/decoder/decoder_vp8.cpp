@@ -80,6 +80,10 @@ void DecoderVP8::CodecThread()
 		}
 
 		auto buffer = std::move(obj.value());
+		if (ApplyFlush(buffer) == false)
+		{
+			continue;
+		}
 
 		auto packet_data = buffer->GetData();
 
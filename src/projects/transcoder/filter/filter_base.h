@@ -42,6 +42,13 @@ public:
 	virtual bool Configure(const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<MediaTrack> &output_track) = 0;
 	virtual bool Start() = 0;
 	virtual void Stop() = 0;
+
+	// Whether the filter only reads the input frames (e.g. av_buffersrc_write_frame()).
+	// If true, the same frame is shared with other filters without cloning.
+	virtual bool IsInputReadOnly() const
+	{
+		return false;
+	}
 	
 	cmn::Timebase GetInputTimebase() const
 	{
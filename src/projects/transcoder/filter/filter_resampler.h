@@ -22,6 +22,10 @@ public:
 
 	bool Configure(const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<MediaTrack> &output_track) override;
 	bool Start() override;
+	bool IsInputReadOnly() const override
+	{
+		return true;
+	}
 	void Stop() override;
 
 	void WorkerThread();
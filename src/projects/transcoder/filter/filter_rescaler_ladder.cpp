@@ -0,0 +1,511 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Keukhan Kwon
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#include "filter_rescaler_ladder.h"
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <limits>
+
+#include "../transcoder_private.h"
+
+#define MAX_QUEUE_SIZE 500
+
+FilterRescalerLadder::FilterRescalerLadder()
+{
+	_frame = ::av_frame_alloc();
+
+	_input_buffer.SetThreshold(MAX_QUEUE_SIZE);
+
+	OV_ASSERT2(_frame != nullptr);
+}
+
+FilterRescalerLadder::~FilterRescalerLadder()
+{
+	Stop();
+
+	OV_SAFE_FUNC(_frame, nullptr, ::av_frame_free, &);
+
+	OV_SAFE_FUNC(_inputs, nullptr, ::avfilter_inout_free, &);
+	OV_SAFE_FUNC(_outputs, nullptr, ::avfilter_inout_free, &);
+
+	OV_SAFE_FUNC(_filter_graph, nullptr, ::avfilter_graph_free, &);
+
+	_input_buffer.Clear();
+}
+
+bool FilterRescalerLadder::IsSupported(const std::shared_ptr<MediaTrack> &input_track)
+{
+	if (input_track->GetMediaType() != cmn::MediaType::Video)
+	{
+		return false;
+	}
+
+	// Hardware scalers (scale_cuda, multiscale_xma, ...) are bound to their own device memory, so only frames in host memory are cascaded
+	switch (input_track->GetCodecLibraryId())
+	{
+		case cmn::MediaCodecLibraryId::DEFAULT:
+		case cmn::MediaCodecLibraryId::QSV:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+bool FilterRescalerLadder::Configure(const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<MediaTrack> &output_track)
+{
+	return Configure(input_track, std::vector<std::shared_ptr<MediaTrack>>{output_track});
+}
+
+void FilterRescalerLadder::BuildRungs(const std::vector<std::shared_ptr<MediaTrack>> &output_tracks)
+{
+	_rungs.clear();
+
+	for (size_t index = 0; index < output_tracks.size(); index++)
+	{
+		Rung rung;
+
+		rung.output_index = index;
+		rung.track = output_tracks[index];
+		rung.framerate = std::max(0.0, static_cast<double>(rung.track->GetFrameRateByConfig()));
+
+		_rungs.push_back(std::move(rung));
+	}
+
+	// Larger resolution first. If the resolutions are the same, the unlimited/higher frame rate comes first.
+	std::stable_sort(_rungs.begin(), _rungs.end(), [](const Rung &a, const Rung &b) {
+		int64_t area_a = static_cast<int64_t>(a.track->GetWidth()) * a.track->GetHeight();
+		int64_t area_b = static_cast<int64_t>(b.track->GetWidth()) * b.track->GetHeight();
+
+		if (area_a != area_b)
+		{
+			return area_a > area_b;
+		}
+
+		double framerate_a = (a.framerate == 0.0) ? std::numeric_limits<double>::max() : a.framerate;
+		double framerate_b = (b.framerate == 0.0) ? std::numeric_limits<double>::max() : b.framerate;
+
+		return framerate_a > framerate_b;
+	});
+
+	for (size_t index = 0; index < _rungs.size(); index++)
+	{
+		auto &rung = _rungs[index];
+		auto width = rung.track->GetWidth();
+		auto height = rung.track->GetHeight();
+
+		// Find the nearest larger rung that has at least as many frames as this rung needs
+		int parent = -1;
+		int64_t parent_area = 0;
+
+		for (size_t candidate_index = 0; candidate_index < index; candidate_index++)
+		{
+			const auto &candidate = _rungs[candidate_index];
+
+			if ((candidate.track->GetWidth() < width) || (candidate.track->GetHeight() < height))
+			{
+				continue;
+			}
+
+			bool has_enough_frames = (candidate.framerate == 0.0) || ((rung.framerate > 0.0) && (rung.framerate <= candidate.framerate));
+			if (has_enough_frames == false)
+			{
+				continue;
+			}
+
+			int64_t area = static_cast<int64_t>(candidate.track->GetWidth()) * candidate.track->GetHeight();
+
+			if ((parent == -1) || (area < parent_area) ||
+				// Prefer the rung that has already decimated to the same frame rate
+				((area == parent_area) && (candidate.framerate == rung.framerate) && (_rungs[parent].framerate != rung.framerate)))
+			{
+				parent = static_cast<int>(candidate_index);
+				parent_area = area;
+			}
+		}
+
+		rung.parent = parent;
+
+		if (parent >= 0)
+		{
+			_rungs[parent].children.push_back(index);
+		}
+	}
+}
+
+ov::String FilterRescalerLadder::MakeFilterDescription() const
+{
+	std::vector<ov::String> chains;
+	std::vector<ov::String> source_labels(_rungs.size());
+
+	// Input pad of each rung
+	std::vector<size_t> root_children;
+	for (size_t index = 0; index < _rungs.size(); index++)
+	{
+		if (_rungs[index].parent == -1)
+		{
+			root_children.push_back(index);
+		}
+	}
+
+	if (root_children.size() == 1)
+	{
+		source_labels[root_children[0]] = "in";
+	}
+	else
+	{
+		ov::String split = ov::String::FormatString("[in]split=%zu", root_children.size());
+		for (auto child : root_children)
+		{
+			source_labels[child] = ov::String::FormatString("r%zu", child);
+			split.AppendFormat("[%s]", source_labels[child].CStr());
+		}
+		chains.push_back(split);
+	}
+
+	for (size_t index = 0; index < _rungs.size(); index++)
+	{
+		const auto &rung = _rungs[index];
+		const auto &track = rung.track;
+
+		int32_t source_width = _input_width;
+		int32_t source_height = _input_height;
+		double source_framerate = 0.0;
+
+		if (rung.parent >= 0)
+		{
+			const auto &parent = _rungs[rung.parent];
+
+			source_width = parent.track->GetWidth();
+			source_height = parent.track->GetHeight();
+			source_framerate = parent.framerate;
+		}
+
+		std::vector<ov::String> filters;
+
+		// 1. Framerate (skipped if the parent rung has already been decimated to the same frame rate)
+		if ((rung.framerate > 0.0) && (rung.framerate != source_framerate))
+		{
+			filters.push_back(ov::String::FormatString("fps=fps=%.2f:round=near", rung.framerate));
+		}
+
+		// 2. Scaler
+		if ((track->GetWidth() != source_width) || (track->GetHeight() != source_height))
+		{
+			filters.push_back(ov::String::FormatString("scale=%dx%d:flags=bilinear", track->GetWidth(), track->GetHeight()));
+		}
+
+		auto settb = ov::String::FormatString("settb=%s[out%zu]", track->GetTimeBase().GetStringExpr().CStr(), rung.output_index);
+
+		if (rung.children.empty())
+		{
+			// 3. Timebase
+			filters.push_back(settb);
+			chains.push_back(ov::String::FormatString("[%s]%s", source_labels[index].CStr(), ov::String::Join(filters, ",").CStr()));
+		}
+		else
+		{
+			// 3. Split to this rung and to the smaller rungs
+			ov::String split = ov::String::FormatString("split=%zu[o%zu]", rung.children.size() + 1, index);
+			for (auto child : rung.children)
+			{
+				source_labels[child] = ov::String::FormatString("c%zu", child);
+				split.AppendFormat("[%s]", source_labels[child].CStr());
+			}
+			filters.push_back(split);
+
+			chains.push_back(ov::String::FormatString("[%s]%s", source_labels[index].CStr(), ov::String::Join(filters, ",").CStr()));
+
+			// 4. Timebase
+			chains.push_back(ov::String::FormatString("[o%zu]%s", index, settb.CStr()));
+		}
+	}
+
+	return ov::String::Join(chains, ";");
+}
+
+bool FilterRescalerLadder::Configure(const std::shared_ptr<MediaTrack> &input_track, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks)
+{
+	SetState(State::CREATED);
+
+	if (output_tracks.empty())
+	{
+		logte("There is no output track to rescale");
+
+		SetState(State::ERROR);
+
+		return false;
+	}
+
+	_input_track = input_track;
+	_output_track = output_tracks[0];
+
+	_input_width = input_track->GetWidth();
+	_input_height = input_track->GetHeight();
+
+	const AVFilter *buffersrc = ::avfilter_get_by_name("buffer");
+	const AVFilter *buffersink = ::avfilter_get_by_name("buffersink");
+	int ret;
+	_filter_graph = ::avfilter_graph_alloc();
+
+	if (_filter_graph == nullptr)
+	{
+		logte("Could not allocate variables for filter graph: %p", _filter_graph);
+
+		SetState(State::ERROR);
+
+		return false;
+	}
+
+	// Limit the number of filter threads to 4. I think 4 thread is usually enough for video filtering processing.
+	_filter_graph->nb_threads = 4;
+
+	//////////////////////////////////////////////////////
+	// Prepare the input parameters
+	//////////////////////////////////////////////////////
+	std::vector<ov::String> src_params = {
+		ov::String::FormatString("video_size=%dx%d", input_track->GetWidth(), input_track->GetHeight()),
+		ov::String::FormatString("pix_fmt=%d", input_track->GetColorspace()),
+		ov::String::FormatString("time_base=%s", input_track->GetTimeBase().GetStringExpr().CStr()),
+		ov::String::FormatString("pixel_aspect=%d/%d", 1, 1)};
+
+	ov::String input_filters = ov::String::Join(src_params, ":");
+
+	ret = ::avfilter_graph_create_filter(&_buffersrc_ctx, buffersrc, "in", input_filters, nullptr, _filter_graph);
+	if (ret < 0)
+	{
+		logte("Could not create video buffer source filter for rescaling: %d", ret);
+
+		SetState(State::ERROR);
+
+		return false;
+	}
+
+	_outputs = ::avfilter_inout_alloc();
+	if (_outputs == nullptr)
+	{
+		logte("Could not allocate filter output for rescaling");
+
+		SetState(State::ERROR);
+
+		return false;
+	}
+
+	_outputs->name = ::av_strdup("in");
+	_outputs->filter_ctx = _buffersrc_ctx;
+	_outputs->pad_idx = 0;
+	_outputs->next = nullptr;
+
+	//////////////////////////////////////////////////////
+	// Prepare output filters
+	//////////////////////////////////////////////////////
+	_buffersink_ctxs.assign(output_tracks.size(), nullptr);
+
+	// Build the list in reverse order so that the list is in order of output index
+	for (size_t index = output_tracks.size(); index-- > 0;)
+	{
+		auto &output_track = output_tracks[index];
+		auto name = ov::String::FormatString("out%zu", index);
+
+		ret = ::avfilter_graph_create_filter(&_buffersink_ctxs[index], buffersink, name, nullptr, nullptr, _filter_graph);
+		if (ret < 0)
+		{
+			logte("Could not create video buffer sink filter for rescaling: %d", ret);
+
+			SetState(State::ERROR);
+
+			return false;
+		}
+
+		enum AVPixelFormat pix_fmts[] = {(AVPixelFormat)output_track->GetColorspace(), AV_PIX_FMT_NONE};
+		ret = av_opt_set_int_list(_buffersink_ctxs[index], "pix_fmts", pix_fmts, AV_PIX_FMT_NONE, AV_OPT_SEARCH_CHILDREN);
+		if (ret < 0)
+		{
+			logte("Could not set output pixel format for rescaling: %d", ret);
+
+			SetState(State::ERROR);
+
+			return false;
+		}
+
+		auto inout = ::avfilter_inout_alloc();
+		if (inout == nullptr)
+		{
+			logte("Could not allocate filter input for rescaling");
+
+			SetState(State::ERROR);
+
+			return false;
+		}
+
+		inout->name = ::av_strdup(name);
+		inout->filter_ctx = _buffersink_ctxs[index];
+		inout->pad_idx = 0;
+		inout->next = _inputs;
+
+		_inputs = inout;
+	}
+
+	// The first output is used as a representative
+	_buffersink_ctx = _buffersink_ctxs[0];
+
+	//////////////////////////////////////////////////////
+	// Build
+	//////////////////////////////////////////////////////
+	BuildRungs(output_tracks);
+
+	ov::String output_filters = MakeFilterDescription();
+
+	ov::String output_track_ids;
+	for (auto &output_track : output_tracks)
+	{
+		output_track_ids.AppendFormat("%s#%u", output_track_ids.IsEmpty() ? "" : ", ", output_track->GetId());
+	}
+
+	logti("Rescaler ladder is enabled for track #%u -> %s using parameters. input: %s / outputs: %s", input_track->GetId(), output_track_ids.CStr(), input_filters.CStr(), output_filters.CStr());
+
+	if ((ret = ::avfilter_graph_parse_ptr(_filter_graph, output_filters, &_inputs, &_outputs, nullptr)) < 0)
+	{
+		logte("Could not parse filter string for rescaling: %d (%s)", ret, output_filters.CStr());
+
+		SetState(State::ERROR);
+
+		return false;
+	}
+
+	if ((ret = ::avfilter_graph_config(_filter_graph, nullptr)) < 0)
+	{
+		logte("Could not validate filter graph for rescaling: %d", ret);
+
+		SetState(State::ERROR);
+
+		return false;
+	}
+
+	return true;
+}
+
+bool FilterRescalerLadder::Start()
+{
+	try
+	{
+		_kill_flag = false;
+
+		_thread_work = std::thread(&FilterRescalerLadder::WorkerThread, this);
+		pthread_setname_np(_thread_work.native_handle(), "RescalerLadder");
+	}
+	catch (const std::system_error &e)
+	{
+		_kill_flag = true;
+		SetState(State::ERROR);
+
+		logte("Failed to start rescaling filter thread");
+
+		return false;
+	}
+
+	return true;
+}
+
+void FilterRescalerLadder::Stop()
+{
+	_kill_flag = true;
+
+	_input_buffer.Stop();
+
+	if (_thread_work.joinable())
+	{
+		_thread_work.join();
+	}
+
+	SetState(State::STOPPED);
+}
+
+void FilterRescalerLadder::WorkerThread()
+{
+	logtd("Start rescaling ladder filter thread");
+	int ret;
+
+	SetState(State::STARTED);
+
+	while (!_kill_flag)
+	{
+		auto obj = _input_buffer.Dequeue();
+		if (obj.has_value() == false)
+		{
+			continue;
+		}
+
+		auto media_frame = std::move(obj.value());
+
+		auto av_frame = ffmpeg::Conv::ToAVFrame(cmn::MediaType::Video, media_frame);
+		if (!av_frame)
+		{
+			logte("Could not allocate the video frame data");
+
+			SetState(State::ERROR);
+
+			break;
+		}
+
+		ret = ::av_buffersrc_write_frame(_buffersrc_ctx, av_frame);
+		if (ret < 0)
+		{
+			logte("An error occurred while feeding to filtergraph: format: %d, pts: %lld, linesize: %d, queue.size: %d", av_frame->format, av_frame->pts, av_frame->linesize[0], _input_buffer.Size());
+
+			continue;
+		}
+
+		for (size_t output_index = 0; (output_index < _buffersink_ctxs.size()) && (_kill_flag == false); output_index++)
+		{
+			while (!_kill_flag)
+			{
+				ret = ::av_buffersink_get_frame(_buffersink_ctxs[output_index], _frame);
+				if (ret == AVERROR(EAGAIN))
+				{
+					break;
+				}
+				else if (ret == AVERROR_EOF)
+				{
+					logte("Error receiving filtered frame. error(EOF)");
+
+					SetState(State::ERROR);
+
+					break;
+				}
+				else if (ret < 0)
+				{
+					logte("Error receiving filtered frame. error(%d)", ret);
+
+					SetState(State::ERROR);
+
+					break;
+				}
+				else
+				{
+					// The buffer of the filtered frame comes from the frame pool of the filter link,
+					// so it is returned to the pool when the encoder releases the frame.
+					_frame->pict_type = AV_PICTURE_TYPE_NONE;
+					auto output_frame = ffmpeg::Conv::ToMediaFrame(cmn::MediaType::Video, _frame);
+					::av_frame_unref(_frame);
+					if (output_frame == nullptr)
+					{
+						continue;
+					}
+
+					if (_ladder_complete_handler != nullptr && _kill_flag == false)
+					{
+						_ladder_complete_handler(output_index, std::move(output_frame));
+					}
+				}
+			}
+		}
+	}
+}
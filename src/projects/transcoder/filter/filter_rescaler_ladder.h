@@ -0,0 +1,77 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Keukhan Kwon
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#pragma once
+
+#include "../transcoder_context.h"
+#include "base/mediarouter/media_buffer.h"
+#include "base/mediarouter/media_type.h"
+#include "filter_base.h"
+
+// Scales one decoded video track into several output tracks (ABR ladder) using a single filter graph.
+//
+// Each rung is scaled from the nearest larger rung instead of the full-resolution input,
+// and rungs with the same frame rate share one fps decimation.
+//
+// Filter graph (1080p -> 720p/480p/360p):
+//     [buffer] -> [fps] -> [scale 720p] -> [split] -> [settb] -> [buffersink #0]
+//                                             \-> [scale 480p] -> [split] -> [settb] -> [buffersink #1]
+//                                                                    \-> [scale 360p] -> [settb] -> [buffersink #2]
+class FilterRescalerLadder : public FilterBase
+{
+public:
+	typedef std::function<void(size_t output_index, std::shared_ptr<MediaFrame>)> LadderCompleteHandler;
+
+	FilterRescalerLadder();
+	~FilterRescalerLadder();
+
+	// Only available for software scaling
+	static bool IsSupported(const std::shared_ptr<MediaTrack> &input_track);
+
+	bool Configure(const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<MediaTrack> &output_track) override;
+	bool Configure(const std::shared_ptr<MediaTrack> &input_track, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks);
+	bool Start() override;
+	bool IsInputReadOnly() const override
+	{
+		return true;
+	}
+	void Stop() override;
+
+	void SetLadderCompleteHandler(LadderCompleteHandler complete_handler)
+	{
+		_ladder_complete_handler = std::move(complete_handler);
+	}
+
+	void WorkerThread();
+
+private:
+	struct Rung
+	{
+		// Index of output_tracks
+		size_t output_index = 0;
+		std::shared_ptr<MediaTrack> track;
+
+		// Index of the parent rung in _rungs, -1 if the rung is scaled from the input
+		int parent = -1;
+		std::vector<size_t> children;
+
+		// 0.0 means that the frame rate is not limited
+		double framerate = 0.0;
+	};
+
+	void BuildRungs(const std::vector<std::shared_ptr<MediaTrack>> &output_tracks);
+	ov::String MakeFilterDescription() const;
+
+	// Sorted in descending order of resolution
+	std::vector<Rung> _rungs;
+	// Indexed by output_index
+	std::vector<AVFilterContext *> _buffersink_ctxs;
+
+	LadderCompleteHandler _ladder_complete_handler;
+};
@@ -19,11 +19,60 @@ extern "C"
 
 #include "base/mediarouter/media_type.h"
 
+// Memory of the decoded/filtered frames that are alive in a stream
+class MediaFrameMemoryUsage
+{
+public:
+	void Increase(int64_t bytes)
+	{
+		_frame_count++;
+		auto current_bytes = (_bytes += bytes);
+
+		auto peak_bytes = _peak_bytes.load();
+		while ((current_bytes > peak_bytes) && (_peak_bytes.compare_exchange_weak(peak_bytes, current_bytes) == false))
+		{
+		}
+	}
+
+	void Decrease(int64_t bytes)
+	{
+		_frame_count--;
+		_bytes -= bytes;
+	}
+
+	int64_t GetFrameCount() const
+	{
+		return _frame_count;
+	}
+
+	int64_t GetBytes() const
+	{
+		return _bytes;
+	}
+
+	int64_t GetPeakBytes() const
+	{
+		return _peak_bytes;
+	}
+
+private:
+	std::atomic<int64_t> _frame_count{0};
+	std::atomic<int64_t> _bytes{0};
+	std::atomic<int64_t> _peak_bytes{0};
+};
+
+// MediaFrame is passed between the decoder, filters and encoders by std::shared_ptr.
+// Once a frame is created, it is not modified, so the stages that only read the frame share it without cloning.
 class MediaFrame
 {
 public:
 	MediaFrame() = default;
 	~MediaFrame() {
+		if (_memory_usage != nullptr)
+		{
+			_memory_usage->Decrease(_accounted_bytes);
+		}
+
 		if(_priv_data)
 		{
 			av_frame_unref(_priv_data);
@@ -176,6 +225,12 @@ public:
 			return;
 		}
 
+		// The buffers may be shared with other frames (CloneFrame)
+		if (::av_frame_make_writable(_priv_data) < 0)
+		{
+			return;
+		}
+
 		for (int i = 0; i < AV_NUM_DATA_POINTERS; i++)
 		{
 			if(_priv_data->linesize[i] > 0)
@@ -229,9 +284,52 @@ public:
 		return _priv_data;
 	}
 
+	// Size of the buffers referenced by the frame
+	int64_t GetBufferSize() const
+	{
+		if (_priv_data == nullptr)
+		{
+			return 0LL;
+		}
+
+		int64_t size = 0LL;
+
+		for (int i = 0; i < AV_NUM_DATA_POINTERS; i++)
+		{
+			if (_priv_data->buf[i] != nullptr)
+			{
+				size += _priv_data->buf[i]->size;
+			}
+		}
+
+		for (int i = 0; i < _priv_data->nb_extended_buf; i++)
+		{
+			size += _priv_data->extended_buf[i]->size;
+		}
+
+		return size;
+	}
+
+	// Accounts the buffers of the frame to the memory usage until the frame is released.
+	// Clones share the buffers, so only the frame that owns new buffers should be accounted.
+	void SetMemoryUsage(const std::shared_ptr<MediaFrameMemoryUsage> &memory_usage)
+	{
+		if ((_memory_usage != nullptr) || (memory_usage == nullptr))
+		{
+			return;
+		}
+
+		_memory_usage = memory_usage;
+		_accounted_bytes = GetBufferSize();
+		_memory_usage->Increase(_accounted_bytes);
+	}
+
 private:
 	AVFrame *_priv_data = nullptr;
 
+	std::shared_ptr<MediaFrameMemoryUsage> _memory_usage;
+	int64_t _accounted_bytes = 0LL;
+
 	// Data plane, Data
 	cmn::MediaType _media_type = cmn::MediaType::Unknown;
 	int32_t _track_id = 0;
@@ -241,9 +241,203 @@ bool TranscodeDecoder::Configure(std::shared_ptr<MediaTrack> track)
 
 void TranscodeDecoder::SendBuffer(std::shared_ptr<const MediaPacket> packet)
 {
+	if (IsNeededPacket(packet) == false)
+	{
+		return;
+	}
+
 	_input_buffer.Enqueue(std::move(packet));
 }
 
+void TranscodeDecoder::SetKeyframeOnly(bool keyframe_only)
+{
+	_keyframe_only = keyframe_only;
+}
+
+void TranscodeDecoder::SetMaxOutputFrameRate(double framerate)
+{
+	_max_output_framerate = framerate;
+
+	if (framerate <= 0.0)
+	{
+		_discard_non_reference_frames = false;
+	}
+
+	// Otherwise, whether to discard the non-reference frames is decided at the next key frame (See IsNeededPacket())
+	logtd("Max output framerate of decoder(%d): %.2f", _decoder_id, framerate);
+}
+
+void TranscodeDecoder::Flush()
+{
+	// The codec is only accessed by the codec thread, so it is reset there (See ApplyFlush())
+	_input_buffer.Clear();
+	_flush_requested = true;
+
+	logtd("Decoder(%d) is flushed", _decoder_id);
+}
+
+bool TranscodeDecoder::ApplyFlush(const std::shared_ptr<const MediaPacket> &packet)
+{
+	if (_flush_requested.exchange(false))
+	{
+		if (_context != nullptr)
+		{
+			::avcodec_flush_buffers(_context);
+		}
+
+		if (_parser != nullptr)
+		{
+			// The parser keeps the partial frame and the timestamps of the previous sequence,
+			// and libavcodec has no API to flush it, so it is recreated
+			auto parser = ::av_parser_init(GetCodecID());
+
+			if (parser != nullptr)
+			{
+				parser->flags = _parser->flags;
+
+				::av_parser_close(_parser);
+				_parser = parser;
+			}
+			else
+			{
+				logte("Could not reset the parser of decoder(%d)", _decoder_id);
+			}
+		}
+
+		_wait_for_key_frame = true;
+	}
+
+	if (_wait_for_key_frame)
+	{
+		// A packet that was dequeued before Flush() may still arrive here
+		if ((packet->GetMediaType() == cmn::MediaType::Video) && (packet->GetFlag() != MediaPacketFlag::Key))
+		{
+			return false;
+		}
+
+		_wait_for_key_frame = false;
+	}
+
+	return true;
+}
+
+bool TranscodeDecoder::FindReferenceFlag(cmn::MediaCodecId codec_id, const std::shared_ptr<const MediaPacket> &packet, bool *is_reference)
+{
+	auto data = packet->GetData();
+	if (data == nullptr)
+	{
+		return false;
+	}
+
+	auto bytes = data->GetDataAs<uint8_t>();
+	auto length = data->GetLength();
+
+	// Find 00 00 01 followed by the NAL unit header
+	for (size_t index = 0; (index + 3) < length; index++)
+	{
+		if ((bytes[index] != 0x00) || (bytes[index + 1] != 0x00) || (bytes[index + 2] != 0x01))
+		{
+			continue;
+		}
+
+		uint8_t header = bytes[index + 3];
+
+		if (codec_id == cmn::MediaCodecId::H264)
+		{
+			// Coded slice (1) ~ IDR slice (5)
+			uint8_t nal_unit_type = header & 0x1F;
+			if ((nal_unit_type >= 1) && (nal_unit_type <= 5))
+			{
+				// nal_ref_idc
+				*is_reference = ((header >> 5) & 0x03) != 0;
+				return true;
+			}
+		}
+		else
+		{
+			// VCL NAL unit types are 0 ~ 31
+			uint8_t nal_unit_type = (header >> 1) & 0x3F;
+			if (nal_unit_type <= 31)
+			{
+				// TRAIL_N, TSA_N, STSA_N, RADL_N, RASL_N and RSV_VCL_N10/12/14 are sub-layer non-reference pictures
+				*is_reference = (nal_unit_type > 14) || ((nal_unit_type % 2) == 1);
+				return true;
+			}
+		}
+
+		index += 2;
+	}
+
+	return false;
+}
+
+bool TranscodeDecoder::IsNeededPacket(const std::shared_ptr<const MediaPacket> &packet)
+{
+	auto flag = packet->GetFlag();
+
+	if (_keyframe_only)
+	{
+		return (flag != MediaPacketFlag::NoFlag);
+	}
+
+	double max_output_framerate = _max_output_framerate;
+	if ((max_output_framerate <= 0.0) || (_track->GetMediaType() != cmn::MediaType::Video))
+	{
+		return true;
+	}
+
+	auto codec_id = _track->GetCodecId();
+	bool is_avc_or_hevc = (codec_id == cmn::MediaCodecId::H264) || (codec_id == cmn::MediaCodecId::H265);
+
+	if (flag == MediaPacketFlag::Key)
+	{
+		if ((_last_key_frame_pts >= 0) && (packet->GetPts() > _last_key_frame_pts))
+		{
+			_key_frame_interval = (packet->GetPts() - _last_key_frame_pts) * _track->GetTimeBase().GetExpr();
+
+			// The reference pictures of the last GOP, they are all that is left if the non-reference frames are discarded
+			_reference_framerate = (_key_frame_interval > 0.0) ? (_gop_reference_frame_count / _key_frame_interval) : 0.0;
+		}
+		_last_key_frame_pts = packet->GetPts();
+
+		// The mode can only be changed at a key frame, because the following frames refer to it.
+		// If key frames alone are enough for the output frame rate, the rest of the GOP is skipped.
+		bool skip_non_key_frames = (_key_frame_interval > 0.0) && ((max_output_framerate * _key_frame_interval) <= 1.0);
+		if (skip_non_key_frames != _skip_non_key_frames)
+		{
+			logtd("Decoder(%d) %s key frame only decoding. key frame interval: %.3fs, max output framerate: %.2f", _decoder_id, skip_non_key_frames ? "starts" : "stops", _key_frame_interval, max_output_framerate);
+			_skip_non_key_frames = skip_non_key_frames;
+		}
+
+		// Discarding the non-reference frames doesn't lower the frame rate below the output frame rate
+		// only if the reference pictures alone are enough for it (and there are frames to discard)
+		bool discard_non_reference_frames = is_avc_or_hevc &&
+											(_gop_reference_frame_count < _gop_frame_count) &&
+											(_reference_framerate > 0.0) && (_reference_framerate >= max_output_framerate);
+		if (discard_non_reference_frames != _discard_non_reference_frames)
+		{
+			logtd("Decoder(%d) %s discarding non-reference frames. reference framerate: %.2f, max output framerate: %.2f", _decoder_id, discard_non_reference_frames ? "starts" : "stops", _reference_framerate, max_output_framerate);
+			_discard_non_reference_frames = discard_non_reference_frames;
+		}
+
+		_gop_frame_count = 0;
+		_gop_reference_frame_count = 0;
+	}
+
+	if (is_avc_or_hevc)
+	{
+		// Observe the GOP structure
+		bool is_reference = false;
+		if (FindReferenceFlag(codec_id, packet, &is_reference))
+		{
+			_gop_frame_count++;
+			_gop_reference_frame_count += is_reference ? 1 : 0;
+		}
+	}
+
+	return (_skip_non_key_frames == false) || (flag != MediaPacketFlag::NoFlag);
+}
+
 void TranscodeDecoder::SendOutputBuffer(TranscodeResult result, std::shared_ptr<MediaFrame> frame)
 {
 	// Invoke callback function when encoding/decoding is completed.
@@ -27,6 +27,14 @@ public:
 	bool Configure(std::shared_ptr<MediaTrack> track) override;
 
 	void SendBuffer(std::shared_ptr<const MediaPacket> packet) override;
+	// Decode only key frames. Used when all outputs of the decoder are encoded on demand.
+	void SetKeyframeOnly(bool keyframe_only);
+	// The highest frame rate that the outputs of this decoder need (0: all frames are needed).
+	// Depending on the GOP structure, only key frames are decoded or non-reference frames are discarded.
+	void SetMaxOutputFrameRate(double framerate);
+	// Drops the queued packets and resets the codec, so decoding restarts from the next key frame.
+	// Used when the packets start to come from another source (See TranscodeSharedDecoder)
+	void Flush();
 	void SendOutputBuffer(TranscodeResult result, std::shared_ptr<MediaFrame> frame);
 	
 	std::shared_ptr<MediaTrack> &GetRefTrack();
@@ -43,6 +51,15 @@ public:
 	}
 
 protected:
+	bool IsNeededPacket(const std::shared_ptr<const MediaPacket> &packet);
+	// Finds the first VCL NAL unit of the H.264/H.265 packet (Annex B),
+	// and returns whether the picture can be referenced by other pictures.
+	// Returns false if the packet has no VCL NAL unit.
+	static bool FindReferenceFlag(cmn::MediaCodecId codec_id, const std::shared_ptr<const MediaPacket> &packet, bool *is_reference);
+	// Called by the codec thread with a dequeued packet. Resets the codec and the parser if Flush() is requested,
+	// and returns false if the packet has to be dropped until the next key frame.
+	bool ApplyFlush(const std::shared_ptr<const MediaPacket> &packet);
+
 	int32_t _decoder_id;
 
 	std::shared_ptr<MediaTrack> _track;
@@ -53,6 +70,26 @@ protected:
 
 	bool _change_format = false;
 
+	// These can be changed while decoding when the decoder is shared by several streams
+	std::atomic<bool> _keyframe_only = false;
+	std::atomic<double> _max_output_framerate = 0.0;
+
+	int64_t _last_key_frame_pts = -1LL;
+	double _key_frame_interval = 0.0;
+	// Whether to skip the non-key packets of the current GOP
+	bool _skip_non_key_frames = false;
+	// The number of pictures (and the reference pictures among them) in the current GOP
+	int64_t _gop_frame_count = 0;
+	int64_t _gop_reference_frame_count = 0;
+	// The rate of the reference pictures measured in the last GOP (frames per second, 0 if unknown)
+	double _reference_framerate = 0.0;
+	// Applied to AVCodecContext::skip_frame by the software decoders
+	std::atomic<bool> _discard_non_reference_frames = false;
+
+	std::atomic<bool> _flush_requested = false;
+	// Only used by the codec thread
+	bool _wait_for_key_frame = false;
+
 	AVPacket *_pkt;
 	AVFrame *_frame;
 
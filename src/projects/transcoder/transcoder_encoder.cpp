@@ -256,11 +256,85 @@ std::shared_ptr<MediaTrack> &TranscodeEncoder::GetRefTrack()
 
 void TranscodeEncoder::SendBuffer(std::shared_ptr<const MediaFrame> frame)
 {
+	if (_on_demand)
+	{
+		std::lock_guard<std::mutex> lock(_on_demand_mutex);
+
+		_on_demand_frame = frame;
+		_on_demand_packet = nullptr;
+
+		// Nobody is waiting for this frame
+		if (_on_demand_requested == false)
+		{
+			_on_demand_frame_queued = false;
+			return;
+		}
+
+		_on_demand_requested = false;
+		_on_demand_frame_queued = true;
+	}
+
 	_input_buffer.Enqueue(std::move(frame));
 }
 
 void TranscodeEncoder::SendOutputBuffer(std::shared_ptr<MediaPacket> packet)
 {
+	if (_on_demand)
+	{
+		std::lock_guard<std::mutex> lock(_on_demand_mutex);
+
+		if (_on_demand_frame != nullptr && _on_demand_frame->GetPts() == packet->GetPts())
+		{
+			_on_demand_packet = packet;
+		}
+	}
+
+	if (_complete_handler)
+	{
+		_complete_handler(_encoder_id, std::move(packet));
+	}
+}
+
+void TranscodeEncoder::SetOnDemand(bool on_demand)
+{
+	_on_demand = on_demand;
+}
+
+bool TranscodeEncoder::IsOnDemand() const
+{
+	return _on_demand;
+}
+
+void TranscodeEncoder::RequestEncoding()
+{
+	std::shared_ptr<MediaPacket> packet;
+
+	{
+		std::lock_guard<std::mutex> lock(_on_demand_mutex);
+
+		if (_on_demand_frame == nullptr)
+		{
+			_on_demand_requested = true;
+			return;
+		}
+
+		if (_on_demand_frame_queued == false)
+		{
+			_on_demand_frame_queued = true;
+			_input_buffer.Enqueue(_on_demand_frame);
+			return;
+		}
+
+		// The latest frame is already being encoded
+		if (_on_demand_packet == nullptr)
+		{
+			return;
+		}
+
+		// There is no newer frame, so send the latest encoded packet again
+		packet = _on_demand_packet->ClonePacket();
+	}
+
 	if (_complete_handler)
 	{
 		_complete_handler(_encoder_id, std::move(packet));
@@ -38,6 +38,10 @@ public:
 
 	cmn::Timebase GetTimebase() const;
 
+	// In on-demand mode, the latest frame is kept and encoded only when RequestEncoding() is called
+	void SetOnDemand(bool on_demand);
+	bool IsOnDemand() const;
+	void RequestEncoding();
 
 public:
 
@@ -70,4 +74,13 @@ protected:
 
 	CompleteHandler _complete_handler;
 
+	bool _on_demand = false;
+	std::mutex _on_demand_mutex;
+	// The latest frame and whether it has been sent to the codec
+	std::shared_ptr<const MediaFrame> _on_demand_frame;
+	bool _on_demand_frame_queued = false;
+	// Encode the next frame as soon as it arrives
+	bool _on_demand_requested = false;
+	// The packet encoded from _on_demand_frame
+	std::shared_ptr<MediaPacket> _on_demand_packet;
 };
@@ -2,6 +2,7 @@
 
 #include "filter/filter_resampler.h"
 #include "filter/filter_rescaler.h"
+#include "filter/filter_rescaler_ladder.h"
 #include "transcoder_gpu.h"
 #include "transcoder_private.h"
 
@@ -37,6 +38,25 @@ bool TranscodeFilter::Configure(int32_t id,
 	return Create();
 }
 
+bool TranscodeFilter::Configure(const std::vector<int32_t>& ids,
+								const std::shared_ptr<info::Stream>& input_stream_info, std::shared_ptr<MediaTrack> input_track,
+								const std::shared_ptr<info::Stream>& output_stream_info, const std::vector<std::shared_ptr<MediaTrack>>& output_tracks,
+								CompleteHandler complete_handler)
+{
+	if (ids.empty() || (ids.size() != output_tracks.size()))
+	{
+		logte("Invalid rescaler ladder. Filters(%zu), OutputTracks(%zu)", ids.size(), output_tracks.size());
+		return false;
+	}
+
+	logtd("Create a transcode filter ladder. Track(%d -> %zu tracks)", input_track->GetId(), output_tracks.size());
+
+	_ladder_ids = ids;
+	_ladder_output_tracks = output_tracks;
+
+	return Configure(ids[0], input_stream_info, input_track, output_stream_info, output_tracks[0], complete_handler);
+}
+
 bool TranscodeFilter::Create()
 {
 	std::lock_guard<std::shared_mutex> lock(_mutex);
@@ -49,13 +69,23 @@ bool TranscodeFilter::Create()
 		_internal = nullptr;
 	}
 
+	std::shared_ptr<FilterRescalerLadder> ladder;
+
 	switch (_input_track->GetMediaType())
 	{
 		case MediaType::Audio:
 			_internal = std::make_shared<FilterResampler>();
 			break;
 		case MediaType::Video:
-			_internal = std::make_shared<FilterRescaler>();
+			if (_ladder_output_tracks.empty() == false)
+			{
+				ladder = std::make_shared<FilterRescalerLadder>();
+				_internal = ladder;
+			}
+			else
+			{
+				_internal = std::make_shared<FilterRescaler>();
+			}
 			break;
 		default:
 			logte("Unsupported media type in filter");
@@ -71,7 +101,17 @@ bool TranscodeFilter::Create()
 	_internal->SetQueueUrn(urn);
 	_internal->SetCompleteHandler(bind(&TranscodeFilter::OnComplete, this, std::placeholders::_1));
 
-	bool success = _internal->Configure(_input_track, _output_track);
+	bool success = false;
+	if (ladder != nullptr)
+	{
+		ladder->SetLadderCompleteHandler(bind(&TranscodeFilter::OnLadderComplete, this, std::placeholders::_1, std::placeholders::_2));
+		success = ladder->Configure(_input_track, _ladder_output_tracks);
+	}
+	else
+	{
+		success = _internal->Configure(_input_track, _output_track);
+	}
+
 	if (success == false)
 	{
 		logte("Could not create filter");
@@ -115,6 +155,17 @@ bool TranscodeFilter::SendBuffer(std::shared_ptr<MediaFrame> buffer)
 	return _internal->SendBuffer(std::move(buffer));
 }
 
+bool TranscodeFilter::IsInputReadOnly()
+{
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	if (_internal == nullptr)
+	{
+		return false;
+	}
+
+	return _internal->IsInputReadOnly();
+}
+
 bool TranscodeFilter::IsNeedUpdate(std::shared_ptr<MediaFrame> buffer)
 {
 	// In case of pts/dts jumps
@@ -178,6 +229,14 @@ void TranscodeFilter::OnComplete(std::shared_ptr<MediaFrame> frame)
 	}
 }
 
+void TranscodeFilter::OnLadderComplete(size_t output_index, std::shared_ptr<MediaFrame> frame)
+{
+	if (_complete_handler && (output_index < _ladder_ids.size()))
+	{
+		_complete_handler(_ladder_ids[output_index], frame);
+	}
+}
+
 cmn::Timebase TranscodeFilter::GetInputTimebase() const
 {
 	return _internal->GetInputTimebase();
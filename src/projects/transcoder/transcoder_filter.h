@@ -32,7 +32,15 @@ public:
 		const std::shared_ptr<info::Stream> &input_stream_info, std::shared_ptr<MediaTrack> input_track,
 		const std::shared_ptr<info::Stream> &output_stream_info, std::shared_ptr<MediaTrack> output_track,
 		CompleteHandler complete_handler);
+	// Scales one input track to several output tracks with a single cascaded scaler (Video only)
+	bool Configure(
+		const std::vector<int32_t> &filter_ids,
+		const std::shared_ptr<info::Stream> &input_stream_info, std::shared_ptr<MediaTrack> input_track,
+		const std::shared_ptr<info::Stream> &output_stream_info, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks,
+		CompleteHandler complete_handler);
 	bool SendBuffer(std::shared_ptr<MediaFrame> buffer);
+	// If true, the frame passed to SendBuffer() can be shared with other filters
+	bool IsInputReadOnly();
 	void Stop(); 
 
 	cmn::Timebase GetInputTimebase() const;
@@ -42,6 +50,7 @@ public:
 
 	void SetCompleteHandler(CompleteHandler complete_handler);
 	void OnComplete(std::shared_ptr<MediaFrame> frame);
+	void OnLadderComplete(size_t output_index, std::shared_ptr<MediaFrame> frame);
 
 private:
 	bool Create();
@@ -57,6 +66,10 @@ private:
 	std::shared_ptr<info::Stream> _output_stream_info;
 	std::shared_ptr<MediaTrack> _output_track;
 
+	// Filter IDs and output tracks of the rescaler ladder. Empty if it is not a ladder.
+	std::vector<int32_t> _ladder_ids;
+	std::vector<std::shared_ptr<MediaTrack>> _ladder_output_tracks;
+
 	CompleteHandler _complete_handler;
 
 	std::shared_mutex _mutex;
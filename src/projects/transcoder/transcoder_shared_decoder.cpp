@@ -0,0 +1,277 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Kwon Keuk Han
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "transcoder_shared_decoder.h"
+
+#include "transcoder_private.h"
+
+TranscodeSharedDecoder::TranscodeSharedDecoder(const ov::String &key)
+	: _key(key)
+{
+}
+
+void TranscodeSharedDecoder::Subscribe(Subscriber subscriber, int32_t decoder_id, TranscodeDecoder::CompleteHandler handler, bool keyframe_only, double max_output_framerate)
+{
+	std::lock_guard<std::shared_mutex> lock(_subscriber_mutex);
+
+	auto &context = _subscribers[subscriber];
+	context.decoder_id = decoder_id;
+	context.handler_guard = std::make_shared<HandlerGuard>();
+	context.handler_guard->handler = std::move(handler);
+	context.keyframe_only = keyframe_only;
+	context.max_output_framerate = max_output_framerate;
+
+	if (_feeder == nullptr)
+	{
+		_feeder = subscriber;
+	}
+
+	UpdateDecodingPolicy();
+
+	logtd("Subscribed to the shared decoder: %s, subscribers: %zu", _key.CStr(), _subscribers.size());
+}
+
+size_t TranscodeSharedDecoder::Unsubscribe(Subscriber subscriber)
+{
+	std::shared_ptr<HandlerGuard> handler_guard;
+	size_t subscriber_count = 0;
+
+	{
+		std::lock_guard<std::shared_mutex> lock(_subscriber_mutex);
+
+		auto item = _subscribers.find(subscriber);
+		if (item != _subscribers.end())
+		{
+			handler_guard = item->second.handler_guard;
+			_subscribers.erase(item);
+		}
+
+		// Another subscriber feeds the packets from now on
+		if (_feeder == subscriber)
+		{
+			// Both are changed under the exclusive lock, so the new feeder sees the wait with its first packet
+			_wait_for_key_frame = true;
+			_feeder = _subscribers.empty() ? nullptr : _subscribers.begin()->first;
+		}
+
+		if (_subscribers.empty() == false)
+		{
+			UpdateDecodingPolicy();
+		}
+
+		subscriber_count = _subscribers.size();
+	}
+
+	if (handler_guard != nullptr)
+	{
+		// Wait for the handler that the decoder thread may be running
+		std::lock_guard<std::mutex> lock(handler_guard->mutex);
+		handler_guard->handler = nullptr;
+	}
+
+	logtd("Unsubscribed from the shared decoder: %s, subscribers: %zu", _key.CStr(), subscriber_count);
+
+	return subscriber_count;
+}
+
+void TranscodeSharedDecoder::SendBuffer(Subscriber subscriber, std::shared_ptr<const MediaPacket> packet)
+{
+	std::shared_lock<std::shared_mutex> lock(_subscriber_mutex);
+
+	// Every subscriber receives the same packets from the origin, so only one of them is decoded
+	if ((_feeder != subscriber) || (_decoder == nullptr))
+	{
+		return;
+	}
+
+	if (_wait_for_key_frame)
+	{
+		// Audio packets can be decoded independently
+		if ((packet->GetMediaType() == cmn::MediaType::Video) && (packet->GetFlag() != MediaPacketFlag::Key))
+		{
+			return;
+		}
+
+		// Only the feeder gets here, and the exclusive lock is needed to set the flag again
+		_wait_for_key_frame = false;
+
+		// Drop what is left from the previous feeder, and start a new sequence from this key frame
+		_decoder->Flush();
+
+		logtd("The new feeder of the shared decoder starts from a key frame: %s", _key.CStr());
+	}
+
+	_decoder->SendBuffer(std::move(packet));
+}
+
+void TranscodeSharedDecoder::OnDecodedFrame(TranscodeResult result, int32_t decoder_id, std::shared_ptr<MediaFrame> frame)
+{
+	struct Delivery
+	{
+		std::shared_ptr<HandlerGuard> handler_guard;
+		int32_t decoder_id;
+		TranscodeResult result;
+	};
+
+	std::vector<Delivery> deliveries;
+
+	{
+		std::shared_lock<std::shared_mutex> lock(_subscriber_mutex);
+
+		deliveries.reserve(_subscribers.size());
+
+		for (auto &item : _subscribers)
+		{
+			auto &context = item.second;
+
+			// format_notified is only accessed by the decoder thread
+			auto subscriber_result = result;
+			if (result == TranscodeResult::FormatChanged)
+			{
+				context.format_notified = true;
+			}
+			else if ((result == TranscodeResult::DataReady) && (context.format_notified == false))
+			{
+				subscriber_result = TranscodeResult::FormatChanged;
+				context.format_notified = true;
+			}
+
+			deliveries.push_back({context.handler_guard, context.decoder_id, subscriber_result});
+		}
+	}
+
+	// The handlers run the filters and the encoders of the subscribers, so they are called without _subscriber_mutex
+	for (auto &delivery : deliveries)
+	{
+		std::lock_guard<std::mutex> lock(delivery.handler_guard->mutex);
+
+		if (delivery.handler_guard->handler == nullptr)
+		{
+			continue;
+		}
+
+		// Decoded frames are shared as they are. A clone is only needed to change the track ID.
+		auto subscriber_frame = frame;
+		if (delivery.decoder_id != decoder_id)
+		{
+			subscriber_frame = frame->CloneFrame();
+			if (subscriber_frame == nullptr)
+			{
+				continue;
+			}
+			subscriber_frame->SetTrackId(delivery.decoder_id);
+		}
+
+		delivery.handler_guard->handler(delivery.result, delivery.decoder_id, std::move(subscriber_frame));
+	}
+}
+
+void TranscodeSharedDecoder::UpdateDecodingPolicy()
+{
+	if (_decoder == nullptr)
+	{
+		return;
+	}
+
+	// Key frames only if all subscribers need only key frames,
+	// and all frames if any subscriber has no frame rate limit.
+	bool keyframe_only = true;
+	double max_output_framerate = 0.0;
+	bool unlimited = false;
+
+	for (auto &item : _subscribers)
+	{
+		auto &context = item.second;
+
+		if (context.keyframe_only)
+		{
+			continue;
+		}
+
+		keyframe_only = false;
+
+		if (context.max_output_framerate <= 0.0)
+		{
+			unlimited = true;
+		}
+
+		max_output_framerate = std::max(max_output_framerate, context.max_output_framerate);
+	}
+
+	_decoder->SetKeyframeOnly(keyframe_only);
+	_decoder->SetMaxOutputFrameRate((keyframe_only || unlimited) ? 0.0 : max_output_framerate);
+}
+
+ov::String TranscodeSharedDecoders::MakeKey([[maybe_unused]] const std::shared_ptr<info::Stream> &input_stream, [[maybe_unused]] const std::shared_ptr<MediaTrack> &input_track)
+{
+	// No decoder is shared for now.
+	//
+	// Every provider, OVT included, rebases the timestamps of a session to its own first DTS
+	// and adds the reconnection time to the base (See pvd::Stream::AdjustTimestampByBase()).
+	// So the frames decoded from the packets of one subscriber are on a different timeline
+	// from the other subscribers, and the timeline jumps when the feeder changes.
+	// The frames have to be translated into the timeline of each subscriber before they can be shared.
+	return "";
+}
+
+std::shared_ptr<TranscodeSharedDecoder> TranscodeSharedDecoders::Subscribe(
+	const ov::String &key,
+	TranscodeSharedDecoder::Subscriber subscriber, int32_t decoder_id, TranscodeDecoder::CompleteHandler handler,
+	bool keyframe_only, double max_output_framerate,
+	DecoderFactory factory)
+{
+	std::lock_guard<std::mutex> lock(_shared_decoder_map_mutex);
+
+	auto shared_decoder_it = _shared_decoder_map.find(key);
+	if (shared_decoder_it != _shared_decoder_map.end())
+	{
+		auto shared_decoder = shared_decoder_it->second;
+
+		logti("The decoder is shared with other applications: %s", key.CStr());
+		shared_decoder->Subscribe(subscriber, decoder_id, std::move(handler), keyframe_only, max_output_framerate);
+
+		return shared_decoder;
+	}
+
+	auto shared_decoder = std::make_shared<TranscodeSharedDecoder>(key);
+
+	// The shared decoder outlives the decoder because it is stopped when the last subscriber leaves
+	auto decoder = factory(std::bind(&TranscodeSharedDecoder::OnDecodedFrame, shared_decoder.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	if (decoder == nullptr)
+	{
+		return nullptr;
+	}
+
+	shared_decoder->SetDecoder(std::move(decoder));
+	shared_decoder->Subscribe(subscriber, decoder_id, std::move(handler), keyframe_only, max_output_framerate);
+
+	_shared_decoder_map[key] = shared_decoder;
+
+	return shared_decoder;
+}
+
+void TranscodeSharedDecoders::Unsubscribe(const std::shared_ptr<TranscodeSharedDecoder> &shared_decoder, TranscodeSharedDecoder::Subscriber subscriber)
+{
+	{
+		std::lock_guard<std::mutex> lock(_shared_decoder_map_mutex);
+
+		if (shared_decoder->Unsubscribe(subscriber) > 0)
+		{
+			return;
+		}
+
+		_shared_decoder_map.erase(shared_decoder->GetKey());
+	}
+
+	// Stop outside of the lock because the decoder thread may be delivering a frame
+	auto decoder = shared_decoder->GetDecoder();
+	if (decoder != nullptr)
+	{
+		decoder->Stop();
+	}
+}
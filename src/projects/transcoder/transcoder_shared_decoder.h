@@ -0,0 +1,117 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Kwon Keuk Han
+//  Copyright (c) 2023 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/info/stream.h>
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <map>
+#include <shared_mutex>
+
+#include "transcoder_decoder.h"
+
+// A decoder that is shared by the TranscoderStreams of several applications.
+//
+// When the same origin stream is pulled into more than one application, each application
+// creates its own TranscoderStream. Instead of decoding the same input in every stream,
+// the first stream creates the decoder and the others subscribe to its decoded frames.
+// Only the packets of one subscriber (feeder) are decoded, and the others are ignored.
+// Each subscriber still has its own filters and encoders.
+class TranscodeSharedDecoder
+{
+public:
+	using Subscriber = const void *;
+
+	TranscodeSharedDecoder(const ov::String &key);
+
+	const ov::String &GetKey() const
+	{
+		return _key;
+	}
+
+	const std::shared_ptr<TranscodeDecoder> &GetDecoder() const
+	{
+		return _decoder;
+	}
+
+	// keyframe_only/max_output_framerate: What the subscriber needs (See TranscodeDecoder)
+	void Subscribe(Subscriber subscriber, int32_t decoder_id, TranscodeDecoder::CompleteHandler handler, bool keyframe_only, double max_output_framerate);
+	// Returns the number of remaining subscribers
+	size_t Unsubscribe(Subscriber subscriber);
+
+	void SendBuffer(Subscriber subscriber, std::shared_ptr<const MediaPacket> packet);
+
+private:
+	friend class TranscodeSharedDecoders;
+
+	// The handler of a subscriber is called without _subscriber_mutex, so a slow subscriber doesn't block the others.
+	// Unsubscribe() waits on the mutex until the running handler returns, and no handler is called after that.
+	struct HandlerGuard
+	{
+		std::mutex mutex;
+		// nullptr after Unsubscribe()
+		TranscodeDecoder::CompleteHandler handler;
+	};
+
+	struct SubscriberContext
+	{
+		int32_t decoder_id = -1;
+		std::shared_ptr<HandlerGuard> handler_guard;
+
+		bool keyframe_only = false;
+		double max_output_framerate = 0.0;
+
+		// A subscriber that joins a running decoder has to create its filters and encoders
+		// with the first frame it receives
+		bool format_notified = false;
+	};
+
+	void SetDecoder(std::shared_ptr<TranscodeDecoder> decoder)
+	{
+		_decoder = std::move(decoder);
+	}
+
+	void OnDecodedFrame(TranscodeResult result, int32_t decoder_id, std::shared_ptr<MediaFrame> frame);
+	// Must be called with _subscriber_mutex locked
+	void UpdateDecodingPolicy();
+
+	ov::String _key;
+	std::shared_ptr<TranscodeDecoder> _decoder;
+
+	std::shared_mutex _subscriber_mutex;
+	std::map<Subscriber, SubscriberContext> _subscribers;
+
+	// Changed under the exclusive lock of _subscriber_mutex, and read under the shared lock
+	Subscriber _feeder = nullptr;
+	// Set when the feeder is changed. The packets of the new feeder are dropped until its key frame,
+	// because the decoder is in the middle of the GOP of the previous feeder.
+	// Cleared by the feeder under the shared lock, so it is atomic.
+	std::atomic<bool> _wait_for_key_frame = false;
+};
+
+class TranscodeSharedDecoders : public ov::Singleton<TranscodeSharedDecoders>
+{
+public:
+	using DecoderFactory = std::function<std::shared_ptr<TranscodeDecoder>(TranscodeDecoder::CompleteHandler)>;
+
+	// Returns an empty string if the decoder of the track cannot be shared
+	static ov::String MakeKey(const std::shared_ptr<info::Stream> &input_stream, const std::shared_ptr<MediaTrack> &input_track);
+
+	// Returns the shared decoder of the key. If there is no decoder, it is created by the factory.
+	std::shared_ptr<TranscodeSharedDecoder> Subscribe(
+		const ov::String &key,
+		TranscodeSharedDecoder::Subscriber subscriber, int32_t decoder_id, TranscodeDecoder::CompleteHandler handler,
+		bool keyframe_only, double max_output_framerate,
+		DecoderFactory factory);
+	void Unsubscribe(const std::shared_ptr<TranscodeSharedDecoder> &shared_decoder, TranscodeSharedDecoder::Subscriber subscriber);
+
+private:
+	std::mutex _shared_decoder_map_mutex;
+	std::map<ov::String, std::shared_ptr<TranscodeSharedDecoder>> _shared_decoder_map;
+};
@@ -9,14 +9,18 @@
 
 #include "transcoder_stream.h"
 
+#include <base/mediarouter/on_demand_encoding.h>
 #include <config/config_manager.h>
+#include <monitoring/monitoring.h>
 
+#include "filter/filter_rescaler_ladder.h"
 #include "transcoder_application.h"
 #include "transcoder_private.h"
 
 #define MAX_QUEUE_SIZE 100
 #define GENERATE_FILLER_FRAME true
 #define UNUSED_VARIABLE(var) (void)var;
+#define FRAME_MEMORY_USAGE_LOG_INTERVAL_MS 10000
 
 TranscoderStream::TranscoderStream(const info::Application &application_info, const std::shared_ptr<info::Stream> &stream, TranscodeApplication *parent)
 	: _parent(parent), _application_info(application_info), _input_stream(stream)
@@ -68,6 +72,7 @@ bool TranscoderStream::Stop()
 	_link_decoder_to_filters.clear();
 	_link_filter_to_encoder.clear();
 	_link_encoder_to_outputs.clear();
+	_on_demand_encoders.clear();
 
 	// Delete all last decoded frame information
 	_last_decoded_frame_pts.clear();
@@ -76,6 +81,8 @@ bool TranscoderStream::Stop()
 	// Delete all output streams information
 	_output_streams.clear();
 
+	logti("%s Peak frame memory usage: %s", _log_prefix.CStr(), ov::Converter::BytesToString(_frame_memory_usage->GetPeakBytes()).CStr());
+
 	_is_stopped = true;
 
 	logti("%s Transcoder stream has been stopped", _log_prefix.CStr());
@@ -190,11 +197,20 @@ void TranscoderStream::RemoveDecoders()
 	
 	for (auto &it : _decoders)
 	{
+		auto shared_decoder_it = _shared_decoders.find(it.first);
+		if (shared_decoder_it != _shared_decoders.end())
+		{
+			// The decoder is stopped when the last stream unsubscribes
+			TranscodeSharedDecoders::GetInstance()->Unsubscribe(shared_decoder_it->second, this);
+			continue;
+		}
+
 		auto object = it.second;
 		object->Stop();
 		object.reset();
 	}
 	_decoders.clear();
+	_shared_decoders.clear();
 }
 
 void TranscoderStream::RemoveFilters()
@@ -204,8 +220,11 @@ void TranscoderStream::RemoveFilters()
 	for (auto &it : _filters)
 	{
 		auto object = it.second;
-		object->Stop();
-		object.reset();
+		if (object != nullptr)
+		{
+			object->Stop();
+			object.reset();
+		}
 	}
 	_filters.clear();
 }
@@ -215,6 +234,14 @@ void TranscoderStream::RemoveEncoders()
 	std::lock_guard<std::shared_mutex> encoder_lock(_encoder_map_mutex);
 	for (auto &iter : _encoders)
 	{
+		if (iter.second->IsOnDemand())
+		{
+			for (auto &[linked_stream, linked_track_id] : _link_encoder_to_outputs[iter.first])
+			{
+				OnDemandEncoding::GetInstance()->Unregister(linked_stream->GetId(), linked_track_id);
+			}
+		}
+
 		auto object = iter.second;
 		object->Stop();
 		object.reset();
@@ -433,7 +460,7 @@ std::shared_ptr<info::Stream> TranscoderStream::CreateOutputStream(const cfg::vh
 					stream->AddTrack(output_track);
 
 					auto profile_sign = GetIdentifiedForImageProfile(input_track_id, profile);
-					AddComposite(profile_sign, _input_stream, input_track, stream, output_track);
+					AddComposite(profile_sign, _input_stream, input_track, stream, output_track, profile.IsOnDemand());
 				}
 			}
 			break;
@@ -524,17 +551,51 @@ int32_t TranscoderStream::BuildComposite()
 
 				// Flushing: Encoder(1) -> OutputTrack (N)
 				_link_encoder_to_outputs[encoder_id].push_back(make_pair(output_stream, output_track_id));
+
+				if (composite->IsOnDemand())
+				{
+					_on_demand_encoders.insert(encoder_id);
+				}
 			}
 		}
 
 		created_count++;
 	}
 
+	UpdateDeduplicatedEncodes();
+
 	logtd("%s", GetInfoStringComposite().CStr());
 
 	return created_count;
 }
 
+void TranscoderStream::UpdateDeduplicatedEncodes()
+{
+	// Output tracks with the same encoding settings are linked to one encoder
+	int32_t deduplicated_count = 0;
+
+	for (auto &[encoder_id, output_tracks] : _link_encoder_to_outputs)
+	{
+		UNUSED_VARIABLE(encoder_id)
+
+		if (output_tracks.size() > 1)
+		{
+			deduplicated_count += output_tracks.size() - 1;
+		}
+	}
+
+	if (deduplicated_count > 0)
+	{
+		logti("%s %d encodes are deduplicated. %zu encoders are used", _log_prefix.CStr(), deduplicated_count, _link_encoder_to_outputs.size());
+	}
+
+	auto stream_metrics = StreamMetrics(*_input_stream);
+	if (stream_metrics != nullptr)
+	{
+		stream_metrics->SetDeduplicatedEncodes(deduplicated_count);
+	}
+}
+
 // LOG for DEBUG
 ov::String TranscoderStream::GetInfoStringComposite()
 {
@@ -606,7 +667,8 @@ ov::String TranscoderStream::GetInfoStringComposite()
 void TranscoderStream::AddComposite(
 	ov::String profile_sign,
 	std::shared_ptr<info::Stream> input_stream,	std::shared_ptr<MediaTrack> input_track,
-	std::shared_ptr<info::Stream> output_stream, std::shared_ptr<MediaTrack> output_track)
+	std::shared_ptr<info::Stream> output_stream, std::shared_ptr<MediaTrack> output_track,
+	bool on_demand)
 {
 	auto key = std::make_pair(profile_sign, input_track->GetMediaType());
 
@@ -614,6 +676,7 @@ void TranscoderStream::AddComposite(
 	{
 		auto composite = std::make_shared<CompositeContext>(_last_composite_id++);
 		composite->SetInput(input_stream, input_track);
+		composite->SetOnDemand(on_demand);
 
 		_composite_map[key] = composite;
 	}
@@ -670,7 +733,53 @@ bool TranscoderStream::CreateDecoder(int32_t decoder_id, std::shared_ptr<MediaTr
 		return true;
 	}
 
-	auto decoder = TranscodeDecoder::Create(decoder_id, *_input_stream, input_track, bind(&TranscoderStream::OnDecodedFrame, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	auto complete_handler = bind(&TranscoderStream::OnDecodedFrame, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+
+	// If nobody needs continuous frames, only the key frames are decoded
+	bool keyframe_only = false;
+	double max_output_framerate = 0.0;
+
+	if (IsOnDemandOnlyDecoder(decoder_id))
+	{
+		logti("[%s/%s(%u)] Only key frames will be decoded because all outputs are encoded on demand. InputTrack(%d) > Decoder(%d)", _input_stream->GetApplicationName(), _input_stream->GetName().CStr(), _input_stream->GetId(), input_track->GetId(), decoder_id);
+		keyframe_only = true;
+	}
+	else if (input_track->GetMediaType() == cmn::MediaType::Video)
+	{
+		max_output_framerate = GetMaxOutputFrameRate(decoder_id);
+		if (max_output_framerate > 0.0)
+		{
+			logti("[%s/%s(%u)] Frames that outputs do not need will be skipped. InputTrack(%d) > Decoder(%d), max output framerate: %.2f", _input_stream->GetApplicationName(), _input_stream->GetName().CStr(), _input_stream->GetId(), input_track->GetId(), decoder_id, max_output_framerate);
+		}
+	}
+
+	// If another application already decodes the same input, its decoder is used
+	auto shared_key = TranscodeSharedDecoders::MakeKey(_input_stream, input_track);
+	if (shared_key.IsEmpty() == false)
+	{
+		auto shared_decoder = TranscodeSharedDecoders::GetInstance()->Subscribe(
+			shared_key, this, decoder_id, complete_handler, keyframe_only, max_output_framerate,
+			[&](TranscodeDecoder::CompleteHandler shared_complete_handler) {
+				return TranscodeDecoder::Create(decoder_id, *_input_stream, input_track, std::move(shared_complete_handler));
+			});
+
+		if (shared_decoder != nullptr)
+		{
+			auto &decoder = shared_decoder->GetDecoder();
+
+			// Filters are created according to the library of the decoder
+			input_track->SetCodecLibraryId(decoder->GetRefTrack()->GetCodecLibraryId());
+
+			_shared_decoders[decoder_id] = shared_decoder;
+			_decoders[decoder_id] = decoder;
+
+			return true;
+		}
+
+		logtw("[%s/%s(%u)] Could not create a shared decoder. A dedicated decoder is used. InputTrack(%d) > Decoder(%d)", _input_stream->GetApplicationName(), _input_stream->GetName().CStr(), _input_stream->GetId(), input_track->GetId(), decoder_id);
+	}
+
+	auto decoder = TranscodeDecoder::Create(decoder_id, *_input_stream, input_track, complete_handler);
 	if (decoder == nullptr)
 	{
 		logte("[%s/%s(%u)] Decoder allocation failed", _input_stream->GetApplicationName(), _input_stream->GetName().CStr(), _input_stream->GetId());
@@ -678,11 +787,93 @@ bool TranscoderStream::CreateDecoder(int32_t decoder_id, std::shared_ptr<MediaTr
 		return false;
 	}
 
+	if (keyframe_only)
+	{
+		decoder->SetKeyframeOnly(true);
+	}
+	else if (max_output_framerate > 0.0)
+	{
+		decoder->SetMaxOutputFrameRate(max_output_framerate);
+	}
+
 	_decoders[decoder_id] = std::move(decoder);
 
 	return true;
 }
 
+bool TranscoderStream::IsOnDemandOnlyDecoder(int32_t decoder_id)
+{
+	auto filters_it = _link_decoder_to_filters.find(decoder_id);
+	if ((filters_it == _link_decoder_to_filters.end()) || filters_it->second.empty())
+	{
+		return false;
+	}
+
+	for (auto &filter_id : filters_it->second)
+	{
+		auto encoder_it = _link_filter_to_encoder.find(filter_id);
+		if ((encoder_it == _link_filter_to_encoder.end()) || (_on_demand_encoders.find(encoder_it->second) == _on_demand_encoders.end()))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+double TranscoderStream::GetMaxOutputFrameRate(int32_t decoder_id)
+{
+	auto filters_it = _link_decoder_to_filters.find(decoder_id);
+	if ((filters_it == _link_decoder_to_filters.end()) || filters_it->second.empty())
+	{
+		return 0.0;
+	}
+
+	double max_framerate = 0.0;
+
+	for (auto &filter_id : filters_it->second)
+	{
+		auto encoder_it = _link_filter_to_encoder.find(filter_id);
+		if (encoder_it == _link_filter_to_encoder.end())
+		{
+			return 0.0;
+		}
+
+		auto encoder_id = encoder_it->second;
+		if (_on_demand_encoders.find(encoder_id) != _on_demand_encoders.end())
+		{
+			// On-demand encoders use only key frames
+			continue;
+		}
+
+		auto outputs_it = _link_encoder_to_outputs.find(encoder_id);
+		if (outputs_it == _link_encoder_to_outputs.end())
+		{
+			return 0.0;
+		}
+
+		for (auto &[output_stream, output_track_id] : outputs_it->second)
+		{
+			auto output_track = output_stream->GetTrack(output_track_id);
+			if ((output_track == nullptr) || (output_track->GetMediaType() != cmn::MediaType::Video))
+			{
+				return 0.0;
+			}
+
+			// If the frame rate is not limited, the output needs all frames
+			auto framerate = output_track->GetFrameRateByConfig();
+			if (framerate <= 0.0)
+			{
+				return 0.0;
+			}
+
+			max_framerate = std::max(max_framerate, framerate);
+		}
+	}
+
+	return max_framerate;
+}
+
 int32_t TranscoderStream::CreateEncoders(MediaFrame *buffer)
 {
 	MediaTrackId track_id = buffer->GetTrackId();
@@ -763,6 +954,24 @@ bool TranscoderStream::CreateEncoder(int32_t encoder_id, std::shared_ptr<info::S
 		return false;
 	}
 
+	if (_on_demand_encoders.find(encoder_id) != _on_demand_encoders.end())
+	{
+		encoder->SetOnDemand(true);
+
+		// The publisher requests encoding through the output tracks linked to the encoder
+		std::weak_ptr<TranscodeEncoder> encoder_ref = encoder;
+		for (auto &[linked_stream, linked_track_id] : _link_encoder_to_outputs[encoder_id])
+		{
+			OnDemandEncoding::GetInstance()->Register(linked_stream->GetId(), linked_track_id, [encoder_ref]() {
+				auto encoder = encoder_ref.lock();
+				if (encoder != nullptr)
+				{
+					encoder->RequestEncoding();
+				}
+			});
+		}
+	}
+
 	_encoders[encoder_id] = std::move(encoder);
 
 	return true;
@@ -787,6 +996,9 @@ int32_t TranscoderStream::CreateFilters(MediaFrame *buffer)
 	auto filter_ids = decoder_to_filters_it->second;
 
 	// 2. Get Output Track of Encoders
+	std::vector<int32_t> ladder_filter_ids;
+	std::vector<std::shared_ptr<MediaTrack>> ladder_output_tracks;
+
 	for (auto &filter_id : filter_ids)
 	{
 		MediaTrackId encoder_id = _link_filter_to_encoder[filter_id];
@@ -798,6 +1010,15 @@ int32_t TranscoderStream::CreateFilters(MediaFrame *buffer)
 
 		auto output_track = _encoders[encoder_id]->GetRefTrack();
 
+		// Video tracks of the same input are scaled together in a cascaded rescaler ladder
+		if (FilterRescalerLadder::IsSupported(input_track))
+		{
+			ladder_filter_ids.push_back(filter_id);
+			ladder_output_tracks.push_back(output_track);
+
+			continue;
+		}
+
 		logtd("%s Create Filter. Decoder(%d) > Filter(%d) > Encoder(%d)", _log_prefix.CStr(), decoder_id, filter_id, encoder_id);
 		if(CreateFilter(filter_id, input_track, output_track) == false)
 		{
@@ -807,6 +1028,27 @@ int32_t TranscoderStream::CreateFilters(MediaFrame *buffer)
 		created_count++;
 	}
 
+	if (ladder_filter_ids.size() == 1)
+	{
+		logtd("%s Create Filter. Decoder(%d) > Filter(%d) > Encoder(%d)", _log_prefix.CStr(), decoder_id, ladder_filter_ids[0], _link_filter_to_encoder[ladder_filter_ids[0]]);
+		if (CreateFilter(ladder_filter_ids[0], input_track, ladder_output_tracks[0]) == true)
+		{
+			created_count++;
+		}
+		else
+		{
+			logte("%s Could not create filter. Decoder(%d) > Filter(%d)", _log_prefix.CStr(), decoder_id, ladder_filter_ids[0]);
+		}
+	}
+	else if (ladder_filter_ids.size() > 1)
+	{
+		logtd("%s Create Filter Ladder. Decoder(%d) > Filters(%zu)", _log_prefix.CStr(), decoder_id, ladder_filter_ids.size());
+		if (CreateFilterLadder(ladder_filter_ids, input_track, ladder_output_tracks) == true)
+		{
+			created_count += ladder_filter_ids.size();
+		}
+	}
+
 	return created_count;
 }
 
@@ -848,6 +1090,52 @@ bool TranscoderStream::CreateFilter(int32_t filter_id, std::shared_ptr<MediaTrac
 	return true;
 }
 
+bool TranscoderStream::CreateFilterLadder(const std::vector<int32_t> &filter_ids, std::shared_ptr<MediaTrack> input_track, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks)
+{
+	std::lock_guard<std::shared_mutex> filter_lock(_filter_map_mutex);
+
+	// remove the previous created filters
+	for (auto &filter_id : filter_ids)
+	{
+		auto filter_it = _filters.find(filter_id);
+		if ((filter_it != _filters.end()) && (filter_it->second != nullptr))
+		{
+			filter_it->second->Stop();
+			filter_it->second = nullptr;
+		}
+	}
+
+	auto input_stream = GetInputStream();
+	if(input_stream == nullptr)
+	{
+		logte("%s Could not found input stream", _log_prefix.CStr());
+		return false;
+	}
+
+	auto output_stream = GetOutputStreamByTrackId(output_tracks[0]->GetId());
+	if(output_stream == nullptr)
+	{
+		logte("%s Could not found output stream", _log_prefix.CStr());
+		return false;
+	}
+
+	auto filter = std::make_shared<TranscodeFilter>();
+
+	if (filter->Configure(filter_ids, input_stream, input_track, output_stream, output_tracks, bind(&TranscoderStream::OnFilteredFrame, this, std::placeholders::_1, std::placeholders::_2)) != true)
+	{
+		logte("%s Failed to create filter ladder. Filter(%d), Outputs(%zu)", _log_prefix.CStr(), filter_ids[0], filter_ids.size());
+		return false;
+	}
+
+	// All filters of the ladder share one filter instance
+	for (auto &filter_id : filter_ids)
+	{
+		_filters[filter_id] = filter;
+	}
+
+	return true;
+}
+
 
 // Function called when codec information is extracted or changed from the decoder
 void TranscoderStream::ChangeOutputFormat(MediaFrame *buffer)
@@ -1070,6 +1358,13 @@ void TranscoderStream::DecodePacket(std::shared_ptr<MediaPacket> packet)
 	{
 		return;
 	}
+	auto shared_decoder_it = _shared_decoders.find(decoder_id);
+	if (shared_decoder_it != _shared_decoders.end())
+	{
+		shared_decoder_it->second->SendBuffer(this, std::move(packet));
+		return;
+	}
+
 	auto decoder = decoder_it->second;
 	decoder->SendBuffer(std::move(packet));
 }
@@ -1204,6 +1499,9 @@ void TranscoderStream::OnDecodedFrame(TranscodeResult result, int32_t decoder_id
 
 			auto input_track = GetInputTrack(decoder_id);
 
+			decoded_frame->SetMemoryUsage(_frame_memory_usage);
+			LogFrameMemoryUsageIfNeeded();
+
 			// Record the timestamp of the last decoded frame. managed by microseconds.
 			_last_decoded_frame_pts[decoder_id] = decoded_frame->GetPts() * input_track->GetTimeBase().GetExpr() * 1000000;
 
@@ -1221,9 +1519,28 @@ void TranscoderStream::OnDecodedFrame(TranscodeResult result, int32_t decoder_id
 	}
 }
 
+void TranscoderStream::LogFrameMemoryUsageIfNeeded()
+{
+	auto now = ov::Clock::NowMSec();
+	auto last_log_time = _last_frame_memory_usage_log_time.load();
+	if (((now - last_log_time) < FRAME_MEMORY_USAGE_LOG_INTERVAL_MS) ||
+		(_last_frame_memory_usage_log_time.compare_exchange_strong(last_log_time, now) == false))
+	{
+		return;
+	}
+
+	logtd("%s Frame memory usage: %s (%lld frames), peak: %s",
+		  _log_prefix.CStr(),
+		  ov::Converter::BytesToString(_frame_memory_usage->GetBytes()).CStr(),
+		  _frame_memory_usage->GetFrameCount(),
+		  ov::Converter::BytesToString(_frame_memory_usage->GetPeakBytes()).CStr());
+}
+
 void TranscoderStream::SetLastDecodedFrame(int32_t decoder_id, std::shared_ptr<MediaFrame> &decoded_frame)
 {
-	_last_decoded_frames[decoder_id] = decoded_frame->CloneFrame();
+	// Decoded frames are not modified, so the reference is kept instead of a clone.
+	// GetLastDecodedFrame() returns a clone because the filler frame changes the PTS.
+	_last_decoded_frames[decoder_id] = decoded_frame;
 }
 
 std::shared_ptr<MediaFrame> TranscoderStream::GetLastDecodedFrame(int32_t decoder_id)
@@ -1287,6 +1604,7 @@ TranscodeResult TranscoderStream::FilterFrame(int32_t filter_id, std::shared_ptr
 void TranscoderStream::OnFilteredFrame(int32_t filter_id, std::shared_ptr<MediaFrame> filtered_frame)
 {
 	filtered_frame->SetTrackId(filter_id);
+	filtered_frame->SetMemoryUsage(_frame_memory_usage);
 
 	EncodeFrame(std::move(filtered_frame));
 }
@@ -1420,8 +1738,39 @@ void TranscoderStream::SpreadToFilters(int32_t decoder_id, std::shared_ptr<Media
 	}
 	auto filter_ids = filters->second;
 
+	// A rescaler ladder is shared by several filter IDs, so the frame is sent to it only once.
+	std::vector<std::shared_ptr<TranscodeFilter>> sent_filters;
+
 	for (auto &filter_id : filter_ids)
 	{
+		// Holds a reference, because the filter can be replaced/removed after the lock is released
+		std::shared_ptr<TranscodeFilter> filter;
+
+		{
+			std::shared_lock<std::shared_mutex> lock(_filter_map_mutex);
+
+			auto filter_it = _filters.find(filter_id);
+			if ((filter_it == _filters.end()) || (filter_it->second == nullptr))
+			{
+				continue;
+			}
+
+			filter = filter_it->second;
+			if (std::find(sent_filters.begin(), sent_filters.end(), filter) != sent_filters.end())
+			{
+				continue;
+			}
+
+			sent_filters.push_back(filter);
+		}
+
+		// Filters that only read the frame share it
+		if (filter->IsInputReadOnly())
+		{
+			FilterFrame(filter_id, frame);
+			continue;
+		}
+
 		auto frame_clone = frame->CloneFrame();
 		if (frame_clone == nullptr)
 		{
@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <memory>
 #include <queue>
+#include <set>
 #include <vector>
 
 #include "base/info/stream.h"
@@ -22,6 +23,7 @@
 #include "transcoder_decoder.h"
 #include "transcoder_encoder.h"
 #include "transcoder_filter.h"
+#include "transcoder_shared_decoder.h"
 #include "transcoder_stream_internal.h"
 
 class TranscodeApplication;
@@ -67,9 +69,22 @@ public:
 			return _output_tracks;
 		}
 
+		void SetOnDemand(bool on_demand)
+		{
+			_on_demand = on_demand;
+		}
+
+		bool IsOnDemand() const
+		{
+			return _on_demand;
+		}
+
 	private:
 		MediaTrackId _id;
 
+		// Encoded only when a consumer requests it
+		bool _on_demand = false;
+
 		// Input Track
 		std::pair<std::shared_ptr<info::Stream>, std::shared_ptr<MediaTrack>> _input_track;
 
@@ -94,6 +109,11 @@ public:
 	void NotifyDeleteStreams();
 	void NotifyUpdateStreams();
 
+	const std::shared_ptr<MediaFrameMemoryUsage> &GetFrameMemoryUsage() const
+	{
+		return _frame_memory_usage;
+	}
+
 private:
 	ov::String _log_prefix;
 	std::shared_mutex _format_change_mutex;
@@ -137,14 +157,23 @@ private:
 	// [FILTER_ID, ENCODER_ID]
 	std::map<MediaTrackId, MediaTrackId> _link_filter_to_encoder;
 
+	// [ENCODER_ID] of encoders that encode only when requested
+	std::set<MediaTrackId> _on_demand_encoders;
+
 	// [ENCODER_ID, OUTPUT_TRACKS]
 	std::map<MediaTrackId, std::vector<std::pair<std::shared_ptr<info::Stream>, MediaTrackId>>> _link_encoder_to_outputs;
 
 	// Decoder Component
 	// DECODER_ID, DECODER
 	std::map<MediaTrackId, std::shared_ptr<TranscodeDecoder>> _decoders;
+	// DECODER_ID, SHARED_DECODER (Decoders shared with the streams of other applications)
+	std::map<MediaTrackId, std::shared_ptr<TranscodeSharedDecoder>> _shared_decoders;
 	std::map<MediaTrackId, std::shared_ptr<MediaFrame>> _last_decoded_frames;
 
+	// Memory of the decoded/filtered frames that are alive in this stream
+	std::shared_ptr<MediaFrameMemoryUsage> _frame_memory_usage = std::make_shared<MediaFrameMemoryUsage>();
+	std::atomic<int64_t> _last_frame_memory_usage_log_time{0LL};
+
 	// Filter Component
 	// FILTER_ID, FILTER
 	std::map<MediaTrackId, std::shared_ptr<TranscodeFilter>> _filters;
@@ -174,15 +203,22 @@ private:
 						 std::shared_ptr<info::Stream> input_stream,
 						 std::shared_ptr<MediaTrack> input_track,
 						 std::shared_ptr<info::Stream> output_stream,
-						 std::shared_ptr<MediaTrack> output_track);
+						 std::shared_ptr<MediaTrack> output_track,
+						 bool on_demand = false);
 
 	ov::String GetInfoStringComposite();
+	// Counts the output tracks that share an encoder and reports it to the stream metrics
+	void UpdateDeduplicatedEncodes();
 
 	int32_t CreateDecoders();
 	bool CreateDecoder(int32_t decoder_id, std::shared_ptr<MediaTrack> input_track);
+	bool IsOnDemandOnlyDecoder(int32_t decoder_id);
+	// The highest frame rate of the outputs linked to the decoder. 0 if any output needs all frames.
+	double GetMaxOutputFrameRate(int32_t decoder_id);
 
 	int32_t CreateFilters(MediaFrame *buffer);
 	bool CreateFilter(int32_t filter_id, std::shared_ptr<MediaTrack> input_track, std::shared_ptr<MediaTrack> output_track);
+	bool CreateFilterLadder(const std::vector<int32_t> &filter_ids, std::shared_ptr<MediaTrack> input_track, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks);
 	std::shared_ptr<MediaTrack> GetInputTrackOfFilter(int32_t decoder_id);
 
 	int32_t CreateEncoders(MediaFrame *buffer);
@@ -192,6 +228,7 @@ private:
 	// Step 1: Decode (Decode a frame from given packets)
 	void DecodePacket(std::shared_ptr<MediaPacket> packet);
 	void OnDecodedFrame(TranscodeResult result, int32_t decoder_id, std::shared_ptr<MediaFrame> decoded_frame);
+	void LogFrameMemoryUsageIfNeeded();
 	void SetLastDecodedFrame(int32_t decoder_id, std::shared_ptr<MediaFrame> &decoded_frame);
 	std::shared_ptr<MediaFrame> GetLastDecodedFrame(int32_t decoder_id);
 
@@ -44,17 +44,34 @@ ov::String TranscoderStreamInternal::GetIdentifiedForVideoProfile(const uint32_t
 		unique_profile_name +=  ov::String::FormatString("-Pf%s", profile.GetProfile().CStr());
 	}
 
+	// Profiles with the same signature share one encoder, so every setting of the encoder must be included
+	if (profile.GetKeyFrameInterval() > 0)
+	{
+		unique_profile_name += ov::String::FormatString("-K%d", profile.GetKeyFrameInterval());
+	}
+
+	if (profile.GetBFrames() > 0)
+	{
+		unique_profile_name += ov::String::FormatString("-B%d", profile.GetBFrames());
+	}
+
+	if (profile.GetThreadCount() >= 0)
+	{
+		unique_profile_name += ov::String::FormatString("-Th%d", profile.GetThreadCount());
+	}
+
 	return unique_profile_name;
 }
 
 ov::String TranscoderStreamInternal::GetIdentifiedForImageProfile(const uint32_t track_id, const cfg::vhost::app::oprf::ImageProfile &profile)
 {
-	return ov::String::FormatString("In_T%d_Out_C%s-%.02f-%d-%d",
+	return ov::String::FormatString("In_T%d_Out_C%s-%.02f-%d-%d%s",
 									track_id,
 									profile.GetCodec().CStr(),
 									profile.GetFramerate(),
 									profile.GetWidth(),
-									profile.GetHeight());
+									profile.GetHeight(),
+									profile.IsOnDemand() ? "-ondemand" : "");
 }
 
 ov::String TranscoderStreamInternal::GetIdentifiedForAudioProfile(const uint32_t track_id, const cfg::vhost::app::oprf::AudioProfile &profile)
@@ -310,8 +327,9 @@ std::shared_ptr<MediaTrack> TranscoderStreamInternal::CreateOutputTrack(const st
 		output_track->SetHeightByConfig(profile.GetHeight());
 	}
 
+	// On-demand images are encoded from the latest key frame when requested, so the frame rate is not limited
 	profile.GetFramerate(&is_parsed);
-	if (is_parsed == true)
+	if ((is_parsed == true) && (profile.IsOnDemand() == false))
 	{
 		output_track->SetFrameRateByConfig(profile.GetFramerate());
 	}